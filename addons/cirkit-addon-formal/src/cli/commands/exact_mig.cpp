@@ -31,9 +31,11 @@
 
 #include <cli/stores.hpp>
 #include <core/utils/program_options.hpp>
+#include <classical/functions/exact_mig_cnf.hpp>
 #include <classical/mig/mig.hpp>
 #include <classical/mig/mig_from_string.hpp>
 #include <classical/mig/mig_utils.hpp>
+#include <classical/utils/exact_database.hpp>
 #include <classical/utils/truth_table_utils.hpp>
 #include <formal/synthesis/exact_mig.hpp>
 
@@ -68,13 +70,25 @@ exact_mig_command::exact_mig_command( const environment::ptr& env )
     ( "breaking",          value_with_default( &breaking ),      "symmetry breaking\ns: structural hashing\na: associativity\nl: co-lexicographic ordering\nt: support\ny: symmetric variables" )
     ( "print_solutions",                                         "print solutions" )
     ( "enc_int",                                                 "encode numbers as integers (not bit-vectors)" )
+    ( "engine",            value_with_default( &engine ),        "synthesis engine:\nz3: SMT encoding\ncnf: native CNF encoding (truth tables only)" )
     ( "timeout",           value( &timeout ),                    "timeout (in seconds)" )
     ( "timeout_heuristic",                                       "continue with next level on timeout" )
+    ( "portfolio",         value_with_default( &portfolio ),     "number of threads solving gate counts and encodings in parallel (size-optimum only)" )
+    ( "database",          value( &database ),                   "database of optimum networks (default: $CIRKIT_HOME/exact.db)" )
+    ( "no_database",                                             "do not look up or store networks in the database" )
     ( "very_verbose",                                            "be very verbose" )
     ;
   be_verbose();
 }
 
+command::rules_t exact_mig_command::validity_rules() const
+{
+  return {
+    {[this]() { return engine == "z3" || engine == "cnf"; }, "engine must be z3 or cnf" },
+    {[this]() { return engine == "z3" || !is_set( "mig" ); }, "cnf engine requires truth table specification" }
+  };
+}
+
 bool exact_mig_command::execute()
 {
   using boost::format;
@@ -97,6 +111,12 @@ bool exact_mig_command::execute()
     settings->set( "timeout", boost::optional<unsigned>( timeout ) );
     settings->set( "timeout_heuristic", is_set( "timeout_heuristic" ) );
   }
+  settings->set( "portfolio",           portfolio );
+
+  if ( !is_set( "no_database" ) )
+  {
+    settings->set( "database", is_set( "database" ) ? database : default_exact_database_filename() );
+  }
 
   const auto& tts = env->store<tt>();
   auto& migs = env->store<mig_graph>();
@@ -116,7 +136,7 @@ bool exact_mig_command::execute()
   }
   else
   {
-    auto new_mig = exact_mig_with_sat( tts.current(), settings, statistics );
+    auto new_mig = engine == "cnf" ? exact_mig_with_cnf( tts.current(), settings, statistics ) : exact_mig_with_sat( tts.current(), settings, statistics );
     if ( (bool)new_mig )
     {
       migs.extend();
@@ -142,7 +162,10 @@ bool exact_mig_command::execute()
   }
 
   print_runtime();
-  std::cout << format( "[i] memory: %.2f MB" ) % statistics->get<double>( "memory" ) << std::endl;
+  if ( engine == "z3" )
+  {
+    std::cout << format( "[i] memory: %.2f MB" ) % statistics->get<double>( "memory" ) << std::endl;
+  }
 
   return true;
 }
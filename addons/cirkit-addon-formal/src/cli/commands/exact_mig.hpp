@@ -47,6 +47,7 @@ public:
   exact_mig_command( const environment::ptr& env );
 
 protected:
+  rules_t validity_rules() const;
   bool execute();
 
 public:
@@ -58,8 +59,11 @@ private:
   unsigned    stop;
   unsigned    start_depth = 1u;
   unsigned    timeout;
+  unsigned    portfolio = 0u;
   unsigned    max_solutions = 1u;
   std::string breaking = "CIsalty";
+  std::string engine = "z3";
+  std::string database;
 };
 
 }
@@ -31,7 +31,9 @@
 
 #include <cli/stores.hpp>
 #include <core/utils/program_options.hpp>
+#include <classical/functions/exact_mig_cnf.hpp>
 #include <classical/mig/mig.hpp>
+#include <classical/utils/exact_database.hpp>
 #include <classical/utils/truth_table_utils.hpp>
 #include <classical/xmg/xmg.hpp>
 #include <classical/xmg/xmg_expr.hpp>
@@ -66,13 +68,25 @@ exact_xmg_command::exact_xmg_command( const environment::ptr& env )
     ( "breaking",          value_with_default( &breaking ),  "symmetry breaking\ns: structural hashing\na: associativity\nl: co-lexicographic ordering\nt: support" )
     ( "print_solutions",                                     "print solutions" )
     ( "enc_int",                                             "encode numbers as integers (not bit-vectors)" )
+    ( "engine",            value_with_default( &engine ),    "synthesis engine:\nz3: SMT encoding\ncnf: native CNF encoding (truth tables only)" )
     ( "timeout",           value( &timeout ),                "timeout (in seconds)" )
     ( "timeout_heuristic",                                   "continue with next level on timeout" )
+    ( "portfolio",         value_with_default( &portfolio ), "number of threads solving gate counts and encodings in parallel (size-optimum only)" )
+    ( "database",          value( &database ),               "database of optimum networks (default: $CIRKIT_HOME/exact.db)" )
+    ( "no_database",                                         "do not look up or store networks in the database" )
     ( "very_verbose",                                        "be very verbose" )
     ;
   be_verbose();
 }
 
+command::rules_t exact_xmg_command::validity_rules() const
+{
+  return {
+    {[this]() { return engine == "z3" || engine == "cnf"; }, "engine must be z3 or cnf" },
+    {[this]() { return engine == "z3" || !is_set( "mig" ); }, "cnf engine requires truth table specification" }
+  };
+}
+
 bool exact_xmg_command::execute()
 {
   using boost::format;
@@ -90,6 +104,12 @@ bool exact_xmg_command::execute()
     settings->set( "timeout", boost::optional<unsigned>( timeout ) );
     settings->set( "timeout_heuristic", is_set( "timeout_heuristic" ) );
   }
+  settings->set( "portfolio",           portfolio );
+
+  if ( !is_set( "no_database" ) )
+  {
+    settings->set( "database", is_set( "database" ) ? database : default_exact_database_filename() );
+  }
 
   const auto& tts = env->store<tt>();
   auto& migs = env->store<mig_graph>();
@@ -110,7 +130,7 @@ bool exact_xmg_command::execute()
   }
   else
   {
-    auto new_xmg = exact_xmg_with_sat( tts.current(), settings, statistics );
+    auto new_xmg = engine == "cnf" ? exact_xmg_with_cnf( tts.current(), settings, statistics ) : exact_xmg_with_sat( tts.current(), settings, statistics );
     if ( (bool)new_xmg )
     {
       xmgs.extend();
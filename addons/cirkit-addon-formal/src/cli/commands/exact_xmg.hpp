@@ -47,6 +47,7 @@ public:
   exact_xmg_command( const environment::ptr& env );
 
 protected:
+  rules_t validity_rules() const;
   bool execute();
 
 public:
@@ -56,7 +57,10 @@ private:
   unsigned              objective = 0u;
   unsigned              start = 1u;
   unsigned              timeout;
+  unsigned              portfolio = 0u;
   std::string           breaking = "CIsalty";
+  std::string           engine = "z3";
+  std::string           database;
 };
 
 }
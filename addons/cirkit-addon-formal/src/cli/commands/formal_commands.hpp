@@ -40,13 +40,15 @@
 #include <cli/commands/exact_xmg.hpp>
 #include <cli/commands/xmglut.hpp>
 #include <cli/commands/xmgmine.hpp>
+#include <cli/commands/xmgrewrite.hpp>
 
 #define CIRKIT_FORMAL_Z3_CLI_COMMANDS \
   cli.set_category( "Synthesis" );    \
   ADD_COMMAND( exact_mig );           \
   ADD_COMMAND( exact_xmg );           \
   ADD_COMMAND( xmglut );              \
-  ADD_COMMAND( xmgmine );
+  ADD_COMMAND( xmgmine );             \
+  ADD_COMMAND( xmgrewrite );
 
 #endif
 
@@ -31,6 +31,7 @@
 
 #include <alice/rules.hpp>
 #include <cli/stores.hpp>
+#include <classical/utils/exact_database.hpp>
 #include <formal/xmg/xmg_mine.hpp>
 #include <formal/xmg/xmg_minlib.hpp>
 
@@ -46,6 +47,9 @@ xmgmine_command::xmgmine_command( const environment::ptr& env )
     ( "lut_file",  value( &lut_file ), "filename with truth table in binary form in each line" )
     ( "opt_file",  value( &opt_file ), "filename with optimum XMG database" )
     ( "timeout,t", value( &timeout ),  "timeout in seconds (afterwards, heuristics are tried)" )
+    ( "npn_cache", value( &npn_cache ), "file to load NPN classes from and save them to" )
+    ( "database",  value( &database ),  "database of optimum networks (default: $CIRKIT_HOME/exact.db)" )
+    ( "no_database",                   "do not look up or store networks in the database" )
     ( "add,a",                         "add current XMG to database" )
     ( "verify",                        "verifies entries in optimum XMG database" )
     ;
@@ -115,6 +119,14 @@ bool xmgmine_command::execute()
     {
       settings->set( "timeout", boost::optional<unsigned>( timeout ) );
     }
+    if ( is_set( "npn_cache" ) )
+    {
+      settings->set( "npn_cache", npn_cache );
+    }
+    if ( !is_set( "no_database" ) )
+    {
+      settings->set( "database", is_set( "database" ) ? database : default_exact_database_filename() );
+    }
     xmg_mine( lut_file, opt_file, settings );
   }
 
@@ -56,6 +56,8 @@ private:
   std::string lut_file;
   std::string opt_file;
   unsigned    timeout;
+  std::string npn_cache;
+  std::string database;
 };
 
 }
@@ -0,0 +1,133 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "xmgrewrite.hpp"
+
+#include <boost/format.hpp>
+#include <boost/optional.hpp>
+#include <boost/program_options.hpp>
+
+#include <alice/rules.hpp>
+#include <core/utils/program_options.hpp>
+#include <classical/utils/exact_database.hpp>
+#include <formal/xmg/xmg_minlib.hpp>
+
+using namespace boost::program_options;
+
+namespace cirkit
+{
+
+/******************************************************************************
+ * Types                                                                      *
+ ******************************************************************************/
+
+/******************************************************************************
+ * Private functions                                                          *
+ ******************************************************************************/
+
+/******************************************************************************
+ * Public functions                                                           *
+ ******************************************************************************/
+
+xmgrewrite_command::xmgrewrite_command( const environment::ptr& env )
+  : xmg_base_command( env, "Rewrite XMG with optimum XMGs from library" )
+{
+  opts.add_options()
+    ( "cut_size,k", value_with_default( &cut_size ), "cut size (at most 6)" )
+    ( "threads",    value_with_default( &threads ),  "number of threads (0: shared pool, 1: sequential)" )
+    ( "noxor",                                       "don't use XOR, only works with cut sizes up to 4" )
+    ( "opt_file",   value( &opt_file ),              "filename with additional optimum XMGs" )
+    ( "timeout,t",  value( &timeout ),               "timeout in seconds for missing entries (afterwards, heuristics are tried)" )
+    ( "npn_cache",  value( &npn_cache ),             "file to load NPN classes from and save them to" )
+    ( "database",   value( &database ),              "database of optimum networks (default: $CIRKIT_HOME/exact.db)" )
+    ( "no_database",                                 "do not look up or store networks in the database" )
+    ( "progress,p",                                  "show progress" )
+    ;
+  add_new_option();
+  be_verbose();
+}
+
+command::rules_t xmgrewrite_command::validity_rules() const
+{
+  return {
+    has_xmg( env ),
+    {[this]() { return cut_size >= 2u && cut_size <= 6u; }, "cut size must be between 2 and 6" },
+    {[this]() { return !is_set( "noxor" ) || cut_size <= 4u; }, "cut size can be at most 4 if no XOR is allowed" },
+    file_exists_if_set( *this, opt_file, "opt_file" )
+  };
+}
+
+bool xmgrewrite_command::execute()
+{
+  auto settings = make_settings();
+  settings->set( "cut_size", cut_size );
+  settings->set( "num_threads", threads );
+  settings->set( "noxor", is_set( "noxor" ) );
+  settings->set( "progress", is_set( "progress" ) );
+  if ( is_set( "opt_file" ) )
+  {
+    settings->set( "library", opt_file );
+  }
+  if ( is_set( "timeout" ) )
+  {
+    settings->set( "timeout", boost::optional<unsigned>( timeout ) );
+  }
+  if ( is_set( "npn_cache" ) )
+  {
+    settings->set( "npn_cache", npn_cache );
+  }
+  if ( !is_set( "no_database" ) )
+  {
+    settings->set( "database", is_set( "database" ) ? database : default_exact_database_filename() );
+  }
+
+  auto xmg_new = xmg_minlib_rewrite( xmg(), settings, statistics );
+  extend_if_new( store );
+  xmg() = xmg_new;
+
+  std::cout << boost::format( "[i] replaced %d cones, gain: %d" ) % statistics->get<unsigned>( "num_replacements" ) % statistics->get<unsigned>( "gain" ) << std::endl;
+  print_runtime();
+
+  return true;
+}
+
+command::log_opt_t xmgrewrite_command::log() const
+{
+  return log_opt_t({
+      {"runtime", statistics->get<double>( "runtime" )},
+      {"cut_size", static_cast<int>( cut_size )},
+      {"num_replacements", static_cast<int>( statistics->get<unsigned>( "num_replacements" ) )},
+      {"gain", static_cast<int>( statistics->get<unsigned>( "gain" ) )}
+    });
+}
+
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
@@ -26,8 +26,16 @@
 
 #include "exact_mig.hpp"
 
+#include <algorithm>
+#include <chrono>
 #include <cmath>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <thread>
 #include <type_traits>
 #include <vector>
 
@@ -38,8 +46,10 @@
 
 #include <core/utils/range_utils.hpp>
 #include <core/utils/timer.hpp>
+#include <classical/functions/exact_mig_cnf.hpp>
 #include <classical/mig/mig_from_string.hpp>
 #include <classical/mig/mig_utils.hpp>
+#include <classical/utils/exact_database.hpp>
 #include <classical/utils/spec_representation.hpp>
 
 #ifdef ADDON_FORMAL
@@ -1008,6 +1018,7 @@ public:
 
     timeout             = get( settings, "timeout",             boost::optional<unsigned>() );
     timeout_heuristic   = get( settings, "timeout_heuristic",   false );
+    portfolio           = get( settings, "portfolio",           0u );    /* number of threads, 0: sequential */
     verbose             = get( settings, "verbose",             false );
     very_verbose        = get( settings, "very_verbose",        false );
 
@@ -1019,6 +1030,9 @@ public:
     support    = spec.support();
     symmetries = spec.symmetric_variables();
 
+    /* the CNF engine in the portfolio needs the (non-inverted) truth table */
+    cnf_spec   = spec.apply_visitor( explicit_spec_visitor() );
+
     if ( verbose )
     {
       std::cout << "[i] symmetry breaking: " << symmetry_breaking << std::endl;
@@ -1055,7 +1069,7 @@ public:
       switch ( objective )
       {
       case 0u:
-        return exact_mig_size_explicit();
+        return portfolio > 1u ? exact_mig_size_portfolio() : exact_mig_size_explicit();
       case 1u:
         return exact_mig_size_depth_explicit();
       case 2u:
@@ -1102,6 +1116,254 @@ public:
     }
   }
 
+  /* Solves several gate counts and both number encodings at once.  Jobs are
+   * pairs of gate count and encoding in increasing order of gate count, each
+   * with its own Z3 context.  The result is the smallest gate count k with a
+   * realization, after all gate counts smaller than k have been shown to be
+   * unrealizable.  Jobs whose answer is no longer needed are interrupted.
+   * For explicit specifications, the CNF engine from exact_mig_with_cnf races
+   * the jobs in an additional thread; it tries gate counts in increasing order
+   * and therefore its result is optimum. */
+  std::vector<T> exact_mig_size_portfolio()
+  {
+    const std::vector<bool> encodings = {enc_with_bitvectors, !enc_with_bitvectors};
+    const auto num_enc = static_cast<unsigned>( encodings.size() );
+
+    enum class status_t { open, unsat, sat };
+
+    struct job_t
+    {
+      unsigned                            k;
+      bool                                enc_bv;
+      std::shared_ptr<exact_mig_instance> inst;
+    };
+
+    std::mutex                    mutex;
+    std::condition_variable       cv;
+    std::map<unsigned, status_t>  status;   /* per gate count */
+    std::map<unsigned, unsigned>  unknowns; /* number of encodings that timed out */
+    std::vector<job_t*>           running;
+    std::vector<T>                solutions;
+    std::exception_ptr            error;
+    auto                          next_job = 0u;
+    auto                          best     = stop + 1u; /* smallest gate count with realization */
+    auto                          failed   = false;
+    const auto                    with_cnf = (bool)cnf_spec && !timeout_heuristic;
+    auto                          workers  = portfolio + ( with_cnf ? 1u : 0u );
+
+    /* the following lambdas expect the lock to be held */
+    const auto needed = [&]( unsigned k ) {
+      return !failed && !error && k < best && status[k] == status_t::open;
+    };
+
+    const auto finished = [&]() {
+      if ( failed || error ) { return true; }
+      for ( auto k = start; k < best && k <= stop; ++k )
+      {
+        if ( status[k] != status_t::unsat ) { return false; }
+      }
+      return true;
+    };
+
+    const auto cancel = [&]() {
+      for ( auto* job : running )
+      {
+        if ( !needed( job->k ) )
+        {
+          job->inst->ctx.interrupt();
+        }
+      }
+    };
+
+    const auto worker = [&]() {
+      while ( true )
+      {
+        job_t job;
+
+        {
+          std::lock_guard<std::mutex> lock( mutex );
+
+          while ( true )
+          {
+            job.k = start + next_job / num_enc;
+            if ( finished() || job.k >= best || job.k > stop ) { --workers; cv.notify_all(); return; }
+            job.enc_bv = encodings[next_job++ % num_enc];
+            if ( needed( job.k ) ) { break; }
+          }
+
+          if ( verbose )
+          {
+            std::cout << boost::format( "[i] check for realization with %d gates (%s encoding)" ) % job.k % ( job.enc_bv ? "bit-vector" : "integer" ) << std::endl;
+          }
+        }
+
+        try
+        {
+          /* building the instance cannot be interrupted, check in between levels */
+          const auto inst = create_instance( job.enc_bv );
+          auto cancelled = false;
+          for ( auto i = 0u; i < job.k && !cancelled; ++i )
+          {
+            inst->add_level( symmetry_breaking );
+
+            std::lock_guard<std::mutex> lock( mutex );
+            cancelled = !needed( job.k );
+          }
+          if ( cancelled ) { continue; }
+          constrain( inst );
+
+          {
+            std::lock_guard<std::mutex> lock( mutex );
+            if ( !needed( job.k ) ) { continue; }
+            job.inst = inst;
+            running.push_back( &job );
+          }
+
+          const auto result = inst->solver.check();
+
+          std::lock_guard<std::mutex> lock( mutex );
+          running.erase( std::find( running.begin(), running.end(), &job ) );
+
+          if ( needed( job.k ) )
+          {
+            if ( result == z3::sat )
+            {
+              status[job.k] = status_t::sat;
+              best = job.k;
+              store_memory( inst );
+              solutions = extract_solutions( inst );
+            }
+            else if ( result == z3::unsat )
+            {
+              status[job.k] = status_t::unsat;
+            }
+            else if ( ++unknowns[job.k] == num_enc )
+            {
+              /* all encodings timed out for this gate count */
+              if ( timeout_heuristic )
+              {
+                status[job.k] = status_t::unsat;
+              }
+              else
+              {
+                failed = true;
+                last_size = job.k;
+              }
+            }
+
+            cancel();
+          }
+
+          cv.notify_all();
+        }
+        catch ( ... )
+        {
+          std::lock_guard<std::mutex> lock( mutex );
+          const auto it = std::find( running.begin(), running.end(), &job );
+          if ( it != running.end() ) { running.erase( it ); }
+          if ( !error ) { error = std::current_exception(); }
+          cancel();
+          cv.notify_all();
+        }
+      }
+    };
+
+    const auto cnf_worker = [&]() {
+      try
+      {
+        const auto cnf_settings = std::make_shared<properties>();
+        cnf_settings->set( "start",         start );
+        cnf_settings->set( "stop",          stop );
+        cnf_settings->set( "max_solutions", max_solutions );
+        cnf_settings->set( "breaking",      breaking );
+        cnf_settings->set( "timeout",       timeout );
+        cnf_settings->set( "model_name",    model_name );
+        cnf_settings->set( "output_name",   output_name );
+        cnf_settings->set( "cancel",        std::function<bool()>( [&]() {
+              std::lock_guard<std::mutex> lock( mutex );
+              return finished();
+            } ) );
+
+        const auto networks = exact_with_cnf<T>( *cnf_spec, cnf_settings );
+
+        std::lock_guard<std::mutex> lock( mutex );
+        if ( !networks.empty() )
+        {
+          const auto k = num_gates<T>( networks.front() );
+          if ( !failed && !error && k < best )
+          {
+            for ( auto j = start; j < k; ++j )
+            {
+              status[j] = status_t::unsat;
+            }
+            status[k] = status_t::sat;
+            best = k;
+            solutions = networks;
+
+            if ( verbose )
+            {
+              std::cout << boost::format( "[i] CNF engine found realization with %d gates" ) % k << std::endl;
+            }
+
+            cancel();
+          }
+        }
+      }
+      catch ( ... )
+      {
+        std::lock_guard<std::mutex> lock( mutex );
+        if ( !error ) { error = std::current_exception(); }
+        cancel();
+      }
+
+      std::lock_guard<std::mutex> lock( mutex );
+      --workers;
+      cv.notify_all();
+    };
+
+    std::vector<std::thread> threads;
+    for ( auto i = 0u; i < portfolio; ++i )
+    {
+      threads.emplace_back( worker );
+    }
+    if ( with_cnf )
+    {
+      threads.emplace_back( cnf_worker );
+    }
+
+    {
+      /* interrupts can get lost if they arrive before the solver starts,
+         therefore they are repeated until all workers have returned */
+      std::unique_lock<std::mutex> lock( mutex );
+      while ( workers != 0u )
+      {
+        cv.wait_for( lock, std::chrono::milliseconds( 10 ) );
+        cancel();
+      }
+    }
+
+    for ( auto& t : threads )
+    {
+      t.join();
+    }
+
+    if ( error )
+    {
+      std::rethrow_exception( error );
+    }
+
+    if ( failed || solutions.empty() )
+    {
+      if ( !failed )
+      {
+        last_size = stop;
+      }
+      return std::vector<T>();
+    }
+
+    return solutions;
+  }
+
   std::vector<T> exact_mig_size_depth_explicit()
   {
     auto k = start;
@@ -1262,6 +1524,32 @@ private:
     return true;
   }
 
+  template<typename C, typename std::enable_if<std::is_same<mig_graph, C>::value>::type* = nullptr>
+  std::vector<mig_graph> exact_with_cnf( const tt& spec, const properties::ptr& settings ) const
+  {
+    const auto statistics = std::make_shared<properties>();
+    return (bool)exact_mig_with_cnf( spec, settings, statistics ) ? statistics->get<std::vector<mig_graph>>( "all_solutions" ) : std::vector<mig_graph>();
+  }
+
+  template<typename C, typename std::enable_if<std::is_same<xmg_graph, C>::value>::type* = nullptr>
+  std::vector<xmg_graph> exact_with_cnf( const tt& spec, const properties::ptr& settings ) const
+  {
+    const auto statistics = std::make_shared<properties>();
+    return (bool)exact_xmg_with_cnf( spec, settings, statistics ) ? statistics->get<std::vector<xmg_graph>>( "all_solutions" ) : std::vector<xmg_graph>();
+  }
+
+  template<typename C, typename std::enable_if<std::is_same<mig_graph, C>::value>::type* = nullptr>
+  unsigned num_gates( const mig_graph& mig ) const
+  {
+    return number_of_gates( mig );
+  }
+
+  template<typename C, typename std::enable_if<std::is_same<xmg_graph, C>::value>::type* = nullptr>
+  unsigned num_gates( const xmg_graph& xmg ) const
+  {
+    return xmg.num_gates();
+  }
+
   template<typename C, typename std::enable_if<std::is_same<mig_graph, C>::value>::type* = nullptr>
   mig_graph create_trivial( unsigned id, bool complement )
   {
@@ -1318,7 +1606,12 @@ private:
 
   inline std::shared_ptr<exact_mig_instance> create_instance() const
   {
-    auto inst = std::make_shared<exact_mig_instance>( spec.num_vars(), with_xor<T>(), enc_with_bitvectors, spec.is_explicit(), timeout );
+    return create_instance( enc_with_bitvectors );
+  }
+
+  inline std::shared_ptr<exact_mig_instance> create_instance( bool enc_bv ) const
+  {
+    auto inst = std::make_shared<exact_mig_instance>( spec.num_vars(), with_xor<T>(), enc_bv, spec.is_explicit(), timeout );
     inst->support    = support;
     inst->symmetries = symmetries;
     return inst;
@@ -1339,6 +1632,19 @@ private:
     return migs;
   }
 
+  struct explicit_spec_visitor : public boost::static_visitor<boost::optional<tt>>
+  {
+    boost::optional<tt> operator()( const tt& spec ) const
+    {
+      return spec;
+    }
+
+    boost::optional<tt> operator()( const mig_graph& spec ) const
+    {
+      return boost::none;
+    }
+  };
+
   struct constrain_visitor : public boost::static_visitor<void>
   {
     constrain_visitor( const std::shared_ptr<exact_mig_instance>& inst ) : inst( inst ) {}
@@ -1410,12 +1716,14 @@ private:
   bool enc_with_bitvectors;
   boost::optional<unsigned> timeout;
   bool timeout_heuristic;
+  unsigned portfolio;
   bool verbose;
   bool very_verbose;
 
   /* pre-computed function properties */
   boost::dynamic_bitset<>                    support;
   std::vector<std::pair<unsigned, unsigned>> symmetries;
+  boost::optional<tt>                        cnf_spec;
 
   /* vector for symmetry breaking (bits from 0 to ?):
    * 0: commutativity          C
@@ -1433,6 +1741,22 @@ public:
   unsigned last_size = 0u; /* the last level that has been tried (helpful when using timeout) */
   double   memory    = -1.0; /* memory usage */
 };
+
+/* networks from the solver are only stored in the database if they are
+   optimum, i.e., enumeration started from the smallest size and depth and
+   did not continue after a timeout */
+bool is_optimum_run( const properties::ptr& settings )
+{
+  return get( settings, "start", 1u ) <= 1u && get( settings, "start_depth", 1u ) <= 1u &&
+         !get( settings, "timeout_heuristic", false );
+}
+
+/* the database stores one network per function */
+std::shared_ptr<exact_database> database_for_run( const properties::ptr& settings )
+{
+  return get( settings, "max_solutions", 1u ) == 1u ? exact_database_from_settings( settings ) : nullptr;
+}
+
 #endif
 
 /******************************************************************************
@@ -1448,12 +1772,34 @@ boost::optional<mig_graph> exact_mig_with_sat( const tt& spec,
 
   assert( !spec.empty() );
 
+  const auto db        = database_for_run( settings );
+  const auto objective = get( settings, "objective", 0u );
+  if ( db )
+  {
+    const auto mig = db->find_mig( spec, objective, true, get( settings, "model_name", std::string( "exact" ) ),
+                                  get( settings, "output_name", std::string( "f" ) ) );
+    if ( (bool)mig )
+    {
+      set( statistics, "all_solutions", std::vector<mig_graph>{*mig} );
+      set( statistics, "last_size", 0u );
+      set( statistics, "memory", 0.0 );
+      set( statistics, "database_hit", true );
+      return mig;
+    }
+  }
+
   exact_mig_manager<mig_graph> mgr( spec_representation( spec ), settings );
 
   const auto migs = mgr.run();
   set( statistics, "all_solutions", migs );
   set( statistics, "last_size", mgr.last_size );
   set( statistics, "memory", mgr.memory );
+  set( statistics, "database_hit", false );
+
+  if ( db && !migs.empty() && is_optimum_run( settings ) )
+  {
+    db->insert_mig( spec, objective, migs.front() );
+  }
 
   if ( migs.empty() )
   {
@@ -1498,12 +1844,34 @@ boost::optional<xmg_graph> exact_xmg_with_sat( const tt& spec,
 
   assert( !spec.empty() );
 
+  const auto db        = database_for_run( settings );
+  const auto objective = get( settings, "objective", 0u );
+  if ( db )
+  {
+    const auto xmg = db->find_xmg( spec, objective, true, get( settings, "model_name", std::string( "exact" ) ),
+                                  get( settings, "output_name", std::string( "f" ) ) );
+    if ( (bool)xmg )
+    {
+      set( statistics, "all_solutions", std::vector<xmg_graph>{*xmg} );
+      set( statistics, "last_size", 0u );
+      set( statistics, "memory", 0.0 );
+      set( statistics, "database_hit", true );
+      return xmg;
+    }
+  }
+
   exact_mig_manager<xmg_graph> mgr( spec_representation( spec ), settings );
 
   const auto xmgs = mgr.run();
   set( statistics, "all_solutions", xmgs );
   set( statistics, "last_size", mgr.last_size );
   set( statistics, "memory", mgr.memory );
+  set( statistics, "database_hit", false );
+
+  if ( db && !xmgs.empty() && is_optimum_run( settings ) )
+  {
+    db->insert_xmg( spec, objective, xmgs.front() );
+  }
 
   if ( xmgs.empty() )
   {
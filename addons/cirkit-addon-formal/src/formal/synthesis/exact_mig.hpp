@@ -60,6 +60,8 @@ namespace cirkit
    | min_depth           | Smallest MIG with smallest depth              | false                  |
    | all_solutions       | Enumerate all solutions                       | false                  |
    | enc_with_bitvectors | Encode numbers as bit-vectors and not as ints | false                  |
+   | portfolio           | Threads for gate counts and encodings (size), | 0u                     |
+   |                     | races the CNF engine for truth tables         |                        |
    | verbose             | Be verbose                                    | false                  |
    |---------------------+-----------------------------------------------+------------------------|
  */
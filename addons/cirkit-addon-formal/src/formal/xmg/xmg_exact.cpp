@@ -38,6 +38,7 @@
 
 #include <core/utils/range_utils.hpp>
 #include <core/utils/timer.hpp>
+#include <classical/utils/exact_database.hpp>
 #include <classical/utils/spec_representation.hpp>
 
 #ifdef ADDON_FORMAL
@@ -744,6 +745,21 @@ boost::optional<xmg_graph> xmg_exact_with_sat( const tt& spec,
   assert( !spec.empty() );
 
   const auto all_solutions = get( settings, "all_solutions", false );
+
+  /* size-optimum XMGs share the database entries of exact_xmg_with_sat */
+  const auto db = all_solutions ? nullptr : exact_database_from_settings( settings );
+  if ( db )
+  {
+    const auto xmg = db->find_xmg( spec, 0u, true, get( settings, "model_name", std::string( "exact" ) ),
+                                   get( settings, "output_name", std::string( "f" ) ) );
+    if ( (bool)xmg )
+    {
+      set( statistics, "last_size", 0u );
+      set( statistics, "database_hit", true );
+      return xmg;
+    }
+  }
+
   xmg_exact_manager mgr( spec_representation( spec ), settings );
 
   const auto migs = mgr.run();
@@ -752,6 +768,13 @@ boost::optional<xmg_graph> xmg_exact_with_sat( const tt& spec,
     set( statistics, "all_solutions", migs );
   }
   set( statistics, "last_size", mgr.last_size );
+  set( statistics, "database_hit", false );
+
+  /* only optimum if enumeration started at the smallest size and did not skip a timeout */
+  if ( db && !migs.empty() && get( settings, "start", 1u ) <= 1u && !get( settings, "timeout_heuristic", false ) )
+  {
+    db->insert_xmg( spec, 0u, migs.front() );
+  }
 
   if ( migs.empty() )
   {
@@ -26,8 +26,13 @@
 
 #include "xmg_minlib.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <fstream>
 #include <iomanip>
+#include <memory>
+#include <mutex>
+#include <set>
 #include <sstream>
 
 #include <boost/algorithm/string/trim.hpp>
@@ -36,12 +41,15 @@
 
 #include <core/utils/conversion_utils.hpp>
 #include <core/utils/string_utils.hpp>
+#include <core/utils/thread_pool.hpp>
 #include <core/utils/timer.hpp>
 #include <classical/functions/aig_from_truth_table.hpp>
 #include <classical/functions/npn_canonization.hpp>
 #include <classical/utils/expression_parser.hpp>
 #include <classical/xmg/xmg_aig.hpp>
+#include <classical/xmg/xmg_cuts_paged.hpp>
 #include <classical/xmg/xmg_expr.hpp>
+#include <classical/xmg/xmg_mffc.hpp>
 #include <classical/xmg/xmg_simulate.hpp>
 #include <classical/xmg/xmg_string.hpp>
 #include <formal/synthesis/exact_mig.hpp>
@@ -54,10 +62,124 @@ namespace cirkit
  * Types                                                                      *
  ******************************************************************************/
 
+struct xmg_minlib_replacement
+{
+  std::vector<xmg_node>      leafs;
+  const xmg_minlib_template* tmpl = nullptr;
+  boost::dynamic_bitset<>    phase;
+  std::vector<unsigned>      perm;
+};
+
+using xmg_minlib_replacements_t = std::vector<boost::optional<xmg_minlib_replacement>>;
+
+/* NPN class of a cut function, hex is empty if the cut is not considered */
+struct xmg_minlib_cut_class
+{
+  std::string             hex;
+  boost::dynamic_bitset<> phase;
+  std::vector<unsigned>   perm;
+};
+
 /******************************************************************************
  * Private functions                                                          *
  ******************************************************************************/
 
+xmg_minlib_template compile_template( const std::string& expr, unsigned num_vars )
+{
+  xmg_graph xmg;
+  std::vector<xmg_function> pis;
+  for ( auto i = 0u; i < num_vars; ++i )
+  {
+    pis.push_back( xmg.create_pi( std::string( 1, 'a' + i ) ) );
+  }
+  auto xfs_settings = std::make_shared<properties>();
+  xfs_settings->set( "primary_inputs", pis );
+  const auto f = xmg_from_string( xmg, expr, xfs_settings );
+
+  xmg_minlib_template tmpl;
+  tmpl.num_vars = num_vars;
+
+  std::vector<unsigned> index( xmg.size(), 0u );
+  for ( auto i = 0u; i < num_vars; ++i )
+  {
+    index[pis[i].node] = i + 1u;
+  }
+
+  const auto literal = [&index]( const xmg_function& g ) {
+    return ( index[g.node] << 1u ) | static_cast<unsigned>( g.complemented );
+  };
+
+  /* children come before their parents */
+  for ( auto n : xmg.topological_nodes() )
+  {
+    if ( !xmg.is_maj( n ) && !xmg.is_xor( n ) ) { continue; }
+
+    const auto c = xmg.children( n );
+
+    xmg_minlib_template::gate_t gate;
+    gate.is_xor   = xmg.is_xor( n );
+    gate.fanin[0] = literal( c[0] );
+    gate.fanin[1] = literal( c[1] );
+    gate.fanin[2] = gate.is_xor ? 0u : literal( c[2] );
+
+    index[n] = num_vars + 1u + tmpl.gates.size();
+    tmpl.gates.push_back( gate );
+  }
+
+  tmpl.output = literal( f );
+
+  return tmpl;
+}
+
+xmg_function xmg_minlib_rebuild_rec( const xmg_graph& xmg, xmg_node node,
+                                     xmg_graph& xmg_new,
+                                     const xmg_minlib_replacements_t& replacements,
+                                     std::vector<xmg_function>& old_to_new,
+                                     boost::dynamic_bitset<>& visited )
+{
+  if ( visited[node] )
+  {
+    return old_to_new[node];
+  }
+
+  xmg_function f;
+  if ( replacements[node] )
+  {
+    const auto& r = *replacements[node];
+    const auto num_vars = r.tmpl->num_vars;
+
+    std::vector<xmg_function> inputs( num_vars );
+    for ( auto i = 0u; i < num_vars; ++i )
+    {
+      inputs[i] = xmg_minlib_rebuild_rec( xmg, r.leafs[r.perm[i]], xmg_new, replacements, old_to_new, visited ) ^ r.phase[r.perm[i]];
+    }
+    f = r.tmpl->instantiate( xmg_new, inputs ) ^ r.phase[num_vars];
+  }
+  else if ( xmg.is_maj( node ) )
+  {
+    const auto c = xmg.children( node );
+    f = xmg_new.create_maj( xmg_minlib_rebuild_rec( xmg, c[0].node, xmg_new, replacements, old_to_new, visited ) ^ c[0].complemented,
+                            xmg_minlib_rebuild_rec( xmg, c[1].node, xmg_new, replacements, old_to_new, visited ) ^ c[1].complemented,
+                            xmg_minlib_rebuild_rec( xmg, c[2].node, xmg_new, replacements, old_to_new, visited ) ^ c[2].complemented );
+  }
+  else if ( xmg.is_xor( node ) )
+  {
+    const auto c = xmg.children( node );
+    f = xmg_new.create_xor( xmg_minlib_rebuild_rec( xmg, c[0].node, xmg_new, replacements, old_to_new, visited ) ^ c[0].complemented,
+                            xmg_minlib_rebuild_rec( xmg, c[1].node, xmg_new, replacements, old_to_new, visited ) ^ c[1].complemented );
+  }
+  else
+  {
+    /* cannot happen */
+    assert( false );
+  }
+
+  visited.set( node );
+  old_to_new[node] = f;
+
+  return f;
+}
+
 void xmg_minlib_manager::load_library( std::istream& in )
 {
   std::string line;
@@ -107,6 +229,7 @@ std::string xmg_minlib_manager::find_or_create_xmg( const std::string& hex )
   auto exs_settings = std::make_shared<properties>();
   exs_settings->set( "verbose", true );
   exs_settings->set( "timeout", timeout );
+  exs_settings->set( "database", database );
   auto exs_statistics = std::make_shared<properties>();
 
   tt spec( convert_hex2bin( hex ) );
@@ -172,6 +295,18 @@ std::string xmg_minlib_manager::find_or_create_xmg( const std::string& hex )
   return str;
 }
 
+const xmg_minlib_template& xmg_minlib_manager::find_or_create_template( const std::string& hex )
+{
+  const auto it = templates.find( hex );
+  if ( it != templates.end() )
+  {
+    return it->second;
+  }
+
+  const auto expr = find_or_create_xmg( hex );
+  return templates.insert( {hex, compile_template( expr, boost::integer_log2( hex.size() << 2u ) )} ).first->second;
+}
+
 npn_manager::npn_classifier_t make_classifier()
 {
   return npn_manager::npn_classifier_t([]( const tt& t, boost::dynamic_bitset<>& phase, std::vector<unsigned>& perm ) {
@@ -190,15 +325,53 @@ npn_manager::npn_classifier_t make_classifier()
  * Public functions                                                           *
  ******************************************************************************/
 
+xmg_function xmg_minlib_template::instantiate( xmg_graph& dest, const std::vector<xmg_function>& inputs ) const
+{
+  std::vector<xmg_function> fs;
+  fs.reserve( 1u + num_vars + gates.size() );
+  fs.push_back( dest.get_constant( false ) );
+  fs.insert( fs.end(), inputs.begin(), inputs.begin() + num_vars );
+
+  const auto literal = [&fs]( unsigned l ) {
+    return fs[l >> 1u] ^ static_cast<bool>( l & 1u );
+  };
+
+  for ( const auto& gate : gates )
+  {
+    if ( gate.is_xor )
+    {
+      fs.push_back( dest.create_xor( literal( gate.fanin[0] ), literal( gate.fanin[1] ) ) );
+    }
+    else
+    {
+      fs.push_back( dest.create_maj( literal( gate.fanin[0] ), literal( gate.fanin[1] ), literal( gate.fanin[2] ) ) );
+    }
+  }
+
+  return literal( output );
+}
+
 xmg_minlib_manager::xmg_minlib_manager( const properties::ptr& settings )
   : npn( 4096, make_classifier() )
 {
   timeout = get( settings, "timeout", timeout );
   verbose = get( settings, "verbose", verbose );
+  npn_cache = get( settings, "npn_cache", npn_cache );
+  database  = get( settings, "database", database );
+
+  if ( !npn_cache.empty() && npn.load( npn_cache ) && verbose )
+  {
+    std::cout << "[i] loaded " << npn.size() << " NPN classes from " << npn_cache << std::endl;
+  }
 }
 
 xmg_minlib_manager::~xmg_minlib_manager()
 {
+  if ( !npn_cache.empty() )
+  {
+    npn.save( npn_cache );
+  }
+
   if ( auto_update )
   {
     update_out.close();
@@ -248,24 +421,13 @@ xmg_graph xmg_minlib_manager::find_xmg( const tt& spec )
 {
   const auto numvars = tt_num_vars( spec );
 
-  std::vector<unsigned> perm;
-  boost::dynamic_bitset<> phase;
-  const auto npn_spec = npn.compute( spec, phase, perm );
-
   xmg_graph xmg;
   std::vector<xmg_function> pis;
   for ( auto i = 0u; i < numvars; ++i )
   {
-    xmg.create_pi( std::string( 1, 'a' + i ) );
-  }
-  for ( auto i = 0u; i < numvars; ++i )
-  {
-    pis.push_back( {xmg.inputs()[perm[i]].first, phase[perm[i]]} );
+    pis.push_back( xmg.create_pi( std::string( 1, 'a' + i ) ) );
   }
-  auto xfs_settings = std::make_shared<properties>();
-  xfs_settings->set( "primary_inputs", pis );
-  const auto min_xmg_expr = find_or_create_xmg( tt_to_hex( npn_spec ) );
-  xmg.create_po( xmg_from_string( xmg, min_xmg_expr, xfs_settings ) ^ phase[numvars], "f" );
+  xmg.create_po( rewrite_inplace( spec, xmg, pis ), "f" );
 
   return xmg;
 }
@@ -280,14 +442,219 @@ xmg_graph xmg_minlib_manager::find_xmg_no_npn( const tt& spec )
   {
     pis.push_back( xmg.create_pi( std::string( 1, 'a' + i ) ) );
   }
-  auto xfs_settings = std::make_shared<properties>();
-  xfs_settings->set( "primary_inputs", pis );
-  const auto min_xmg_expr = find_or_create_xmg( tt_to_hex( spec ) );
-  xmg.create_po( xmg_from_string( xmg, min_xmg_expr, xfs_settings ), "f" );
+  xmg.create_po( find_or_create_template( tt_to_hex( spec ) ).instantiate( xmg, pis ), "f" );
 
   return xmg;
 }
 
+xmg_function xmg_minlib_manager::rewrite_inplace( const tt& spec,
+                                                  xmg_graph& dest,
+                                                  const std::vector<xmg_function>& pi_mapping )
+{
+  const auto numvars = tt_num_vars( spec );
+
+  std::vector<unsigned> perm;
+  boost::dynamic_bitset<> phase;
+  const auto npn_spec = npn.compute( spec, phase, perm );
+
+  std::vector<xmg_function> inputs( numvars );
+  for ( auto i = 0u; i < numvars; ++i )
+  {
+    inputs[i] = pi_mapping[perm[i]] ^ phase[perm[i]];
+  }
+
+  return find_or_create_template( tt_to_hex( npn_spec ) ).instantiate( dest, inputs ) ^ phase[numvars];
+}
+
+xmg_graph xmg_minlib_manager::rewrite( xmg_graph& xmg, const properties::ptr& settings, const properties::ptr& statistics )
+{
+  /* settings */
+  const auto cut_size    = get( settings, "cut_size",    4u );
+  const auto num_threads = get( settings, "num_threads", 0u );
+  const auto progress    = get( settings, "progress",    false );
+
+  /* statistics */
+  properties_timer t( statistics );
+
+  if ( cut_size > 6u )
+  {
+    throw "cut size must not be larger than 6";
+  }
+
+  xmg.compute_fanout();
+  xmg.compute_parents();
+
+  /* fanout-free regions, nodes are listed from the root downwards */
+  std::vector<unsigned char> is_po( xmg.size(), 0u );
+  for ( const auto& po : xmg.outputs() )
+  {
+    is_po[po.first.node] = 1u;
+  }
+
+  const auto topo = xmg.topological_nodes();
+  std::vector<unsigned> region_of( xmg.size(), 0u );
+  std::vector<std::vector<xmg_node>> regions;
+  for ( auto it = topo.rbegin(); it != topo.rend(); ++it )
+  {
+    const auto n = *it;
+    if ( !xmg.is_maj( n ) && !xmg.is_xor( n ) ) { continue; }
+
+    if ( xmg.fanout_count( n ) == 1u && !is_po[n] )
+    {
+      region_of[n] = region_of[xmg.parents( n ).front()];
+    }
+    else
+    {
+      region_of[n] = regions.size();
+      regions.push_back( std::vector<xmg_node>() );
+    }
+    regions[region_of[n]].push_back( n );
+  }
+
+  auto cuts_settings = std::make_shared<properties>();
+  cuts_settings->set( "progress", progress );
+  xmg_cuts_paged cuts( xmg, cut_size, cuts_settings );
+
+  if ( verbose )
+  {
+    std::cout << boost::format( "[i] enumerated %d cuts in %.2f secs, %d fanout-free regions" ) % cuts.total_cut_count() % cuts.enumeration_time() % regions.size() << std::endl;
+  }
+
+  std::unique_ptr<thread_pool> local_pool;
+  if ( num_threads > 1u )
+  {
+    local_pool.reset( new thread_pool( num_threads ) );
+  }
+  const auto foreach_region = [&]( const std::function<void(const std::vector<xmg_node>&)>& fn ) {
+    if ( num_threads == 1u )
+    {
+      for ( const auto& region : regions )
+      {
+        fn( region );
+      }
+      return;
+    }
+
+    auto& pool = local_pool ? *local_pool : shared_thread_pool();
+    pool.parallel_for( 0u, regions.size(), 16u, [&]( std::size_t i ) { fn( regions[i] ); } );
+  };
+
+  /* NPN classes of all cuts, computed once and used in both passes; the hex
+     string is empty if the function does not depend on all leafs (a smaller
+     cut has the same function) */
+  std::vector<std::vector<xmg_minlib_cut_class>> cut_classes( xmg.size() );
+
+  /* compile missing library entries first, templates is only read in parallel */
+  std::set<std::string> missing;
+  std::mutex missing_mutex;
+  foreach_region( [&]( const std::vector<xmg_node>& region ) {
+      for ( auto n : region )
+      {
+        auto& classes = cut_classes[n];
+        for ( const auto& cut : cuts.cuts( n ) )
+        {
+          classes.emplace_back();
+          auto& c = classes.back();
+
+          const auto spec = cuts.simulate( n, cut );
+          if ( cut.size() < 2u || tt_support_size( spec ) < cut.size() ) { continue; }
+
+          c.hex = tt_to_hex( npn.compute( spec, c.phase, c.perm ) );
+          if ( templates.find( c.hex ) == templates.end() )
+          {
+            std::lock_guard<std::mutex> lock( missing_mutex );
+            missing.insert( c.hex );
+          }
+        }
+      }
+    } );
+
+  for ( const auto& hex : missing )
+  {
+    find_or_create_template( hex );
+  }
+
+  /* select replacements from the region root downwards; the cone of a replaced
+     node is its MFFC within the region, therefore regions are independent */
+  std::vector<unsigned char> covered( xmg.size(), 0u );
+  xmg_minlib_replacements_t replacements( xmg.size() );
+  std::atomic<unsigned> num_replacements( 0u ), gain( 0u );
+
+  foreach_region( [&]( const std::vector<xmg_node>& region ) {
+      for ( auto n : region )
+      {
+        if ( covered[n] ) { continue; }
+
+        auto best_gain = 0u;
+        xmg_minlib_replacement best;
+        std::vector<xmg_node> best_cone;
+
+        auto index = 0u;
+        for ( const auto& cut : cuts.cuts( n ) )
+        {
+          const auto& c = cut_classes[n][index++];
+          if ( c.hex.empty() ) { continue; }
+
+          const auto& tmpl = templates.at( c.hex );
+
+          std::vector<xmg_node> leafs( cut.begin(), cut.end() );
+          const auto size = xmg_mffc_size( xmg, n, leafs );
+          if ( size <= tmpl.size() + best_gain ) { continue; }
+
+          /* the size is only saved if no node in the cone has fanout outside of it */
+          auto cone = xmg_mffc_cone( xmg, n, leafs );
+          if ( !std::all_of( cone.begin(), cone.end(), [&]( xmg_node m ) { return region_of[m] == region_of[n]; } ) ) { continue; }
+
+          best_gain = size - tmpl.size();
+          best.leafs = std::move( leafs );
+          best.tmpl = &tmpl;
+          best.phase = c.phase;
+          best.perm = c.perm;
+          best_cone = std::move( cone );
+        }
+
+        if ( best_gain == 0u ) { continue; }
+
+        for ( auto m : best_cone )
+        {
+          covered[m] = 1u;
+        }
+        replacements[n] = best;
+        ++num_replacements;
+        gain += best_gain;
+      }
+    } );
+
+  /* apply replacements */
+  xmg_graph xmg_new( xmg.name() );
+  std::vector<xmg_function> old_to_new( xmg.size() );
+  boost::dynamic_bitset<> visited( xmg.size() );
+
+  old_to_new[0u] = xmg_new.get_constant( false );
+  visited.set( 0u );
+  for ( const auto& pi : xmg.inputs() )
+  {
+    old_to_new[pi.first] = xmg_new.create_pi( pi.second );
+    visited.set( pi.first );
+  }
+
+  for ( const auto& po : xmg.outputs() )
+  {
+    xmg_new.create_po( xmg_minlib_rebuild_rec( xmg, po.first.node, xmg_new, replacements, old_to_new, visited ) ^ po.first.complemented, po.second );
+  }
+
+  if ( verbose )
+  {
+    std::cout << boost::format( "[i] replaced %d cones, gain %d gates" ) % num_replacements % gain << std::endl;
+  }
+
+  set( statistics, "num_cuts", cuts.total_cut_count() );
+  set( statistics, "num_replacements", num_replacements.load() );
+  set( statistics, "gain", gain.load() );
+
+  return xmg_new;
+}
+
 void xmg_minlib_manager::add_to_library( const xmg_graph& xmg )
 {
   auto sim_res = simulate_xmg( xmg, xmg_tt_simulator() ).at( xmg.outputs().front().first );
@@ -341,6 +708,41 @@ void xmg_minlib_manager::print_statistics( std::ostream& os )
   npn.print_statistics( os );
 }
 
+xmg_graph xmg_minlib_rewrite( xmg_graph& xmg, const properties::ptr& settings, const properties::ptr& statistics )
+{
+  /* settings */
+  const auto noxor    = get( settings, "noxor",    false );
+  const auto library  = get( settings, "library",  std::string() );
+  const auto cut_size = get( settings, "cut_size", 4u );
+
+  if ( noxor && cut_size > 4u )
+  {
+    throw "cut size can be at most 4 if no XOR is allowed";
+  }
+
+  xmg_minlib_manager minlib( settings );
+
+  if ( !noxor )
+  {
+    minlib.load_library_string( xmg_minlib_manager::npn2_s );
+    minlib.load_library_string( xmg_minlib_manager::npn3_s );
+    minlib.load_library_string( xmg_minlib_manager::npn4_s );
+  }
+  else
+  {
+    minlib.load_library_string( xmg_minlib_manager::npn2_s_mig );
+    minlib.load_library_string( xmg_minlib_manager::npn3_s_mig );
+    minlib.load_library_string( xmg_minlib_manager::npn4_s_mig );
+  }
+
+  if ( !library.empty() )
+  {
+    minlib.load_library_file( library );
+  }
+
+  return minlib.rewrite( xmg, settings, statistics );
+}
+
 std::string xmg_minlib_manager::npn2_s = "0x1 !<1ab>\n0x6 [ab]";
 
 std::string xmg_minlib_manager::npn3_s = "0x69 [!c[ab]]\n0x3c [bc]\n0x1b <!b!c[ac]>\n0x01 <0!b<!ab!c>>\n0x18 [c<abc>]\n0x0f !c\n0x1e [c<!0ab>]\n0x07 <0!c!<abc>>\n0x19 <!a[!ab]!<bc![!ab]>>\n0x03 <0!b!c>\n0x06 <0!c[ab]>\n0x00 0\n0x17 <!a!b!c>\n0x16 [!<!0ab>!<c<!0ab>![ab]>]";
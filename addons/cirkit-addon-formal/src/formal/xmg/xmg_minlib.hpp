@@ -29,6 +29,11 @@
  *
  * @brief Optimum XMGs from libraries
  *
+ * Library entries are kept as expression strings, but each entry is
+ * compiled once into a gate list (xmg_minlib_template) when it is first
+ * used, such that XMGs are instantiated without parsing the expression
+ * again.
+ *
  * @author Mathias Soeken
  * @since  2.3
  */
@@ -52,6 +57,25 @@
 namespace cirkit
 {
 
+/* library entry as a gate list; literals are 2 * index + complement, where
+   index 0 is the constant, 1 to num_vars are the inputs, and gates follow */
+struct xmg_minlib_template
+{
+  struct gate_t
+  {
+    bool     is_xor;
+    unsigned fanin[3]; /* fanin[2] is unused for XOR gates */
+  };
+
+  unsigned            num_vars = 0u;
+  std::vector<gate_t> gates;
+  unsigned            output = 0u;
+
+  inline unsigned size() const { return gates.size(); }
+
+  xmg_function instantiate( xmg_graph& dest, const std::vector<xmg_function>& inputs ) const;
+};
+
 class xmg_minlib_manager
 {
 public:
@@ -68,6 +92,11 @@ public:
                                 xmg_graph& dest,
                                 const std::vector<xmg_function>& pi_mapping );
 
+  /* replaces cut functions by library entries, see xmg_minlib_rewrite */
+  xmg_graph rewrite( xmg_graph& xmg,
+                     const properties::ptr& settings = properties::ptr(),
+                     const properties::ptr& statistics = properties::ptr() );
+
   void add_to_library( const xmg_graph& xmg );
   bool verify();
 
@@ -79,12 +108,16 @@ private:
   std::string format_library_entry( const std::string& hex, const std::string& expr );
 
   std::string find_or_create_xmg( const std::string& hex );
+  const xmg_minlib_template& find_or_create_template( const std::string& hex );
 
 private:
   std::unordered_map<std::string, std::vector<std::string>> library;
+  std::unordered_map<std::string, xmg_minlib_template>      templates; /* compiled first entries of library */
   npn_manager                                               npn;
   boost::optional<unsigned>                                 timeout;
-  bool                                                      verbose;
+  bool                                                      verbose = false;
+  std::string                                               npn_cache; /* file to load and save NPN classes */
+  std::string                                               database;  /* exact_database for missing entries */
 
   bool auto_update = false;
   std::ofstream update_out;
@@ -98,6 +131,47 @@ public: /* libraries */
   static std::string npn4_s_mig;
 };
 
+/**
+ * @brief Rewrites an XMG with optimum XMGs from the library
+ *
+ * Cuts are enumerated with xmg_cuts_paged and the function of each cut is
+ * looked up by its NPN class.  A cut is replaced if its cone is fanout free
+ * and larger (by xmg_mffc_size) than the library entry.  Since such cones
+ * lie within a single fanout-free region, replacements are selected for
+ * all regions in parallel.  Missing library entries are found with exact
+ * synthesis before the regions are processed.
+ *
+ * @settings
+ *
+   |-------------+------------------------------------------------------------------+---------------|
+   | Settings    | Description                                                      | Default       |
+   |-------------+------------------------------------------------------------------+---------------|
+   | cut_size    | Maximum cut size, at most 6                                      | 4u            |
+   | num_threads | 0: shared pool, 1: sequential, otherwise size of a local pool    | 0u            |
+   | noxor       | Use MIG libraries instead of XMG libraries                       | false         |
+   | library     | File name of an additional library                               | std::string() |
+   | timeout     | Timeout for exact synthesis of missing entries                   | boost::none   |
+   | npn_cache   | File to load NPN classes from and save them to                   | std::string() |
+   | database    | File name of the database of optimum networks                    | std::string() |
+   | progress    | Show progress                                                    | false         |
+   | verbose     | Be verbose                                                       | false         |
+   |-------------+------------------------------------------------------------------+---------------|
+ *
+ * @statistics
+ *
+   |------------------+------------------------------------------|
+   | Statistics       | Description                              |
+   |------------------+------------------------------------------|
+   | runtime          | Runtime in seconds                       |
+   | num_cuts         | Number of enumerated cuts                |
+   | num_replacements | Number of replaced cones                 |
+   | gain             | Number of removed gates (before hashing) |
+   |------------------+------------------------------------------|
+ */
+xmg_graph xmg_minlib_rewrite( xmg_graph& xmg,
+                              const properties::ptr& settings = properties::ptr(),
+                              const properties::ptr& statistics = properties::ptr() );
+
 }
 
 #endif
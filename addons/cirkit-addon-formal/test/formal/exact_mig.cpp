@@ -0,0 +1,89 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE exact_mig
+
+#include <functional>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <classical/mig/mig_simulate.hpp>
+#include <classical/mig/mig_utils.hpp>
+#include <classical/utils/truth_table_utils.hpp>
+#include <classical/xmg/xmg_simulate.hpp>
+#include <formal/synthesis/exact_mig.hpp>
+
+using namespace cirkit;
+
+/* 3- and 4-input functions, including non-normal ones */
+const std::vector<tt> specs = {tt( 8u, 0xe8u ), tt( 8u, 0x96u ), tt( 8u, 0x17u ), tt( 8u, 0x80u ),
+                               tt( 16u, 0x8000u ), tt( 16u, 0x7888u ), tt( 16u, 0x6996u )};
+
+template<typename T>
+void check_portfolio( const std::function<boost::optional<T>( const tt&, const properties::ptr& )>& synth,
+                      const std::function<tt( const T&, unsigned )>& simulate,
+                      const std::function<unsigned( const T& )>& num_gates )
+{
+  for ( const auto& spec : specs )
+  {
+    const auto num_vars = tt_num_vars( spec );
+    const auto sequential = synth( spec, properties::ptr() );
+    BOOST_REQUIRE( (bool)sequential );
+
+    for ( auto portfolio : {2u, 4u} )
+    {
+      auto settings = std::make_shared<properties>();
+      settings->set( "portfolio", portfolio );
+
+      const auto network = synth( spec, settings );
+      BOOST_REQUIRE( (bool)network );
+      BOOST_CHECK( simulate( *network, num_vars ) == spec );
+      BOOST_CHECK_EQUAL( num_gates( *network ), num_gates( *sequential ) );
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE( mig_portfolio )
+{
+  check_portfolio<mig_graph>( []( const tt& spec, const properties::ptr& settings ) { return exact_mig_with_sat( spec, settings ); },
+                              []( const mig_graph& mig, unsigned num_vars ) { return mig_simulate_output( mig, num_vars ); },
+                              number_of_gates );
+}
+
+BOOST_AUTO_TEST_CASE( xmg_portfolio )
+{
+  check_portfolio<xmg_graph>( []( const tt& spec, const properties::ptr& settings ) { return exact_xmg_with_sat( spec, settings ); },
+                              []( const xmg_graph& xmg, unsigned num_vars ) { return xmg_simulate_output( xmg, num_vars ); },
+                              []( const xmg_graph& xmg ) { return xmg.num_gates(); } );
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
@@ -0,0 +1,139 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE xmg_minlib
+
+#include <random>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <classical/utils/truth_table_utils.hpp>
+#include <classical/xmg/xmg.hpp>
+#include <classical/xmg/xmg_simulate.hpp>
+#include <formal/xmg/xmg_minlib.hpp>
+
+using namespace cirkit;
+
+/* XORs and majorities built from ANDs and ORs, followed by random gates */
+xmg_graph redundant_xmg( unsigned seed )
+{
+  xmg_graph xmg;
+  std::mt19937 gen( seed );
+
+  std::vector<xmg_function> fs;
+  for ( auto i = 0u; i < 6u; ++i )
+  {
+    fs.push_back( xmg.create_pi( std::string( 1u, 'a' + i ) ) );
+  }
+
+  for ( auto i = 0u; i < 4u; ++i )
+  {
+    const auto x = fs[gen() % 6u], y = fs[gen() % 6u], z = fs[gen() % 6u];
+    const auto xy = xmg.create_or( xmg.create_and( x, !y ), xmg.create_and( !x, y ) );
+    fs.push_back( xmg.create_or( xmg.create_and( xy, !z ), xmg.create_and( !xy, z ) ) );
+    fs.push_back( xmg.create_or( xmg.create_and( x, y ), xmg.create_or( xmg.create_and( x, z ), xmg.create_and( y, z ) ) ) );
+  }
+
+  for ( auto i = 0u; i < 20u; ++i )
+  {
+    const auto pick = [&]() { return fs[fs.size() - 1u - gen() % 8u] ^ static_cast<bool>( gen() % 2u ); };
+    fs.push_back( gen() % 3u ? xmg.create_maj( pick(), pick(), pick() ) : xmg.create_xor( pick(), pick() ) );
+  }
+
+  for ( auto i = 6u; i < fs.size(); i += 3u )
+  {
+    xmg.create_po( fs[i], "y" + std::to_string( i ) );
+  }
+
+  return xmg;
+}
+
+std::vector<tt> simulate( const xmg_graph& xmg )
+{
+  const auto values = simulate_xmg( xmg, xmg_tt_simulator() );
+
+  std::vector<tt> result;
+  for ( const auto& o : xmg.outputs() )
+  {
+    auto t = values.at( o.first );
+    tt_extend( t, xmg.inputs().size() );
+    result.push_back( t );
+  }
+  return result;
+}
+
+BOOST_AUTO_TEST_CASE(rewrite)
+{
+  for ( auto seed = 1u; seed <= 3u; ++seed )
+  {
+    auto xmg = redundant_xmg( seed );
+    const auto spec = simulate( xmg );
+
+    std::vector<unsigned> sizes;
+    for ( auto num_threads : {1u, 2u, 4u} )
+    {
+      auto settings = std::make_shared<properties>();
+      settings->set( "num_threads", num_threads );
+      auto statistics = std::make_shared<properties>();
+
+      const auto xmg_new = xmg_minlib_rewrite( xmg, settings, statistics );
+
+      BOOST_CHECK( simulate( xmg_new ) == spec );
+      BOOST_CHECK( xmg_new.num_gates() <= xmg.num_gates() );
+      BOOST_CHECK( statistics->get<unsigned>( "num_replacements" ) > 0u );
+      sizes.push_back( xmg_new.num_gates() );
+    }
+
+    /* regions are optimized independently, the result does not depend on the number of threads */
+    BOOST_CHECK_EQUAL( sizes[0u], sizes[1u] );
+    BOOST_CHECK_EQUAL( sizes[0u], sizes[2u] );
+  }
+}
+
+BOOST_AUTO_TEST_CASE(manager)
+{
+  /* MIG library, 3-input cuts */
+  xmg_minlib_manager minlib( std::make_shared<properties>() );
+  minlib.load_library_string( xmg_minlib_manager::npn2_s_mig );
+  minlib.load_library_string( xmg_minlib_manager::npn3_s_mig );
+
+  auto xmg = redundant_xmg( 4u );
+  const auto spec = simulate( xmg );
+
+  for ( auto num_threads : {1u, 2u} )
+  {
+    auto settings = std::make_shared<properties>();
+    settings->set( "cut_size", 3u );
+    settings->set( "num_threads", num_threads );
+
+    const auto xmg_new = minlib.rewrite( xmg, settings );
+
+    BOOST_CHECK( simulate( xmg_new ) == spec );
+    BOOST_CHECK( xmg_new.num_gates() <= xmg.num_gates() );
+  }
+}
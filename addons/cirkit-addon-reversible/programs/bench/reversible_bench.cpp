@@ -0,0 +1,127 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+/**
+ * @author Mathias Soeken
+ *
+ * Reversible synthesis benchmarks for cirkit_bench, linked in when the
+ * reversible addon is enabled.
+ */
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include <core/properties.hpp>
+#include <core/utils/microbenchmark.hpp>
+
+#include <reversible/circuit.hpp>
+#include <reversible/rcbdd.hpp>
+#include <reversible/truth_table.hpp>
+#include <reversible/synthesis/rcbdd_synthesis.hpp>
+#include <reversible/synthesis/transformation_based_synthesis.hpp>
+
+using namespace cirkit;
+
+namespace
+{
+
+binary_truth_table random_permutation_spec( unsigned n )
+{
+  std::vector<unsigned> perm( 1u << n );
+  std::iota( perm.begin(), perm.end(), 0u );
+  std::shuffle( perm.begin(), perm.end(), std::mt19937( 0xc1c1u + n ) );
+
+  binary_truth_table spec;
+  for ( auto x = 0u; x < perm.size(); ++x )
+  {
+    spec.add_entry( number_to_truth_table_cube( x, n ), number_to_truth_table_cube( perm[x], n ) );
+  }
+  return spec;
+}
+
+void benchmark_tbs( benchmark_state& state, unsigned n, bool bidirectional )
+{
+  const auto spec = random_permutation_spec( n );
+  auto settings = std::make_shared<properties>();
+  settings->set( "bidirectional", bidirectional );
+
+  auto gates = 0u;
+  while ( state.keep_running() )
+  {
+    circuit circ;
+    transformation_based_synthesis( circ, spec, settings );
+    gates = circ.num_gates();
+  }
+  state.set_counter( "gates", gates );
+}
+
+}
+
+CIRKIT_BENCHMARK( rev_tbs_random8 )
+{
+  benchmark_tbs( state, 8u, false );
+}
+
+CIRKIT_BENCHMARK( rev_tbs_bidirectional_random8 )
+{
+  benchmark_tbs( state, 8u, true );
+}
+
+/* x_{i+n} ^= x_i for all i < n, same function as in the rcbdd scalability test */
+CIRKIT_MACROBENCHMARK( rev_rcbdd_bitwise_xor12, 3u )
+{
+  const auto n = 12u;
+  auto settings = std::make_shared<properties>();
+  settings->set( "create_gates", false );
+
+  while ( state.keep_running() )
+  {
+    rcbdd cf;
+    cf.initialize_manager();
+    cf.create_variables( 2u * n );
+
+    BDD chi = cf.manager().bddOne();
+    for ( auto i = 0u; i < n; ++i )
+    {
+      chi &= cf.y( i ).Xnor( cf.x( i ) );
+      chi &= cf.y( n + i ).Xnor( cf.x( i ) ^ cf.x( n + i ) );
+    }
+    cf.set_chi( chi );
+
+    circuit circ;
+    rcbdd_synthesis( circ, cf, settings );
+  }
+  state.set_counter( "lines", 2u * n );
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
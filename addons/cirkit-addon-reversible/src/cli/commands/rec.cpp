@@ -30,6 +30,7 @@
 
 #include <core/utils/program_options.hpp>
 #include <cli/reversible_stores.hpp>
+#include <reversible/verification/staged_equivalence_check.hpp>
 #include <reversible/verification/xorsat_equivalence_check.hpp>
 
 namespace cirkit
@@ -54,17 +55,38 @@ rec_command::rec_command( const environment::ptr& env )
     ( "id1",            value_with_default( &id1 ), "ID of first circuit" )
     ( "id2",            value_with_default( &id2 ), "ID of second circuit" )
     ( "name_mapping,n",                             "map circuits by name instead by index" )
+    ( "staged,s",                                   "simulate before using SAT and BDDs (Toffoli, Fredkin, and Peres gates)" )
     ;
   be_verbose();
 }
 
+command::rules_t rec_command::validity_rules() const
+{
+  return {
+    { [this]() { return !is_set( "staged" ) || !is_set( "name_mapping" ); }, "name mapping is not supported by staged check" }
+  };
+}
+
 bool rec_command::execute()
 {
   const auto& circuits = env->store<circuit>();
 
   auto settings = make_settings();
-  settings->set( "name_mapping", is_set( "name_mapping" ) );
-  result = xorsat_equivalence_check( circuits[id1], circuits[id2], settings, statistics );
+
+  if ( is_set( "staged" ) )
+  {
+    result = staged_equivalence_check( circuits[id1], circuits[id2], settings, statistics );
+
+    if ( is_verbose() )
+    {
+      std::cout << "[i] decided by stage " << statistics->get<std::string>( "stage" ) << std::endl;
+    }
+  }
+  else
+  {
+    settings->set( "name_mapping", is_set( "name_mapping" ) );
+    result = xorsat_equivalence_check( circuits[id1], circuits[id2], settings, statistics );
+  }
 
   print_runtime();
 
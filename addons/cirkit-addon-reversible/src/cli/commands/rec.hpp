@@ -47,6 +47,7 @@ public:
   rec_command( const environment::ptr& env );
 
 protected:
+  rules_t validity_rules() const;
   bool execute();
 
 public:
@@ -30,7 +30,9 @@
 #include <boost/program_options.hpp>
 
 #include <alice/rules.hpp>
+#include <core/utils/program_options.hpp>
 #include <cli/reversible_stores.hpp>
+#include <reversible/simulation/bitsliced_simulation.hpp>
 #include <reversible/simulation/partial_simulation.hpp>
 #include <reversible/simulation/simple_simulation.hpp>
 
@@ -43,8 +45,10 @@ revsim_command::revsim_command( const environment::ptr& env )
   : cirkit_command( env, "Reversible circuit simulation" )
 {
   opts.add_options()
-    ( "partial,r",                    "use partial simulation" )
-    ( "pattern,p", value( &pattern ), "simulation pattern" )
+    ( "partial,r",                                     "use partial simulation" )
+    ( "pattern,p", value( &pattern ),                  "simulation pattern" )
+    ( "all,a",                                         "simulate all patterns with bit-sliced simulation" )
+    ( "threads,t", value_with_default( &num_threads ), "number of threads for bit-sliced simulation (0: one per core)" )
     ;
   add_positional_option( "pattern" );
 }
@@ -68,7 +72,9 @@ command::rules_t revsim_command::validity_rules() const
       }, "pattern must consists of 0s and 1s" },
     {[this]() { return pattern == "0*" ||
                        pattern == "1*" ||
-                       ( is_set( "partial" ) || env->store<circuit>().current().lines() == pattern.size() ); }, "pattern bits must equal number of lines" }
+                       is_set( "all" ) ||
+                       ( is_set( "partial" ) || env->store<circuit>().current().lines() == pattern.size() ); }, "pattern bits must equal number of lines" },
+    {[this]() { return !is_set( "all" ) || env->store<circuit>().current().lines() <= 32u; }, "bit-sliced simulation supports at most 32 lines" }
   };
 }
 
@@ -76,6 +82,39 @@ bool revsim_command::execute()
 {
   const auto& circuits = env->store<circuit>();
 
+  if ( is_set( "all" ) )
+  {
+    auto settings = make_settings();
+    settings->set( "num_threads", num_threads );
+
+    std::vector<boost::dynamic_bitset<>> table;
+    if ( !bitsliced_truth_table( table, circuits.current(), settings, statistics ) )
+    {
+      std::cout << "[e] circuit contains gates that are not supported by bit-sliced simulation" << std::endl;
+      return true;
+    }
+
+    /* print outputs as permutation for small circuits */
+    if ( table.size() <= 10u )
+    {
+      std::cout << "[i] result:";
+      for ( auto p = 0u; p < ( 1u << table.size() ); ++p )
+      {
+        auto value = 0u;
+        for ( auto i = 0u; i < table.size(); ++i )
+        {
+          if ( table[i][p] ) { value |= 1u << i; }
+        }
+        std::cout << " " << value;
+      }
+      std::cout << std::endl;
+    }
+
+    print_runtime();
+
+    return true;
+  }
+
   /* prepare pattern */
   if ( pattern == "0*" || pattern == "1*" )
   {
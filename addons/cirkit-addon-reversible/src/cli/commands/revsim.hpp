@@ -54,6 +54,7 @@ protected:
 
 private:
   std::string pattern;
+  unsigned    num_threads = 0u;
 };
 
 }
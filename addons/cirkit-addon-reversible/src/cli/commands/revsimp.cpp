@@ -53,6 +53,7 @@ revsimp_command::revsimp_command( const environment::ptr& env )
   opts.add_options()
     ( "methods",   value_with_default( &methods ), "optimization methods:\nm: try to merge gates with same target\nn: cancel NOT gates\na: merge adjacent gates\ne: resynthesize same-target gates with exorcism\np: same target optimization (reduces T-count)\ns: propagate SWAP gates (may change output order)" )
     ( "noreverse",                                 "do not optimize in reverse direction" )
+    ( "threads,t", value_with_default( &num_threads ), "number of threads for same target optimization (0: one per core)" )
     ;
   be_verbose();
   add_new_option();
@@ -70,6 +71,7 @@ bool revsimp_command::execute()
   auto settings = make_settings();
   settings->set( "methods",     methods );
   settings->set( "reverse_opt", !is_set( "noreverse" ) );
+  settings->set( "num_threads", num_threads );
   circuit circ;
   simplify( circ, circuits.current(), settings, statistics );
 
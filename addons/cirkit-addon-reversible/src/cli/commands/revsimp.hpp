@@ -57,6 +57,7 @@ public:
 
 private:
   std::string methods = "mnae";
+  unsigned    num_threads = 0u;
 };
 
 }
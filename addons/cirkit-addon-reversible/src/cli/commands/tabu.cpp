@@ -26,8 +26,11 @@
 
 #include "tabu.hpp"
 
+#include <algorithm>
 #include <iostream>
+#include <memory>
 #include <time.h>
+#include <core/utils/thread_pool.hpp>
 #include <core/utils/timer.hpp>
 #include <alice/rules.hpp>
 #include <cli/reversible_stores.hpp>
@@ -47,8 +50,6 @@
 #include <core/utils/program_options.hpp>
 
 
-typedef std::vector<std::vector<int>> matrix;
-
 namespace cirkit
 {
  
@@ -62,6 +63,8 @@ tabu_command::tabu_command(const environment::ptr& env)
     ( "neighborhood,g",value_with_default(&neighborhood),	"Select the size of the neighborhood" )
     ( "optimization,t",value_with_default(&opt),				"Select the optimization. 0: gates (default), 1: quantum cost, 2: average of both" )
     ( "overlap,o",value_with_default(&overlap),			"Select the size of the overlap (%)" )
+    ( "parallel,p",								"Score the rule windows in parallel and apply all non-conflicting improving rules in each iteration" )
+    ( "threads",value_with_default(&num_threads),	"Select the number of threads for parallel mode (0: one per core)" )
     ( "verbose,v",								"be verbose")
     ( "step,s",									"be verbose and step-by-step")
     ;
@@ -74,12 +77,12 @@ command::rules_t tabu_command::validity_rules() const
 }
 
 //Any rule changed the truth table?
-bool changed_circuit(circuit circ)
+bool changed_circuit(const circuit& circ)
 {
-	circuit aux;
+	circuit aux, miter = circ;
 	reverse_circuit(circ, aux);
-	append_circuit(circ, aux);
-	if(!is_identity(circ))
+	append_circuit(miter, aux);
+	if(!is_identity(miter))
 	{
 		std::cout << "Some rule changed the truth table of the circuit!" << std::endl;
 		return false;
@@ -125,175 +128,161 @@ int t_depth(unsigned int control)
 	}
 }
 
-unsigned int circuit_ncv_cost(circuit& circ)
+unsigned int circuit_ncv_cost(const circuit& circ)
 {
 	unsigned int cost = 0;
-	for (auto g : circ)
+	for (const auto& g : circ)
  		cost += ncv_cost(g.controls().size());
  	return cost;
 }
 
-void list_rules( circuit circ, std::vector<std::vector<int>>& x, unsigned begin, unsigned end, bool verbose )
+//Row of a rule: rule, gate indexes, gates cost, quantum cost, and average of both
+std::vector<int> rule_row( int rule, unsigned itGateIndex, int gates, int qcost )
+{
+	return {rule, int(itGateIndex), int(itGateIndex) + 1, gates, qcost, ( gates + qcost ) / 2};
+}
+
+//Rules of two adjacent gates, compared with sorted controls
+void pair_rules( const gate& itGate, const gate& nextGate, unsigned itGateIndex, matrix& x, bool verbose )
 {
-	for( circuit::const_iterator itGate = circ.begin() + begin, nextGate = ++( circ.begin() + begin );  nextGate != circ.begin() + end; ++itGate, ++nextGate )
+	int gaNCVCost, gbNCVCost; //Quantum cost of the gates
+	unsigned int gaControls, gbControls; //Controls of the gates
+
+	gate ga, gb;
+
+	ga.controls() = itGate.controls();
+	gb.controls() = nextGate.controls();
+	ga.targets() = itGate.targets();
+	gb.targets() = nextGate.targets();
+
+	std::sort( ga.controls().begin(), ga.controls().end() );
+	std::sort( gb.controls().begin(), gb.controls().end() );
+
+	gaControls = ga.controls().size();
+	gbControls = gb.controls().size();
+
+	gaNCVCost = ncv_cost(ga.controls().size());
+	gbNCVCost = ncv_cost(gb.controls().size());
+
+	if( verify_rule_Done( ga, gb ) )
 	{
-		unsigned int itGateIndex = itGate - circ.begin();
-		unsigned int nextGateIndex = nextGate - circ.begin();
-		int gaNCVCost, gbNCVCost, gaTdepth, gbTdepth; //Quantum cost of the gates
-		unsigned int gaControls, gbControls; //Controls of the gates
-
-		gate ga, gb;
-		
-		std::sort( itGate->controls().begin(), itGate->controls().end() );
-		std::sort( nextGate->controls().begin(), nextGate->controls().end() );
-		
-		ga.controls() = itGate->controls();
-		gb.controls() = nextGate->controls();
-		ga.targets() = itGate->targets();
-		gb.targets() = nextGate->targets();
-
-		gaControls = ga.controls().size();
-		gbControls = gb.controls().size();
-
-		gaNCVCost = ncv_cost(ga.controls().size());
-		gbNCVCost = ncv_cost(gb.controls().size());
-		gaTdepth = t_depth(ga.controls().size());
-		gbTdepth = t_depth(gb.controls().size());
-
-		if( verify_rule_Done( ga, gb ) )
-		{
-			std::vector<int> v;
-			if(verbose)
-				std::cout  << "[D1] Gates ( " << itGateIndex << " - " << itGateIndex + 1 << " ) can be removed.\t\tCost=-2;\t\tQCost:" << -1*(gaNCVCost + gbNCVCost) << std::endl;
-			v.push_back(1);
-			v.push_back(itGateIndex);
-			v.push_back(nextGateIndex);
-			v.push_back(-2);
-			v.push_back(-1*(gaNCVCost + gbNCVCost));
-			x.push_back( v );
-		}
-	
-		apply_rule_Rfive( ga, gb );
+		if(verbose)
+			std::cout  << "[D1] Gates ( " << itGateIndex << " - " << itGateIndex + 1 << " ) can be removed.\t\tCost=-2;\t\tQCost:" << -1*(gaNCVCost + gbNCVCost) << std::endl;
+		x.push_back( rule_row( 1, itGateIndex, -2, -1*(gaNCVCost + gbNCVCost) ) );
+	}
 
-		if( verify_rule_Dtwo( ga, gb ) ) 
-		{
-			std::vector<int> v;
-			if(verbose)
-				std::cout  << "[R5] Gates ( " << itGateIndex << " - " << itGateIndex + 1 << " ) can be interchanged.\t\tNo cost change;" << std::endl;
-			v.push_back(2);
-			v.push_back(itGateIndex);
-			v.push_back(nextGateIndex);
-			v.push_back(0);
-			v.push_back(0);
-			x.push_back( v );
-		}
+	apply_rule_Rfive( ga, gb );
 
-		if( verify_rule_Dthree( ga, gb ) )
-		{
-			std::vector<int> v;
-			if(verbose)
-				std::cout  << "[D3] Gates ( " << itGateIndex << " - " << itGateIndex + 1 << " ) can be merged.\t\t\t--Cost;\t\tQCost:" << -1*(gaNCVCost-1) << std::endl;
-			v.push_back(3);
-			v.push_back(itGateIndex);
-			v.push_back(nextGateIndex);
-			v.push_back(-1);
-			v.push_back(-1*(gaNCVCost-1));
-			x.push_back( v );
-		}
-		
-		if( verify_rule_Dfour( ga, gb ) )
-		{
-			std::vector<int> v;
-			// if(verbose)
-			// 	std::cout  << "[D4] Gates ( " << itGateIndex << " - " << itGateIndex + 1 << " ) can be merged.\t\t\t--Cost" << std::endl;
-			v.push_back(14);
-			v.push_back(itGateIndex);
-			v.push_back(nextGateIndex);
-			v.push_back(-1);
-			if(gaControls > gbControls)
-			{
-				v.push_back(-1*gaNCVCost);
-				if(verbose)
-					std::cout  << "[D4] Gates ( " << itGateIndex << " - " << itGateIndex + 1 << " ) can be merged.\t\t\t--Cost;\t\tQCost:" << -1*gaNCVCost << std::endl;
-			}
-			else
-			{
-				if(verbose)
-					std::cout  << "[D4] Gates ( " << itGateIndex << " - " << itGateIndex + 1 << " ) can be merged.\t\t\t--Cost;\t\tQCost:" << -1*gbNCVCost << std::endl;
-				v.push_back(-1*gbNCVCost);
-			}
-			x.push_back( v );
-		}
+	if( verify_rule_Dtwo( ga, gb ) )
+	{
+		if(verbose)
+			std::cout  << "[R5] Gates ( " << itGateIndex << " - " << itGateIndex + 1 << " ) can be interchanged.\t\tNo cost change;" << std::endl;
+		x.push_back( rule_row( 2, itGateIndex, 0, 0 ) );
+	}
 
-		if( verify_rule_Rfour( ga, gb ) )
-		{
-			std::vector<int> v;
-			if(verbose)
-				std::cout  << "[R4] Gates ( " << itGateIndex << " - " << itGateIndex + 1 << " ) can be interchanged.\t\tNo cost change;" << std::endl;
-			v.push_back(4);
-			v.push_back(itGateIndex);
-			v.push_back(nextGateIndex);
-			v.push_back(0);
-			v.push_back(0);
-			x.push_back( v );
-		}
-		
-		if( verify_rule_Dfive( ga, gb ) )
-		{
-			std::vector<int> v;
-			if(verbose)
-				std::cout  << "[D5] Gates ( " << itGateIndex << " - " << itGateIndex + 1 << " ) can insert controls.\t\tNo cost change;\tQCost:" << ncv_cost(gaControls+1) + ncv_cost(gbControls+1) << std::endl;
-			v.push_back(5);
-			v.push_back(itGateIndex);
-			v.push_back(nextGateIndex);
-			v.push_back(0);
-			v.push_back(ncv_cost(gaControls+1) + ncv_cost(gbControls+1));
-			x.push_back( v );
-		}
-		
-		if( verify_rule_Dfivee( ga, gb ) )
-		{
-			std::vector<int> v;
-			if(verbose)
-				std::cout  << "[D5] Gates ( " << itGateIndex << " - " << itGateIndex + 1 << " ) can remove controls.\t\tNo cost change;\tQCost:" << -1*(ncv_cost(gaControls+1) + ncv_cost(gbControls+1)) <<std::endl;
-			v.push_back(-5);
-			v.push_back(itGateIndex);
-			v.push_back(nextGateIndex);
-			v.push_back(0);
-			v.push_back(-1*(ncv_cost(gaControls+1) + ncv_cost(gbControls+1)));
-			x.push_back( v );
-		}
+	if( verify_rule_Dthree( ga, gb ) )
+	{
+		if(verbose)
+			std::cout  << "[D3] Gates ( " << itGateIndex << " - " << itGateIndex + 1 << " ) can be merged.\t\t\t--Cost;\t\tQCost:" << -1*(gaNCVCost-1) << std::endl;
+		x.push_back( rule_row( 3, itGateIndex, -1, -1*(gaNCVCost-1) ) );
+	}
 
-		if( verify_rule_Dsix( ga, gb ) )
-		{
-			std::vector<int> v;
-			if(verbose)
-				std::cout  << "[D6] Gates ( " << itGateIndex << " - " << itGateIndex + 1 << " ) can be interchanged.\t\tNo cost change;" << std::endl;
-			v.push_back(6);
-			v.push_back(itGateIndex);
-			v.push_back(nextGateIndex);
-			v.push_back(0);
-			v.push_back(0);
-			x.push_back( v );
-		}
+	if( verify_rule_Dfour( ga, gb ) )
+	{
+		const auto qcost = gaControls > gbControls ? -1*gaNCVCost : -1*gbNCVCost;
+		if(verbose)
+			std::cout  << "[D4] Gates ( " << itGateIndex << " - " << itGateIndex + 1 << " ) can be merged.\t\t\t--Cost;\t\tQCost:" << qcost << std::endl;
+		x.push_back( rule_row( 14, itGateIndex, -1, qcost ) );
+	}
 
-		if( verify_rule_Dseven( ga, gb ) )
+	if( verify_rule_Rfour( ga, gb ) )
+	{
+		if(verbose)
+			std::cout  << "[R4] Gates ( " << itGateIndex << " - " << itGateIndex + 1 << " ) can be interchanged.\t\tNo cost change;" << std::endl;
+		x.push_back( rule_row( 4, itGateIndex, 0, 0 ) );
+	}
+
+	if( verify_rule_Dfive( ga, gb ) )
+	{
+		if(verbose)
+			std::cout  << "[D5] Gates ( " << itGateIndex << " - " << itGateIndex + 1 << " ) can insert controls.\t\tNo cost change;\tQCost:" << ncv_cost(gaControls+1) + ncv_cost(gbControls+1) << std::endl;
+		x.push_back( rule_row( 5, itGateIndex, 0, ncv_cost(gaControls+1) + ncv_cost(gbControls+1) ) );
+	}
+
+	if( verify_rule_Dfivee( ga, gb ) )
+	{
+		if(verbose)
+			std::cout  << "[D5] Gates ( " << itGateIndex << " - " << itGateIndex + 1 << " ) can remove controls.\t\tNo cost change;\tQCost:" << -1*(ncv_cost(gaControls+1) + ncv_cost(gbControls+1)) <<std::endl;
+		x.push_back( rule_row( -5, itGateIndex, 0, -1*(ncv_cost(gaControls+1) + ncv_cost(gbControls+1)) ) );
+	}
+
+	if( verify_rule_Dsix( ga, gb ) )
+	{
+		if(verbose)
+			std::cout  << "[D6] Gates ( " << itGateIndex << " - " << itGateIndex + 1 << " ) can be interchanged.\t\tNo cost change;" << std::endl;
+		x.push_back( rule_row( 6, itGateIndex, 0, 0 ) );
+	}
+
+	if( verify_rule_Dseven( ga, gb ) )
+	{
+		if(verbose)
+			std::cout  << "[D7] Gates ( " << itGateIndex << " - " << itGateIndex + 1 << " ) can be interchanged.\t\t++Cost;\t\tQCost:" << ncv_cost(gaControls + gbControls) << std::endl;
+		x.push_back( rule_row( 7, itGateIndex, 1, ncv_cost(gaControls + gbControls) ) );
+	}
+}
+
+//Rules of the gate windows from begin to end; only windows invalidated by a previous rule are scanned again,
+//in parallel if a thread pool is given (the windows are independent, verbose output stays sequential)
+void list_rules( const circuit& circ, std::vector<rule_window>& windows, matrix& x, unsigned begin, unsigned end, thread_pool* pool, bool verbose )
+{
+	std::vector<unsigned> invalid;
+	for( unsigned i = begin; i + 1 < end; ++i )
+		if( !windows[i].valid )
+			invalid.push_back( i );
+
+	const auto scan = [&]( std::size_t j ) {
+		auto& w = windows[invalid[j]];
+		w.rules.clear();
+		pair_rules( circ[invalid[j]], circ[invalid[j] + 1], invalid[j], w.rules, verbose );
+		w.valid = true;
+	};
+
+	if( pool && !verbose )
+		pool->parallel_for( 0u, invalid.size(), 8u, scan );
+	else
+		for( unsigned j = 0; j < invalid.size(); ++j )
+			scan( j );
+
+	for( unsigned i = begin; i + 1 < end; ++i )
+	{
+		for( auto v : windows[i].rules )
 		{
-			std::vector<int> v;
-			if(verbose)
-				std::cout  << "[D7] Gates ( " << itGateIndex << " - " << itGateIndex + 1 << " ) can be interchanged.\t\t++Cost;\t\tQCost:" << ncv_cost(gaControls + gbControls) << std::endl;
-			v.push_back(7);
-			v.push_back(itGateIndex);
-			v.push_back(nextGateIndex);
-			v.push_back(1);
-			v.push_back(ncv_cost(gaControls + gbControls));
+			v[1] = i;
+			v[2] = i + 1;
 			x.push_back( v );
 		}
 	}
+}
+
+//NCV cost of the gates from begin to end
+int window_ncv_cost( const circuit& circ, unsigned begin, unsigned end )
+{
+	int cost = 0;
+	for( unsigned i = begin; i < end && i < circ.num_gates(); ++i )
+		cost += ncv_cost(circ[i].controls().size());
+	return cost;
+}
 
+//Invalidate the windows that overlap with the gates changed by a rule, delta gates were added
+void update_windows( std::vector<rule_window>& windows, unsigned itGateIndex, int delta )
+{
+	const unsigned first = itGateIndex > 0 ? itGateIndex - 1 : 0;
+	const unsigned last = itGateIndex + 2;
+	windows.erase( windows.begin() + first, windows.begin() + last );
+	windows.insert( windows.begin() + first, last - first + delta, rule_window() );
 }
 
-void apply_rule( circuit& circ, std::vector<std::vector<int>> x, unsigned y )
+void apply_rule( circuit& circ, const matrix& x, unsigned y )
 {
 	circuit::const_iterator itGate = circ.begin(), nextGate = circ.begin();
 	switch( x[y][0] )
@@ -347,7 +336,7 @@ void apply_rule( circuit& circ, std::vector<std::vector<int>> x, unsigned y )
 	}
 }
 
-void apply_rule( circuit& circ, std::vector<std::vector<int>> x, unsigned y, bool verbose )
+void apply_rule( circuit& circ, const matrix& x, unsigned y, bool verbose )
 {
 	circuit::const_iterator itGate = circ.begin(), nextGate = circ.begin();
 	switch( x[y][0] )
@@ -432,87 +421,108 @@ void print_list(matrix& x)
 
 }
 
-//Function to decide which rule must be applied
-void choosing_rule(circuit& circ, matrix x, matrix& tp, bool verbose)
+//Apply a rule, update the NCV cost locally and invalidate the windows of the changed gates
+void apply_rule_update(circuit& circ, const matrix& x, unsigned y, std::vector<rule_window>& windows, int& cost, bool verbose)
+{
+	const unsigned itGateIndex = x[y][1];
+	const int gates = circ.num_gates();
+
+	cost -= window_ncv_cost(circ, itGateIndex, itGateIndex + 2);
+	if(verbose)
+		apply_rule(circ, x, y, verbose);
+	else
+		apply_rule(circ, x, y);
+
+	const int delta = int(circ.num_gates()) - gates;
+	cost += window_ncv_cost(circ, itGateIndex, itGateIndex + 2 + delta);
+	update_windows(windows, itGateIndex, delta);
+}
+
+//Is the rule in the tabu list?
+bool is_tabu(const std::vector<int>& rule, const matrix& tp)
 {
-	bool insert;
-	//std::cout << t.size() << std::endl;
+	for(unsigned i = 0; i < tp.size(); ++i)
+		if(rule[0] == tp[i][0] && rule[1] == tp[i][1] && rule[2] == tp[i][2])
+			return true;
+	return false;
+}
+
+//The chosen rule and, in the order of the list, all non-tabu rules that improve the optimized cost (column opt+3, as used
+//by sortrows) and whose gates are disjoint from the ones taken before; sorted by decreasing gate index, such that applying
+//a rule does not move the gates of the remaining ones
+std::vector<unsigned> non_conflicting_rules(const matrix& x, const matrix& tp, unsigned chosen, unsigned opt)
+{
+	std::vector<unsigned> rules = {chosen};
 	for(unsigned k = 0; k < x.size(); ++k)
 	{
-		if(x[k][3] < 0)
+		if(k == chosen || x[k][opt + 3] >= 0 || is_tabu(x[k], tp))
+			continue;
+		bool conflict = false;
+		for(auto r : rules)
 		{
-			apply_rule(circ, x, k, verbose);
-			break;
-		}
-		insert = true;
-		for(unsigned i = 0; i < tp.size(); ++i)
-		{
-			if(x[k][0] == tp[i][0] && x[k][1] == tp[i][1] && x[k][2] == tp[i][2])
+			if(x[k][1] <= x[r][2] && x[r][1] <= x[k][2])
 			{
-				insert = false;
+				conflict = true;
 				break;
 			}
 		}
-		if(insert)
+		if(!conflict)
+			rules.push_back(k);
+	}
+	std::stable_sort(rules.begin(), rules.end(), [&x](unsigned a, unsigned b) { return x[a][1] > x[b][1]; });
+	return rules;
+}
+
+//Apply the chosen rule, in batch mode together with the non-conflicting improving rules; the additional rules enter the
+//tabu list like a chosen non-improving rule, such that the next iterations cannot undo them
+void commit_rules(circuit& circ, const matrix& x, matrix& tp, unsigned chosen, std::vector<rule_window>& windows, int& cost, unsigned opt, bool batch, bool verbose)
+{
+	if(!batch)
+	{
+		apply_rule_update(circ, x, chosen, windows, cost, verbose);
+		return;
+	}
+	for(auto k : non_conflicting_rules(x, tp, chosen, opt))
+	{
+		if(k != chosen)
 		{
-			x[k][3] = 0;
 			tp.push_back( x[k] );
-			apply_rule( circ, x, k, verbose );
-			break;
+			tp.back()[3] = 0;
 		}
+		apply_rule_update(circ, x, k, windows, cost, verbose);
 	}
-	for(unsigned i = 0; i < tp.size(); ++i)
-		++tp[i][3];
 }
 
 //Function to decide which rule must be applied
-void choosing_rule(circuit& circ, matrix x, matrix& tp)
+void choosing_rule(circuit& circ, const matrix& x, matrix& tp, std::vector<rule_window>& windows, int& cost, unsigned opt, bool batch, bool verbose)
 {
-	bool insert;
-	//std::cout << t.size() << std::endl;
 	for(unsigned k = 0; k < x.size(); ++k)
 	{
 		if(x[k][3] < 0)
 		{
-			apply_rule(circ, x, k);
+			commit_rules(circ, x, tp, k, windows, cost, opt, batch, verbose);
 			break;
 		}
-		insert = true;
-		for(unsigned i = 0; i < tp.size(); ++i)
+		if(!is_tabu(x[k], tp))
 		{
-			if(x[k][0] == tp[i][0] && x[k][1] == tp[i][1] && x[k][2] == tp[i][2])
-			{
-				insert = false;
-				break;
-			}
-		}
-		if(insert)
-		{
-			x[k][3] = 0;
 			tp.push_back( x[k] );
-			apply_rule( circ, x, k );
+			tp.back()[3] = 0;
+			commit_rules(circ, x, tp, k, windows, cost, opt, batch, verbose);
 			break;
 		}
 	}
 	for(unsigned i = 0; i < tp.size(); ++i)
-		++tp[i][3];	
+		++tp[i][3];
 }
 
-//Update the tabu list (penalization)
+//Update the tabu list (penalization); rules applied in the same batch expire together
 void update_tabu_list(matrix& tp, int penalization)
 {
-	for(unsigned i = 0; i < tp.size(); ++i)
-	{
-		if(tp[i][3] >= penalization)
-		{
-			tp.erase(tp.begin()+i);
-			break;
-		}
-	}
+	tp.erase(std::remove_if(tp.begin(), tp.end(), [penalization](const std::vector<int>& r) { return r[3] >= penalization; }), tp.end());
 }
 
 //Save the minimum circuit found
-bool update_circuit(circuit& circ, circuit& min, unsigned opt)
+bool update_circuit(circuit& circ, circuit& min, int cost, int& min_cost, unsigned opt)
 {
 	switch(opt){
 		case 0:
@@ -520,14 +530,16 @@ bool update_circuit(circuit& circ, circuit& min, unsigned opt)
 			{
 				clear_circuit(min);
 				copy_circuit(circ, min);
+				min_cost = cost;
 				//std::cout << " Minimo: " << min.num_gates() << std::endl;
 				return true;
 			}
 		default:
-			if(circuit_ncv_cost(circ) < circuit_ncv_cost(min))
+			if(cost < min_cost)
 			{
 				clear_circuit(min);
 				copy_circuit(circ, min);
+				min_cost = cost;
 				//std::cout << " Minimo: " << min.num_gates() << std::endl;
 				return true;
 			}
@@ -535,14 +547,17 @@ bool update_circuit(circuit& circ, circuit& min, unsigned opt)
 	return false;
 }
 
-void tabu_search( circuit& circ, unsigned overlap, unsigned neighborhood, const properties::ptr& statistics, unsigned opt )
+//Without a thread pool, one rule is applied per iteration
+void tabu_search( circuit& circ, unsigned overlap, unsigned neighborhood, const properties::ptr& statistics, unsigned opt, thread_pool* pool )
 {
 	properties_timer t( statistics );
 	unsigned stop = 0, begin, end;
 	bool finish = false;
 	matrix x; //list of possible rules of the current iteration
 	matrix tp; //tabu list with the penalization
+	std::vector<rule_window> windows; //rules of the adjacent gates
 	circuit orig, min;
+	int cost = circuit_ncv_cost( circ ), min_cost = cost;
 
 	copy_circuit( circ, orig );
  	copy_circuit( circ, min );
@@ -574,13 +589,14 @@ void tabu_search( circuit& circ, unsigned overlap, unsigned neighborhood, const
 	 	stop = 0;
 	 	unsigned int improvement = circ.num_gates();
 	 	tp.clear();
+	 	windows.assign( circ.num_gates(), rule_window() );
 	 	while(stop < neighborhood * 50)
 	 	{
-	 		list_rules(circ, x, begin, end, false);
+	 		list_rules(circ, windows, x, begin, end, pool, false);
 	 		sortrows(x, opt+3);
-	 		choosing_rule(circ, x, tp);
+	 		choosing_rule(circ, x, tp, windows, cost, opt, pool != nullptr, false);
 	 		update_tabu_list(tp, neighborhood);
-	 		if(!update_circuit(circ, min, opt))
+	 		if(!update_circuit(circ, min, cost, min_cost, opt))
 	 			++stop;
 	 		else
 	 			stop = 0;
@@ -596,6 +612,7 @@ void tabu_search( circuit& circ, unsigned overlap, unsigned neighborhood, const
 	 	}
 	 	clear_circuit(circ);
 	 	copy_circuit(min, circ);
+	 	cost = min_cost;
 	 	improvement = improvement - min.num_gates();
 	 	//std::cout << "improvement: " << improvement << std::endl;
 	 	//std::cin.get();
@@ -606,14 +623,16 @@ void tabu_search( circuit& circ, unsigned overlap, unsigned neighborhood, const
 	copy_circuit(min, circ);
 }
 
-void tabu_search( circuit& circ, unsigned overlap, unsigned neighborhood, const properties::ptr& statistics, unsigned opt, bool verbose, bool step )
+void tabu_search( circuit& circ, unsigned overlap, unsigned neighborhood, const properties::ptr& statistics, unsigned opt, thread_pool* pool, bool verbose, bool step )
 {
 	properties_timer t( statistics );
 	unsigned stop = 0, begin, end;
 	bool finish = false;
 	matrix x; //list of possible rules of the current iteration
 	matrix tp; //tabu list with the penalization
+	std::vector<rule_window> windows; //rules of the adjacent gates
 	circuit orig, min;
+	int cost = circuit_ncv_cost( circ ), min_cost = cost;
 
 	copy_circuit( circ, orig );
  	copy_circuit( circ, min );
@@ -644,22 +663,23 @@ void tabu_search( circuit& circ, unsigned overlap, unsigned neighborhood, const
 		//std::cout << "begin: " << begin << " end: " << end << std::endl;
 	 	stop = 0;
 	 	tp.clear();
+	 	windows.assign( circ.num_gates(), rule_window() );
 	 	unsigned int improvement = circ.num_gates();
 	 	while(stop < neighborhood * 50)
 	 	{
 	 		std::cout << "++++++++++ ITERATION " << stop << " +++++++++++" << std::endl;
 	 		std::cout << circ << std::endl;
-	 		list_rules(circ, x, begin, end, verbose);
+	 		list_rules(circ, windows, x, begin, end, pool, verbose);
 	 		sortrows(x, opt+3);
 	 		std::cout << "++++++++++ BEGIN LIST OF RULES +++++++++++" << std::endl;
  			print_list( x );
 	 		std::cout << "++++++++++   END LIST OF RULES +++++++++++" << std::endl;
-	 		choosing_rule(circ, x, tp, verbose);
+	 		choosing_rule(circ, x, tp, windows, cost, opt, pool != nullptr, verbose);
 	 		update_tabu_list(tp, neighborhood);
  			std::cout << "++++++++++ BEGIN TABU LIST +++++++++++" << std::endl;
  			print_list( tp );
  			std::cout << "++++++++++   END TABU LIST +++++++++++" << std::endl;	
-	 		if(!update_circuit(circ, min, opt))
+	 		if(!update_circuit(circ, min, cost, min_cost, opt))
 	 		{
 	 			++stop;
 	 		}
@@ -682,6 +702,7 @@ void tabu_search( circuit& circ, unsigned overlap, unsigned neighborhood, const
 	 	}
 	 	clear_circuit(circ);
 	 	copy_circuit(min, circ);
+	 	cost = min_cost;
 	 	improvement = improvement - min.num_gates();
 	 	//std::cout << "improvement: " << improvement << std::endl;
 	 	//std::cin.get();
@@ -704,12 +725,21 @@ bool tabu_command::execute()
  	
  	InitialQuantumCost = circuit_ncv_cost(circ);
 
+ 	std::unique_ptr<thread_pool> local_pool;
+ 	thread_pool* pool = nullptr;
+ 	if ( is_set("parallel") )
+ 	{
+ 		if ( num_threads > 0u )
+ 			local_pool.reset( new thread_pool( num_threads ) );
+ 		pool = local_pool ? local_pool.get() : &shared_thread_pool();
+ 	}
+
  	if ( is_set("verbose") && is_set("step") )
- 		tabu_search( circ, overlap, neighborhood, statistics, opt, true, true );
+ 		tabu_search( circ, overlap, neighborhood, statistics, opt, pool, true, true );
  	else if ( is_set("verbose") && !is_set("step") )
- 		tabu_search( circ, overlap, neighborhood, statistics, opt, true, false );
+ 		tabu_search( circ, overlap, neighborhood, statistics, opt, pool, true, false );
  	else
- 		tabu_search( circ, overlap, neighborhood, statistics, opt );
+ 		tabu_search( circ, overlap, neighborhood, statistics, opt, pool );
 	if ( is_set( "new" ) )
         circuits.extend();    
  	circuits.current() = circ;
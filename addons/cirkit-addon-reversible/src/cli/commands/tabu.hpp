@@ -36,12 +36,27 @@
 #ifndef CLI_TABU_COMMAND_HPP
 #define CLI_TABU_COMMAND_HPP
 
+#include <vector>
+
+#include <core/properties.hpp>
 #include <reversible/circuit.hpp>
 #include <cli/cirkit_command.hpp>
 
 namespace cirkit
 {
 
+class thread_pool;
+
+//Rows of rules: rule, gate indexes, gates cost, quantum cost, and average of both
+typedef std::vector<std::vector<int>> matrix;
+
+//Rules of the gates i and i + 1, valid until a rule changes one of the gates
+struct rule_window
+{
+	bool valid = false;
+	matrix rules;
+};
+
 class tabu_command : public cirkit_command
     {
     public:
@@ -57,11 +72,24 @@ private:
 	unsigned int penalization = 10u;
 	unsigned int neighborhood = 10u;
 	unsigned int overlap = 70u;
+	unsigned int num_threads = 0u;
 	
 public:
   log_opt_t log() const;
 };
 
+unsigned int circuit_ncv_cost(const circuit& circ);
+
+//Rules of the windows from begin to end, invalid windows are scanned again (in parallel if pool is not null)
+void list_rules( const circuit& circ, std::vector<rule_window>& windows, matrix& x, unsigned begin, unsigned end, thread_pool* pool, bool verbose );
+void sortrows(matrix& x, int col);
+
+//Apply rule y of x, update the NCV cost locally and invalidate the windows of the changed gates
+void apply_rule_update(circuit& circ, const matrix& x, unsigned y, std::vector<rule_window>& windows, int& cost, bool verbose);
+
+//With a thread pool, windows are scored in parallel and all non-conflicting improving rules are applied in each iteration
+void tabu_search( circuit& circ, unsigned overlap, unsigned neighborhood, const properties::ptr& statistics, unsigned opt, thread_pool* pool );
+
 }
 
 #endif
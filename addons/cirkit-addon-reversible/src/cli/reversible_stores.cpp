@@ -59,7 +59,6 @@
 #include <reversible/io/write_quipper.hpp>
 #include <reversible/io/write_realization.hpp>
 #include <reversible/io/write_specification.hpp>
-#include <reversible/simulation/simple_simulation.hpp>
 #include <reversible/utils/circuit_utils.hpp>
 #include <reversible/utils/costs.hpp>
 
@@ -423,7 +422,7 @@ template<>
 binary_truth_table store_convert<circuit, binary_truth_table>( const circuit& circ )
 {
   binary_truth_table spec;
-  circuit_to_truth_table( circ, spec, simple_simulation_func() );
+  circuit_to_truth_table( circ, spec );
   return spec;
 }
 
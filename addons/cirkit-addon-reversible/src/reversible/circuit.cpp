@@ -27,7 +27,9 @@
 #include "circuit.hpp"
 
 #include <iostream>
+#include <iterator>
 #include <string>
+#include <utility>
 
 #include <boost/format.hpp>
 #include <boost/range/adaptors.hpp>
@@ -41,6 +43,169 @@ namespace cirkit
   using boost::adaptors::indirected;
   using boost::adaptors::transformed;
 
+  gate_store::gate_store( const gate_store& other )
+  {
+    append( other );
+  }
+
+  gate_store& gate_store::operator=( const gate_store& other )
+  {
+    if ( this != &other )
+    {
+      clear();
+      append( other );
+    }
+    return *this;
+  }
+
+  gate_store::gate_store( gate_store&& other )
+  {
+    *this = std::move( other );
+  }
+
+  gate_store& gate_store::operator=( gate_store&& other )
+  {
+    if ( this != &other )
+    {
+      order          = std::move( other.order );
+      chunks         = std::move( other.chunks );
+      chunk_used     = other.chunk_used;
+      chunk_capacity = other.chunk_capacity;
+      free_slots     = std::move( other.free_slots );
+      other.clear();
+    }
+    return *this;
+  }
+
+  gate& gate_store::at( std::size_t pos ) const
+  {
+    return *order.at( pos );
+  }
+
+  gate* gate_store::allocate()
+  {
+    if ( !free_slots.empty() )
+    {
+      auto * g = free_slots.back();
+      free_slots.pop_back();
+      return g;
+    }
+
+    if ( chunk_used == chunk_capacity )
+    {
+      chunk_capacity = chunks.empty() ? 16u : std::min<std::size_t>( chunk_capacity << 1u, 4096u );
+      chunks.emplace_back( new gate[chunk_capacity] );
+      chunk_used = 0u;
+    }
+
+    return &chunks.back()[chunk_used++];
+  }
+
+  gate& gate_store::insert( std::size_t pos )
+  {
+    auto * g = allocate();
+    order.insert( order.begin() + pos, g );
+    return *g;
+  }
+
+  gate& gate_store::push_back()
+  {
+    auto * g = allocate();
+    order.push_back( g );
+    return *g;
+  }
+
+  void gate_store::erase( std::size_t pos )
+  {
+    auto * g = order[pos];
+    *g = gate();
+    free_slots.push_back( g );
+    order.erase( order.begin() + pos );
+  }
+
+  void gate_store::clear()
+  {
+    order.clear();
+    chunks.clear();
+    chunk_used = chunk_capacity = 0u;
+    free_slots.clear();
+  }
+
+  void gate_store::reserve( std::size_t n )
+  {
+    order.reserve( n );
+  }
+
+  void gate_store::append( const gate_store& other )
+  {
+    /* no exact reserve here, repeated appends must grow geometrically */
+    for ( const auto * g : other.order )
+    {
+      push_back() = *g;
+    }
+  }
+
+  void gate_store::append( gate_store&& other )
+  {
+    if ( chunks.empty() )
+    {
+      *this = std::move( other );
+      return;
+    }
+
+    /* keep the last chunk of this store as the one to allocate from,
+       the unused slots of the last chunk in other become free slots */
+    if ( !other.chunks.empty() )
+    {
+      auto * last = other.chunks.back().get();
+      for ( auto i = other.chunk_used; i < other.chunk_capacity; ++i )
+      {
+        free_slots.push_back( last + i );
+      }
+    }
+    order.insert( order.end(), other.order.begin(), other.order.end() );
+    chunks.insert( chunks.end() - 1, std::make_move_iterator( other.chunks.begin() ), std::make_move_iterator( other.chunks.end() ) );
+    free_slots.insert( free_slots.end(), other.free_slots.begin(), other.free_slots.end() );
+    other.clear();
+  }
+
+  standard_circuit::standard_circuit( const standard_circuit& other )
+  {
+    *this = other;
+  }
+
+  standard_circuit& standard_circuit::operator=( const standard_circuit& other )
+  {
+    if ( this == &other )
+    {
+      return *this;
+    }
+
+    gates          = other.gates;
+    lines          = other.lines;
+    inputs         = other.inputs;
+    outputs        = other.outputs;
+    constants      = other.constants;
+    garbage        = other.garbage;
+    name           = other.name;
+    inputbuses     = other.inputbuses;
+    outputbuses    = other.outputbuses;
+    statesignals   = other.statesignals;
+    annotations.clear();
+
+    /* annotations are keyed by gate addresses */
+    for ( auto i = 0u; i < gates.size(); ++i )
+    {
+      const auto it = other.annotations.find( &other.gates[i] );
+      if ( it != other.annotations.end() )
+      {
+        annotations.insert( {&gates[i], it->second} );
+      }
+    }
+
+    return *this;
+  }
+
   struct num_gates_visitor : public boost::static_visitor<unsigned>
   {
     unsigned operator()( const standard_circuit& circ ) const
@@ -203,16 +368,14 @@ namespace cirkit
   {
     gate& operator()( standard_circuit& circ ) const
     {
-      circ.gates.push_back( std::make_shared<gate>() );
-      return *circ.gates.back();
+      return circ.gates.push_back();
     }
 
     gate& operator()( subcircuit& circ ) const
     {
-      circ.base->gates.insert( circ.base->gates.begin() + circ.to, std::make_shared<gate>() );
+      gate& g = circ.base->gates.insert( circ.to );
       ++circ.to;
 
-      gate& g = **( circ.base->gates.begin() + circ.to - 1 );
       return g;
     }
   };
@@ -221,16 +384,14 @@ namespace cirkit
   {
     gate& operator()( standard_circuit& circ ) const
     {
-      circ.gates.insert( circ.gates.begin(), std::make_shared<gate>() );
-      return *circ.gates.front();
+      return circ.gates.insert( 0u );
     }
 
     gate& operator()( subcircuit& circ ) const
     {
-      circ.base->gates.insert( circ.base->gates.begin() + circ.from, std::make_shared<gate>() );
+      gate& g = circ.base->gates.insert( circ.from );
       ++circ.to;
 
-      gate& g = **( circ.base->gates.begin() + circ.from );
       return g;
     }
   };
@@ -241,16 +402,14 @@ namespace cirkit
 
     gate& operator()( standard_circuit& circ ) const
     {
-      circ.gates.insert( circ.gates.begin() + pos, std::make_shared<gate>() );
-      return *circ.gates.at( pos );
+      return circ.gates.insert( pos );
     }
 
     gate& operator()( subcircuit& circ ) const
     {
-      circ.base->gates.insert( circ.base->gates.begin() + circ.from + pos, std::make_shared<gate>() );
+      gate& g = circ.base->gates.insert( circ.from + pos );
       ++circ.to;
 
-      gate& g = **( circ.base->gates.begin() + circ.from + pos );
       return g;
     }
 
@@ -266,7 +425,8 @@ namespace cirkit
     {
       if ( pos < circ.gates.size() )
       {
-        circ.gates.erase( circ.gates.begin() + pos );
+        circ.annotations.erase( &circ.gates[pos] );
+        circ.gates.erase( pos );
       }
     }
 
@@ -274,7 +434,8 @@ namespace cirkit
     {
       if ( pos < circ.to )
       {
-        circ.base->gates.erase( circ.base->gates.begin() + circ.from + pos );
+        circ.base->annotations.erase( &circ.base->gates[circ.from + pos] );
+        circ.base->gates.erase( circ.from + pos );
         --circ.to;
       }
     }
@@ -106,6 +106,74 @@ namespace cirkit
    */
   using constant = boost::optional<bool>;
 
+  /**
+   * @brief Gate storage of a standard_circuit
+   *
+   * Gates are allocated in chunks of growing size and the gate order is
+   * a vector of pointers into the chunks.  Therefore references to gates
+   * stay valid when other gates are inserted or removed, and slots of
+   * removed gates are reused.
+   *
+   * Copies are deep: every gate is copied into the new store.  Before
+   * 2.3 the gates were shared pointers and a copied circuit shared its
+   * gates with the original.  Moving a store or appending an rvalue
+   * store does not copy any gate, it transfers the chunks.
+   *
+   * @since  2.3
+   */
+  class gate_store
+  {
+  public:
+    using iterator               = std::vector<gate*>::iterator;
+    using const_iterator         = std::vector<gate*>::const_iterator;
+    using reverse_iterator       = std::vector<gate*>::reverse_iterator;
+    using const_reverse_iterator = std::vector<gate*>::const_reverse_iterator;
+
+    gate_store() {}
+    gate_store( const gate_store& other );
+    gate_store( gate_store&& other );
+
+    gate_store& operator=( const gate_store& other );
+    gate_store& operator=( gate_store&& other );
+
+    inline std::size_t size() const { return order.size(); }
+    inline bool empty() const { return order.empty(); }
+
+    inline iterator begin() { return order.begin(); }
+    inline iterator end() { return order.end(); }
+    inline const_iterator begin() const { return order.begin(); }
+    inline const_iterator end() const { return order.end(); }
+    inline reverse_iterator rbegin() { return order.rbegin(); }
+    inline reverse_iterator rend() { return order.rend(); }
+    inline const_reverse_iterator rbegin() const { return order.rbegin(); }
+    inline const_reverse_iterator rend() const { return order.rend(); }
+
+    inline gate& operator[]( std::size_t pos ) const { return *order[pos]; }
+    gate& at( std::size_t pos ) const;
+
+    /* inserts an empty gate before position pos */
+    gate& insert( std::size_t pos );
+    gate& push_back();
+    void erase( std::size_t pos );
+    void clear();
+    void reserve( std::size_t n );
+
+    /* appends copies of all gates in other */
+    void append( const gate_store& other );
+    /* appends all gates in other without copying them, other is empty afterwards */
+    void append( gate_store&& other );
+
+  private:
+    gate* allocate();
+
+  private:
+    std::vector<gate*>                   order;
+    std::vector<std::unique_ptr<gate[]>> chunks;
+    std::size_t                          chunk_used = 0u;     /* used slots in last chunk */
+    std::size_t                          chunk_capacity = 0u; /* size of last chunk */
+    std::vector<gate*>                   free_slots;
+  };
+
   /**
    * @brief Represents a circuit
    *
@@ -177,8 +245,23 @@ namespace cirkit
       garbage.resize( lines, false );
     }
 
+    /**
+     * @brief Copy constructor
+     *
+     * Copies the gates and moves the annotations to the copies.
+     * Changes to the gates of the copy do not affect the original
+     * circuit (before 2.3 both circuits shared their gates).
+     *
+     * @since  2.3
+     */
+    standard_circuit( const standard_circuit& other );
+    standard_circuit( standard_circuit&& other ) = default;
+
+    standard_circuit& operator=( const standard_circuit& other );
+    standard_circuit& operator=( standard_circuit&& other ) = default;
+
     /** @cond */
-    std::vector<std::shared_ptr<gate> > gates;
+    gate_store gates;
     unsigned lines;
 
     std::vector<std::string> inputs;
@@ -367,6 +450,8 @@ namespace cirkit
      *
      * It copies the underlying circuit, but it does not
      * copy the signals, so that this information gets lost.
+     * The gates of a standard_circuit are copied as well, see
+     * gate_store.
      *
      * @param other Circuit to be copied
      *
@@ -377,21 +462,21 @@ namespace cirkit
     /**
      * @brief Mutable iterator for accessing the gates in a circuit
      */
-    using iterator = boost::indirect_iterator<std::vector<std::shared_ptr<gate>>::iterator>;
+    using iterator = boost::indirect_iterator<gate_store::iterator>;
 
     /**
      * @brief Constant iterator for accessing the gates in a circuit
      */
-    using const_iterator = boost::indirect_iterator<std::vector<std::shared_ptr<gate>>::const_iterator>;
+    using const_iterator = boost::indirect_iterator<gate_store::const_iterator>;
 
     /**
      * @brief Mutable reverse iterator for accessing the gates in a circuit
      */
-    using reverse_iterator = boost::indirect_iterator<std::vector<std::shared_ptr<gate>>::reverse_iterator>;
+    using reverse_iterator = boost::indirect_iterator<gate_store::reverse_iterator>;
     /**
      * @brief Constant reverse iterator for accessing the gates in a circuit
      */
-    using const_reverse_iterator = boost::indirect_iterator<std::vector<std::shared_ptr<gate>>::const_reverse_iterator>;
+    using const_reverse_iterator = boost::indirect_iterator<gate_store::const_reverse_iterator>;
 
     /**
      * @brief Returns the number of gates
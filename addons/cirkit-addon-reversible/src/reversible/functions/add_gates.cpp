@@ -343,7 +343,7 @@ gate& insert_not( circuit& circ, unsigned n, unsigned target )
   return create_not( circ.insert_gate( n ), target );
 }
 
-gate& insert_module( circuit& circ, unsigned n, const std::string& module_name, const gate::control_container& controls, const std::vector<unsigned>& targets )
+gate& insert_module( circuit& circ, unsigned n, const std::string& module_name, const gate::control_container& controls, const gate::target_container& targets )
 {
   return create_module( circ.insert_gate( n ), circ, module_name, controls, targets );
 }
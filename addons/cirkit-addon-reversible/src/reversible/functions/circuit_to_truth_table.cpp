@@ -30,6 +30,8 @@
 
 #include <core/properties.hpp>
 #include <core/utils/bitset_utils.hpp>
+#include <reversible/simulation/bitsliced_simulation.hpp>
+#include <reversible/simulation/simple_simulation.hpp>
 
 namespace cirkit
 {
@@ -77,6 +79,40 @@ namespace cirkit
     return true;
   }
 
+  bool circuit_to_truth_table( const circuit& circ, binary_truth_table& spec, const properties::ptr& settings, const properties::ptr& statistics )
+  {
+    std::vector<boost::dynamic_bitset<>> table;
+    if ( !bitsliced_truth_table( table, circ, settings, statistics ) )
+    {
+      simulation_func simulation = []( boost::dynamic_bitset<>& output, const circuit& circ, const boost::dynamic_bitset<>& input ) {
+        return simple_simulation( output, circ, input );
+      };
+      return circuit_to_truth_table( circ, spec, simulation );
+    }
+
+    const auto n = circ.lines();
+    binary_truth_table::cube_type in_cube( n ), out_cube( n );
+
+    for ( auto p = 0ul; p < ( 1ul << n ); ++p )
+    {
+      for ( auto i = 0u; i < n; ++i )
+      {
+        in_cube[i] = ( ( p >> i ) & 1u ) == 1u;
+        out_cube[i] = table[i][p];
+      }
+
+      spec.add_entry( in_cube, out_cube );
+    }
+
+    // metadata
+    spec.set_inputs( circ.inputs() );
+    spec.set_outputs( circ.outputs() );
+    spec.set_constants( circ.constants() );
+    spec.set_garbage( circ.garbage() );
+
+    return true;
+  }
+
 }
 
 // Local Variables:
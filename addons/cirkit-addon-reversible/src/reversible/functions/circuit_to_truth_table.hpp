@@ -62,6 +62,27 @@ namespace cirkit
    */
   bool circuit_to_truth_table( const circuit& circ, binary_truth_table& spec, const functor<bool(boost::dynamic_bitset<>&, const circuit&, const boost::dynamic_bitset<>&)>& simulation );
 
+  /**
+   * @brief Generates a truth table from a circuit
+   *
+   * All input patterns are simulated with bitsliced_truth_table, or
+   * with simple_simulation if the circuit contains gates that are not
+   * supported by the bit-sliced simulation.  The settings are passed
+   * to bitsliced_truth_table.
+   *
+   * @param circ Circuit to be simulated
+   * @param spec Empty truth table to be constructed
+   * @param settings Settings for bitsliced_truth_table
+   * @param statistics Statistics of bitsliced_truth_table
+   *
+   * @return true on success, false otherwise
+   *
+   * @since  2.3
+   */
+  bool circuit_to_truth_table( const circuit& circ, binary_truth_table& spec,
+                               const properties::ptr& settings = properties::ptr(),
+                               const properties::ptr& statistics = properties::ptr() );
+
 }
 
 #endif /* CIRCUIT_TO_TRUTH_TABLE_HPP */
@@ -46,7 +46,7 @@ void fredkin_gates_to_toffoli( const circuit& src, circuit& dest )
         {
           gate::control_container controls;
           boost::push_back( controls, g.controls() );
-          controls += make_var( g.targets()[0u], true );
+          controls.push_back( make_var( g.targets()[0u], true ) );
 
           append_cnot( circ, g.targets()[1u], g.targets()[0u] );
           append_toffoli( circ, controls, g.targets()[1u] );
@@ -26,29 +26,14 @@
 
 #include "is_identity.hpp"
 
-#include <boost/range/combine.hpp>
-#include <boost/range/numeric.hpp>
-
-#include <reversible/rcbdd.hpp>
+#include <reversible/verification/staged_equivalence_check.hpp>
 
 namespace cirkit
 {
 
-bool is_identity( const circuit& circ )
+bool is_identity( const circuit& circ, const properties::ptr& settings, const properties::ptr& statistics )
 {
-  rcbdd mgr;
-  mgr.initialize_manager();
-  mgr.create_variables( circ.lines() );
-
-  BDD f = mgr.create_from_circuit( circ );
-
-  BDD identity = boost::accumulate( boost::combine( mgr.xs(), mgr.ys() ),
-                                    mgr.manager().bddOne(),
-                                    []( BDD current, const boost::tuple<BDD, BDD>& t ) {
-                                      return current & ( boost::get<0>( t ).Xnor( boost::get<1>( t ) ) );
-                                    } );
-
-  return f == identity;
+  return staged_equivalence_check( circ, circuit( circ.lines() ), settings, statistics );
 }
 
 }
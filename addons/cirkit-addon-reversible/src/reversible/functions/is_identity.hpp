@@ -36,12 +36,17 @@
 #ifndef IS_IDENTITY_HPP
 #define IS_IDENTITY_HPP
 
+#include <core/properties.hpp>
 #include <reversible/circuit.hpp>
 
 namespace cirkit
 {
 
-bool is_identity( const circuit& circ );
+/* uses staged_equivalence_check against the empty circuit, settings and
+   statistics are passed to it */
+bool is_identity( const circuit& circ,
+                  const properties::ptr& settings = properties::ptr(),
+                  const properties::ptr& statistics = properties::ptr() );
 
 }
 
@@ -77,7 +77,7 @@ void pattern_to_circuit( circuit& circ, const boost::dynamic_bitset<>& pattern1,
   for ( unsigned pos = 0u; pos < pattern2.size(); ++pos )
   {
     if ( pos == last_pos ) continue;
-    controls += make_var( pos, pattern2[pos] );
+    controls.push_back( make_var( pos, pattern2[pos] ) );
   }
 
   insert_toffoli( circ, index, controls, last_pos );
@@ -26,100 +26,108 @@
 
 #include "gate.hpp"
 
-#include <boost/assign/std/vector.hpp>
-#include <boost/range/adaptors.hpp>
 #include <boost/range/algorithm.hpp>
 
+#include <reversible/pauli_tags.hpp>
+#include <reversible/rotation_tags.hpp>
+#include <reversible/target_tags.hpp>
+
 namespace cirkit
 {
-  using namespace boost::assign;
 
-  class gate::priv
+  /* tags without data are shared by all gates of the same kind */
+  const boost::any& type_of_kind( gate_kind kind )
   {
-  public:
-    priv() {}
-
-    priv( priv& other )
-      : controls( other.controls ),
-        targets( other.targets ),
-        target_type( other.target_type ) {}
-
-      control_container controls;
-      target_container targets;
-      boost::any     target_type;
-  };
-
+    static const boost::any none;
+    static const boost::any toffoli = toffoli_tag();
+    static const boost::any fredkin = fredkin_tag();
+    static const boost::any peres = peres_tag();
+    static const boost::any hadamard = hadamard_tag();
 
-  gate::gate()
-    : d( new priv() )
-  {
+    switch ( kind )
+    {
+    case gate_kind::toffoli:  return toffoli;
+    case gate_kind::fredkin:  return fredkin;
+    case gate_kind::peres:    return peres;
+    case gate_kind::hadamard: return hadamard;
+    default:                  return none;
+    }
   }
 
-  gate::gate( const gate& other )
-    : d( new priv() )
+  gate_kind kind_of_type( const std::type_info& type )
   {
-    operator=( other );
+    if ( type == typeid( void ) )         { return gate_kind::none; }
+    if ( type == typeid( toffoli_tag ) )  { return gate_kind::toffoli; }
+    if ( type == typeid( fredkin_tag ) )  { return gate_kind::fredkin; }
+    if ( type == typeid( peres_tag ) )    { return gate_kind::peres; }
+    if ( type == typeid( hadamard_tag ) ) { return gate_kind::hadamard; }
+    if ( type == typeid( module_tag ) )   { return gate_kind::module; }
+    if ( type == typeid( stg_tag ) )      { return gate_kind::stg; }
+    if ( type == typeid( pauli_tag ) )    { return gate_kind::pauli; }
+    if ( type == typeid( rotation_tag ) ) { return gate_kind::rotation; }
+    return gate_kind::other;
   }
 
-  gate::~gate()
+  bool kind_has_data( gate_kind kind )
   {
-    delete d;
+    return kind >= gate_kind::module;
   }
 
-  gate& gate::operator=( const gate& other )
+  gate::gate()
   {
-    if ( this != &other )
-    {
-      d->controls = other.controls();
-      d->targets = other.targets();
-      d->target_type = other.type();
-    }
-    return *this;
   }
 
   gate::control_container& gate::controls() const
   {
-    return d->controls;
+    return _controls;
   }
 
   gate::target_container& gate::targets() const
   {
-    return d->targets;
+    return _targets;
   }
 
   unsigned gate::size() const
   {
-    return d->controls.size() + d->targets.size();
+    return _controls.size() + _targets.size();
   }
 
   void gate::add_control( variable c )
   {
-    d->controls += c;
+    _controls.push_back( c );
   }
 
   void gate::remove_control( variable c )
   {
-    d->controls.erase( boost::remove( d->controls, c ) );
+    _controls.erase( boost::remove( _controls, c ), _controls.end() );
   }
 
   void gate::add_target( unsigned l )
   {
-    d->targets += l;
+    _targets.push_back( l );
   }
 
   void gate::remove_target( unsigned l )
   {
-    d->targets.erase( boost::remove( d->targets, l ) );
+    _targets.erase( boost::remove( _targets, l ), _targets.end() );
   }
 
   void gate::set_type( const boost::any& t )
   {
-    d->target_type = t;
+    _kind = kind_of_type( t.type() );
+    if ( kind_has_data( _kind ) )
+    {
+      _type = t;
+    }
+    else
+    {
+      _type = boost::any();
+    }
   }
 
   const boost::any& gate::type() const
   {
-    return d->target_type;
+    return kind_has_data( _kind ) ? _type : type_of_kind( _kind );
   }
 
 }
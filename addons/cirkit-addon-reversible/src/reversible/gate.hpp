@@ -39,15 +39,28 @@
 
 #include <reversible/variable.hpp>
 
+#include <cstdint>
 #include <iostream>
 #include <set>
 #include <vector>
 
 #include <boost/any.hpp>
+#include <boost/container/small_vector.hpp>
 
 namespace cirkit
 {
 
+  /**
+   * @brief Target types known to the gate
+   *
+   * The kind is derived in gate::set_type from the type of the tag, such
+   * that checks like is_toffoli do not need to inspect the boost::any.
+   * Tags without data are not stored in the gate.
+   *
+   * @since  2.3
+   */
+  enum class gate_kind : uint8_t { none, toffoli, fredkin, peres, hadamard, module, stg, pauli, rotation, other };
+
   /**
    * @brief Represents a gate in a circuit
    *
@@ -64,57 +77,30 @@ namespace cirkit
 
     /**
      * @brief Container for storing control lines
+     *
+     * Up to two control lines are stored inside the gate.
+     *
      * @since  2.0
      */
-    using control_container = std::vector<variable>;
+    using control_container = boost::container::small_vector<variable, 2u>;
 
     /**
      * @brief Container for storing target lines
+     *
+     * Up to two target lines are stored inside the gate.
+     *
      * @since 2.0
      */
-    using target_container = std::vector<unsigned>;
+    using target_container = boost::container::small_vector<unsigned, 2u>;
 
   public:
     /**
      * @brief Default constructor
      *
-     * Initializes private data
-     *
      * @since  1.0
      */
     gate();
 
-    /**
-     * @brief Copy Constructor
-     *
-     * Initializes private data and copies gate
-     *
-     * @param other Gate to be assigned
-     *
-     * @since  1.0
-     */
-    gate( const gate& other );
-
-    /**
-     * @brief Default deconstructor
-     *
-     * Clears private data
-     *
-     * @since  1.0
-     */
-    virtual ~gate();
-
-    /**
-     * @brief Assignment operator
-     *
-     * @param other Gate to be assigned
-     *
-     * @return Pointer to instance
-     *
-     * @since  1.0
-     */
-    gate& operator=( const gate& other );
-
     /**
      * @brief Returns the control lines
      *
@@ -139,7 +125,7 @@ namespace cirkit
      *
      * @return Number of control and target lines.
      */
-    virtual unsigned size() const;
+    unsigned size() const;
 
     /**
      * @brief Adds a control line to the gate
@@ -148,7 +134,7 @@ namespace cirkit
      *
      * @since 1.0
      */
-    virtual void add_control( variable c );
+    void add_control( variable c );
 
     /**
      * @brief Remove control line to the gate
@@ -157,7 +143,7 @@ namespace cirkit
      *
      * @since 1.0
      */
-    virtual void remove_control( variable c );
+    void remove_control( variable c );
 
     /**
      * @brief Adds a target to the desired line
@@ -166,7 +152,7 @@ namespace cirkit
      *
      * @since 1.0
      */
-    virtual void add_target( unsigned l );
+    void add_target( unsigned l );
 
     /**
      * @brief Removes a target from the desired line
@@ -175,7 +161,7 @@ namespace cirkit
      *
      * @since 1.0
      */
-    virtual void remove_target( unsigned l );
+    void remove_target( unsigned l );
 
     /**
      * @brief Sets the type of the target line(s)
@@ -184,7 +170,7 @@ namespace cirkit
      *
      * @since  1.0
      */
-    virtual void set_type( const boost::any& t );
+    void set_type( const boost::any& t );
 
     /**
      * @brief Returns the type of the target line(s)
@@ -193,11 +179,20 @@ namespace cirkit
      *
      * @since  1.0
      */
-    virtual const boost::any& type() const;
+    const boost::any& type() const;
+
+    /**
+     * @brief Returns the kind of the target type
+     *
+     * @since  2.3
+     */
+    inline gate_kind kind() const { return _kind; }
 
   private:
-    class priv;
-    priv* const d;
+    mutable control_container _controls;
+    mutable target_container  _targets;
+    gate_kind                 _kind = gate_kind::none;
+    boost::any                _type; /* only for tags with data */
   };
 }
 
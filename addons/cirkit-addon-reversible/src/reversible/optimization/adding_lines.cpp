@@ -54,7 +54,7 @@ namespace cirkit
     {
       if ( factor.test( it.index ) )
       {
-        factored += it.value;
+        factored.push_back( it.value );
       }
     }
     return factored;
@@ -172,7 +172,7 @@ bool pair::computequivalence( unsigned& c1, unsigned& c2, double* t1,
 
       unsigned target = log2( a_notb );
 
-      std::vector<variable> controls;
+      gate::control_container controls;
       uint16_t to_create = b_nota;
       for ( unsigned i = 0; i < 16; i++ )
       {
@@ -200,7 +200,7 @@ bool pair::computequivalence( unsigned& c1, unsigned& c2, double* t1,
     {
       unsigned target = boost::integer_log2( b_nota );
 
-      std::vector<variable> controls;
+      gate::control_container controls;
       uint16_t to_create = a_notb;
       for ( unsigned i = 0; i < 16; i++ )
       {
@@ -237,7 +237,7 @@ bool pair::computequivalence( unsigned& c1, unsigned& c2, double* t1,
       bool done = false;
       std::vector<unsigned> cnot_targets;
       unsigned cnot_control;
-      std::vector<variable> common_controls;
+      gate::control_container common_controls;
 
       for ( i = 0; i < 16; ++i )
       {
@@ -27,6 +27,7 @@
 #include "simplify.hpp"
 
 #include <cmath>
+#include <memory>
 
 #include <boost/dynamic_bitset.hpp>
 #include <boost/range/algorithm_ext/iota.hpp>
@@ -34,6 +35,7 @@
 #include <core/cube.hpp>
 #include <core/utils/bitset_utils.hpp>
 #include <core/utils/range_utils.hpp>
+#include <core/utils/thread_pool.hpp>
 #include <core/utils/timer.hpp>
 #include <classical/optimization/exorcism_minimization.hpp>
 #include <reversible/target_tags.hpp>
@@ -457,52 +459,59 @@ circuit exorcism_merge_heuristic( const circuit& base )
   return circ;
 }
 
-circuit same_target_optimization_heuristic( const circuit& base )
+/* blocks of Toffoli gates with the same target are optimized independently
+   in parallel and appended in their original order */
+circuit same_target_optimization_heuristic( const circuit& base, thread_pool& pool )
 {
   circuit circ;
   circ.set_lines( base.lines() );
   copy_metadata( base, circ );
 
+  /* first gate of each block, blocks of non-Toffoli gates have size 1 */
+  std::vector<unsigned> firsts;
   auto current_target = -1;
-  circuit sub( base.lines() );
 
-  auto append_sub = [&circ, &sub]() {
-    if ( sub.num_gates() == 0u ) return;
-
-    append_circuit( circ, esop_post_optimization( sub ) );
-    while ( sub.num_gates() )
-    {
-      sub.remove_gate_at( 0u );
-    }
-  };
-
-  for ( const auto& gate : base )
+  for ( auto i = 0u; i < base.num_gates(); ++i )
   {
-    /* works only for Toffoli gates for now */
+    const auto& gate = base[i];
+
     if ( !is_toffoli( gate ) )
     {
-      append_sub();
+      firsts.push_back( i );
       current_target = -1;
-      circ.append_gate() = gate;
-      continue;
     }
+    else if ( static_cast<int>( gate.targets().front() ) != current_target )
+    {
+      firsts.push_back( i );
+      current_target = gate.targets().front();
+    }
+  }
+  firsts.push_back( base.num_gates() );
 
-    const auto target = gate.targets().front();
+  std::vector<circuit> blocks( firsts.size() - 1u );
+  pool.parallel_for( 0u, blocks.size(), 1u, [&]( std::size_t b ) {
+      if ( !is_toffoli( base[firsts[b]] ) ) { return; }
 
-    /* apply current cubes */
-    if ( static_cast<int>( target ) != current_target )
+      circuit sub( base.lines() );
+      for ( auto i = firsts[b]; i < firsts[b + 1u]; ++i )
+      {
+        sub.append_gate() = base[i];
+      }
+      blocks[b] = esop_post_optimization( sub );
+    } );
+
+  for ( auto b = 0u; b < blocks.size(); ++b )
+  {
+    if ( is_toffoli( base[firsts[b]] ) )
     {
-      append_sub();
-      current_target = target;
+      append_circuit( circ, blocks[b] );
+    }
+    else
+    {
+      circ.append_gate() = base[firsts[b]];
     }
-
-    /* add gate to sub */
-    sub.append_gate() = gate;
   }
 
-  /* leftovers? */
-  append_sub();
-
   return circ;
 }
 
@@ -516,10 +525,18 @@ bool simplify( circuit& circ, const circuit& base, properties::ptr settings, pro
   const auto methods     = get( settings, "methods",     std::string( "mnaes" ) );
   const auto reverse_opt = get( settings, "reverse_opt", true );
   const auto verbose     = get( settings, "verbose",     false );
+  const auto num_threads = get( settings, "num_threads", 0u );
 
   /* timer */
   properties_timer t( statistics );
 
+  std::unique_ptr<thread_pool> local_pool;
+  if ( num_threads > 0u )
+  {
+    local_pool.reset( new thread_pool( num_threads ) );
+  }
+  auto& pool = local_pool ? *local_pool : shared_thread_pool();
+
   circuit tmp;
   copy_circuit( base, tmp );
 
@@ -546,7 +563,7 @@ bool simplify( circuit& circ, const circuit& base, properties::ptr settings, pro
     if ( methods_vec[1u] ) { tmp = simplify_not_gates( tmp );                 vsize_out( "not gates" ); }
     if ( methods_vec[2u] ) { tmp = simplify_adjacent( tmp );                  vsize_out( "adjacent" ); }
     if ( methods_vec[3u] ) { tmp = exorcism_merge_heuristic( tmp );           vsize_out( "exorcism" ); }
-    if ( methods_vec[4u] ) { tmp = same_target_optimization_heuristic( tmp ); vsize_out( "same target" ); }
+    if ( methods_vec[4u] ) { tmp = same_target_optimization_heuristic( tmp, pool ); vsize_out( "same target" ); }
     if ( methods_vec[5u] ) {
       tmp = simplify_swap_gates( tmp, perm ); vsize_out( "swap" );
       gperm = permutation_multiply( gperm, perm );
@@ -559,7 +576,7 @@ bool simplify( circuit& circ, const circuit& base, properties::ptr settings, pro
       if ( methods_vec[1u] ) { tmp = simplify_not_gates( tmp );                 vsize_out( "not gates (r)" ); }
       if ( methods_vec[2u] ) { tmp = simplify_adjacent( tmp );                  vsize_out( "adjacent (r)" ); }
       if ( methods_vec[3u] ) { tmp = exorcism_merge_heuristic( tmp );           vsize_out( "exorcism (r)" ); }
-      if ( methods_vec[4u] ) { tmp = same_target_optimization_heuristic( tmp ); vsize_out( "same target (r)" ); }
+      if ( methods_vec[4u] ) { tmp = same_target_optimization_heuristic( tmp, pool ); vsize_out( "same target (r)" ); }
       if ( methods_vec[5u] ) {
         //tmp = simplify_swap_gates( tmp, perm ); vsize_out( "swap (r)" );
       }
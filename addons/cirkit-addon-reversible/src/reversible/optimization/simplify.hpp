@@ -42,6 +42,19 @@
 namespace cirkit
 {
 
+/**
+ * @settings
+ *
+   |-------------+------------------------------------------------------+---------|
+   | Settings    | Description                                          | Default |
+   |-------------+------------------------------------------------------+---------|
+   | methods     | Optimization methods, see revsimp command            | "mnaes" |
+   | reverse_opt | Also optimize the reversed circuit in each round     | true    |
+   | verbose     | Print circuit size after each method                 | false   |
+   | num_threads | Threads for same target optimization, 0 uses shared  | 0u      |
+   |             | thread pool; the result does not depend on it        |         |
+   |-------------+------------------------------------------------------+---------|
+ */
 bool simplify( circuit& circ, const circuit& base, properties::ptr settings = properties::ptr(), properties::ptr statistics = properties::ptr() );
 
 optimization_func simplify( properties::ptr settings = std::make_shared<properties>(),
@@ -33,7 +33,7 @@ namespace cirkit
 
 bool is_pauli( const gate& g )
 {
-  return is_type<pauli_tag>( g.type() );
+  return g.kind() == gate_kind::pauli;
 }
 
 gate& create_pauli( gate& g, unsigned target, pauli_axis axis, unsigned root, bool adjoint )
@@ -60,7 +60,7 @@ gate& insert_pauli( circuit& circ, unsigned n, unsigned target, pauli_axis axis,
 
 bool is_hadamard( const gate& g )
 {
-  return is_type<hadamard_tag>( g.type() );
+  return g.kind() == gate_kind::hadamard;
 }
 
 gate& create_hadamard( gate& g, unsigned target )
@@ -33,7 +33,7 @@ namespace cirkit
 
 bool is_rotation( const gate& g )
 {
-  return is_type<rotation_tag>( g.type() );
+  return g.kind() == gate_kind::rotation;
 }
 
 gate& create_rotation( gate& g, unsigned target, rotation_axis axis, double rotation )
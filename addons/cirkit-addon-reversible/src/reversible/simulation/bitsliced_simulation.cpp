@@ -0,0 +1,350 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "bitsliced_simulation.hpp"
+
+#include <algorithm>
+#include <memory>
+
+#include <core/utils/thread_pool.hpp>
+#include <core/utils/timer.hpp>
+#include <reversible/target_tags.hpp>
+
+namespace cirkit
+{
+
+/******************************************************************************
+ * Types                                                                      *
+ ******************************************************************************/
+
+/******************************************************************************
+ * Private functions                                                          *
+ ******************************************************************************/
+
+/* values of the first 6 lines for the patterns 0 to 63 */
+const uint64_t bitsliced_projections[] = {
+  0xaaaaaaaaaaaaaaaa, 0xcccccccccccccccc, 0xf0f0f0f0f0f0f0f0,
+  0xff00ff00ff00ff00, 0xffff0000ffff0000, 0xffffffff00000000 };
+
+bool bitsliced_gate_supported( const gate& g )
+{
+  switch ( g.kind() )
+  {
+  case gate_kind::toffoli:
+    return g.targets().size() == 1u;
+  case gate_kind::fredkin:
+    return g.targets().size() == 2u;
+  case gate_kind::peres:
+    return g.targets().size() == 2u && !g.controls().empty();
+  case gate_kind::stg:
+    return g.targets().size() == 1u && g.controls().size() <= 16u;
+  default:
+    return false;
+  }
+}
+
+std::unique_ptr<thread_pool> bitsliced_local_pool( const properties::ptr& settings )
+{
+  const auto num_threads = get( settings, "num_threads", 0u );
+
+  std::unique_ptr<thread_pool> local_pool;
+  if ( num_threads > 0u )
+  {
+    local_pool.reset( new thread_pool( num_threads ) );
+  }
+  return local_pool;
+}
+
+/******************************************************************************
+ * Public functions                                                           *
+ ******************************************************************************/
+
+bitsliced_simulator::bitsliced_simulator( const circuit& circ )
+  : num_lines( circ.lines() )
+{
+  gates.reserve( circ.num_gates() );
+
+  for ( const auto& g : circ )
+  {
+    if ( !bitsliced_gate_supported( g ) )
+    {
+      throw "unsupported gate in bit-sliced simulation";
+    }
+
+    gate_t bg;
+    bg.kind          = g.kind();
+    bg.target1       = g.targets().front();
+    bg.target2       = g.targets().back();
+    bg.first_control = controls.size();
+    bg.first_minterm = minterms.size();
+    bg.num_minterms  = 0u;
+
+    if ( bg.kind == gate_kind::peres )
+    {
+      /* as in core_gate_simulation, only the first control is considered */
+      controls.push_back( {g.controls().front().line(), 0u} );
+    }
+    else if ( bg.kind == gate_kind::stg )
+    {
+      /* the function is given over the values of the control lines */
+      for ( const auto& c : g.controls() )
+      {
+        controls.push_back( {c.line(), 0u} );
+      }
+
+      const auto& function = boost::any_cast<stg_tag>( &g.type() )->function;
+      for ( auto m = function.find_first(); m != boost::dynamic_bitset<>::npos; m = function.find_next( m ) )
+      {
+        minterms.push_back( m );
+      }
+      bg.num_minterms = minterms.size() - bg.first_minterm;
+    }
+    else
+    {
+      for ( const auto& c : g.controls() )
+      {
+        controls.push_back( {c.line(), c.polarity() ? uint64_t( 0 ) : ~uint64_t( 0 )} );
+      }
+    }
+    bg.num_controls = controls.size() - bg.first_control;
+
+    gates.push_back( bg );
+  }
+}
+
+bool bitsliced_simulator::supports( const circuit& circ )
+{
+  return std::all_of( circ.begin(), circ.end(), bitsliced_gate_supported );
+}
+
+void bitsliced_simulator::simulate( uint64_t * words, unsigned num_words ) const
+{
+  for ( const auto& g : gates )
+  {
+    auto * t1 = words + g.target1 * num_words;
+    auto * t2 = words + g.target2 * num_words;
+    const auto * cfirst = controls.data() + g.first_control;
+    const auto * clast = cfirst + g.num_controls;
+
+    switch ( g.kind )
+    {
+    case gate_kind::toffoli:
+      for ( auto w = 0u; w < num_words; ++w )
+      {
+        auto mask = ~uint64_t( 0 );
+        for ( auto c = cfirst; c != clast; ++c )
+        {
+          mask &= words[c->line * num_words + w] ^ c->complement;
+        }
+        t1[w] ^= mask;
+      }
+      break;
+
+    case gate_kind::fredkin:
+      for ( auto w = 0u; w < num_words; ++w )
+      {
+        auto mask = ~uint64_t( 0 );
+        for ( auto c = cfirst; c != clast; ++c )
+        {
+          mask &= words[c->line * num_words + w] ^ c->complement;
+        }
+        const auto diff = ( t1[w] ^ t2[w] ) & mask;
+        t1[w] ^= diff;
+        t2[w] ^= diff;
+      }
+      break;
+
+    case gate_kind::peres:
+      for ( auto w = 0u; w < num_words; ++w )
+      {
+        const auto c = words[cfirst->line * num_words + w];
+        t2[w] ^= c & t1[w];
+        t1[w] ^= c;
+      }
+      break;
+
+    case gate_kind::stg:
+      for ( auto w = 0u; w < num_words; ++w )
+      {
+        uint64_t value = 0u;
+        for ( auto m = 0u; m < g.num_minterms; ++m )
+        {
+          const auto minterm = minterms[g.first_minterm + m];
+          auto term = ~uint64_t( 0 );
+          for ( auto c = cfirst; c != clast; ++c )
+          {
+            const auto x = words[c->line * num_words + w];
+            term &= ( ( minterm >> ( c - cfirst ) ) & 1u ) ? x : ~x;
+          }
+          value |= term;
+        }
+        t1[w] ^= value;
+      }
+      break;
+
+    default:
+      break;
+    }
+  }
+}
+
+bool bitsliced_simulation( std::vector<boost::dynamic_bitset<>>& outputs, const circuit& circ,
+                           const std::vector<boost::dynamic_bitset<>>& inputs,
+                           const properties::ptr& settings,
+                           const properties::ptr& statistics )
+{
+  /* settings */
+  const auto block_size = std::max( 1u, std::min( get( settings, "block_size", 4u ), 8u ) );
+
+  /* timing */
+  properties_timer t( statistics );
+
+  if ( !bitsliced_simulator::supports( circ ) )
+  {
+    return false;
+  }
+
+  const bitsliced_simulator sim( circ );
+  const auto n = circ.lines();
+
+  for ( const auto& input : inputs )
+  {
+    if ( input.size() != n )
+    {
+      throw "pattern size does not match number of lines";
+    }
+  }
+
+  outputs.assign( inputs.size(), boost::dynamic_bitset<>( n ) );
+
+  const auto patterns_per_block = 64u * block_size;
+  const auto num_blocks = ( inputs.size() + patterns_per_block - 1u ) / patterns_per_block;
+
+  auto local_pool = bitsliced_local_pool( settings );
+  auto& pool = local_pool ? *local_pool : shared_thread_pool();
+
+  pool.parallel_for( 0u, num_blocks, 4u, [&]( std::size_t b ) {
+      const auto first = b * patterns_per_block;
+      const auto last = std::min<std::size_t>( first + patterns_per_block, inputs.size() );
+
+      std::vector<uint64_t> words( n * block_size, 0u );
+      for ( auto p = first; p < last; ++p )
+      {
+        const auto offset = p - first;
+        for ( auto i = inputs[p].find_first(); i != boost::dynamic_bitset<>::npos; i = inputs[p].find_next( i ) )
+        {
+          words[i * block_size + ( offset >> 6u )] |= uint64_t( 1 ) << ( offset & 63u );
+        }
+      }
+
+      sim.simulate( words.data(), block_size );
+
+      for ( auto p = first; p < last; ++p )
+      {
+        const auto offset = p - first;
+        for ( auto i = 0u; i < n; ++i )
+        {
+          if ( ( words[i * block_size + ( offset >> 6u )] >> ( offset & 63u ) ) & 1u )
+          {
+            outputs[p].set( i );
+          }
+        }
+      }
+    } );
+
+  return true;
+}
+
+bool bitsliced_truth_table( std::vector<boost::dynamic_bitset<>>& table, const circuit& circ,
+                            const properties::ptr& settings,
+                            const properties::ptr& statistics )
+{
+  /* settings */
+  const auto block_size = std::max( 1u, std::min( get( settings, "block_size", 4u ), 8u ) );
+
+  /* timing */
+  properties_timer t( statistics );
+
+  if ( !bitsliced_simulator::supports( circ ) )
+  {
+    return false;
+  }
+
+  const auto n = circ.lines();
+  if ( n > 32u )
+  {
+    throw "too many lines for truth table simulation";
+  }
+
+  const bitsliced_simulator sim( circ );
+
+  const uint64_t num_patterns = uint64_t( 1 ) << n;
+  const uint64_t num_words = std::max<uint64_t>( num_patterns >> 6u, 1u );
+  const uint64_t num_blocks = ( num_words + block_size - 1u ) / block_size;
+
+  std::vector<std::vector<uint64_t>> columns( n, std::vector<uint64_t>( num_words ) );
+
+  auto local_pool = bitsliced_local_pool( settings );
+  auto& pool = local_pool ? *local_pool : shared_thread_pool();
+
+  pool.parallel_for( 0u, num_blocks, 16u, [&]( std::size_t b ) {
+      const uint64_t first = b * block_size;
+      const unsigned count = std::min<uint64_t>( block_size, num_words - first );
+
+      std::vector<uint64_t> words( n * count );
+      for ( auto i = 0u; i < n; ++i )
+      {
+        for ( auto w = 0u; w < count; ++w )
+        {
+          words[i * count + w] = i < 6u ? bitsliced_projections[i] : ( ( ( first + w ) >> ( i - 6u ) ) & 1u ? ~uint64_t( 0 ) : uint64_t( 0 ) );
+        }
+      }
+
+      sim.simulate( words.data(), count );
+
+      for ( auto i = 0u; i < n; ++i )
+      {
+        std::copy( words.begin() + i * count, words.begin() + ( i + 1u ) * count, columns[i].begin() + first );
+      }
+    } );
+
+  table.clear();
+  for ( auto i = 0u; i < n; ++i )
+  {
+    table.emplace_back( columns[i].begin(), columns[i].end() );
+    table.back().resize( num_patterns );
+  }
+
+  return true;
+}
+
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
@@ -0,0 +1,137 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * @file bitsliced_simulation.hpp
+ *
+ * @brief Bit-sliced simulation of many patterns at once
+ *
+ * Every line is represented by a number of 64-bit words, where bit j of
+ * word w holds the value of the line for pattern 64w + j.  Toffoli,
+ * Fredkin, Peres, and single-target gates are then simulated with a few
+ * AND and XOR operations per word, and 64 to 512 patterns are simulated in
+ * one pass over the gates.
+ *
+ * @author Mathias Soeken
+ * @since  2.3
+ */
+
+#ifndef BITSLICED_SIMULATION_HPP
+#define BITSLICED_SIMULATION_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include <boost/dynamic_bitset.hpp>
+
+#include <core/properties.hpp>
+#include <reversible/circuit.hpp>
+
+namespace cirkit
+{
+
+class bitsliced_simulator
+{
+public:
+  /* throws if the circuit contains gates that are not supported */
+  explicit bitsliced_simulator( const circuit& circ );
+
+  /* Toffoli, Fredkin, Peres, and single-target gates are supported */
+  static bool supports( const circuit& circ );
+
+  inline unsigned lines() const { return num_lines; }
+
+  /* words contains lines() * num_words words, the ones for line i start at
+     words[i * num_words]; they are overriden by the output values */
+  void simulate( uint64_t * words, unsigned num_words ) const;
+
+private:
+  struct control_t
+  {
+    unsigned line;
+    uint64_t complement; /* all ones for negative controls */
+  };
+
+  struct gate_t
+  {
+    gate_kind kind;
+    unsigned  target1;
+    unsigned  target2;
+    unsigned  first_control;
+    unsigned  num_controls;
+    unsigned  first_minterm; /* single-target gates only */
+    unsigned  num_minterms;
+  };
+
+private:
+  unsigned               num_lines;
+  std::vector<gate_t>    gates;
+  std::vector<control_t> controls;
+  std::vector<unsigned>  minterms;
+};
+
+/**
+ * @settings
+ *
+   |-------------+--------------------------------------------------------+---------|
+   | Settings    | Description                                            | Default |
+   |-------------+--------------------------------------------------------+---------|
+   | block_size  | Number of 64-bit words per line in one pass (1 to 8)   | 4u      |
+   | num_threads | Number of threads, 0 uses the shared thread pool       | 0u      |
+   |-------------+--------------------------------------------------------+---------|
+ *
+ * @statistics
+ *
+   |------------+--------------------|
+   | Statistics | Description        |
+   |------------+--------------------|
+   | runtime    | Runtime in seconds |
+   |------------+--------------------|
+ */
+
+/* output[i] is the output pattern of circ for inputs[i]; returns false if
+   the circuit contains gates that are not supported */
+bool bitsliced_simulation( std::vector<boost::dynamic_bitset<>>& outputs, const circuit& circ,
+                           const std::vector<boost::dynamic_bitset<>>& inputs,
+                           const properties::ptr& settings = properties::ptr(),
+                           const properties::ptr& statistics = properties::ptr() );
+
+/* simulates all 2^n input patterns of circ with n lines; bit p of table[i]
+   is the value of line i for input pattern p; returns false if the circuit
+   contains gates that are not supported */
+bool bitsliced_truth_table( std::vector<boost::dynamic_bitset<>>& table, const circuit& circ,
+                            const properties::ptr& settings = properties::ptr(),
+                            const properties::ptr& statistics = properties::ptr() );
+
+}
+
+#endif
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
@@ -38,35 +38,28 @@ namespace cirkit
   {
     if ( is_toffoli( g ) )
     {
-      boost::dynamic_bitset<> c_mask( input.size() );
-      boost::dynamic_bitset<> input_copy = input;
       for ( const auto& v : g.controls() )
       {
-        if ( !v.polarity() )
+        if ( input.test( v.line() ) != v.polarity() )
         {
-          input_copy.flip( v.line() );
+          return input;
         }
-        c_mask.set( v.line() );
-      }
-
-      if ( c_mask.none() || ( ( input_copy & c_mask ) == c_mask ) )
-      {
-        input.flip( g.targets().front() );
       }
 
+      input.flip( g.targets().front() );
       return input;
     }
     // TODO negative controls
     else if ( is_fredkin( g ) )
     {
-      boost::dynamic_bitset<> c_mask( input.size() );
+      bool controls_hit = true;
       for ( const auto& v : g.controls() )
       {
         assert( v.polarity() );
-        c_mask.set( v.line() );
+        controls_hit = controls_hit && input.test( v.line() );
       }
 
-      if ( c_mask.none() || ( ( input & c_mask ) == c_mask ) )
+      if ( controls_hit )
       {
         // get both positions and values
         unsigned t1 = g.targets().at( 0u );
@@ -216,7 +216,7 @@ bool eval_original(z3::solver& solver, circuit& circ,
       {
         if (eval_control.test(j))
         {
-          controls += make_var(j);
+          controls.push_back( make_var(j) );
         }
       }
 
@@ -246,7 +246,7 @@ bool eval_multiple_target(z3::solver& solver, circuit& circ,
       {
         if (eval_control.test(j))
         {
-          controls += make_var(j);
+          controls.push_back( make_var(j) );
         }
       }
 
@@ -255,7 +255,7 @@ bool eval_multiple_target(z3::solver& solver, circuit& circ,
       {
         if (eval_target.test(j))
         {
-          targets += j;
+          targets.push_back( j );
         }
       }
 
@@ -290,7 +290,7 @@ bool eval_negative_control(z3::solver& solver, circuit& circ,
       {
         if (eval_control.test(j))
         {
-          controls += make_var(j, !eval_polarity.test(j));
+          controls.push_back( make_var(j, !eval_polarity.test(j)) );
         }
       }
 
@@ -328,7 +328,7 @@ bool eval_negative_control_multiple_target(z3::solver& solver, circuit& circ,
       {
         if (eval_control.test(j))
         {
-          controls += make_var(j, !eval_polarity.test(j));
+          controls.push_back( make_var(j, !eval_polarity.test(j)) );
         }
       }
 
@@ -338,7 +338,7 @@ bool eval_negative_control_multiple_target(z3::solver& solver, circuit& circ,
         if (eval_target.test(j))
         {
 //          std::cout <<"j: " <<  j << "\n";
-          targets += j;
+          targets.push_back( j );
         }
       }
 
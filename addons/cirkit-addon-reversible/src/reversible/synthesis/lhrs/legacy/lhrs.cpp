@@ -31,7 +31,6 @@
 
 #include <boost/dynamic_bitset.hpp>
 #include <boost/format.hpp>
-#include <boost/range/algorithm_ext/push_back.hpp>
 #include <boost/variant.hpp>
 
 #include <core/utils/bitset_utils.hpp>
@@ -616,7 +615,7 @@ private:
     auto& dest_s = boost::get<standard_circuit>( static_cast<circuit_variant&>( circ ) );
     const auto& src_s = boost::get<standard_circuit>( static_cast<const circuit_variant&>( src ) );
 
-    boost::push_back( dest_s.gates, src_s.gates );
+    dest_s.gates.append( src_s.gates );
   }
 
   inline circuit get_fast_circuit() const
@@ -27,7 +27,6 @@
 #include "stg_map_shannon.hpp"
 
 #include <boost/dynamic_bitset.hpp>
-#include <boost/range/algorithm_ext/push_back.hpp>
 
 #include <reversible/functions/add_gates.hpp>
 
@@ -117,7 +116,7 @@ private:
     auto& dest_s = boost::get<standard_circuit>( static_cast<circuit_variant&>( circ ) );
     const auto& src_s = boost::get<standard_circuit>( static_cast<const circuit_variant&>( src ) );
 
-    boost::push_back( dest_s.gates, src_s.gates );
+    dest_s.gates.append( src_s.gates );
   }
 
   unsigned get_dirty_ancilla()
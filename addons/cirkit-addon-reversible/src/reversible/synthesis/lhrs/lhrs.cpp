@@ -27,11 +27,11 @@
 #include "lhrs.hpp"
 
 #include <fstream>
+#include <utility>
 #include <vector>
 
 #include <boost/dynamic_bitset.hpp>
 #include <boost/format.hpp>
-#include <boost/range/algorithm_ext/push_back.hpp>
 #include <boost/variant.hpp>
 
 #include <core/utils/bitset_utils.hpp>
@@ -588,12 +588,13 @@ private:
     stg_map_luts( circ, lut, line_map, clean_ancilla, params.map_luts_params, stats.map_luts_stats );
   }
 
-  inline void append_circuit_fast( const circuit& src )
+  /* moves the gates of src to the end of circ, src is empty afterwards */
+  inline void append_circuit_fast( circuit& src )
   {
     auto& dest_s = boost::get<standard_circuit>( static_cast<circuit_variant&>( circ ) );
-    const auto& src_s = boost::get<standard_circuit>( static_cast<const circuit_variant&>( src ) );
+    auto& src_s = boost::get<standard_circuit>( static_cast<circuit_variant&>( src ) );
 
-    boost::push_back( dest_s.gates, src_s.gates );
+    dest_s.gates.append( std::move( src_s.gates ) );
   }
 
   inline circuit get_fast_circuit() const
@@ -607,36 +608,39 @@ private:
   {
     using candidate_t = std::pair<circuit, cost_t>;
     std::vector<candidate_t> candidates;
+    candidates.reserve( 4u ); /* circuits are mapped in place and never copied */
 
     const auto lut = xmg_extract_lut( xmg, index );
 
     const auto sp = pbar.subprogress();
 
+    const auto add_candidate = [&]( unsigned max_cut_size ) {
+      candidates.emplace_back( get_fast_circuit(), cost_t() );
+      auto& lcirc = candidates.back().first;
+      params.map_luts_params.max_cut_size = max_cut_size;
+      stg_map_luts( lcirc, lut, line_map, clean_ancilla, params.map_luts_params, stats.map_luts_stats );
+      if ( lcirc.num_gates() )
+      {
+        candidates.back().second = costs( lcirc, costs_by_gate_func( t_costs() ) );
+      }
+      else
+      {
+        candidates.pop_back();
+      }
+    };
+
     const auto old_strategy = params.map_luts_params.strategy;
     for ( const auto& strategy : {stg_map_luts_params::mapping_strategy::mindb, stg_map_luts_params::mapping_strategy::bestfit} )
     {
-      /* cut size 4 */
       params.map_luts_params.strategy = strategy;
-      {
-        auto lcirc = get_fast_circuit();
-        params.map_luts_params.max_cut_size = 4;
-        stg_map_luts( lcirc, lut, line_map, clean_ancilla, params.map_luts_params, stats.map_luts_stats );
-        if ( lcirc.num_gates() )
-        {
-          candidates.push_back( {lcirc, costs( lcirc, costs_by_gate_func( t_costs() ) )} );
-        }
-      }
+
+      /* cut size 4 */
+      add_candidate( 4u );
 
       /* cut size 5 */
       if ( params.map_precomp_params.class_method == 0u )
       {
-        auto lcirc = get_fast_circuit();
-        params.map_luts_params.max_cut_size = 5;
-        stg_map_luts( lcirc, lut, line_map, clean_ancilla, params.map_luts_params, stats.map_luts_stats );
-        if ( lcirc.num_gates() )
-        {
-          candidates.push_back( {lcirc, costs( lcirc, costs_by_gate_func( t_costs() ) )} );
-        }
+        add_candidate( 5u );
       }
     }
 
@@ -152,7 +152,7 @@ void qmdd_synthesis_manager::create_toffoli_gates( unsigned var, const BDD& gate
         {
           if ( c.second[3u * i] )
           {
-            controls += make_var( i, c.first[3u * i] );
+            controls.push_back( make_var( i, c.first[3u * i] ) );
           }
         }
 
@@ -166,13 +166,13 @@ void extract_solution( circuit& circ, T * str, unsigned num_gates, unsigned n, u
     {
       if ( str[offset + j] == 1 )
       {
-        controls += make_var( j );
+        controls.push_back( make_var( j ) );
         assert( !( negative && str[offset + n + j] == 1 ) );
       }
 
       if ( negative && str[offset + n + j] == 1 )
       {
-        controls += make_var( j, false );
+        controls.push_back( make_var( j, false ) );
       }
     }
 
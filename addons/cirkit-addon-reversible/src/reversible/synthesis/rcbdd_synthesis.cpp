@@ -481,7 +481,7 @@ struct rcbdd_synthesis_manager
     {
       if ( cube.second[3u * i + offset] )
       {
-        controls += make_var( i, cube.first[3u * i + offset] );
+        controls.push_back( make_var( i, cube.first[3u * i + offset] ) );
       }
     }
 
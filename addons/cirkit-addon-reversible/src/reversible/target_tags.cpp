@@ -31,32 +31,36 @@ namespace cirkit
 
 bool same_type( const gate& g1, const gate& g2 )
 {
+  if ( g1.kind() != gate_kind::other || g2.kind() != gate_kind::other )
+  {
+    return g1.kind() == g2.kind();
+  }
   return g1.type().type() == g2.type().type();
 }
 
 bool is_toffoli( const gate& g )
 {
-  return is_type<toffoli_tag>( g.type() );
+  return g.kind() == gate_kind::toffoli;
 }
 
 bool is_fredkin( const gate& g )
 {
-  return is_type<fredkin_tag>( g.type() );
+  return g.kind() == gate_kind::fredkin;
 }
 
 bool is_peres( const gate& g )
 {
-  return is_type<peres_tag>( g.type() );
+  return g.kind() == gate_kind::peres;
 }
 
 bool is_module( const gate& g )
 {
-  return is_type<module_tag>( g.type() );
+  return g.kind() == gate_kind::module;
 }
 
 bool is_stg( const gate& g )
 {
-  return is_type<stg_tag>( g.type() );
+  return g.kind() == gate_kind::stg;
 }
 
 }
@@ -65,7 +65,7 @@ circuit create_gate_circuit( unsigned target, boost::dynamic_bitset<> controls,
   while ( bpos != boost::dynamic_bitset<>::npos )
   {
     auto line = bpos < target ? bpos : bpos + 1u;
-    cont += make_var( line, polarities[pos] );
+    cont.push_back( make_var( line, polarities[pos] ) );
     bpos = controls.find_next( bpos );
     ++pos;
   }
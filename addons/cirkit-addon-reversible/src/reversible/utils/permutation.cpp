@@ -38,7 +38,6 @@
 
 #include <core/utils/range_utils.hpp>
 #include <reversible/functions/circuit_to_truth_table.hpp>
-#include <reversible/simulation/simple_simulation.hpp>
 
 using namespace boost::assign;
 using boost::adaptors::transformed;
@@ -72,7 +71,7 @@ permutation_t truth_table_to_permutation( const binary_truth_table& spec )
 permutation_t circuit_to_permutation( const circuit& circ )
 {
   binary_truth_table spec;
-  circuit_to_truth_table( circ, spec, simple_simulation_func() );
+  circuit_to_truth_table( circ, spec );
   return truth_table_to_permutation( spec );
 }
 
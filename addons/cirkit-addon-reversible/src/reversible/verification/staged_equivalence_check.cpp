@@ -0,0 +1,516 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "staged_equivalence_check.hpp"
+
+#include <algorithm>
+#include <mutex>
+#include <random>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/dynamic_bitset.hpp>
+#include <boost/optional.hpp>
+
+#include <cuddObj.hh>
+
+#include <core/utils/hash_utils.hpp>
+#include <core/utils/timer.hpp>
+#include <classical/sat/minisat.hpp>
+#include <classical/sat/sat_solver.hpp>
+#include <classical/sat/operations/logic.hpp>
+#include <reversible/target_tags.hpp>
+#include <reversible/simulation/bitsliced_simulation.hpp>
+
+namespace cirkit
+{
+
+/******************************************************************************
+ * Types                                                                      *
+ ******************************************************************************/
+
+using staged_cache_key_t = std::pair<std::size_t, std::size_t>;
+
+/* the hashes only select the entry, the normalized gate lists decide a hit */
+struct staged_cache_entry
+{
+  std::vector<unsigned> gates1;
+  std::vector<unsigned> gates2;
+  bool                  result;
+};
+
+struct staged_equivalence_cache
+{
+  std::mutex                                                                           mutex;
+  std::unordered_map<staged_cache_key_t, staged_cache_entry, hash<staged_cache_key_t>> results;
+};
+
+/******************************************************************************
+ * Private functions                                                          *
+ ******************************************************************************/
+
+staged_equivalence_cache& staged_cache()
+{
+  static staged_equivalence_cache cache;
+  return cache;
+}
+
+bool staged_gate_supported( const gate& g )
+{
+  return is_toffoli( g ) || is_fredkin( g ) || ( is_peres( g ) && !g.controls().empty() );
+}
+
+/* number of lines followed by kind, controls, and targets of each gate (only supported gates) */
+std::vector<unsigned> staged_normalized_gates( const circuit& circ )
+{
+  std::vector<unsigned> gates{circ.lines()};
+
+  for ( const auto& g : circ )
+  {
+    gates.push_back( static_cast<unsigned>( g.kind() ) );
+    gates.push_back( g.controls().size() );
+    for ( const auto& c : g.controls() )
+    {
+      gates.push_back( ( c.line() << 1u ) | ( c.polarity() ? 1u : 0u ) );
+    }
+    gates.push_back( g.targets().size() );
+    for ( const auto& t : g.targets() )
+    {
+      gates.push_back( t );
+    }
+  }
+
+  return gates;
+}
+
+/* simulation: returns a counterexample, decided is true if all patterns were simulated */
+boost::optional<boost::dynamic_bitset<>> staged_simulation( const circuit& circ1, const circuit& circ2,
+                                                            unsigned sim_patterns, unsigned exhaustive_lines, unsigned seed,
+                                                            bool& decided )
+{
+  const auto n = circ1.lines();
+
+  if ( n <= exhaustive_lines )
+  {
+    decided = true;
+
+    std::vector<boost::dynamic_bitset<>> table1, table2;
+    bitsliced_truth_table( table1, circ1 );
+    bitsliced_truth_table( table2, circ2 );
+
+    auto first = boost::dynamic_bitset<>::npos;
+    for ( auto i = 0u; i < n; ++i )
+    {
+      const auto p = ( table1[i] ^ table2[i] ).find_first();
+      first = std::min( first, p );
+    }
+
+    if ( first == boost::dynamic_bitset<>::npos )
+    {
+      return boost::none;
+    }
+    return boost::dynamic_bitset<>( n, first );
+  }
+
+  decided = false;
+
+  const auto num_words = std::max( 1u, ( sim_patterns + 63u ) / 64u );
+
+  std::mt19937_64 gen( seed );
+  std::vector<uint64_t> inputs( n * num_words );
+  std::generate( inputs.begin(), inputs.end(), std::ref( gen ) );
+
+  auto words1 = inputs;
+  auto words2 = inputs;
+  bitsliced_simulator( circ1 ).simulate( words1.data(), num_words );
+  bitsliced_simulator( circ2 ).simulate( words2.data(), num_words );
+
+  for ( auto w = 0u; w < num_words; ++w )
+  {
+    uint64_t diff = 0u;
+    for ( auto i = 0u; i < n; ++i )
+    {
+      diff |= words1[i * num_words + w] ^ words2[i * num_words + w];
+    }
+
+    if ( diff )
+    {
+      auto bit = 0u;
+      while ( !( ( diff >> bit ) & 1u ) ) { ++bit; }
+
+      boost::dynamic_bitset<> cex( n );
+      for ( auto i = 0u; i < n; ++i )
+      {
+        cex[i] = ( inputs[i * num_words + w] >> bit ) & 1u;
+      }
+      return cex;
+    }
+  }
+
+  return boost::none;
+}
+
+int staged_and( minisat_solver& solver, const clause_t& lits, int& next_var )
+{
+  if ( lits.size() == 1u )
+  {
+    return lits.front();
+  }
+
+  const auto v = next_var++;
+  logic_and( solver, lits, v );
+  return v;
+}
+
+int staged_xor( minisat_solver& solver, int a, int b, int& next_var )
+{
+  const auto v = next_var++;
+  logic_xor( solver, a, b, v );
+  return v;
+}
+
+/* encodes the circuit on the input variables 1, ..., n and returns output literals */
+std::vector<int> staged_encode( minisat_solver& solver, const circuit& circ, int& next_var )
+{
+  std::vector<int> lines( circ.lines() );
+  for ( auto i = 0u; i < circ.lines(); ++i )
+  {
+    lines[i] = i + 1;
+  }
+
+  for ( const auto& g : circ )
+  {
+    clause_t controls;
+    for ( const auto& c : g.controls() )
+    {
+      controls.push_back( c.polarity() ? lines[c.line()] : -lines[c.line()] );
+    }
+
+    auto& t1 = lines[g.targets().front()];
+    auto& t2 = lines[g.targets().back()];
+
+    if ( is_toffoli( g ) )
+    {
+      t1 = controls.empty() ? -t1 : staged_xor( solver, t1, staged_and( solver, controls, next_var ), next_var );
+    }
+    else if ( is_fredkin( g ) )
+    {
+      if ( controls.empty() )
+      {
+        std::swap( t1, t2 );
+      }
+      else
+      {
+        const auto m = staged_and( solver, controls, next_var );
+        const auto d = staged_and( solver, {m, staged_xor( solver, t1, t2, next_var )}, next_var );
+        t1 = staged_xor( solver, t1, d, next_var );
+        t2 = staged_xor( solver, t2, d, next_var );
+      }
+    }
+    else
+    {
+      /* Peres gate, as in core_gate_simulation only the first control is considered */
+      const auto c = lines[g.controls().front().line()];
+      t2 = staged_xor( solver, t2, staged_and( solver, {c, t1}, next_var ), next_var );
+      t1 = staged_xor( solver, t1, c, next_var );
+    }
+  }
+
+  return lines;
+}
+
+/* SAT miter: returns true if equivalent, false if not, and none if the conflict limit is reached */
+boost::optional<bool> staged_sat( const circuit& circ1, const circuit& circ2, int conflict_limit,
+                                  boost::dynamic_bitset<>& cex )
+{
+  const auto n = circ1.lines();
+
+  auto solver = make_solver<minisat_solver>();
+  int next_var = n + 1;
+
+  const auto outputs1 = staged_encode( solver, circ1, next_var );
+  const auto outputs2 = staged_encode( solver, circ2, next_var );
+
+  clause_t miter;
+  for ( auto i = 0u; i < n; ++i )
+  {
+    if ( outputs1[i] != outputs2[i] )
+    {
+      miter.push_back( staged_xor( solver, outputs1[i], outputs2[i], next_var ) );
+    }
+  }
+
+  /* structurally equal outputs */
+  if ( miter.empty() )
+  {
+    return true;
+  }
+  add_clause( solver )( miter );
+
+  if ( conflict_limit > 0 )
+  {
+    solver.solver->setConfBudget( conflict_limit );
+  }
+  else
+  {
+    solver.solver->budgetOff();
+  }
+
+  Minisat::vec<Minisat::Lit> assumptions;
+  const auto result = solver.solver->solveLimited( assumptions );
+
+  if ( result == Minisat::lbool( (uint8_t)0 ) ) /* satisfiable */
+  {
+    cex.resize( n );
+    for ( auto i = 0u; i < n; ++i )
+    {
+      cex[i] = solver.solver->modelValue( i ) == Minisat::lbool( (uint8_t)0 );
+    }
+    return false;
+  }
+  else if ( result == Minisat::lbool( (uint8_t)1 ) ) /* unsatisfiable */
+  {
+    return true;
+  }
+
+  return boost::none;
+}
+
+std::vector<BDD> staged_bdd_outputs( Cudd& mgr, const circuit& circ )
+{
+  std::vector<BDD> lines;
+  for ( auto i = 0u; i < circ.lines(); ++i )
+  {
+    lines.push_back( mgr.bddVar( i ) );
+  }
+
+  for ( const auto& g : circ )
+  {
+    auto& t1 = lines[g.targets().front()];
+    auto& t2 = lines[g.targets().back()];
+
+    if ( is_peres( g ) )
+    {
+      const auto c = lines[g.controls().front().line()];
+      t2 = t2 ^ ( c & t1 );
+      t1 = t1 ^ c;
+      continue;
+    }
+
+    auto m = mgr.bddOne();
+    for ( const auto& c : g.controls() )
+    {
+      m = m & ( c.polarity() ? lines[c.line()] : !lines[c.line()] );
+    }
+
+    if ( is_toffoli( g ) )
+    {
+      t1 = t1 ^ m;
+    }
+    else
+    {
+      const auto d = ( t1 ^ t2 ) & m;
+      t1 = t1 ^ d;
+      t2 = t2 ^ d;
+    }
+  }
+
+  return lines;
+}
+
+bool staged_bdd( const circuit& circ1, const circuit& circ2 )
+{
+  Cudd mgr;
+
+  const auto outputs1 = staged_bdd_outputs( mgr, circ1 );
+  const auto outputs2 = staged_bdd_outputs( mgr, circ2 );
+
+  for ( auto i = 0u; i < circ1.lines(); ++i )
+  {
+    if ( !( outputs1[i] == outputs2[i] ) )
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/******************************************************************************
+ * Public functions                                                           *
+ ******************************************************************************/
+
+std::size_t circuit_hash( const circuit& circ )
+{
+  std::size_t seed = 0u;
+  hash_combine( seed, circ.lines() );
+
+  for ( const auto& g : circ )
+  {
+    hash_combine( seed, static_cast<unsigned>( g.kind() ) );
+    for ( const auto& c : g.controls() )
+    {
+      hash_combine( seed, ( c.line() << 1u ) | ( c.polarity() ? 1u : 0u ) );
+    }
+    for ( const auto& t : g.targets() )
+    {
+      hash_combine( seed, t );
+    }
+
+    if ( is_stg( g ) )
+    {
+      const auto& function = boost::any_cast<stg_tag>( &g.type() )->function;
+      for ( auto m = function.find_first(); m != boost::dynamic_bitset<>::npos; m = function.find_next( m ) )
+      {
+        hash_combine( seed, m );
+      }
+    }
+    else if ( is_module( g ) )
+    {
+      hash_combine( seed, boost::any_cast<module_tag>( &g.type() )->name );
+    }
+  }
+
+  return seed;
+}
+
+bool staged_equivalence_check( const circuit& circ1, const circuit& circ2,
+                               const properties::ptr& settings,
+                               const properties::ptr& statistics )
+{
+  /* settings */
+  const auto sim_patterns     = get( settings, "sim_patterns",     4096u );
+  const auto exhaustive_lines = get( settings, "exhaustive_lines", 16u );
+  const auto conflict_limit   = get( settings, "conflict_limit",   10000 );
+  const auto use_bdd          = get( settings, "use_bdd",          true );
+  const auto use_cache        = get( settings, "use_cache",        true );
+  const auto seed             = get( settings, "seed",             0u );
+
+  /* timing */
+  properties_timer t( statistics );
+
+  const auto set_stage = [&statistics]( const std::string& stage ) {
+    if ( statistics ) { statistics->set( "stage", stage ); }
+  };
+
+  if ( circ1.lines() != circ2.lines() )
+  {
+    set_stage( "lines" );
+    return false;
+  }
+
+  if ( !std::all_of( circ1.begin(), circ1.end(), staged_gate_supported ) ||
+       !std::all_of( circ2.begin(), circ2.end(), staged_gate_supported ) )
+  {
+    throw "staged equivalence check supports only Toffoli, Fredkin, and Peres gates";
+  }
+
+  /* cache */
+  auto& cache = staged_cache();
+  staged_cache_key_t key;
+  std::vector<unsigned> gates1, gates2;
+  if ( use_cache )
+  {
+    auto h1 = circuit_hash( circ1 );
+    auto h2 = circuit_hash( circ2 );
+    gates1 = staged_normalized_gates( circ1 );
+    gates2 = staged_normalized_gates( circ2 );
+    if ( std::tie( h2, gates2 ) < std::tie( h1, gates1 ) )
+    {
+      std::swap( h1, h2 );
+      std::swap( gates1, gates2 );
+    }
+    key = std::make_pair( h1, h2 );
+
+    std::lock_guard<std::mutex> lock( cache.mutex );
+    const auto it = cache.results.find( key );
+    if ( it != cache.results.end() && it->second.gates1 == gates1 && it->second.gates2 == gates2 )
+    {
+      set_stage( "cache" );
+      return it->second.result;
+    }
+  }
+
+  const auto store = [&]( bool result ) {
+    if ( use_cache )
+    {
+      std::lock_guard<std::mutex> lock( cache.mutex );
+      if ( cache.results.size() >= ( 1u << 16u ) )
+      {
+        cache.results.clear();
+      }
+      cache.results[key] = {std::move( gates1 ), std::move( gates2 ), result};
+    }
+    return result;
+  };
+
+  /* simulation */
+  auto decided = false;
+  const auto sim_cex = staged_simulation( circ1, circ2, sim_patterns, exhaustive_lines, seed, decided );
+  if ( sim_cex || decided )
+  {
+    set_stage( "simulation" );
+    if ( sim_cex && statistics )
+    {
+      statistics->set( "counterexample", *sim_cex );
+    }
+    return store( !sim_cex );
+  }
+
+  /* SAT */
+  boost::dynamic_bitset<> sat_cex;
+  const auto sat_result = staged_sat( circ1, circ2, use_bdd ? conflict_limit : 0, sat_cex );
+  if ( sat_result )
+  {
+    set_stage( "sat" );
+    if ( !*sat_result && statistics )
+    {
+      statistics->set( "counterexample", sat_cex );
+    }
+    return store( *sat_result );
+  }
+
+  /* BDD */
+  set_stage( "bdd" );
+  return store( staged_bdd( circ1, circ2 ) );
+}
+
+void clear_staged_equivalence_cache()
+{
+  auto& cache = staged_cache();
+  std::lock_guard<std::mutex> lock( cache.mutex );
+  cache.results.clear();
+}
+
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
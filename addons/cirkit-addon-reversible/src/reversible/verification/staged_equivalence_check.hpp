@@ -0,0 +1,99 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * @file staged_equivalence_check.hpp
+ *
+ * @brief Equivalence check with simulation, SAT, and BDDs
+ *
+ * Non-equivalent circuits, e.g., candidates in template based optimization,
+ * are usually refuted by a few thousand random patterns.  Therefore the
+ * circuits are first simulated bit-sliced, exhaustively if they have few
+ * lines.  If no counterexample is found, a miter of both circuits is solved
+ * with MiniSAT and a conflict limit, and only if the SAT solver gives up,
+ * the output functions are computed as BDDs.  Results are cached by the
+ * hashes of both circuits.
+ *
+ * @author Mathias Soeken
+ * @since  2.3
+ */
+
+#ifndef STAGED_EQUIVALENCE_CHECK_HPP
+#define STAGED_EQUIVALENCE_CHECK_HPP
+
+#include <cstddef>
+
+#include <core/properties.hpp>
+#include <reversible/circuit.hpp>
+
+namespace cirkit
+{
+
+/* structural hash of lines and gates */
+std::size_t circuit_hash( const circuit& circ );
+
+/**
+ * @settings
+ *
+   |------------------+----------------------------------------------------+---------|
+   | Settings         | Description                                        | Default |
+   |------------------+----------------------------------------------------+---------|
+   | sim_patterns     | Number of random simulation patterns               | 4096u   |
+   | exhaustive_lines | Simulate all patterns for at most this many lines  | 16u     |
+   | conflict_limit   | Conflict limit of the SAT solver before using BDDs | 10000   |
+   | use_bdd          | Use BDDs, otherwise the SAT solver has no limit    | true    |
+   | use_cache        | Look up and store results in the cache             | true    |
+   | seed             | Seed for random patterns                           | 0u      |
+   |------------------+----------------------------------------------------+---------|
+ *
+ * @statistics
+ *
+   |----------------+-----------------------------------------------------------------|
+   | Statistics     | Description                                                     |
+   |----------------+-----------------------------------------------------------------|
+   | runtime        | Runtime in seconds                                              |
+   | stage          | Deciding stage: cache, lines, simulation, sat, or bdd           |
+   | counterexample | Input pattern with different outputs, if found in this call     |
+   |----------------+-----------------------------------------------------------------|
+ *
+ * Circuits may consist of Toffoli, Fredkin, and Peres gates.
+ */
+bool staged_equivalence_check( const circuit& circ1, const circuit& circ2,
+                               const properties::ptr& settings = properties::ptr(),
+                               const properties::ptr& statistics = properties::ptr() );
+
+/* clears the cache of staged_equivalence_check */
+void clear_staged_equivalence_cache();
+
+}
+
+#endif
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
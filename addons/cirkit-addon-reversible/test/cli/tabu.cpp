@@ -0,0 +1,142 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE tabu
+
+#include <random>
+#include <sstream>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <core/utils/thread_pool.hpp>
+#include <reversible/circuit.hpp>
+#include <reversible/functions/add_gates.hpp>
+#include <reversible/functions/copy_circuit.hpp>
+#include <reversible/io/print_circuit.hpp>
+#include <reversible/verification/staged_equivalence_check.hpp>
+#include <cli/commands/tabu.hpp>
+
+using namespace cirkit;
+
+/* random Toffoli gates with up to two mixed-polarity controls */
+circuit random_circuit( unsigned lines, unsigned gates, unsigned seed )
+{
+  std::mt19937 gen( seed );
+  circuit circ( lines );
+
+  for ( auto i = 0u; i < gates; ++i )
+  {
+    const auto target = gen() % lines;
+    const auto num_controls = gen() % 3u;
+
+    gate::control_container controls;
+    for ( auto l = 0u; l < lines && controls.size() < num_controls; ++l )
+    {
+      if ( l != target && gen() % 2u )
+      {
+        controls.push_back( make_var( l, gen() % 4u != 0u ) );
+      }
+    }
+    append_toffoli( circ, controls, target );
+  }
+
+  return circ;
+}
+
+std::string to_string( const circuit& circ )
+{
+  std::stringstream s;
+  s << circ;
+  return s.str();
+}
+
+BOOST_AUTO_TEST_CASE( incremental_windows_and_cost )
+{
+  for ( auto seed = 0u; seed < 5u; ++seed )
+  {
+    auto circ = random_circuit( 5u, 40u, seed );
+
+    std::vector<rule_window> windows( circ.num_gates() );
+    int cost = circuit_ncv_cost( circ );
+
+    for ( auto step = 0u; step < 60u; ++step )
+    {
+      matrix x, x_scratch;
+      list_rules( circ, windows, x, 0u, circ.num_gates(), nullptr, false );
+
+      /* windows that were not invalidated by the previous rules give the same rules as a full scan */
+      BOOST_REQUIRE_EQUAL( windows.size(), circ.num_gates() );
+      std::vector<rule_window> scratch( circ.num_gates() );
+      list_rules( circ, scratch, x_scratch, 0u, circ.num_gates(), nullptr, false );
+      BOOST_REQUIRE( x == x_scratch );
+
+      if ( x.empty() ) { break; }
+
+      /* vary the applied rules, including the ones that add gates */
+      sortrows( x, 3 );
+      apply_rule_update( circ, x, ( 7u * step + seed ) % x.size(), windows, cost, false );
+      BOOST_REQUIRE_EQUAL( cost, static_cast<int>( circuit_ncv_cost( circ ) ) );
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE( sequential_and_parallel )
+{
+  const auto base = random_circuit( 5u, 60u, 3u );
+
+  thread_pool pool1( 1u ), pool2( 2u );
+
+  for ( auto opt : {0u, 1u} )
+  {
+    const auto cost = [opt]( const circuit& circ ) { return opt == 0u ? circ.num_gates() : circuit_ncv_cost( circ ); };
+
+    circuit seq, par1, par2;
+    copy_circuit( base, seq );
+    copy_circuit( base, par1 );
+    copy_circuit( base, par2 );
+
+    auto statistics = std::make_shared<properties>();
+    tabu_search( seq,  70u, 10u, statistics, opt, nullptr );
+    tabu_search( par1, 70u, 10u, statistics, opt, &pool1 );
+    tabu_search( par2, 70u, 10u, statistics, opt, &pool2 );
+
+    BOOST_CHECK( staged_equivalence_check( base, seq ) );
+    BOOST_CHECK( staged_equivalence_check( base, par1 ) );
+    BOOST_CHECK( cost( seq ) < cost( base ) );
+    BOOST_CHECK( cost( par1 ) <= cost( seq ) );
+
+    /* the result does not depend on the number of threads */
+    BOOST_CHECK_EQUAL( to_string( par1 ), to_string( par2 ) );
+  }
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
@@ -0,0 +1,108 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE bitsliced_simulation
+
+#include <boost/test/unit_test.hpp>
+
+#include <reversible/circuit.hpp>
+#include <reversible/functions/add_gates.hpp>
+#include <reversible/simulation/bitsliced_simulation.hpp>
+#include <reversible/simulation/simple_simulation.hpp>
+
+using namespace cirkit;
+
+circuit make_test_circuit( unsigned n )
+{
+  circuit circ( n );
+
+  for ( auto i = 0u; i < 3u * n; ++i )
+  {
+    const auto t = i % n;
+    const auto c1 = ( i + 1u ) % n;
+    const auto c2 = ( i + 3u ) % n;
+
+    append_toffoli( circ, {make_var( c1, i % 2u == 0u ), make_var( c2 )}, t );
+    append_fredkin( circ, {make_var( c2 )}, t, c1 );
+    append_peres( circ, make_var( c2 ), t, c1 );
+    append_stg( circ, boost::dynamic_bitset<>( 4u, 6u ), {make_var( c1 ), make_var( c2 )}, t );
+  }
+
+  return circ;
+}
+
+BOOST_AUTO_TEST_CASE(truth_table)
+{
+  for ( auto n : {4u, 7u} )
+  {
+    const auto circ = make_test_circuit( n );
+
+    std::vector<boost::dynamic_bitset<>> table;
+    BOOST_REQUIRE( bitsliced_truth_table( table, circ ) );
+    BOOST_REQUIRE( table.size() == n );
+
+    for ( auto p = 0u; p < ( 1u << n ); ++p )
+    {
+      boost::dynamic_bitset<> output;
+      simple_simulation( output, circ, boost::dynamic_bitset<>( n, p ) );
+
+      for ( auto i = 0u; i < n; ++i )
+      {
+        BOOST_CHECK( table[i][p] == output[i] );
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(patterns)
+{
+  const auto circ = make_test_circuit( 9u );
+
+  std::vector<boost::dynamic_bitset<>> inputs, outputs;
+  for ( auto p = 0u; p < 300u; ++p )
+  {
+    inputs.emplace_back( 9u, ( p * 37u ) % 512u );
+  }
+
+  properties::ptr settings( new properties );
+  settings->set( "block_size", 1u );
+  settings->set( "num_threads", 2u );
+  BOOST_REQUIRE( bitsliced_simulation( outputs, circ, inputs, settings ) );
+
+  for ( auto p = 0u; p < inputs.size(); ++p )
+  {
+    boost::dynamic_bitset<> output;
+    simple_simulation( output, circ, inputs[p] );
+    BOOST_CHECK( outputs[p] == output );
+  }
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
@@ -71,6 +71,33 @@ BOOST_AUTO_TEST_CASE(simple)
   BOOST_CHECK( i == 4u );
 }
 
+BOOST_AUTO_TEST_CASE(gate_storage)
+{
+  using namespace cirkit;
+
+  circuit circ( 3u );
+  for ( auto i = 0u; i < 100u; ++i )
+  {
+    append_cnot( circ, i % 2u, 2u );
+  }
+  circ.annotate( circ[5u], "key", "value" );
+
+  /* references stay valid when gates are inserted or removed */
+  const gate* g = &circ[10u];
+  insert_not( circ, 0u, 1u );
+  circ.remove_gate_at( 3u );
+  BOOST_CHECK( g == &circ[10u] );
+  BOOST_CHECK( circ.num_gates() == 100u );
+
+  /* copies are deep and keep annotations */
+  circuit copy = circ;
+  BOOST_CHECK( &copy[0u] != &circ[0u] );
+  BOOST_CHECK( copy.annotation( copy[5u], "key" ) == "value" );
+  copy[0u].add_control( make_var( 2u ) );
+  BOOST_CHECK( circ[0u].controls().empty() );
+  BOOST_CHECK( is_toffoli( copy[0u] ) && copy[0u].controls().size() == 1u );
+}
+
 // Local Variables:
 // c-basic-offset: 2
 // eval: (c-set-offset 'substatement-open 0)
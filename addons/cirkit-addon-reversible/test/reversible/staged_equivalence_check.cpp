@@ -0,0 +1,125 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE staged_equivalence_check
+
+#include <boost/test/unit_test.hpp>
+
+#include <reversible/circuit.hpp>
+#include <reversible/functions/add_gates.hpp>
+#include <reversible/functions/is_identity.hpp>
+#include <reversible/simulation/simple_simulation.hpp>
+#include <reversible/verification/staged_equivalence_check.hpp>
+
+using namespace cirkit;
+
+/* Fredkin gates and their decomposition into three Toffoli gates */
+void make_test_circuits( unsigned n, circuit& fredkins, circuit& toffolis )
+{
+  fredkins = circuit( n );
+  toffolis = circuit( n );
+
+  for ( auto i = 0u; i < 2u * n; ++i )
+  {
+    const auto c = i % n;
+    const auto t1 = ( i + 1u ) % n;
+    const auto t2 = ( i + 2u ) % n;
+
+    append_fredkin( fredkins, {make_var( c )}, t1, t2 );
+
+    append_cnot( toffolis, t2, t1 );
+    append_toffoli( toffolis, {make_var( c ), make_var( t1 )}, t2 );
+    append_cnot( toffolis, t2, t1 );
+  }
+}
+
+BOOST_AUTO_TEST_CASE(equivalent)
+{
+  for ( auto n : {5u, 24u} )
+  {
+    circuit fredkins, toffolis;
+    make_test_circuits( n, fredkins, toffolis );
+
+    properties::ptr settings( new properties );
+    settings->set( "use_cache", false );
+    properties::ptr statistics( new properties );
+
+    BOOST_CHECK( staged_equivalence_check( fredkins, fredkins, settings, statistics ) );
+    BOOST_CHECK( staged_equivalence_check( fredkins, toffolis, settings, statistics ) );
+    BOOST_CHECK( statistics->get<std::string>( "stage" ) == ( n <= 16u ? "simulation" : "sat" ) );
+  }
+}
+
+BOOST_AUTO_TEST_CASE(not_equivalent)
+{
+  for ( auto n : {5u, 24u} )
+  {
+    circuit fredkins, toffolis;
+    make_test_circuits( n, fredkins, toffolis );
+    append_toffoli( toffolis, {make_var( 0u ), make_var( 1u ), make_var( 2u ), make_var( 3u )}, 4u );
+
+    properties::ptr settings( new properties );
+    settings->set( "use_cache", false );
+    settings->set( "sim_patterns", n <= 16u ? 4096u : 1u );
+    properties::ptr statistics( new properties );
+
+    BOOST_CHECK( !staged_equivalence_check( fredkins, toffolis, settings, statistics ) );
+
+    const auto cex = statistics->get<boost::dynamic_bitset<>>( "counterexample" );
+    boost::dynamic_bitset<> output1, output2;
+    simple_simulation( output1, fredkins, cex );
+    simple_simulation( output2, toffolis, cex );
+    BOOST_CHECK( output1 != output2 );
+  }
+}
+
+BOOST_AUTO_TEST_CASE(identity_and_cache)
+{
+  clear_staged_equivalence_cache();
+
+  circuit circ( 20u );
+  append_toffoli( circ, {make_var( 0u ), make_var( 7u, false )}, 19u );
+  append_cnot( circ, 3u, 4u );
+  append_cnot( circ, 3u, 4u );
+  append_toffoli( circ, {make_var( 0u ), make_var( 7u, false )}, 19u );
+
+  properties::ptr statistics( new properties );
+  BOOST_CHECK( is_identity( circ, properties::ptr(), statistics ) );
+  BOOST_CHECK( statistics->get<std::string>( "stage" ) == "sat" );
+  BOOST_CHECK( is_identity( circ, properties::ptr(), statistics ) );
+  BOOST_CHECK( statistics->get<std::string>( "stage" ) == "cache" );
+
+  append_not( circ, 5u );
+  BOOST_CHECK( !is_identity( circ, properties::ptr(), statistics ) );
+  BOOST_CHECK( statistics->get<std::string>( "stage" ) == "simulation" );
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
@@ -0,0 +1,117 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+/**
+ * @author Mathias Soeken
+ */
+
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include <boost/format.hpp>
+
+#include <core/utils/microbenchmark.hpp>
+#include <core/utils/program_options.hpp>
+
+using namespace cirkit;
+
+int main( int argc, char ** argv )
+{
+  using boost::program_options::value;
+
+  benchmark_options options;
+  std::string json;
+
+  program_options opts;
+  opts.add_options()
+    ( "filter,f",      value( &options.filter ),                                 "Runs only benchmarks whose name contains this string" )
+    ( "min_time,t",    value_with_default( &options.min_time ),                  "Minimum run-time per benchmark in seconds" )
+    ( "repetitions,r", value_with_default( &options.repetitions ),               "Number of repetitions, reports mean and median if larger than 1" )
+    ( "json,j",        value( &json ),                                           "Writes results in Google Benchmark JSON format to this file ('-' for stdout)" )
+    ( "list,l",                                                                  "Lists all benchmarks" )
+    ( "verbose,v",                                                               "Be verbose" )
+    ;
+
+  opts.parse( argc, argv );
+
+  if ( !opts.good() )
+  {
+    std::cout << opts << std::endl;
+    return 1;
+  }
+
+  if ( opts.is_set( "list" ) )
+  {
+    for ( const auto& name : registered_benchmarks() )
+    {
+      std::cout << name << std::endl;
+    }
+    return 0;
+  }
+
+  options.verbose = opts.is_set( "verbose" );
+
+  const auto results = run_benchmarks( options );
+
+  const std::map<std::string, std::string> context = {
+    {"executable",   argv[0]},
+    {"num_cpus",     std::to_string( std::thread::hardware_concurrency() )},
+    {"min_time",     boost::str( boost::format( "%.3f" ) % options.min_time )},
+    {"library_build_type",
+#ifdef NDEBUG
+     "release"
+#else
+     "debug"
+#endif
+    }
+  };
+
+  if ( json == "-" )
+  {
+    write_benchmarks_json( std::cout, results, context );
+  }
+  else
+  {
+    write_benchmarks_table( std::cout, results );
+
+    if ( !json.empty() )
+    {
+      std::ofstream os( json.c_str(), std::ofstream::out );
+      write_benchmarks_json( os, results, context );
+    }
+  }
+
+  return 0;
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
@@ -0,0 +1,519 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+/**
+ * @author Mathias Soeken
+ *
+ * Benchmarks for logic networks, simulation, cut enumeration, NPN
+ * canonization, BDDs, and ESOP minimization.  Inputs are generated with the
+ * same generators as gen_trans_arith and gen_npn_circuit using fixed seeds,
+ * such that runs are comparable across revisions.
+ */
+
+#include <algorithm>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <boost/dynamic_bitset.hpp>
+#include <boost/format.hpp>
+
+#include <core/properties.hpp>
+#include <core/utils/microbenchmark.hpp>
+#include <classical/aig.hpp>
+#include <classical/abc/gia/gia.hpp>
+#include <classical/dd/bdd.hpp>
+#include <classical/functions/aig_to_mig.hpp>
+#include <classical/functions/npn_canonization.hpp>
+#include <classical/functions/simulate_aig_bitparallel.hpp>
+#include <classical/functions/strash.hpp>
+#include <classical/functions/cuts/priority.hpp>
+#include <classical/generators/npn_circuit.hpp>
+#include <classical/generators/transparent_arithmetic.hpp>
+#include <classical/io/read_verilog.hpp>
+#include <classical/mig/mig.hpp>
+#include <classical/mig/mig_strash.hpp>
+#include <classical/optimization/exorcism_minimization.hpp>
+#include <classical/utils/aig_utils.hpp>
+#include <classical/utils/npn_manager.hpp>
+#include <classical/utils/static_truth_table.hpp>
+#include <classical/xmg/xmg.hpp>
+#include <classical/xmg/xmg_aig.hpp>
+#include <classical/xmg/xmg_rewrite.hpp>
+
+using namespace cirkit;
+
+namespace
+{
+
+/******************************************************************************
+ * Inputs                                                                     *
+ ******************************************************************************/
+
+const aig_graph& arithmetic_aig( unsigned bitwidth )
+{
+  static std::map<unsigned, aig_graph> cache;
+
+  auto it = cache.find( bitwidth );
+  if ( it == cache.end() )
+  {
+    auto settings = std::make_shared<properties>();
+    settings->set( "seed", 0xc1c1u + bitwidth );
+    settings->set( "bitwidth", bitwidth );
+
+    std::stringstream s;
+    generate_transparent_arithmetic_circuit( s, settings );
+    it = cache.insert( {bitwidth, read_verilog_string_with_abc( s.str() )} ).first;
+  }
+  return it->second;
+}
+
+const aig_graph& npn_aig( unsigned n )
+{
+  static std::map<unsigned, aig_graph> cache;
+
+  auto it = cache.find( n );
+  if ( it == cache.end() )
+  {
+    std::stringstream s;
+    generate_npn_circuit( s, n );
+    it = cache.insert( {n, read_verilog_string_with_abc( s.str() )} ).first;
+  }
+  return it->second;
+}
+
+const xmg_graph& arithmetic_xmg( unsigned bitwidth )
+{
+  static std::map<unsigned, xmg_graph> cache;
+
+  auto it = cache.find( bitwidth );
+  if ( it == cache.end() )
+  {
+    it = cache.insert( {bitwidth, xmg_from_aig( arithmetic_aig( bitwidth ) )} ).first;
+  }
+  return it->second;
+}
+
+const mig_graph& arithmetic_mig( unsigned bitwidth )
+{
+  static std::map<unsigned, mig_graph> cache;
+
+  auto it = cache.find( bitwidth );
+  if ( it == cache.end() )
+  {
+    it = cache.insert( {bitwidth, aig_to_mig( arithmetic_aig( bitwidth ) )} ).first;
+  }
+  return it->second;
+}
+
+/* array multiplier, constructed through the create functions of each network type */
+template<typename Function, typename Pi, typename And, typename Xor, typename Po>
+void build_multiplier( unsigned n, Pi&& pi, And&& create_and, Xor&& create_xor, Po&& po )
+{
+  std::vector<Function> a, b;
+  for ( auto i = 0u; i < n; ++i ) { a.push_back( pi( boost::str( boost::format( "a%d" ) % i ) ) ); }
+  for ( auto i = 0u; i < n; ++i ) { b.push_back( pi( boost::str( boost::format( "b%d" ) % i ) ) ); }
+
+  /* shift-and-add with ripple carry adders, the carries of a full adder are disjoint */
+  std::vector<Function> sum;
+  for ( auto i = 0u; i < n; ++i ) { sum.push_back( create_and( a[i], b[0u] ) ); }
+
+  for ( auto j = 1u; j < n; ++j )
+  {
+    auto carry = create_and( sum[j], create_and( a[0u], b[j] ) );
+    sum[j] = create_xor( sum[j], create_and( a[0u], b[j] ) );
+
+    for ( auto i = 1u; i < n; ++i )
+    {
+      const auto pp = create_and( a[i], b[j] );
+      if ( i + j < sum.size() )
+      {
+        const auto x = create_xor( sum[i + j], pp );
+        const auto c = create_xor( create_and( sum[i + j], pp ), create_and( x, carry ) );
+        sum[i + j] = create_xor( x, carry );
+        carry = c;
+      }
+      else
+      {
+        sum.push_back( create_xor( pp, carry ) );
+        carry = create_and( pp, carry );
+      }
+    }
+    sum.push_back( carry );
+  }
+
+  for ( auto i = 0u; i < sum.size(); ++i )
+  {
+    po( sum[i], boost::str( boost::format( "p%d" ) % i ) );
+  }
+}
+
+std::vector<tt> random_tts( unsigned num_vars, unsigned count )
+{
+  std::mt19937_64 gen( 0xc1c1u + num_vars );
+  std::vector<tt> tts;
+  for ( auto i = 0u; i < count; ++i )
+  {
+    tt t( 1u << num_vars );
+    for ( auto b = 0u; b < t.size(); b += 64u )
+    {
+      auto w = gen();
+      for ( auto j = b; j < std::min<std::size_t>( b + 64u, t.size() ); ++j, w >>= 1u ) { t[j] = w & 1u; }
+    }
+    tts.push_back( t );
+  }
+  return tts;
+}
+
+template<unsigned NumVars>
+std::vector<static_truth_table<NumVars>> random_static_tts( unsigned count )
+{
+  std::vector<static_truth_table<NumVars>> tts;
+  for ( const auto& t : random_tts( NumVars, count ) )
+  {
+    tts.push_back( static_tt_from_tt<NumVars>( t ) );
+  }
+  return tts;
+}
+
+}
+
+/******************************************************************************
+ * Construction and structural hashing                                        *
+ ******************************************************************************/
+
+CIRKIT_BENCHMARK( aig_construct_multiplier16 )
+{
+  auto size = 0u;
+  while ( state.keep_running() )
+  {
+    aig_graph aig;
+    aig_initialize( aig );
+    build_multiplier<aig_function>( 16u,
+                                    [&aig]( const std::string& name ) { return aig_create_pi( aig, name ); },
+                                    [&aig]( const aig_function& a, const aig_function& b ) { return aig_create_and( aig, a, b ); },
+                                    [&aig]( const aig_function& a, const aig_function& b ) { return aig_create_xor( aig, a, b ); },
+                                    [&aig]( const aig_function& f, const std::string& name ) { aig_create_po( aig, f, name ); } );
+    size = num_vertices( aig );
+    do_not_optimize( aig );
+  }
+  state.set_counter( "nodes", size );
+}
+
+CIRKIT_BENCHMARK( mig_construct_multiplier16 )
+{
+  auto size = 0u;
+  while ( state.keep_running() )
+  {
+    mig_graph mig;
+    mig_initialize( mig );
+    build_multiplier<mig_function>( 16u,
+                                    [&mig]( const std::string& name ) { return mig_create_pi( mig, name ); },
+                                    [&mig]( const mig_function& a, const mig_function& b ) { return mig_create_and( mig, a, b ); },
+                                    [&mig]( const mig_function& a, const mig_function& b ) { return mig_create_xor( mig, a, b ); },
+                                    [&mig]( const mig_function& f, const std::string& name ) { mig_create_po( mig, f, name ); } );
+    size = num_vertices( mig );
+    do_not_optimize( mig );
+  }
+  state.set_counter( "nodes", size );
+}
+
+CIRKIT_BENCHMARK( xmg_construct_multiplier16 )
+{
+  auto size = 0u;
+  while ( state.keep_running() )
+  {
+    xmg_graph xmg;
+    build_multiplier<xmg_function>( 16u,
+                                    [&xmg]( const std::string& name ) { return xmg.create_pi( name ); },
+                                    [&xmg]( const xmg_function& a, const xmg_function& b ) { return xmg.create_and( a, b ); },
+                                    [&xmg]( const xmg_function& a, const xmg_function& b ) { return xmg.create_xor( a, b ); },
+                                    [&xmg]( const xmg_function& f, const std::string& name ) { xmg.create_po( f, name ); } );
+    size = xmg.size();
+    do_not_optimize( xmg );
+  }
+  state.set_counter( "nodes", size );
+}
+
+CIRKIT_BENCHMARK( aig_strash_arith16 )
+{
+  const auto& aig = arithmetic_aig( 16u );
+  while ( state.keep_running() )
+  {
+    const auto result = strash( aig );
+    do_not_optimize( result );
+  }
+  state.set_counter( "nodes", num_vertices( aig ) );
+}
+
+CIRKIT_BENCHMARK( mig_strash_arith16 )
+{
+  const auto& mig = arithmetic_mig( 16u );
+  while ( state.keep_running() )
+  {
+    const auto result = mig_strash( mig );
+    do_not_optimize( result );
+  }
+  state.set_counter( "nodes", num_vertices( mig ) );
+}
+
+CIRKIT_BENCHMARK( xmg_strash_arith16 )
+{
+  const auto& xmg = arithmetic_xmg( 16u );
+  while ( state.keep_running() )
+  {
+    const auto result = xmg_strash( xmg );
+    do_not_optimize( result );
+  }
+  state.set_counter( "nodes", xmg.size() );
+}
+
+/******************************************************************************
+ * Simulation                                                                 *
+ ******************************************************************************/
+
+CIRKIT_BENCHMARK( aig_simulate_arith16_4096 )
+{
+  const auto& aig = arithmetic_aig( 16u );
+  aig_bitparallel_simulator sim( aig );
+  while ( state.keep_running() )
+  {
+    sim.simulate_random( 4096u, 42u );
+    do_not_optimize( sim.words( aig_info( aig ).outputs.front().first.node ) );
+  }
+  state.set_counter( "patterns", 4096u );
+  state.set_label( boost::str( boost::format( "lane_width=%d" ) % aig_bitparallel_simulator::lane_width() ) );
+}
+
+/******************************************************************************
+ * Cut enumeration                                                            *
+ ******************************************************************************/
+
+CIRKIT_BENCHMARK( aig_priority_cuts6_arith16 )
+{
+  const auto& aig = arithmetic_aig( 16u );
+  auto count = 0ul;
+  while ( state.keep_running() )
+  {
+    const auto cuts = compute_priority_cuts<6u>( aig );
+    count = cuts.total_cut_count();
+  }
+  state.set_counter( "cuts", count );
+}
+
+CIRKIT_BENCHMARK( mig_priority_cuts6_arith16 )
+{
+  const auto& mig = arithmetic_mig( 16u );
+  auto count = 0ul;
+  while ( state.keep_running() )
+  {
+    const auto cuts = compute_priority_cuts<6u>( mig );
+    count = cuts.total_cut_count();
+  }
+  state.set_counter( "cuts", count );
+}
+
+CIRKIT_BENCHMARK( xmg_priority_cuts6_arith16 )
+{
+  const auto& xmg = arithmetic_xmg( 16u );
+  auto count = 0ul;
+  while ( state.keep_running() )
+  {
+    const auto cuts = compute_priority_cuts<6u>( xmg );
+    count = cuts.total_cut_count();
+  }
+  state.set_counter( "cuts", count );
+}
+
+/******************************************************************************
+ * NPN canonization                                                           *
+ ******************************************************************************/
+
+CIRKIT_BENCHMARK( npn_exact_static4_1024 )
+{
+  const auto tts = random_static_tts<4>( 1024u );
+  unsigned phase;
+  std::array<unsigned, 4> perm;
+  while ( state.keep_running() )
+  {
+    for ( const auto& t : tts )
+    {
+      do_not_optimize( exact_npn_canonization<4u>( t, phase, perm ) );
+    }
+  }
+  state.set_counter( "functions", tts.size() );
+}
+
+CIRKIT_BENCHMARK( npn_exact_static6_16 )
+{
+  const auto tts = random_static_tts<6>( 16u );
+  unsigned phase;
+  std::array<unsigned, 6> perm;
+  while ( state.keep_running() )
+  {
+    for ( const auto& t : tts )
+    {
+      do_not_optimize( exact_npn_canonization<6u>( t, phase, perm ) );
+    }
+  }
+  state.set_counter( "functions", tts.size() );
+}
+
+CIRKIT_BENCHMARK( npn_flip_swap6_256 )
+{
+  const auto tts = random_tts( 6u, 256u );
+  boost::dynamic_bitset<> phase;
+  std::vector<unsigned> perm;
+  while ( state.keep_running() )
+  {
+    for ( const auto& t : tts )
+    {
+      do_not_optimize( npn_canonization_flip_swap( t, phase, perm ) );
+    }
+  }
+  state.set_counter( "functions", tts.size() );
+}
+
+CIRKIT_BENCHMARK( npn_manager_cached4_4096 )
+{
+  const auto tts = random_tts( 4u, 4096u );
+  npn_manager mgr;
+  boost::dynamic_bitset<> phase;
+  std::vector<unsigned> perm;
+  while ( state.keep_running() )
+  {
+    for ( const auto& t : tts )
+    {
+      do_not_optimize( mgr.compute( t, phase, perm ) );
+    }
+  }
+  state.set_counter( "functions", tts.size() );
+}
+
+CIRKIT_BENCHMARK( npn_circuit6_cuts )
+{
+  const auto& aig = npn_aig( 6u );
+  auto count = 0ul;
+  while ( state.keep_running() )
+  {
+    const auto cuts = compute_priority_cuts<6u>( aig );
+    count = cuts.total_cut_count();
+  }
+  state.set_counter( "cuts", count );
+}
+
+/******************************************************************************
+ * BDDs                                                                       *
+ ******************************************************************************/
+
+/* carry out bit of an n-bit adder with interleaved variable order */
+CIRKIT_BENCHMARK( bdd_adder_carry64 )
+{
+  auto nodes = 0u;
+  while ( state.keep_running() )
+  {
+    bdd_manager mgr( 128u, 20u );
+    auto carry = mgr.bdd_bot();
+    for ( auto i = 0u; i < 64u; ++i )
+    {
+      const auto a = mgr.bdd_var( 2u * i );
+      const auto b = mgr.bdd_var( 2u * i + 1u );
+      carry = ( a && b ) || ( ( a ^ b ) && carry );
+    }
+    nodes = mgr.size();
+    do_not_optimize( carry.index );
+  }
+  state.set_counter( "nodes", nodes );
+}
+
+/* n-queens constraint with a small board */
+CIRKIT_BENCHMARK( bdd_queens6 )
+{
+  const auto n = 6u;
+  auto nodes = 0u;
+  while ( state.keep_running() )
+  {
+    bdd_manager mgr( n * n, 22u );
+    const auto x = [&mgr, n]( unsigned r, unsigned c ) { return mgr.bdd_var( r * n + c ); };
+
+    auto f = mgr.bdd_top();
+    for ( auto r = 0u; r < n; ++r )
+    {
+      auto row = mgr.bdd_bot();
+      for ( auto c = 0u; c < n; ++c ) { row = row || x( r, c ); }
+      f = f && row;
+    }
+
+    for ( auto r = 0u; r < n; ++r )
+    {
+      for ( auto c = 0u; c < n; ++c )
+      {
+        for ( auto r2 = 0u; r2 < n; ++r2 )
+        {
+          for ( auto c2 = 0u; c2 < n; ++c2 )
+          {
+            if ( r * n + c >= r2 * n + c2 ) { continue; }
+            if ( r == r2 || c == c2 || r + c2 == r2 + c || r + c == r2 + c2 )
+            {
+              f = f && !( x( r, c ) && x( r2, c2 ) );
+            }
+          }
+        }
+      }
+    }
+    nodes = mgr.size();
+    do_not_optimize( f.index );
+  }
+  state.set_counter( "nodes", nodes );
+}
+
+/******************************************************************************
+ * ESOP minimization (macrobenchmark)                                         *
+ ******************************************************************************/
+
+CIRKIT_MACROBENCHMARK( exorcism_arith4, 3u )
+{
+  const gia_graph gia( arithmetic_aig( 4u ) );
+  auto settings = std::make_shared<properties>();
+  settings->set( "esopname", std::string( "/tmp/cirkit_bench.esop" ) );
+  auto statistics = std::make_shared<properties>();
+
+  while ( state.keep_running() )
+  {
+    const auto esop = exorcism_minimization( gia, settings, statistics );
+    do_not_optimize( esop );
+  }
+  state.set_counter( "cubes", statistics->get<unsigned>( "cube_count" ) );
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
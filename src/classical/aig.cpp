@@ -281,13 +281,12 @@ aig_function aig_create_and( aig_graph& aig, const aig_function& left, const aig
 
   /* structural hashing */
   const bool in_order = left.node < right.node;
-  const auto key = std::make_pair( in_order ? left : right, in_order ? right : left );
+  const strash_table<2u>::key_t key = {{strash_literal( in_order ? left : right ), strash_literal( in_order ? right : left )}};
   if ( info.enable_strashing )
   {
-    const auto it = info.strash.find( key );
-    if ( it != info.strash.end() )
+    if ( const auto* n = info.strash.find( key ) )
     {
-      return it->second;
+      return { *n, false };
     }
   }
 
@@ -303,12 +302,10 @@ aig_function aig_create_and( aig_graph& aig, const aig_function& left, const aig
 
   if ( info.enable_strashing )
   {
-    return info.strash[key] = { node, false };
-  }
-  else
-  {
-    return { node, false };
+    info.strash.insert( key, node );
   }
+
+  return { node, false };
 }
 
 aig_function aig_create_nand( aig_graph& aig, const aig_function& left, const aig_function& right )
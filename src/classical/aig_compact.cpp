@@ -0,0 +1,453 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "aig_compact.hpp"
+
+#include <boost/graph/topological_sort.hpp>
+#include <boost/range/iterator_range.hpp>
+
+#include <classical/utils/aig_utils.hpp>
+
+namespace cirkit
+{
+
+/******************************************************************************
+ * Types                                                                      *
+ ******************************************************************************/
+
+constexpr aig_compact::literal_t aig_compact::no_fanin;
+
+/******************************************************************************
+ * Private functions                                                          *
+ ******************************************************************************/
+
+/******************************************************************************
+ * aig_compact_names                                                          *
+ ******************************************************************************/
+
+bool aig_compact_names::has_name( std::uint32_t n ) const
+{
+  return node_names.find( n ) != node_names.end();
+}
+
+const std::string& aig_compact_names::name( std::uint32_t n ) const
+{
+  static const std::string empty;
+
+  const auto it = node_names.find( n );
+  return it == node_names.end() ? empty : it->second;
+}
+
+/* hash table entries are counted with their payload, a next pointer and a
+   bucket pointer; strings with their heap buffer if they do not fit inline */
+std::size_t aig_compact_names::memory() const
+{
+  const auto string_memory = []( const std::string& str ) {
+    return str.capacity() > std::string().capacity() ? str.capacity() + 1u : 0u;
+  };
+  const auto entry_overhead = 2u * sizeof( void* );
+
+  auto bytes = string_memory( model_name );
+  bytes += node_names.bucket_count() * sizeof( void* );
+  for ( const auto& p : node_names )
+  {
+    bytes += sizeof( p ) + entry_overhead + string_memory( p.second );
+  }
+  bytes += output_names.capacity() * sizeof( std::string );
+  for ( const auto& n : output_names )
+  {
+    bytes += string_memory( n );
+  }
+  bytes += annotations.bucket_count() * sizeof( void* );
+  for ( const auto& p : annotations )
+  {
+    bytes += sizeof( p ) + entry_overhead;
+    for ( const auto& kv : p.second )
+    {
+      /* red-black tree node: three pointers and the color */
+      bytes += sizeof( kv ) + 4u * sizeof( void* ) + string_memory( kv.first ) + string_memory( kv.second );
+    }
+  }
+  return bytes;
+}
+
+/******************************************************************************
+ * aig_compact                                                                *
+ ******************************************************************************/
+
+aig_compact::aig_compact( const std::string& model_name )
+{
+  _names.model_name = model_name;
+
+  /* constant node */
+  add_node( no_fanin, no_fanin );
+}
+
+void aig_compact::reserve( std::size_t num_nodes )
+{
+  _fanins.reserve( num_nodes << 1u );
+  if ( _enable_strashing )
+  {
+    _strash.reserve( num_nodes );
+  }
+}
+
+aig_function aig_compact::get_constant( bool value )
+{
+  _constant_used = true;
+  return {0u, value};
+}
+
+aig_function aig_compact::create_pi( const std::string& name )
+{
+  const auto n = add_node( no_fanin, no_fanin );
+  _inputs.push_back( n );
+  _names.node_names[n] = name;
+  return {n, false};
+}
+
+void aig_compact::create_po( const aig_function& f, const std::string& name )
+{
+  _outputs.push_back( to_literal( f ) );
+  _names.output_names.push_back( name );
+}
+
+aig_function aig_compact::create_ci( const std::string& name )
+{
+  const auto n = add_node( no_fanin, no_fanin );
+  _cis.push_back( n );
+  _names.node_names[n] = name;
+  return {n, false};
+}
+
+void aig_compact::create_co( const aig_function& f )
+{
+  if ( f.node == 0u )
+  {
+    _constant_used = true;
+  }
+  _cos.push_back( to_literal( f ) );
+}
+
+aig_function aig_compact::create_and( const aig_function& a, const aig_function& b )
+{
+  /* constants */
+  if ( _enable_local_optimization )
+  {
+    if ( a.node == 0u )
+    {
+      if ( !a.complemented ) { return get_constant( false ); }
+      else                   { return b; }
+    }
+    if ( b.node == 0u )
+    {
+      if ( !b.complemented ) { return get_constant( false ); }
+      else                   { return a; }
+    }
+    if ( a == b ) { return a; }
+    if ( a.node == b.node && a.complemented != b.complemented ) { return get_constant( false ); }
+  }
+
+  /* structural hashing */
+  auto l0 = to_literal( a );
+  auto l1 = to_literal( b );
+  if ( l0 > l1 )
+  {
+    std::swap( l0, l1 );
+  }
+
+  if ( _enable_strashing )
+  {
+    if ( const auto* n = _strash.find( {{l0, l1}} ) )
+    {
+      return {*n, false};
+    }
+  }
+
+  const auto n = add_node( l0, l1 );
+  ++_num_ands;
+
+  if ( _enable_strashing )
+  {
+    _strash.insert( {{l0, l1}}, n );
+  }
+
+  return {n, false};
+}
+
+aig_function aig_compact::create_lat( const aig_function& in, const std::string& name )
+{
+  const auto l = to_literal( in );
+
+  const auto it = _latch.find( l );
+  if ( it != _latch.end() )
+  {
+    return {it->second, false};
+  }
+
+  const auto n = create_ci( name ).node;
+  create_co( in );
+
+  _latch.emplace( l, n );
+  return {n, false};
+}
+
+std::size_t aig_compact::memory() const
+{
+  return _fanins.capacity() * sizeof( literal_t )
+    + ( _inputs.capacity() + _cis.capacity() ) * sizeof( node_t )
+    + ( _outputs.capacity() + _cos.capacity() ) * sizeof( literal_t )
+    + _strash.memory()
+    + _latch.bucket_count() * sizeof( void* ) + _latch.size() * ( sizeof( std::pair<const literal_t, node_t> ) + 2u * sizeof( void* ) )
+    + _names.memory();
+}
+
+aig_compact::node_t aig_compact::add_node( literal_t l0, literal_t l1 )
+{
+  const auto n = static_cast<node_t>( size() );
+  _fanins.push_back( l0 );
+  _fanins.push_back( l1 );
+  return n;
+}
+
+/******************************************************************************
+ * Public functions                                                           *
+ ******************************************************************************/
+
+void aig_initialize( aig_compact& aig, const std::string& model_name )
+{
+  assert( aig.size() == 1u );
+  aig.set_model_name( model_name );
+}
+
+aig_function aig_get_constant( aig_compact& aig, bool value )
+{
+  return aig.get_constant( value );
+}
+
+bool aig_is_constant_used( const aig_compact& aig )
+{
+  return aig.is_constant_used();
+}
+
+aig_function aig_create_pi( aig_compact& aig, const std::string& name )
+{
+  return aig.create_pi( name );
+}
+
+void aig_create_po( aig_compact& aig, const aig_function& f, const std::string& name )
+{
+  aig.create_po( f, name );
+}
+
+aig_function aig_create_ci( aig_compact& aig, const std::string& name )
+{
+  return aig.create_ci( name );
+}
+
+void aig_create_co( aig_compact& aig, const aig_function& f )
+{
+  aig.create_co( f );
+}
+
+aig_function aig_create_and( aig_compact& aig, const aig_function& left, const aig_function& right )
+{
+  return aig.create_and( left, right );
+}
+
+aig_function aig_create_nand( aig_compact& aig, const aig_function& left, const aig_function& right )
+{
+  return !aig.create_and( left, right );
+}
+
+aig_function aig_create_or( aig_compact& aig, const aig_function& left, const aig_function& right )
+{
+  return !aig.create_and( !left, !right );
+}
+
+aig_function aig_create_nor( aig_compact& aig, const aig_function& left, const aig_function& right )
+{
+  return aig.create_and( !left, !right );
+}
+
+aig_function aig_create_xor( aig_compact& aig, const aig_function& left, const aig_function& right )
+{
+  return aig_create_or( aig, aig.create_and( !left, right ), aig.create_and( left, !right ) );
+}
+
+aig_function aig_create_ite( aig_compact& aig, const aig_function& cond, const aig_function& t, const aig_function& e )
+{
+  return aig_create_or( aig, aig.create_and( cond, t ), aig.create_and( !cond, e ) );
+}
+
+aig_function aig_create_implies( aig_compact& aig, const aig_function& a, const aig_function& b )
+{
+  return aig_create_or( aig, !a, b );
+}
+
+aig_function aig_create_maj( aig_compact& aig, const aig_function& a, const aig_function& b, const aig_function& c )
+{
+  return aig_create_or( aig, aig_create_or( aig, aig.create_and( a, b ), aig.create_and( a, c ) ), aig.create_and( b, c ) );
+}
+
+aig_function aig_create_lat( aig_compact& aig, const aig_function& in, const std::string& name )
+{
+  return aig.create_lat( in, name );
+}
+
+aig_function aig_create_nary_and( aig_compact& aig, const std::vector< aig_function >& v )
+{
+  assert( !v.empty() );
+
+  auto result = v.front();
+  for ( auto u = 1u; u < v.size(); ++u )
+  {
+    result = aig.create_and( result, v[u] );
+  }
+  return result;
+}
+
+aig_function aig_create_nary_nand( aig_compact& aig, const std::vector< aig_function >& v )
+{
+  return !aig_create_nary_and( aig, v );
+}
+
+aig_function aig_create_nary_or( aig_compact& aig, const std::vector< aig_function >& v )
+{
+  assert( !v.empty() );
+
+  auto result = v.front();
+  for ( auto u = 1u; u < v.size(); ++u )
+  {
+    result = aig_create_or( aig, result, v[u] );
+  }
+  return result;
+}
+
+aig_function aig_create_nary_nor( aig_compact& aig, const std::vector< aig_function >& v )
+{
+  return !aig_create_nary_or( aig, v );
+}
+
+aig_function aig_create_nary_xor( aig_compact& aig, const std::vector< aig_function >& v )
+{
+  assert( !v.empty() );
+
+  auto result = v.front();
+  for ( auto u = 1u; u < v.size(); ++u )
+  {
+    result = aig_create_xor( aig, result, v[u] );
+  }
+  return result;
+}
+
+unsigned aig_to_literal( const aig_compact& aig, const aig_function& f )
+{
+  return aig_compact::to_literal( f );
+}
+
+aig_compact aig_to_compact( const aig_graph& aig )
+{
+  const auto& info = aig_info( aig );
+  const auto& complementmap = boost::get( boost::edge_complement, aig );
+  const auto& annotationmap = boost::get( boost::vertex_annotation, aig );
+
+  aig_compact compact( info.model_name );
+  compact.set_structural_hashing( info.enable_strashing );
+  compact.set_local_optimization( false );
+  compact.reserve( num_vertices( aig ) );
+
+  std::vector<aig_compact::node_t> node_map( num_vertices( aig ), 0u );
+
+  const auto copy_node_info = [&]( aig_node n ) {
+    if ( !annotationmap[n].empty() )
+    {
+      compact.names().annotations[node_map[n]] = annotationmap[n];
+    }
+  };
+
+  for ( const auto& input : info.inputs )
+  {
+    const auto it = info.node_names.find( input );
+    node_map[input] = compact.create_pi( it == info.node_names.end() ? std::string() : it->second ).node;
+    copy_node_info( input );
+  }
+  for ( const auto& ci : info.cis )
+  {
+    const auto it = info.node_names.find( ci );
+    node_map[ci] = compact.create_ci( it == info.node_names.end() ? std::string() : it->second ).node;
+    copy_node_info( ci );
+  }
+
+  /* children come first in the topological sort of the edge direction parent -> child */
+  std::vector<aig_node> topsort;
+  topsort.reserve( num_vertices( aig ) );
+  boost::topological_sort( aig, std::back_inserter( topsort ) );
+
+  for ( const auto& n : topsort )
+  {
+    if ( out_degree( n, aig ) == 0u ) { continue; }
+
+    std::vector<aig_function> children;
+    for ( const auto& e : boost::make_iterator_range( out_edges( n, aig ) ) )
+    {
+      children.push_back( {node_map[target( e, aig )], complementmap[e]} );
+    }
+    assert( children.size() == 2u );
+
+    node_map[n] = compact.create_and( children[0u], children[1u] ).node;
+    copy_node_info( n );
+  }
+
+  const auto map_function = [&node_map]( const aig_function& f ) -> aig_function {
+    return {node_map[f.node], f.complemented};
+  };
+
+  for ( const auto& co : info.cos )
+  {
+    compact.create_co( map_function( co ) );
+  }
+  for ( const auto& output : info.outputs )
+  {
+    compact.create_po( map_function( output.first ), output.second );
+  }
+  if ( info.constant_used )
+  {
+    compact.get_constant( false );
+  }
+
+  compact.set_local_optimization( info.enable_local_optimization );
+
+  return compact;
+}
+
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
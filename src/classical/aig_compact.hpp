@@ -0,0 +1,221 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * @file aig_compact.hpp
+ *
+ * @brief Compact array-based AIG package
+ *
+ * Nodes are stored as pairs of 32-bit literals in one contiguous
+ * vector.  The constant node has index 0, combinational inputs have
+ * no fanins, and AND gates are always created after their children,
+ * i.e., node indexes are a topological order.  Names and annotations
+ * are kept in a side table such that the structure itself only costs
+ * 8 bytes per node.
+ *
+ * The free functions mirror the aig_create_* API of aig.hpp and
+ * return aig_function handles whose node is the index in the compact
+ * store.
+ *
+ * @author Mathias Soeken
+ * @since  2.3
+ */
+
+#ifndef AIG_COMPACT_HPP
+#define AIG_COMPACT_HPP
+
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <core/utils/strash_table.hpp>
+#include <classical/aig.hpp>
+
+namespace cirkit
+{
+
+/******************************************************************************
+ * Side table for names and annotations                                       *
+ ******************************************************************************/
+
+struct aig_compact_names
+{
+  std::string                                                       model_name;
+  std::unordered_map<std::uint32_t, std::string>                    node_names;
+  std::vector<std::string>                                          output_names;
+  std::unordered_map<std::uint32_t, std::map<std::string, std::string>> annotations;
+
+  bool has_name( std::uint32_t n ) const;
+  const std::string& name( std::uint32_t n ) const;
+
+  /* approximate number of bytes used by the tables */
+  std::size_t memory() const;
+};
+
+/******************************************************************************
+ * Compact AIG                                                                *
+ ******************************************************************************/
+
+class aig_compact
+{
+public:
+  using node_t    = std::uint32_t;
+  using literal_t = std::uint32_t;
+
+  /* fanin marker for the constant and combinational inputs */
+  static constexpr literal_t no_fanin = 0xffffffffu;
+
+public:
+  aig_compact( const std::string& model_name = std::string() );
+
+  void reserve( std::size_t num_nodes );
+
+  /* construction */
+  aig_function get_constant( bool value );
+  aig_function create_pi( const std::string& name );
+  void create_po( const aig_function& f, const std::string& name );
+  aig_function create_ci( const std::string& name );
+  void create_co( const aig_function& f );
+  aig_function create_and( const aig_function& a, const aig_function& b );
+  aig_function create_lat( const aig_function& in, const std::string& name );
+
+  /* structure */
+  inline std::size_t size() const                     { return _fanins.size() >> 1u; }
+  inline unsigned num_ands() const                    { return _num_ands; }
+  inline bool is_constant( node_t n ) const           { return n == 0u; }
+  inline bool is_ci( node_t n ) const                 { return n != 0u && _fanins[n << 1u] == no_fanin; }
+  inline bool is_and( node_t n ) const                { return _fanins[n << 1u] != no_fanin; }
+  inline literal_t fanin_literal( node_t n, unsigned i ) const { return _fanins[( n << 1u ) + i]; }
+  inline aig_function fanin( node_t n, unsigned i ) const
+  {
+    const auto l = fanin_literal( n, i );
+    return {l >> 1u, ( l & 1u ) == 1u};
+  }
+  inline const std::vector<literal_t>& fanins() const { return _fanins; }
+
+  inline const std::vector<node_t>& inputs() const     { return _inputs; }
+  inline const std::vector<literal_t>& outputs() const { return _outputs; }
+  inline const std::vector<node_t>& cis() const        { return _cis; }
+  inline const std::vector<literal_t>& cos() const     { return _cos; }
+  inline aig_function output( unsigned i ) const       { return {_outputs[i] >> 1u, ( _outputs[i] & 1u ) == 1u}; }
+  inline bool is_constant_used() const                 { return _constant_used; }
+
+  /* side table */
+  inline const aig_compact_names& names() const        { return _names; }
+  inline aig_compact_names& names()                    { return _names; }
+  inline const std::string& model_name() const         { return _names.model_name; }
+  inline void set_model_name( const std::string& name ) { _names.model_name = name; }
+
+  /* settings */
+  inline void set_structural_hashing( bool enabled )   { _enable_strashing = enabled; }
+  inline bool has_structural_hashing() const           { return _enable_strashing; }
+  inline void set_local_optimization( bool enabled )   { _enable_local_optimization = enabled; }
+  inline bool has_local_optimization() const           { return _enable_local_optimization; }
+
+  /* approximate number of bytes used by structure, strash table, latch map and name side table */
+  std::size_t memory() const;
+  inline const strash_table<2u>& strash() const       { return _strash; }
+  inline strash_table<2u>& strash()                   { return _strash; }
+
+  static inline literal_t to_literal( const aig_function& f )
+  {
+    return ( static_cast<literal_t>( f.node ) << 1u ) | ( f.complemented ? 1u : 0u );
+  }
+
+private:
+  node_t add_node( literal_t l0, literal_t l1 );
+
+private:
+  std::vector<literal_t>                    _fanins;
+  std::vector<node_t>                       _inputs;
+  std::vector<literal_t>                    _outputs;
+  std::vector<node_t>                       _cis;
+  std::vector<literal_t>                    _cos;
+
+  strash_table<2u>                          _strash;
+  std::unordered_map<literal_t, node_t>     _latch;
+
+  aig_compact_names                         _names;
+
+  unsigned                                  _num_ands = 0u;
+  bool                                      _constant_used = false;
+  bool                                      _enable_strashing = true;
+  bool                                      _enable_local_optimization = true;
+};
+
+/******************************************************************************
+ * aig_create_* API                                                           *
+ ******************************************************************************/
+
+void aig_initialize( aig_compact& aig, const std::string& model_name = std::string() );
+aig_function aig_get_constant( aig_compact& aig, bool value );
+bool aig_is_constant_used( const aig_compact& aig );
+aig_function aig_create_pi( aig_compact& aig, const std::string& name );
+void aig_create_po( aig_compact& aig, const aig_function& f, const std::string& name );
+aig_function aig_create_ci( aig_compact& aig, const std::string& name );
+void aig_create_co( aig_compact& aig, const aig_function& f );
+aig_function aig_create_and( aig_compact& aig, const aig_function& left, const aig_function& right );
+aig_function aig_create_nand( aig_compact& aig, const aig_function& left, const aig_function& right );
+aig_function aig_create_or( aig_compact& aig, const aig_function& left, const aig_function& right );
+aig_function aig_create_nor( aig_compact& aig, const aig_function& left, const aig_function& right );
+aig_function aig_create_xor( aig_compact& aig, const aig_function& left, const aig_function& right );
+aig_function aig_create_ite( aig_compact& aig, const aig_function& cond, const aig_function& t, const aig_function& e );
+aig_function aig_create_implies( aig_compact& aig, const aig_function& a, const aig_function& b );
+aig_function aig_create_maj( aig_compact& aig, const aig_function& a, const aig_function& b, const aig_function& c );
+aig_function aig_create_lat( aig_compact& aig, const aig_function& in, const std::string& name );
+
+aig_function aig_create_nary_and( aig_compact& aig, const std::vector< aig_function >& v );
+aig_function aig_create_nary_nand( aig_compact& aig, const std::vector< aig_function >& v );
+aig_function aig_create_nary_or( aig_compact& aig, const std::vector< aig_function >& v );
+aig_function aig_create_nary_nor( aig_compact& aig, const std::vector< aig_function >& v );
+aig_function aig_create_nary_xor( aig_compact& aig, const std::vector< aig_function >& v );
+
+unsigned aig_to_literal( const aig_compact& aig, const aig_function& f );
+
+/******************************************************************************
+ * Conversion                                                                 *
+ ******************************************************************************/
+
+/**
+ * @brief Copies an aig_graph into the compact store
+ *
+ * Primary inputs and latch outputs are created first (in the order of
+ * `inputs' and `cis'), followed by all AND gates in topological order.
+ */
+aig_compact aig_to_compact( const aig_graph& aig );
+
+}
+
+#endif
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
@@ -62,6 +62,30 @@ inline void assert_valid( const std::vector<bdd>& f, const std::vector<bdd>& fha
   assert( !f.empty() );
 }
 
+/* pairwise disjunction, balanced such that the operations at each round are
+   independent and large enough to fork in parallel apply mode */
+bdd balanced_or( std::vector<bdd> fs )
+{
+  while ( fs.size() > 1u )
+  {
+    std::vector<bdd> next;
+    next.reserve( ( fs.size() + 1u ) >> 1u );
+    for ( auto i = 0u; i + 1u < fs.size(); i += 2u )
+    {
+      next.push_back( fs[i] || fs[i + 1u] );
+    }
+    if ( fs.size() & 1u ) { next.push_back( fs.back() ); }
+    fs.swap( next );
+  }
+  return fs.front();
+}
+
+/* managers for characteristic functions follow the parallel mode of the circuit's manager */
+inline void inherit_parallel_apply( const bdd_manager& from, bdd_manager& to )
+{
+  if ( from.parallel_apply() ) { to.set_parallel_apply( true ); }
+}
+
 std::vector<bdd> compute_diff( const std::vector<bdd>& f, const std::vector<bdd>& fhat, bool print_truthtables = false )
 {
   assert_valid( f, fhat );
@@ -139,6 +163,7 @@ boost::multiprecision::uint256_t get_max_value( const std::vector<bdd>& f )
 boost::multiprecision::uint256_t get_max_value_with_chi( const std::vector<bdd>& f )
 {
   bdd_manager mgr_chi( f.front().manager->num_vars() + f.size(), 10u ); /* can we approximate the number of used nodes? */
+  inherit_parallel_apply( *f.front().manager, mgr_chi );
 
   auto fr  = f; boost::reverse( fr );
   auto chi = characteristic_function( fr, mgr_chi );
@@ -165,6 +190,7 @@ boost::multiprecision::uint256_t get_weighted_sum( const std::vector<bdd>& f )
 {
   auto level = f.size();
   bdd_manager mgr_chi( f.front().manager->num_vars() + level, 10u ); /* can we approximate the number of used nodes? */
+  inherit_parallel_apply( *f.front().manager, mgr_chi );
 
   auto fr = f; boost::reverse( fr );
   auto chi = characteristic_function( fr, mgr_chi );
@@ -206,14 +232,14 @@ boost::multiprecision::uint256_t error_rate( const std::vector<bdd>& f, const st
 
   assert_valid( f, fhat );
 
-  auto h = f.front().manager->bdd_bot();
-
+  std::vector<bdd> diffs;
+  diffs.reserve( f.size() );
   for ( auto i = 0u; i < f.size(); ++i )
   {
-    h = h || ( f[i] ^ fhat[i] );
+    diffs.push_back( f[i] ^ fhat[i] );
   }
 
-  return count_solutions( h );
+  return count_solutions( balanced_or( diffs ) );
 }
 
 boost::multiprecision::uint256_t worst_case( const std::vector<bdd>& f, const std::vector<bdd>& fhat,
@@ -60,7 +60,10 @@ enum class bdd_operation {
  ******************************************************************************/
 
 bdd_manager::bdd_manager( unsigned nvars, unsigned log_max_objs, bool verbose )
-  : dd_manager( nvars, log_max_objs, verbose ) {}
+  : dd_manager( nvars, log_max_objs, verbose )
+{
+  complement_edges = true;
+}
 
 bdd_manager::~bdd_manager() {}
 
@@ -72,141 +75,86 @@ unsigned bdd_manager::bdd_and( unsigned f, unsigned g )
   if ( f == 1u ) { return g; }
   if ( g == 1u ) { return f; }
   if ( f == g )  { return f; }
+  if ( f == ( g ^ 1u ) ) { return 0u; }
 
   /* commutativity */
   if ( f > g ) { return bdd_and( g, f ); }
 
-  const auto r = cache.lookup( f, g, (unsigned)bdd_operation::_and );
-  if ( r >= 0 ) { return r; }
+  unsigned r;
+  if ( cache.lookup( f, g, (unsigned)bdd_operation::_and, r ) ) { return r; }
 
-  const auto& node1 = nodes.at( f );
-  const auto& node2 = nodes.at( g );
-  unsigned rlow, rhigh;
-  if ( node1.var < node2.var )
-  {
-    rlow = bdd_and( node1.low, g );
-    rhigh = bdd_and( node1.high, g );
-  }
-  else if ( node1.var > node2.var )
-  {
-    rlow = bdd_and( f, node2.low );
-    rhigh = bdd_and( f, node2.high );
-  }
-  else
-  {
-    rlow = bdd_and( node1.low, node2.low );
-    rhigh = bdd_and( node1.high, node2.high );
-  }
+  const auto v = std::min( top_level( f ), top_level( g ) );
+  unsigned f1, f0, g1, g0;
+  cofactors( f, v, f1, f0 );
+  cofactors( g, v, g1, g0 );
 
-  auto idx = unique_create( std::min( node1.var, node2.var ), rhigh, rlow );
+  const auto rlow  = bdd_and( f0, g0 );
+  const auto rhigh = bdd_and( f1, g1 );
+
+  auto idx = unique_create( v, rhigh, rlow );
   return cache.insert( f, g, (unsigned)bdd_operation::_and, idx );
 }
 
 unsigned bdd_manager::bdd_or( unsigned f, unsigned g )
 {
-  /* terminating cases */
-  if ( f == 0u ) { return g; }
-  if ( g == 0u ) { return f; }
-  if ( f == 1u ) { return 1u; }
-  if ( g == 1u ) { return 1u; }
-  if ( f == g )  { return f; }
-
-  /* commutativity */
-  if ( f > g ) { return bdd_or( g, f ); }
-
-  const auto r = cache.lookup( f, g, (unsigned)bdd_operation::_or );
-  if ( r >= 0 ) { return r; }
-
-  const auto& node1 = nodes.at( f );
-  const auto& node2 = nodes.at( g );
-  unsigned rlow, rhigh;
-  if ( node1.var < node2.var )
-  {
-    rlow = bdd_or( node1.low, g );
-    rhigh = bdd_or( node1.high, g );
-  }
-  else if ( node1.var > node2.var )
-  {
-    rlow = bdd_or( f, node2.low );
-    rhigh = bdd_or( f, node2.high );
-  }
-  else
-  {
-    rlow = bdd_or( node1.low, node2.low );
-    rhigh = bdd_or( node1.high, node2.high );
-  }
-
-  auto idx = unique_create( std::min( node1.var, node2.var ), rhigh, rlow );
-  return cache.insert( f, g, (unsigned)bdd_operation::_or, idx );
+  /* De Morgan, shares computed table entries with AND */
+  return bdd_and( f ^ 1u, g ^ 1u ) ^ 1u;
 }
 
 unsigned bdd_manager::bdd_xor( unsigned f, unsigned g )
 {
   /* terminating cases */
+  if ( f == g )          { return 0u; }
+  if ( f == ( g ^ 1u ) ) { return 1u; }
   if ( f == 0u ) { return g; }
   if ( g == 0u ) { return f; }
-  if ( f == g )  { return 0u; }
+  if ( f == 1u ) { return g ^ 1u; }
+  if ( g == 1u ) { return f ^ 1u; }
+
+  /* complemented operands complement the result */
+  const auto c = ( f ^ g ) & 1u;
+  f &= ~1u;
+  g &= ~1u;
 
   /* commutativity */
-  if ( f > g ) { return bdd_xor( g, f ); }
+  if ( f > g ) { std::swap( f, g ); }
 
-  const auto r = cache.lookup( f, g, (unsigned)bdd_operation::_xor );
-  if ( r >= 0 ) { return r; }
+  unsigned r;
+  if ( cache.lookup( f, g, (unsigned)bdd_operation::_xor, r ) ) { return r ^ c; }
 
-  const auto& node1 = nodes.at( f );
-  const auto& node2 = nodes.at( g );
-  unsigned rlow, rhigh;
-  if ( node1.var < node2.var )
-  {
-    rlow = bdd_xor( node1.low, g );
-    rhigh = bdd_xor( node1.high, g );
-  }
-  else if ( node1.var > node2.var )
-  {
-    rlow = bdd_xor( f, node2.low );
-    rhigh = bdd_xor( f, node2.high );
-  }
-  else
-  {
-    rlow = bdd_xor( node1.low, node2.low );
-    rhigh = bdd_xor( node1.high, node2.high );
-  }
+  const auto v = std::min( top_level( f ), top_level( g ) );
+  unsigned f1, f0, g1, g0;
+  cofactors( f, v, f1, f0 );
+  cofactors( g, v, g1, g0 );
 
-  auto idx = unique_create( std::min( node1.var, node2.var ), rhigh, rlow );
-  return cache.insert( f, g, (unsigned)bdd_operation::_xor, idx );
+  const auto rlow  = bdd_xor( f0, g0 );
+  const auto rhigh = bdd_xor( f1, g1 );
+
+  auto idx = unique_create( v, rhigh, rlow );
+  return cache.insert( f, g, (unsigned)bdd_operation::_xor, idx ) ^ c;
 }
 
 unsigned bdd_manager::bdd_not( unsigned f )
 {
-  /* terminating cases */
-  if ( f == 0u ) { return 1u; }
-  if ( f == 1u ) { return 0u; }
-
-  const auto r = cache.lookup( f, f, (unsigned)bdd_operation::_not );
-  if ( r >= 0 ) { return r; }
-
-  const auto& node = nodes.at( f );
-
-  auto rlow = bdd_not( node.low );
-  auto rhigh = bdd_not( node.high );
-
-  auto idx = unique_create( node.var, rhigh, rlow );
-  return cache.insert( f, f, (unsigned)bdd_operation::_not, idx );
+  return f ^ 1u;
 }
 
 unsigned bdd_manager::bdd_cof0( unsigned f, unsigned v )
 {
   /* terminating cases */
   if ( f <= 1u ) { return f; }
+  if ( top_level( f ) > perm[v] ) { return f; }
+
+  const auto c = f & 1u;
+  f ^= c;
 
-  const auto& node = nodes.at( f );
-  if ( node.var > v ) { return f; }
+  unsigned r;
+  if ( cache.lookup( f, v, (unsigned)bdd_operation::cof0, r ) ) { return r ^ c; }
 
-  const auto r = cache.lookup( f, v, (unsigned)bdd_operation::cof0 );
-  if ( r >= 0 ) { return r; }
+  const auto node = nodes[f >> 1u];
 
   unsigned idx;
-  if ( node.var < v )
+  if ( node.var < perm[v] )
   {
     const auto rlow  = bdd_cof0( node.low, v );
     const auto rhigh = bdd_cof0( node.high, v );
@@ -216,22 +164,25 @@ unsigned bdd_manager::bdd_cof0( unsigned f, unsigned v )
   {
     idx = node.low;
   }
-  return cache.insert( f, v, (unsigned)bdd_operation::cof0, idx );
+  return cache.insert( f, v, (unsigned)bdd_operation::cof0, idx ) ^ c;
 }
 
 unsigned bdd_manager::bdd_cof1( unsigned f, unsigned v )
 {
   /* terminating cases */
   if ( f <= 1u ) { return f; }
+  if ( top_level( f ) > perm[v] ) { return f; }
+
+  const auto c = f & 1u;
+  f ^= c;
 
-  const auto& node = nodes.at( f );
-  if ( node.var > v ) { return f; }
+  unsigned r;
+  if ( cache.lookup( f, v, (unsigned)bdd_operation::cof1, r ) ) { return r ^ c; }
 
-  const auto r = cache.lookup( f, v, (unsigned)bdd_operation::cof1 );
-  if ( r >= 0 ) { return r; }
+  const auto node = nodes[f >> 1u];
 
   unsigned idx;
-  if ( node.var < v )
+  if ( node.var < perm[v] )
   {
     const auto rlow  = bdd_cof1( node.low, v );
     const auto rhigh = bdd_cof1( node.high, v );
@@ -241,7 +192,7 @@ unsigned bdd_manager::bdd_cof1( unsigned f, unsigned v )
   {
     idx = node.high;
   }
-  return cache.insert( f, v, (unsigned)bdd_operation::cof1, idx );
+  return cache.insert( f, v, (unsigned)bdd_operation::cof1, idx ) ^ c;
 }
 
 unsigned bdd_manager::bdd_exists( unsigned f, unsigned g )
@@ -249,31 +200,36 @@ unsigned bdd_manager::bdd_exists( unsigned f, unsigned g )
   /* terminating cases */
   if ( g == 1u || f <= 1u ) { return f; }
 
-  const auto& node1 = nodes.at( f );
-  const auto& node2 = nodes.at( g );
+  const auto fv = top_level( f );
+  const auto gv = top_level( g );
+  unsigned g1, g0;
+  cofactors( g, gv, g1, g0 );
 
-  if ( node1.var > node2.var )
+  if ( fv > gv )
   {
-    return bdd_exists( f, node2.high );
+    return bdd_exists( f, g1 );
   }
 
-  const auto r = cache.lookup( f, g, (unsigned)bdd_operation::exists );
-  if ( r >= 0 ) { return r; }
+  unsigned r;
+  if ( cache.lookup( f, g, (unsigned)bdd_operation::exists, r ) ) { return r; }
+
+  unsigned f1, f0;
+  cofactors( f, fv, f1, f0 );
 
   unsigned idx;
-  auto rlow  = bdd_exists( node1.low, node1.var == node2.var ? node2.high : g );
+  auto rlow  = bdd_exists( f0, fv == gv ? g1 : g );
 
-  if ( rlow == 1 && node1.var == node2.var )
+  if ( rlow == 1 && fv == gv )
   {
     idx = 1;
   }
   else
   {
-    auto rhigh = bdd_exists( node1.high, node1.var == node2.var ? node2.high : g );
+    auto rhigh = bdd_exists( f1, fv == gv ? g1 : g );
 
-    if ( node1.var < node2.var )
+    if ( fv < gv )
     {
-      idx = unique_create( node1.var, rhigh, rlow );
+      idx = unique_create( fv, rhigh, rlow );
     }
     else
     {
@@ -290,43 +246,37 @@ unsigned bdd_manager::bdd_constrain( unsigned f, unsigned g )
   if ( g == 0u )            { return 0u; }
   if ( g == 1u || f <= 1u ) { return f;  }
   if ( f == g )             { return 1u; }
+  if ( f == ( g ^ 1u ) )    { return 0u; }
 
-  const auto r = cache.lookup( f, g, (unsigned)bdd_operation::constrain );
-  if ( r >= 0 ) { return r; }
+  /* constrain( !f, g ) = !constrain( f, g ) */
+  const auto c = f & 1u;
+  f ^= c;
 
-  const auto& node1 = nodes.at( f );
-  const auto& node2 = nodes.at( g );
+  unsigned r;
+  if ( cache.lookup( f, g, (unsigned)bdd_operation::constrain, r ) ) { return r ^ c; }
 
-  unsigned idx;
+  const auto v = std::min( top_level( f ), top_level( g ) );
+  unsigned f1, f0, g1, g0;
+  cofactors( f, v, f1, f0 );
+  cofactors( g, v, g1, g0 );
 
-  do {
-    unsigned v;
-
-    if ( node1.var < node2.var )
-    {
-      v = node1.var;
-    }
-    else
-    {
-      v = node2.var;
-      if ( node2.low == 0u )
-      {
-        idx = bdd_constrain( node1.var == v ? node1.high : f, node2.high );
-        break;
-      }
-      else if ( node2.high == 0u )
-      {
-        idx = bdd_constrain( node1.var == v ? node1.low : f, node2.low );
-        break;
-      }
-    }
-
-    auto rlow = bdd_constrain( node1.var == v ? node1.low : f, node2.var == v ? node2.low : g );
-    auto rhigh = bdd_constrain( node1.var == v ? node1.high : f, node2.var == v ? node2.high : g );
+  unsigned idx;
+  if ( g0 == 0u )
+  {
+    idx = bdd_constrain( f1, g1 );
+  }
+  else if ( g1 == 0u )
+  {
+    idx = bdd_constrain( f0, g0 );
+  }
+  else
+  {
+    auto rlow = bdd_constrain( f0, g0 );
+    auto rhigh = bdd_constrain( f1, g1 );
     idx = unique_create( v, rhigh, rlow );
-  } while ( false );
+  }
 
-  return cache.insert( f, g, (unsigned)bdd_operation::constrain, idx );
+  return cache.insert( f, g, (unsigned)bdd_operation::constrain, idx ) ^ c;
 }
 
 unsigned bdd_manager::bdd_restrict( unsigned f, unsigned g )
@@ -335,50 +285,130 @@ unsigned bdd_manager::bdd_restrict( unsigned f, unsigned g )
   if ( g == 0u )            { return 0u; }
   if ( g == 1u || f <= 1u ) { return f;  }
   if ( f == g )             { return 1u; }
+  if ( f == ( g ^ 1u ) )    { return 0u; }
+
+  /* restrict( !f, g ) = !restrict( f, g ) */
+  const auto c = f & 1u;
+  f ^= c;
 
-  const auto r = cache.lookup( f, g, (unsigned)bdd_operation::restrict );
-  if ( r >= 0 ) { return r; }
+  unsigned r;
+  if ( cache.lookup( f, g, (unsigned)bdd_operation::restrict, r ) ) { return r ^ c; }
 
-  const auto& node1 = nodes.at( f );
-  const auto& node2 = nodes.at( g );
+  const auto v = std::min( top_level( f ), top_level( g ) );
+  unsigned f1, f0, g1, g0;
+  cofactors( f, v, f1, f0 );
+  cofactors( g, v, g1, g0 );
 
   unsigned idx;
+  if ( g0 == 0u )
+  {
+    idx = bdd_restrict( f1, g1 );
+  }
+  else if ( g1 == 0u )
+  {
+    idx = bdd_restrict( f0, g0 );
+  }
+  /* special case in RESTRICT */
+  else if ( f1 == f0 )
+  {
+    idx = bdd_restrict( f, bdd_exists( g, ( invperm[v] + 2u ) << 1u ) );
+  }
+  else
+  {
+    auto rlow = bdd_restrict( f0, g0 );
+    auto rhigh = bdd_restrict( f1, g1 );
+    idx = unique_create( v, rhigh, rlow );
+  }
+
+  return cache.insert( f, g, (unsigned)bdd_operation::restrict, idx ) ^ c;
+}
 
-  do {
-    unsigned v;
+unsigned bdd_manager::bdd_and_parallel( unsigned f, unsigned g, unsigned depth )
+{
+  /* terminating cases and small subproblems are left to the sequential operation */
+  if ( depth == 0u || f <= 1u || g <= 1u || ( f >> 1u ) == ( g >> 1u ) ) { return bdd_and( f, g ); }
 
-    if ( node1.var < node2.var )
-    {
-      v = node1.var;
-    }
-    else
-    {
-      v = node2.var;
-      if ( node2.low == 0u )
-      {
-        idx = bdd_restrict( node1.var == v ? node1.high : f, node2.high );
-        break;
-      }
-      else if ( node2.high == 0u )
-      {
-        idx = bdd_restrict( node1.var == v ? node1.low : f, node2.low );
-        break;
-      }
-    }
+  if ( f > g ) { std::swap( f, g ); }
 
-    /* special case in RESTRICT */
-    if ( node1.low == node1.high )
-    {
-      idx = bdd_restrict( f, bdd_exists( g, v + 2u ) );
-      break;
-    }
+  unsigned r;
+  if ( cache.lookup( f, g, (unsigned)bdd_operation::_and, r ) ) { return r; }
 
-    auto rlow = bdd_restrict( node1.var == v ? node1.low : f, node2.var == v ? node2.low : g );
-    auto rhigh = bdd_restrict( node1.var == v ? node1.high : f, node2.var == v ? node2.high : g );
-    idx = unique_create( v, rhigh, rlow );
-  } while ( false );
+  const auto v = std::min( top_level( f ), top_level( g ) );
+  unsigned f1, f0, g1, g0;
+  cofactors( f, v, f1, f0 );
+  cofactors( g, v, g1, g0 );
+
+  unsigned rlow, rhigh;
+  fork_join( [&]() { rhigh = bdd_and_parallel( f1, g1, depth - 1u ); },
+             [&]() { rlow  = bdd_and_parallel( f0, g0, depth - 1u ); } );
+
+  auto idx = unique_create( v, rhigh, rlow );
+  return cache.insert( f, g, (unsigned)bdd_operation::_and, idx );
+}
+
+unsigned bdd_manager::bdd_xor_parallel( unsigned f, unsigned g, unsigned depth )
+{
+  if ( depth == 0u || f <= 1u || g <= 1u || ( f >> 1u ) == ( g >> 1u ) ) { return bdd_xor( f, g ); }
+
+  const auto c = ( f ^ g ) & 1u;
+  f &= ~1u;
+  g &= ~1u;
+
+  if ( f > g ) { std::swap( f, g ); }
+
+  unsigned r;
+  if ( cache.lookup( f, g, (unsigned)bdd_operation::_xor, r ) ) { return r ^ c; }
+
+  const auto v = std::min( top_level( f ), top_level( g ) );
+  unsigned f1, f0, g1, g0;
+  cofactors( f, v, f1, f0 );
+  cofactors( g, v, g1, g0 );
+
+  unsigned rlow, rhigh;
+  fork_join( [&]() { rhigh = bdd_xor_parallel( f1, g1, depth - 1u ); },
+             [&]() { rlow  = bdd_xor_parallel( f0, g0, depth - 1u ); } );
+
+  auto idx = unique_create( v, rhigh, rlow );
+  return cache.insert( f, g, (unsigned)bdd_operation::_xor, idx ) ^ c;
+}
+
+unsigned bdd_manager::bdd_exists_parallel( unsigned f, unsigned g, unsigned depth )
+{
+  if ( depth == 0u || g == 1u || f <= 1u ) { return bdd_exists( f, g ); }
+
+  const auto fv = top_level( f );
+  const auto gv = top_level( g );
+  unsigned g1, g0;
+  cofactors( g, gv, g1, g0 );
+
+  if ( fv > gv )
+  {
+    return bdd_exists_parallel( f, g1, depth );
+  }
+
+  unsigned r;
+  if ( cache.lookup( f, g, (unsigned)bdd_operation::exists, r ) ) { return r; }
+
+  unsigned f1, f0;
+  cofactors( f, fv, f1, f0 );
+
+  /* both branches are computed, the sequential early exit on a true low branch is lost */
+  const auto gn = fv == gv ? g1 : g;
+  unsigned rlow, rhigh;
+  fork_join( [&]() { rhigh = bdd_exists_parallel( f1, gn, depth - 1u ); },
+             [&]() { rlow  = bdd_exists_parallel( f0, gn, depth - 1u ); } );
+
+  unsigned idx;
+  if ( fv < gv )
+  {
+    idx = unique_create( fv, rhigh, rlow );
+  }
+  else
+  {
+    idx = bdd_and_parallel( rlow ^ 1u, rhigh ^ 1u, depth - 1u ) ^ 1u;
+  }
 
-  return cache.insert( f, g, (unsigned)bdd_operation::restrict, idx );
+  return cache.insert( f, g, (unsigned)bdd_operation::exists, idx );
 }
 
 unsigned bdd_manager::bdd_round_to( unsigned f, unsigned level, unsigned cop, unsigned to )
@@ -396,33 +426,35 @@ unsigned bdd_manager::bdd_round_to( unsigned f, unsigned level, unsigned cop, un
   /* terminating cases */
   if ( f <= 1u ) { return f; }
 
-  const auto r = cache.lookup( f, level, cop );
-  if ( r >= 0 ) { return r; }
+  unsigned r;
+  if ( cache.lookup( f, level, cop, r ) ) { return r; }
 
-  const auto& node = nodes.at( f );
+  const auto v = top_level( f );
+  unsigned f1, f0;
+  cofactors( f, v, f1, f0 );
 
   auto idx = 0u;
-  if ( node.var < level )
+  if ( v < level )
   {
-    auto rlow = bdd_round_to( node.low, level, cop, to, count_map );
-    auto rhigh = bdd_round_to( node.high, level, cop, to, count_map );
+    auto rlow = bdd_round_to( f0, level, cop, to, count_map );
+    auto rhigh = bdd_round_to( f1, level, cop, to, count_map );
 
-    idx = unique_create( node.var, rhigh, rlow );
+    idx = unique_create( v, rhigh, rlow );
   }
   else
   {
-    auto cl = count_map.at( node.low );
-    auto ch = count_map.at( node.high );
+    auto cl = count_map.at( f0 );
+    auto ch = count_map.at( f1 );
 
     if ( cl < ch )
     {
-      auto rhigh = bdd_round_to( node.high, level, cop, to, count_map );
-      idx = unique_create( node.var, rhigh, to );
+      auto rhigh = bdd_round_to( f1, level, cop, to, count_map );
+      idx = unique_create( v, rhigh, to );
     }
     else
     {
-      auto rlow = bdd_round_to( node.low, level, cop, to, count_map );
-      idx = unique_create( node.var, to, rlow );
+      auto rlow = bdd_round_to( f0, level, cop, to, count_map );
+      idx = unique_create( v, to, rlow );
     }
   }
   return cache.insert( f, level, cop, idx );
@@ -443,23 +475,26 @@ unsigned bdd_manager::bdd_round( unsigned f, unsigned level )
   /* terminating cases */
   if ( f <= 1u ) { return f; }
 
-  const auto r = cache.lookup( f, level, (unsigned)bdd_operation::round );
-  if ( r >= 0 ) { return r; }
+  unsigned r;
+  if ( cache.lookup( f, level, (unsigned)bdd_operation::round, r ) ) { return r; }
 
-  const auto& node = nodes.at( f );
+  const auto v = top_level( f );
 
   auto idx = 0u;
-  if ( node.var < level )
+  if ( v < level )
   {
-    auto rlow = bdd_round( node.low, level );
-    auto rhigh = bdd_round( node.high, level );
+    unsigned f1, f0;
+    cofactors( f, v, f1, f0 );
 
-    idx = unique_create( node.var, rhigh, rlow );
+    auto rlow = bdd_round( f0, level );
+    auto rhigh = bdd_round( f1, level );
+
+    idx = unique_create( v, rhigh, rlow );
   }
   else
   {
-    auto onset = count_solutions( bdd( this, f ) ) / ( 1ull << node.var );
-    auto all   = 1ull << ( nvars - node.var );
+    auto onset = count_solutions( bdd( this, f ) ) / ( 1ull << v );
+    auto all   = 1ull << ( nvars - v );
 
     if ( ( onset << 1u ) > all ) /* if onset / all > .5 */
     {
@@ -481,12 +516,42 @@ unsigned bdd_manager::unique_create( unsigned var, unsigned high, unsigned low )
     //std::cout << boost::format( "[i] attempt to create (%d, %d, %d)" ) % var % high % low << std::endl;
   }
   assert( var < nvars );
-  assert( var < nodes[high].var );
-  assert( var < nodes[low].var );
+  assert( var < top_level( high ) );
+  assert( var < top_level( low ) );
 
   if ( high == low ) { return high; }
 
-  return unique_lookup( var, high, low );
+  /* canonical form: the low edge is never complemented (this keeps the
+     variable nodes ( var, 1, 0 ), since 0 is the regular terminal edge) */
+  if ( low & 1u )
+  {
+    return ( unique_lookup( var, high ^ 1u, low ^ 1u ) << 1u ) | 1u;
+  }
+
+  return unique_lookup( var, high, low ) << 1u;
+}
+
+unsigned bdd_manager::apply_and( unsigned f, unsigned g )
+{
+  if ( !parallel_enabled ) { return bdd_and( f, g ); }
+  return run_concurrent( [&]() { return bdd_and_parallel( f, g, fork_depth ); } );
+}
+
+unsigned bdd_manager::apply_or( unsigned f, unsigned g )
+{
+  return apply_and( f ^ 1u, g ^ 1u ) ^ 1u;
+}
+
+unsigned bdd_manager::apply_xor( unsigned f, unsigned g )
+{
+  if ( !parallel_enabled ) { return bdd_xor( f, g ); }
+  return run_concurrent( [&]() { return bdd_xor_parallel( f, g, fork_depth ); } );
+}
+
+unsigned bdd_manager::apply_exists( unsigned f, unsigned g )
+{
+  if ( !parallel_enabled ) { return bdd_exists( f, g ); }
+  return run_concurrent( [&]() { return bdd_exists_parallel( f, g, fork_depth ); } );
 }
 
 std::ostream& operator<<( std::ostream& os, const bdd_manager& mgr )
@@ -496,15 +561,12 @@ std::ostream& operator<<( std::ostream& os, const bdd_manager& mgr )
     os << i << ": " << mgr.nodes[i] << std::endl;
   }
 
-  auto * q = mgr.unique;
-
-  while ( q != mgr.unique + mgr.nodes.size() )
+  for ( auto q : mgr.unique )
   {
-    if ( *q )
+    for ( ; q; q = mgr.nexts[q] )
     {
-      os << *q << ": " << mgr.nodes[*q] << std::endl;
+      os << q << ": " << mgr.nodes[q] << std::endl;
     }
-    ++q;
   }
 
   return os;
@@ -513,43 +575,64 @@ std::ostream& operator<<( std::ostream& os, const bdd_manager& mgr )
 bdd& bdd::operator=( const bdd& other )
 {
   if ( this == &other ) { return *this; }
-  assert( !manager || manager == other.manager );
+  assert( !manager || !other.manager || manager == other.manager );
+  if ( other.manager ) { other.manager->ref( other.index >> 1u ); }
+  if ( manager )       { manager->deref( index >> 1u ); }
+  manager = other.manager;
+  index   = other.index;
+  return *this;
+}
+
+bdd& bdd::operator=( bdd&& other ) noexcept
+{
+  if ( this == &other ) { return *this; }
+  assert( !manager || !other.manager || manager == other.manager );
+  if ( manager ) { manager->deref( index >> 1u ); }
   manager = other.manager;
   index   = other.index;
+  other.manager = nullptr;
   return *this;
 }
 
 unsigned bdd::var() const
 {
-  return manager->get_var( index );
+  return manager->get_var( index >> 1u );
+}
+
+unsigned bdd::level() const
+{
+  return manager->get_level( index >> 1u );
 }
 
 bdd bdd::high() const
 {
-  return bdd( manager, manager->get_high( index ) );
+  return bdd( manager, manager->get_high( index >> 1u ) ^ ( index & 1u ) );
 }
 
 bdd bdd::low() const
 {
-  return bdd( manager, manager->get_low( index ) );
+  return bdd( manager, manager->get_low( index >> 1u ) ^ ( index & 1u ) );
 }
 
 bdd bdd::operator&&( const bdd& other ) const
 {
   assert( manager == other.manager );
-  return bdd( manager, manager->bdd_and( index, other.index ) );
+  manager->safe_point();
+  return bdd( manager, manager->apply_and( index, other.index ) );
 }
 
 bdd bdd::operator||( const bdd& other ) const
 {
   assert( manager == other.manager );
-  return bdd( manager, manager->bdd_or( index, other.index ) );
+  manager->safe_point();
+  return bdd( manager, manager->apply_or( index, other.index ) );
 }
 
 bdd bdd::operator^( const bdd& other ) const
 {
   assert( manager == other.manager );
-  return bdd( manager, manager->bdd_xor( index, other.index ) );
+  manager->safe_point();
+  return bdd( manager, manager->apply_xor( index, other.index ) );
 }
 
 bdd bdd::operator!() const
@@ -559,44 +642,52 @@ bdd bdd::operator!() const
 
 bdd bdd::cof0( unsigned v ) const
 {
+  manager->safe_point();
   return bdd( manager, manager->bdd_cof0( index, v ) );
 }
 
 bdd bdd::cof1( unsigned v ) const
 {
+  manager->safe_point();
   return bdd( manager, manager->bdd_cof1( index, v ) );
 }
 
 bdd bdd::exists( const bdd& other ) const
 {
   assert( manager == other.manager );
-  return bdd( manager, manager->bdd_exists( index, other.index ) );
+  manager->safe_point();
+  return bdd( manager, manager->apply_exists( index, other.index ) );
 }
 
 bdd bdd::constrain( const bdd& other ) const
 {
   assert( manager == other.manager );
+  manager->safe_point();
   return bdd( manager, manager->bdd_constrain( index, other.index ) );
 }
 
 bdd bdd::restrict( const bdd& other ) const
 {
   assert( manager == other.manager );
+  manager->safe_point();
   return bdd( manager, manager->bdd_restrict( index, other.index ) );
 }
 
 bdd bdd::round_down( unsigned level ) const
 {
+  manager->safe_point();
   return bdd( manager, manager->bdd_round_down( index, level ) );
 }
 
 bdd bdd::round_up( unsigned level ) const
 {
+  manager->safe_point();
   return bdd( manager, manager->bdd_round_up( index, level ) );
 }
 
 bdd bdd::round( unsigned level ) const
 {
+  manager->safe_point();
   return bdd( manager, manager->bdd_round( index, level ) );
 }
 
@@ -51,19 +51,24 @@ namespace cirkit
 
 class bdd_manager;
 
+/* index is an edge, i.e., a node index shifted by one with the complement
+ * flag in the least significant bit; 0 is the constant false and 1 the
+ * constant true function */
 struct bdd
 {
   using const_param_ref = boost::call_traits < bdd >::const_reference;
 
   bdd() : manager( nullptr ), index( 0u ) {}
-  bdd( bdd_manager* manager, unsigned index )
-    : manager( manager ),
-      index( index ) {}
-  bdd( const bdd& other ) : manager( other.manager ), index( other.index ) {}
+  bdd( bdd_manager* manager, unsigned index );
+  bdd( const bdd& other );
+  bdd( bdd&& other ) noexcept;
+  ~bdd();
 
   bdd& operator=( const bdd& other );
+  bdd& operator=( bdd&& other ) noexcept;
 
   unsigned var() const;
+  unsigned level() const;
   bdd high() const;
   bdd low() const;
 
@@ -102,8 +107,8 @@ public:
 
   inline bdd bdd_bot()                { return bdd( this, 0u );     }
   inline bdd bdd_top()                { return bdd( this, 1u );     }
-  inline bdd bdd_var( unsigned i )    { assert( i < nvars ); return bdd( this, i + 2u ); }
-  inline bdd operator[]( unsigned i ) { assert( i < nvars ); return bdd( this, i + 2u ); }
+  inline bdd bdd_var( unsigned i )    { assert( i < nvars ); return bdd( this, ( i + 2u ) << 1u ); }
+  inline bdd operator[]( unsigned i ) { assert( i < nvars ); return bdd( this, ( i + 2u ) << 1u ); }
 
   unsigned bdd_and( unsigned f, unsigned g );
   unsigned bdd_or( unsigned f, unsigned g );
@@ -120,9 +125,36 @@ public:
 
   unsigned unique_create( unsigned var, unsigned high, unsigned low );
 
+  /* entry points of the handle operations, fork at the top levels in parallel apply mode */
+  unsigned apply_and( unsigned f, unsigned g );
+  unsigned apply_or( unsigned f, unsigned g );
+  unsigned apply_xor( unsigned f, unsigned g );
+  unsigned apply_exists( unsigned f, unsigned g );
+
   static bdd_manager_ptr create( unsigned nvars, unsigned log_max_objs, bool verbose = false );
 
 private:
+  inline unsigned top_level( unsigned f ) const { return nodes[f >> 1u].var; }
+
+  /* cofactors of f with respect to v, where v is not below the top variable of f */
+  inline void cofactors( unsigned f, unsigned v, unsigned& f1, unsigned& f0 ) const
+  {
+    const auto& n = nodes[f >> 1u];
+    if ( n.var == v )
+    {
+      f1 = n.high ^ ( f & 1u );
+      f0 = n.low ^ ( f & 1u );
+    }
+    else
+    {
+      f1 = f0 = f;
+    }
+  }
+
+  unsigned bdd_and_parallel( unsigned f, unsigned g, unsigned depth );
+  unsigned bdd_xor_parallel( unsigned f, unsigned g, unsigned depth );
+  unsigned bdd_exists_parallel( unsigned f, unsigned g, unsigned depth );
+
   unsigned bdd_round_to( unsigned f, unsigned level, unsigned cop, unsigned to );
   unsigned bdd_round_to( unsigned f, unsigned level, unsigned cop, unsigned to, const std::map<unsigned, boost::multiprecision::uint256_t>& count_map );
 
@@ -130,6 +162,33 @@ public:
   friend std::ostream& operator<<( std::ostream& os, const bdd_manager& mgr );
 };
 
+/* handles keep their node alive, they must not outlive their manager */
+inline bdd::bdd( bdd_manager* manager, unsigned index )
+  : manager( manager ),
+    index( index )
+{
+  if ( manager ) { manager->ref( index >> 1u ); }
+}
+
+inline bdd::bdd( const bdd& other )
+  : manager( other.manager ),
+    index( other.index )
+{
+  if ( manager ) { manager->ref( index >> 1u ); }
+}
+
+inline bdd::bdd( bdd&& other ) noexcept
+  : manager( other.manager ),
+    index( other.index )
+{
+  other.manager = nullptr;
+}
+
+inline bdd::~bdd()
+{
+  if ( manager ) { manager->deref( index >> 1u ); }
+}
+
 }
 
 #endif
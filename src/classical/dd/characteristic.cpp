@@ -56,14 +56,28 @@ bdd characteristic_function( const std::vector<bdd>& fs, bdd_manager& to )
     shifted_fs += bdd_copy( f, to );
   }
 
-  bdd f = to.bdd_top();
-
+  /* conjunction as a balanced tree, such that the operations of one round
+     are independent and large enough to fork in parallel apply mode */
+  std::vector<bdd> terms;
   for ( auto i = 0u; i < shifted_fs.size(); ++i )
   {
-    f = f && ( !to.bdd_var( i ) ^ shifted_fs[i] );
+    terms += !to.bdd_var( i ) ^ shifted_fs[i];
+  }
+
+  if ( terms.empty() ) { return to.bdd_top(); }
+
+  while ( terms.size() > 1u )
+  {
+    std::vector<bdd> next;
+    for ( auto i = 0u; i + 1u < terms.size(); i += 2u )
+    {
+      next += terms[i] && terms[i + 1u];
+    }
+    if ( terms.size() & 1u ) { next += terms.back(); }
+    terms.swap( next );
   }
 
-  return f;
+  return terms.front();
 }
 
 }
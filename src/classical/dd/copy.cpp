@@ -58,19 +58,23 @@ bdd bdd_copy( const bdd& f, bdd_manager& to,
   /* timing */
   properties_timer t( statistics );
 
-  /* map "from" addresses -> "to" addresses */
+  /* map "from" edges -> "to" edges */
   std::unordered_map<unsigned, unsigned> address_map = { {0u, 0u}, {1u, 1u} };
-  for ( unsigned v = 2u; v < 2u + f.manager->num_vars(); ++v )
-  {
-    address_map.insert( { v, v + shift } );
-  }
 
   auto func = [&]( const bdd& n ) {
-    if ( n.index >= 2u + f.manager->num_vars() )
+    const auto high = address_map[n.high().index];
+    const auto low  = address_map[n.low().index];
+    const auto var  = n.var() + shift;
+
+    /* the variable orders of both managers may differ */
+    if ( to.level( var ) < to.get_level( high >> 1u ) && to.level( var ) < to.get_level( low >> 1u ) )
+    {
+      address_map[n.index] = to.unique_create( to.level( var ), high, low );
+    }
+    else
     {
-      address_map[n.index] = to.unique_create( n.var() + shift,
-                                               address_map[n.high().index],
-                                               address_map[n.low().index] );
+      const auto x = to.bdd_var( var ).index;
+      address_map[n.index] = to.bdd_or( to.bdd_and( x, high ), to.bdd_and( x ^ 1u, low ) );
     }
   };
   dd_depth_first( f, detail::node_func_t<bdd>( func ) );
@@ -26,12 +26,15 @@
 
 #include "dd_manager.hpp"
 
-#include <cstring>
+#include <algorithm>
 #include <iostream>
 #include <vector>
 
 #include <boost/format.hpp>
 
+#include <core/utils/thread_pool.hpp>
+#include <core/utils/timer.hpp>
+
 namespace cirkit
 {
 
@@ -39,34 +42,81 @@ namespace cirkit
  * Types                                                                      *
  ******************************************************************************/
 
+/* thrown by tasks of a parallel operation when the node array is full */
+struct dd_capacity_exhausted {};
+
 hash_cache::hash_cache( size_type log_size )
-  : data( 1 << log_size ),
-    mask( ( 1 << log_size ) - 1u )
-  , nhit( 0u )
-  , nmiss( 0 ) {}
+  : locks( new std::mutex[num_locks] ),
+    nhit( 0u ),
+    nmiss( 0u )
+{
+  resize( log_size );
+}
+
+bool hash_cache::lookup( unsigned arg0, unsigned arg1, unsigned op, unsigned& result )
+{
+  const auto index = set_index( arg0, arg1, op );
+
+  if ( concurrent )
+  {
+    std::lock_guard<std::mutex> lock( locks[index & ( num_locks - 1u )] );
+    return lookup_set( &data[index << 1u], arg0, arg1, op, result );
+  }
+  return lookup_set( &data[index << 1u], arg0, arg1, op, result );
+}
+
+unsigned hash_cache::insert( unsigned arg0, unsigned arg1, unsigned op, unsigned result )
+{
+  const auto index = set_index( arg0, arg1, op );
+
+  if ( concurrent )
+  {
+    std::lock_guard<std::mutex> lock( locks[index & ( num_locks - 1u )] );
+    insert_set( &data[index << 1u], arg0, arg1, op, result );
+  }
+  else
+  {
+    insert_set( &data[index << 1u], arg0, arg1, op, result );
+  }
+  return result;
+}
 
-int hash_cache::lookup( unsigned arg0, unsigned arg1, unsigned arg2 )
+bool hash_cache::lookup_set( entry_t* ent, unsigned arg0, unsigned arg1, unsigned op, unsigned& result )
 {
-  auto& ent = entry( arg0, arg1, arg2 );
-  bool hit = std::get<0>( ent ) == arg0 && std::get<1>( ent ) == arg1 && std::get<2>( ent ) == arg2;
+  for ( auto i = 0u; i < 2u; ++i )
+  {
+    if ( ent[i].op == op && ent[i].arg0 == arg0 && ent[i].arg1 == arg1 )
+    {
+      result = ent[i].result;
+      if ( i ) { std::swap( ent[0u], ent[1u] ); }
+      nhit.fetch_add( 1u, std::memory_order_relaxed );
+      return true;
+    }
+  }
 
-  if ( hit ) {
-    ++nhit;
-  } else {
-    ++nmiss;
+  nmiss.fetch_add( 1u, std::memory_order_relaxed );
+  return false;
+}
+
+void hash_cache::insert_set( entry_t* ent, unsigned arg0, unsigned arg1, unsigned op, unsigned result )
+{
+  if ( ent[0u].op != no_op && !( ent[0u].op == op && ent[0u].arg0 == arg0 && ent[0u].arg1 == arg1 ) )
+  {
+    ent[1u] = ent[0u];
   }
+  ent[0u] = {arg0, arg1, op, result};
+}
 
-  return hit ? std::get<3>( ent ) : -1;
+void hash_cache::clear()
+{
+  std::fill( data.begin(), data.end(), entry_t{0u, 0u, no_op, 0u} );
 }
 
-int hash_cache::insert( unsigned arg0, unsigned arg1, unsigned arg2, int res )
+void hash_cache::resize( size_type log_size )
 {
-  auto& ent = entry( arg0, arg1, arg2 );
-  std::get<0>( ent ) = arg0;
-  std::get<1>( ent ) = arg1;
-  std::get<2>( ent ) = arg2;
-  std::get<3>( ent ) = res;
-  return res;
+  assert( log_size > 0u );
+  data.assign( 1u << log_size, entry_t{0u, 0u, no_op, 0u} );
+  mask = ( 1u << ( log_size - 1u ) ) - 1u;
 }
 
 std::size_t hash_cache::cache_size() const
@@ -102,40 +152,52 @@ dd_manager::dd_manager( unsigned nvars, unsigned log_max_objs, bool verbose )
 {
   assert( log_max_objs > 0u );
 
-  const auto _nobjs = 1 << log_max_objs;
+  auto _nobjs = 1u << log_max_objs;
+  while ( _nobjs < 2u * ( nvars + 2u ) )
+  {
+    _nobjs <<= 1u;
+    cache.resize( ++log_max_objs );
+  }
+
   nodes.resize( _nobjs, {-1u, -1u, -1u } );
   mask   = _nobjs - 1u;
-  unique = new unsigned[_nobjs];
-  nexts  = new unsigned[_nobjs];
-
-  memset( unique, 0, sizeof( unsigned ) * _nobjs );
-  memset( nexts,  0, sizeof( unsigned ) * _nobjs );
+  unique.resize( _nobjs, 0u );
+  nexts.resize( _nobjs, 0u );
+  refs.resize( _nobjs, 0u );
 
   /* terminals, value is determined by index */
   nodes[0] = {nvars, -1u, -1u};
   nodes[1] = {nvars, -1u, -1u};
 
-  /* variable nodes */
+  /* variable nodes, initial order is the identity */
+  perm.resize( nvars );
+  invperm.resize( nvars );
   for ( auto i = 0u; i < nvars; ++i )
   {
     nodes[i + 2u] = {i, 1u, 0u};
+    perm[i] = invperm[i] = i;
   }
 
-  nnodes = 2u + nvars;
+  nnodes = peak_nodes = 2u + nvars;
+  gc_threshold = static_cast<unsigned>( gc_occupancy * _nobjs );
 }
 
 dd_manager::~dd_manager()
 {
-  delete[] unique;
-  delete[] nexts;
 }
 
 unsigned dd_manager::size() const
 {
-  return nnodes;
+  return nnodes - nfree;
 }
 
 unsigned dd_manager::get_var( unsigned z ) const
+{
+  const auto l = nodes.at( z ).var;
+  return l < nvars ? invperm[l] : l;
+}
+
+unsigned dd_manager::get_level( unsigned z ) const
 {
   return nodes.at( z ).var;
 }
@@ -150,10 +212,134 @@ unsigned dd_manager::get_low( unsigned z ) const
   return nodes.at( z ).low;
 }
 
+void dd_manager::garbage_collect()
+{
+  increment_timer t( &gc_time );
+
+  const auto first = 2u + nvars;
+  const auto before = size();
+
+  /* mark */
+  std::vector<unsigned char> marked( nnodes, 0u );
+  std::vector<unsigned> stack;
+  std::fill( marked.begin(), marked.begin() + first, 1u );
+
+  const auto shift = complement_edges ? 1u : 0u;
+  for ( auto i = first; i < nnodes; ++i )
+  {
+    if ( refs[i] == 0u || marked[i] ) { continue; }
+
+    marked[i] = 1u;
+    stack.push_back( i );
+    while ( !stack.empty() )
+    {
+      const auto& n = nodes[stack.back()];
+      stack.pop_back();
+
+      const auto high = n.high >> shift;
+      const auto low  = n.low >> shift;
+      if ( !marked[high] ) { marked[high] = 1u; stack.push_back( high ); }
+      if ( !marked[low] )  { marked[low] = 1u;  stack.push_back( low ); }
+    }
+  }
+
+  /* sweep */
+  for ( auto i = first; i < nnodes; ++i )
+  {
+    if ( !marked[i] )
+    {
+      nodes[i] = {-1u, -1u, -1u};
+    }
+  }
+
+  /* cached results may refer to removed nodes */
+  cache.clear();
+  rehash();
+
+  ++num_gc;
+  num_reclaimed += before - size();
+
+  if ( verbose )
+  {
+    std::cout << boost::format( "[i] garbage collection: %d -> %d nodes" ) % before % size() << std::endl;
+  }
+
+  /* collecting again soon does not pay off if most nodes are still alive */
+  if ( size() > grow_occupancy * capacity() )
+  {
+    grow();
+  }
+}
+
+void dd_manager::grow()
+{
+  const auto _nobjs = capacity() << 1u;
+  if ( _nobjs == 0u || _nobjs > ( 1u << 31u ) )
+  {
+    std::cerr << "[e] dd capacity exceeded" << std::endl;
+    assert( false );
+    throw "Error: dd capacity exceeded";
+  }
+
+  nodes.resize( _nobjs, {-1u, -1u, -1u} );
+  unique.resize( _nobjs );
+  nexts.resize( _nobjs );
+  refs.resize( _nobjs, 0u );
+  if ( !irefs.empty() ) { irefs.resize( _nobjs, 0u ); }
+  mask = _nobjs - 1u;
+
+  cache.resize( __builtin_ctz( _nobjs ) );
+  rehash();
+
+  gc_threshold = static_cast<unsigned>( gc_occupancy * _nobjs );
+  ++num_resizes;
+
+  if ( verbose )
+  {
+    std::cout << boost::format( "[i] resized dd tables to %d nodes" ) % _nobjs << std::endl;
+  }
+}
+
+void dd_manager::rehash()
+{
+  std::fill( unique.begin(), unique.end(), 0u );
+  free_list = 0u;
+  nfree     = 0u;
+
+  /* insert in reverse order, such that free nodes are reused from low indexes */
+  for ( auto i = nnodes; i-- > 2u + nvars; )
+  {
+    const auto& n = nodes[i];
+    if ( n.var == -1u )
+    {
+      nexts[i] = free_list;
+      free_list = i;
+      ++nfree;
+    }
+    else
+    {
+      auto& head = unique[unique_index( n.var, n.high, n.low )];
+      nexts[i] = head;
+      head = i;
+    }
+  }
+}
+
 void dd_manager::dump_stats(std::ostream &stream) const
 {
   stream << boost::format ("-- Variables:   %9d\n") % nvars;
-  stream << boost::format ("-- Nodes:       %9d\n") % nnodes;
+  stream << boost::format ("-- Nodes:       %9d\n") % size();
+  stream << boost::format ("-- Peak nodes:  %9d\n") % peak_nodes;
+  stream << boost::format ("-- Capacity:    %9d\n") % capacity();
+  stream << boost::format ("-- Resizes:     %9d\n") % num_resizes;
+  stream << boost::format ("-- GC runs:     %9d\n") % num_gc;
+  stream << boost::format ("-- GC freed:    %9d\n") % num_reclaimed;
+  stream << boost::format ("-- GC time:     %9.2f\n") % gc_time;
+  stream << boost::format ("-- Reorderings: %9d\n") % num_reorderings;
+  stream << boost::format ("-- Swaps:       %9d\n") % num_swaps;
+  stream << boost::format ("-- Reorder time:%9.2f\n") % reorder_time;
+  stream << boost::format ("-- Parallel ops:%9d\n") % num_parallel_ops;
+  stream << boost::format ("-- Par. retries:%9d\n") % num_parallel_retries;
   stream << boost::format ("-- Cache-size:  %9d\n") % cache.cache_size();
   stream << boost::format ("-- Cache-miss:  %9d\n") % cache.miss();
   stream << boost::format ("-- Cache-hit:   %9d\n") % cache.hit();
@@ -164,39 +350,450 @@ unsigned dd_manager::unique_lookup( unsigned var, unsigned high, unsigned low )
   /* variable node */
   if ( high == 1u && low == 0u )
   {
-    return var + 2u;
+    return invperm[var] + 2u;
   }
 
-  const auto hash  = ( 12582917 * (int)var + 4256249 * (int)high + 741457 * (int)low );
-  const auto index = hash & mask;
-  auto*      q     = unique + index;
+  const auto bucket = unique_index( var, high, low );
 
-  while ( *q )
+  if ( concurrent )
+  {
+    std::lock_guard<std::mutex> lock( unique_locks[bucket & ( num_unique_locks - 1u )] );
+    return unique_find_or_add( bucket, var, high, low );
+  }
+  return unique_find_or_add( bucket, var, high, low );
+}
+
+unsigned dd_manager::unique_find_or_add( unsigned bucket, unsigned var, unsigned high, unsigned low )
+{
+  for ( auto q = unique[bucket]; q; q = nexts[q] )
   {
-    if ( nodes.at( *q ).var == var && nodes.at( *q ).high == high && nodes.at( *q ).low == low )
+    const auto& n = nodes[q];
+    if ( n.var == var && n.high == high && n.low == low )
     {
-      return *q;
+      return q;
     }
-    q = nexts + *q;
   }
 
-  if ( nnodes == nodes.size() )
+  const auto z = allocate_node();
+  nodes[z] = {var, high, low};
+
+  auto& head = unique[bucket];
+  nexts[z] = head;
+  head = z;
+
+  return z;
+}
+
+unsigned dd_manager::allocate_node()
+{
+  std::unique_lock<std::mutex> lock( alloc_mutex, std::defer_lock );
+  if ( concurrent ) { lock.lock(); }
+
+  /* node array is full, no garbage collection within operations and no
+     resizing while other tasks access the tables */
+  if ( nfree == 0u && nnodes == capacity() )
   {
-    std::cerr << "[e] dd capacity exceeded" << std::endl;
-    assert( false );
+    if ( concurrent ) { throw dd_capacity_exhausted(); }
+    grow();
+  }
+
+  unsigned z;
+  if ( nfree )
+  {
+    z = free_list;
+    free_list = nexts[z];
+    --nfree;
+  }
+  else
+  {
+    z = nnodes++;
+  }
+
+  peak_nodes = std::max( peak_nodes, size() );
+
+  return z;
+}
+
+unsigned dd_manager::run_concurrent( const std::function<unsigned()>& op )
+{
+  ++num_parallel_ops;
+
+  while ( true )
+  {
+    cache.set_concurrent( true );
+    concurrent = true;
+
+    try
+    {
+      const auto r = op();
+      cache.set_concurrent( false );
+      concurrent = false;
+      return r;
+    }
+    catch ( const dd_capacity_exhausted& )
+    {
+      cache.set_concurrent( false );
+      concurrent = false;
+      ++num_parallel_retries;
+      grow();
+    }
+    catch ( ... )
+    {
+      cache.set_concurrent( false );
+      concurrent = false;
+      throw;
+    }
+  }
+}
+
+void dd_manager::fork_join( const std::function<void()>& f, const std::function<void()>& g )
+{
+  /* the destructor of the group waits for f, also if g throws */
+  task_group group( *pool );
+  group.run( f );
+  g();
+  group.wait();
+}
+
+void dd_manager::set_parallel_apply( bool enable, unsigned num_threads, unsigned cutoff )
+{
+  parallel_enabled = enable;
+  local_pool.reset();
+  pool = nullptr;
+
+  if ( !enable ) { return; }
+
+  if ( num_threads > 0u )
+  {
+    local_pool.reset( new thread_pool( num_threads ) );
+  }
+  pool = local_pool ? local_pool.get() : &shared_thread_pool();
+
+  if ( !unique_locks )
+  {
+    unique_locks.reset( new std::mutex[num_unique_locks] );
+  }
+
+  /* a few more tasks than threads balance the uneven recursion trees */
+  if ( cutoff == 0u )
+  {
+    cutoff = 2u;
+    for ( auto n = pool->size(); n > 1u; n = ( n + 1u ) >> 1u ) { ++cutoff; }
+  }
+  fork_depth = cutoff;
+}
+
+void dd_manager::set_dynamic_reordering( bool enable, unsigned threshold )
+{
+  reorder_enabled   = enable;
+  reorder_threshold = threshold;
+}
+
+void dd_manager::reorder()
+{
+  if ( nvars < 2u ) { return; }
+
+  increment_timer t( &reorder_time );
+
+  /* start from live nodes only, such that size() is exact during sifting */
+  garbage_collect();
+
+  const auto first = 2u + nvars;
+  const auto shift = complement_edges ? 1u : 0u;
+  const auto before = size();
+
+  /* internal reference counts and nodes per level; variable nodes are
+     permanent, but need to be relabeled when their level moves */
+  irefs = refs;
+  level_nodes.assign( nvars, std::vector<unsigned>() );
+  for ( auto z = 2u; z < nnodes; ++z )
+  {
+    const auto& n = nodes[z];
+    if ( n.var == -1u ) { continue; }
+
+    level_nodes[n.var].push_back( z );
+    if ( z >= first )
+    {
+      ++irefs[n.high >> shift];
+      ++irefs[n.low >> shift];
+    }
+  }
+
+  /* sift variables with many nodes first */
+  std::vector<unsigned> vars( invperm );
+  std::vector<unsigned> count( nvars );
+  for ( auto v = 0u; v < nvars; ++v )
+  {
+    count[v] = level_nodes[perm[v]].size();
+  }
+  std::stable_sort( vars.begin(), vars.end(), [&count]( unsigned a, unsigned b ) { return count[a] > count[b]; } );
+
+  for ( auto v : vars )
+  {
+    sift_variable( v, 1.2 );
   }
 
-  *q = nnodes++;
-  nodes[*q].var  = var;
-  nodes[*q].high = high;
-  nodes[*q].low  = low;
+  irefs.clear();
+  level_nodes.clear();
+  cache.clear();
+
+  ++num_reorderings;
+  reorder_threshold = std::max( reorder_threshold, 2u * size() );
 
   if ( verbose )
   {
-    // std::cout << boost::format( "[i] created entry (%d, %d, %d) at index %d" ) % var % high % low % *q << std::endl;
+    std::cout << boost::format( "[i] reordering: %d -> %d nodes" ) % before % size() << std::endl;
+  }
+}
+
+void dd_manager::sift_variable( unsigned var, double max_growth )
+{
+  auto l = perm[var];
+  auto best_size = size();
+  auto best_level = l;
+
+  const auto move = [&]( bool down ) {
+    while ( down ? l + 1u < nvars : l > 0u )
+    {
+      swap_levels( down ? l : l - 1u );
+      l = down ? l + 1u : l - 1u;
+
+      if ( size() < best_size )
+      {
+        best_size = size();
+        best_level = l;
+      }
+      else if ( size() > max_growth * best_size )
+      {
+        break;
+      }
+    }
+  };
+
+  /* closer end first */
+  const auto down_first = l >= nvars / 2u;
+  move( down_first );
+  move( !down_first );
+
+  while ( l < best_level ) { swap_levels( l++ ); }
+  while ( l > best_level ) { swap_levels( --l ); }
+}
+
+void dd_manager::unique_insert( unsigned z )
+{
+  const auto& n = nodes[z];
+  auto& head = unique[unique_index( n.var, n.high, n.low )];
+  nexts[z] = head;
+  head = z;
+}
+
+void dd_manager::unique_remove( unsigned z )
+{
+  const auto& n = nodes[z];
+  auto* q = &unique[unique_index( n.var, n.high, n.low )];
+  while ( *q != z )
+  {
+    assert( *q );
+    q = &nexts[*q];
+  }
+  *q = nexts[z];
+}
+
+/* creates or finds a node while reordering and references it once */
+unsigned dd_manager::make_node( unsigned level, unsigned high, unsigned low )
+{
+  const auto shift = complement_edges ? 1u : 0u;
+
+  auto complement = 0u;
+  if ( complement_edges )
+  {
+    if ( high == low ) { ++irefs[high >> 1u]; return high; }
+    if ( low & 1u )
+    {
+      high ^= 1u;
+      low ^= 1u;
+      complement = 1u;
+    }
+  }
+  else if ( high == 0u )
+  {
+    ++irefs[low];
+    return low;
+  }
+
+  unsigned z = 0u;
+  if ( high == 1u && low == 0u )
+  {
+    z = invperm[level] + 2u;
+  }
+  else
+  {
+    for ( auto q = unique[unique_index( level, high, low )]; q; q = nexts[q] )
+    {
+      const auto& n = nodes[q];
+      if ( n.var == level && n.high == high && n.low == low )
+      {
+        z = q;
+        break;
+      }
+    }
+  }
+
+  if ( !z )
+  {
+    assert( nfree || nnodes < capacity() );
+    if ( nfree )
+    {
+      z = free_list;
+      free_list = nexts[z];
+      --nfree;
+    }
+    else
+    {
+      z = nnodes++;
+    }
+
+    nodes[z] = {level, high, low};
+    irefs[z] = 0u;
+    ++irefs[high >> shift];
+    ++irefs[low >> shift];
+    unique_insert( z );
+    level_nodes[level].push_back( z );
+  }
+
+  ++irefs[z];
+  return ( z << shift ) | complement;
+}
+
+/* removes a reference while reordering, frees nodes that become dead */
+void dd_manager::deref_edge( unsigned e )
+{
+  const auto first = 2u + nvars;
+  const auto shift = complement_edges ? 1u : 0u;
+
+  std::vector<unsigned> stack( 1u, e >> shift );
+  while ( !stack.empty() )
+  {
+    const auto z = stack.back();
+    stack.pop_back();
+
+    assert( irefs[z] > 0u );
+    if ( --irefs[z] > 0u || z < first ) { continue; }
+
+    unique_remove( z );
+    stack.push_back( nodes[z].high >> shift );
+    stack.push_back( nodes[z].low >> shift );
+
+    /* removed lazily from level_nodes */
+    nodes[z] = {-1u, -1u, -1u};
+    nexts[z] = free_list;
+    free_list = z;
+    ++nfree;
+  }
+}
+
+/* swaps the variables at levels l and l + 1, nodes keep their index */
+void dd_manager::swap_levels( unsigned l )
+{
+  const auto first = 2u + nvars;
+  const auto x = l, y = l + 1u;
+  ++num_swaps;
+
+  /* level lists are cleaned lazily: freed nodes may have been reused on
+     another level, or on the same level, which leaves a duplicate */
+  const auto cleanup = [this]( std::vector<unsigned>& list, unsigned level ) {
+    list.erase( std::remove_if( list.begin(), list.end(), [this, level]( unsigned z ) { return nodes[z].var != level; } ), list.end() );
+    std::sort( list.begin(), list.end() );
+    list.erase( std::unique( list.begin(), list.end() ), list.end() );
+  };
+
+  auto xs = std::move( level_nodes[x] );
+  auto ys = std::move( level_nodes[y] );
+  cleanup( xs, x );
+  cleanup( ys, y );
+
+  /* at most two new nodes per node on level x */
+  while ( nfree + ( capacity() - nnodes ) < 2u * xs.size() )
+  {
+    grow();
+  }
+
+  /* cofactors of edge e with respect to level y */
+  const auto cofactors = [this, y]( unsigned e, unsigned& e1, unsigned& e0 ) {
+    if ( complement_edges )
+    {
+      const auto& n = nodes[e >> 1u];
+      if ( n.var == y ) { e1 = n.high ^ ( e & 1u ); e0 = n.low ^ ( e & 1u ); }
+      else              { e1 = e0 = e; }
+    }
+    else
+    {
+      const auto& n = nodes[e];
+      if ( n.var == y ) { e1 = n.high; e0 = n.low; }
+      else              { e1 = 0u; e0 = e; }
+    }
+  };
+  const auto level_of = [this]( unsigned e ) { return nodes[complement_edges ? e >> 1u : e].var; };
+
+  struct pending_t
+  {
+    unsigned z, f11, f10, f01, f00;
+  };
+  std::vector<pending_t> pending;
+  std::vector<unsigned> independent;
+
+  for ( auto z : xs )
+  {
+    if ( z >= first ) { unique_remove( z ); }
+
+    const auto& n = nodes[z];
+    if ( level_of( n.high ) != y && level_of( n.low ) != y )
+    {
+      independent.push_back( z );
+    }
+    else
+    {
+      pending_t p{z};
+      cofactors( n.high, p.f11, p.f10 );
+      cofactors( n.low, p.f01, p.f00 );
+      pending.push_back( p );
+    }
+  }
+
+  for ( auto z : ys )
+  {
+    if ( z >= first ) { unique_remove( z ); }
+    nodes[z].var = x;
+    if ( z >= first ) { unique_insert( z ); }
+  }
+  for ( auto z : independent )
+  {
+    nodes[z].var = y;
+    if ( z >= first ) { unique_insert( z ); }
   }
 
-  return *q;
+  std::swap( invperm[x], invperm[y] );
+  perm[invperm[x]] = x;
+  perm[invperm[y]] = y;
+
+  level_nodes[x] = std::move( ys );
+  level_nodes[y] = std::move( independent );
+
+  for ( const auto& p : pending )
+  {
+    const auto high = make_node( y, p.f11, p.f01 );
+    const auto low  = make_node( y, p.f10, p.f00 );
+
+    const auto old_high = nodes[p.z].high;
+    const auto old_low  = nodes[p.z].low;
+
+    nodes[p.z] = {x, high, low};
+    unique_insert( p.z );
+    level_nodes[x].push_back( p.z );
+
+    deref_edge( old_high );
+    deref_edge( old_low );
+  }
 }
 
 }
@@ -37,46 +37,81 @@
 #ifndef DD_MANAGER_HPP
 #define DD_MANAGER_HPP
 
+#include <atomic>
+#include <cassert>
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <ostream>
 #include <vector>
 
 namespace cirkit
 {
 
+class thread_pool;
+
+/* Computed table, keys are two operands and the operation code, such that
+ * different operations never return each other's results.  Each set holds
+ * two entries with the most recently used one in front, which avoids that
+ * two interleaved operations (e.g., AND inside EXISTS) keep evicting each
+ * other when they hash to the same set. */
 class hash_cache
 {
 public:
-  using value_type     = std::tuple<unsigned, unsigned, unsigned, int>;
-  using container_type = std::vector<value_type>;
+  struct entry_t
+  {
+    unsigned arg0;
+    unsigned arg1;
+    unsigned op;
+    unsigned result;
+  };
+
+  using container_type = std::vector<entry_t>;
   using size_type      = container_type::size_type;
 
+  static constexpr unsigned no_op = -1u;
+
 public:
   hash_cache( size_type log_size );
-  int lookup( unsigned arg0, unsigned arg1, unsigned arg2 );
-  int insert( unsigned arg0, unsigned arg1, unsigned arg2, int res );
+  bool lookup( unsigned arg0, unsigned arg1, unsigned op, unsigned& result );
+  unsigned insert( unsigned arg0, unsigned arg1, unsigned op, unsigned result );
+
+  /* invalidates all entries */
+  void clear();
+  /* resizes to 2^log_size entries, invalidates all entries */
+  void resize( size_type log_size );
+  /* guards lookup and insert by striped locks while operations run in parallel */
+  inline void set_concurrent( bool enable ) { concurrent = enable; }
 
   std::size_t cache_size() const;
 
   std::size_t hit () const;
   std::size_t miss () const;
 private:
-  inline container_type::reference entry( unsigned arg0, unsigned arg1, unsigned arg2 )
+  inline unsigned set_index( unsigned arg0, unsigned arg1, unsigned op ) const
   {
-    return data[( 12582917 * (int)arg0 + 4256249 * (int)arg1 + 741457 * (int)arg2 ) & mask];
+    return ( 12582917u * arg0 + 4256249u * arg1 + 741457u * op ) & mask;
   }
 
+  bool lookup_set( entry_t* ent, unsigned arg0, unsigned arg1, unsigned op, unsigned& result );
+  void insert_set( entry_t* ent, unsigned arg0, unsigned arg1, unsigned op, unsigned result );
+
 private:
+  static constexpr unsigned num_locks = 1024u;
+
   container_type data;
   unsigned mask;
 
-  unsigned nhit;
-  unsigned nmiss;
+  bool concurrent = false;
+  std::unique_ptr<std::mutex[]> locks;
+
+  std::atomic<std::size_t> nhit;
+  std::atomic<std::size_t> nmiss;
 };
 
 struct dd_node
 {
-  unsigned var;
+  unsigned var;   /* level of the node's variable in the current order */
   unsigned high;
   unsigned low;
 
@@ -88,6 +123,29 @@ struct dd_node
 
 std::ostream& operator<<( std::ostream& os, const dd_node& z );
 
+/* Node storage and unique table shared by the BDD and ZDD packages.
+ *
+ * The node array, the unique table and the computed cache start with
+ * 2^log_max_objs entries and are doubled whenever they run full, such
+ * that log_max_objs is only a hint for the initial size.  Nodes are
+ * referenced by the bdd and zdd handles; when the occupancy exceeds
+ * gc_occupancy, the next handle operation first collects all nodes not
+ * reachable from a referenced node (mark-and-sweep).  Garbage collection
+ * never runs inside the recursive operations, which work on raw node
+ * indexes, but only when entering them through a handle.
+ *
+ * The variable order can be changed in place by sifting, either on demand
+ * or automatically when the number of nodes exceeds a threshold.  Nodes
+ * keep their index (and therefore their function) when levels are swapped,
+ * only the level stored in dd_node::var changes; get_var maps it back to
+ * the variable.
+ *
+ * In parallel apply mode, the top levels of the recursive operations are
+ * forked into tasks of a thread pool.  While such an operation runs, the
+ * unique table and the computed cache are guarded by striped locks and the
+ * node array cannot grow; a task that runs out of nodes aborts the
+ * operation, which is restarted after growing the tables.  Nodes created
+ * by the aborted attempt remain valid and are found again by the retry. */
 class dd_manager
 {
 public:
@@ -96,26 +154,130 @@ public:
 
   inline unsigned num_vars() const { return nvars; }
 
+  /* number of allocated nodes, including dead nodes that are not yet collected */
   unsigned size() const;
+  inline unsigned capacity() const { return nodes.size(); }
 
   unsigned get_var( unsigned z ) const;
+  unsigned get_level( unsigned z ) const;
   unsigned get_high( unsigned z ) const;
   unsigned get_low( unsigned z ) const;
 
+  /* external references to node z, maintained by the bdd and zdd handles */
+  inline void ref( unsigned z )   { ++refs[z]; }
+  inline void deref( unsigned z ) { assert( refs[z] > 0u ); --refs[z]; }
+
+  /* removes all nodes that are not reachable from a referenced node */
+  void garbage_collect();
+  inline void set_garbage_collection( bool enable ) { gc_enabled = enable; }
+
+  /* variable order */
+  inline unsigned level( unsigned var ) const            { return perm[var]; }
+  inline unsigned var_at_level( unsigned level ) const   { return invperm[level]; }
+  inline const std::vector<unsigned>& order() const      { return invperm; }
+
+  /* Rudell's sifting, moves each variable to its best level */
+  void reorder();
+  void set_dynamic_reordering( bool enable, unsigned threshold = 4096u );
+
+  /* num_threads = 0 uses shared_thread_pool(), cutoff is the number of
+     recursion levels that fork and is derived from the threads if 0 */
+  void set_parallel_apply( bool enable, unsigned num_threads = 0u, unsigned cutoff = 0u );
+  inline bool parallel_apply() const { return parallel_enabled; }
+
+  /* called by handle operations before they enter the recursive operations */
+  inline void safe_point()
+  {
+    if ( gc_enabled && nnodes - nfree >= gc_threshold ) { garbage_collect(); }
+    if ( reorder_enabled && nnodes - nfree >= reorder_threshold ) { reorder(); }
+  }
+
   void dump_stats ( std::ostream& stream ) const;
 
 protected:
   unsigned unique_lookup( unsigned var, unsigned high, unsigned low );
 
+  /* runs op with synchronized tables, restarts it after growing them when
+     the node array runs full */
+  unsigned run_concurrent( const std::function<unsigned()>& op );
+  /* runs f as a task and g in the calling thread, returns when both are done */
+  void fork_join( const std::function<void()>& f, const std::function<void()>& g );
+
+private:
+  inline unsigned unique_index( unsigned var, unsigned high, unsigned low ) const
+  {
+    return ( 12582917u * var + 4256249u * high + 741457u * low ) & mask;
+  }
+
+  /* doubles node array, unique table, and computed cache */
+  void grow();
+  /* rebuilds unique table and free list from the node array */
+  void rehash();
+
+  unsigned unique_find_or_add( unsigned bucket, unsigned var, unsigned high, unsigned low );
+  unsigned allocate_node();
+
+  /* reordering */
+  void unique_insert( unsigned z );
+  void unique_remove( unsigned z );
+  unsigned make_node( unsigned level, unsigned high, unsigned low );
+  void deref_edge( unsigned e );
+  void swap_levels( unsigned l );
+  void sift_variable( unsigned var, double max_growth );
+
 protected:
-  unsigned             nvars;
-  unsigned             nnodes = 0u;
-  unsigned             mask = 0u;
-  hash_cache           cache;
-  std::vector<dd_node> nodes;
-  bool                 verbose;
-  unsigned *           unique;
-  unsigned *           nexts;
+  unsigned              nvars;
+  unsigned              nnodes = 0u;
+  unsigned              mask = 0u;
+  hash_cache            cache;
+  std::vector<dd_node>  nodes;
+  bool                  verbose;
+  std::vector<unsigned> unique;
+  std::vector<unsigned> nexts;      /* next node in unique table chain, or next free node */
+  std::vector<unsigned> refs;
+
+  /* high and low of nodes are edges with a complement flag (BDD) */
+  bool                  complement_edges = false;
+
+  std::vector<unsigned> perm;       /* variable -> level */
+  std::vector<unsigned> invperm;    /* level -> variable */
+
+  unsigned              free_list = 0u;
+  unsigned              nfree = 0u;
+
+  /* garbage collection */
+  static constexpr double gc_occupancy = 0.8;
+  static constexpr double grow_occupancy = 0.5;
+  bool                  gc_enabled = true;
+  unsigned              gc_threshold = 0u;
+
+  /* dynamic reordering, irefs and level_nodes only exist while reordering */
+  bool                  reorder_enabled = false;
+  unsigned              reorder_threshold = 4096u;
+  std::vector<unsigned> irefs;
+  std::vector<std::vector<unsigned>> level_nodes;
+
+  /* parallel apply, concurrent is set while tasks access the tables */
+  static constexpr unsigned num_unique_locks = 1024u;
+  bool                  parallel_enabled = false;
+  bool                  concurrent = false;
+  unsigned              fork_depth = 0u;
+  std::unique_ptr<thread_pool> local_pool;
+  thread_pool*          pool = nullptr;
+  std::unique_ptr<std::mutex[]> unique_locks;
+  std::mutex            alloc_mutex;
+
+  /* statistics */
+  unsigned              peak_nodes = 0u;
+  unsigned              num_gc = 0u;
+  unsigned long         num_reclaimed = 0ul;
+  unsigned              num_resizes = 0u;
+  double                gc_time = 0.0;
+  unsigned              num_reorderings = 0u;
+  unsigned long         num_swaps = 0ul;
+  double                reorder_time = 0.0;
+  unsigned              num_parallel_ops = 0u;
+  unsigned              num_parallel_retries = 0u;
 };
 
 }
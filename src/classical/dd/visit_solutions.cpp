@@ -86,10 +86,11 @@ void visit_solutions_rec( unsigned level, const bdd& n, boost::dynamic_bitset<>&
   {
     return;
   }
-  if ( n.var() > level )
+  const auto var = level < n.manager->num_vars() ? n.manager->var_at_level( level ) : level;
+  if ( n.level() > level )
   {
-    x.reset( level ); visit_solutions_rec( level + 1u, n, x, f );
-    x.set( level );   visit_solutions_rec( level + 1u, n, x, f );
+    x.reset( var ); visit_solutions_rec( level + 1u, n, x, f );
+    x.set( var );   visit_solutions_rec( level + 1u, n, x, f );
   }
   else if ( n.index == 1u )
   {
@@ -99,11 +100,11 @@ void visit_solutions_rec( unsigned level, const bdd& n, boost::dynamic_bitset<>&
   {
     if ( n.low().index != 0u )
     {
-      x.reset( level ); visit_solutions_rec( level + 1u, n.low(), x, f );
+      x.reset( var ); visit_solutions_rec( level + 1u, n.low(), x, f );
     }
     if ( n.high().index != 0u )
     {
-      x.set( level );   visit_solutions_rec( level + 1u, n.high(), x, f );
+      x.set( var );   visit_solutions_rec( level + 1u, n.high(), x, f );
     }
   }
 }
@@ -119,7 +120,10 @@ void visit_paths_rec( const bdd& n, std::vector<tribool>& x, const visit_paths_f
     break;
   default:
     x[n.var()] = false; visit_paths_rec( n.low(), x, f );
-    std::fill( x.begin() + n.var(), x.end(), dontcare );
+    for ( auto l = n.level(); l < x.size(); ++l )
+    {
+      x[n.manager->var_at_level( l )] = dontcare;
+    }
     x[n.var()] = true;  visit_paths_rec( n.high(), x, f );
   }
 }
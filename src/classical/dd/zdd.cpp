@@ -67,11 +67,11 @@ unsigned zdd_manager::zdd_diff( unsigned z1, unsigned z2 )
   if ( z2 == 0u ) { return z1; }
   if ( z1 == z2 ) { return 0u; }
 
-  const auto r = cache.lookup( z1, z2, (unsigned)zdd_operation::diff );
-  if ( r >= 0 ) { return r; }
+  unsigned r;
+  if ( cache.lookup( z1, z2, (unsigned)zdd_operation::diff, r ) ) { return r; }
 
-  const auto& node1 = nodes.at( z1 );
-  const auto& node2 = nodes.at( z2 );
+  const auto node1 = nodes.at( z1 );
+  const auto node2 = nodes.at( z2 );
   unsigned rlow, rhigh, idx;
   if ( node1.var < node2.var )
   {
@@ -101,11 +101,11 @@ unsigned zdd_manager::zdd_union( unsigned z1, unsigned z2 )
   /* commutativity */
   if ( z1 > z2 ) { return zdd_union( z2, z1 ); }
 
-  const auto r = cache.lookup( z1, z2, (unsigned)zdd_operation::_union );
-  if ( r >= 0 ) { return r; }
+  unsigned r;
+  if ( cache.lookup( z1, z2, (unsigned)zdd_operation::_union, r ) ) { return r; }
 
-  const auto& node1 = nodes.at( z1 );
-  const auto& node2 = nodes.at( z2 );
+  const auto node1 = nodes.at( z1 );
+  const auto node2 = nodes.at( z2 );
   unsigned rlow, rhigh;
   if ( node1.var < node2.var )
   {
@@ -136,8 +136,8 @@ unsigned zdd_manager::zdd_intersection( unsigned z1, unsigned z2 )
   /* commutativity */
   if ( z1 > z2 ) { return zdd_intersection( z2, z1 ); }
 
-  const auto& node1 = nodes.at( z1 );
-  const auto& node2 = nodes.at( z2 );
+  const auto node1 = nodes.at( z1 );
+  const auto node2 = nodes.at( z2 );
   if ( node1.var < node2.var )
   {
     return zdd_intersection( node1.low, z2 );
@@ -147,8 +147,8 @@ unsigned zdd_manager::zdd_intersection( unsigned z1, unsigned z2 )
     return zdd_intersection( z1, node2.low );
   }
 
-  const auto r = cache.lookup( z1, z2, (unsigned)zdd_operation::intersection );
-  if ( r >= 0 ) { return r; }
+  unsigned r;
+  if ( cache.lookup( z1, z2, (unsigned)zdd_operation::intersection, r ) ) { return r; }
 
   auto rlow = zdd_intersection( node1.low, node2.low );
   auto rhigh = zdd_intersection( node1.high, node2.high );
@@ -167,11 +167,11 @@ unsigned zdd_manager::zdd_symmetric_difference( unsigned z1, unsigned z2 )
   /* commutativity */
   if ( z1 > z2 ) { return zdd_symmetric_difference( z2, z1 ); }
 
-  const auto r = cache.lookup( z1, z2, (unsigned)zdd_operation::symmetric_difference );
-  if ( r >= 0 ) { return r; }
+  unsigned r;
+  if ( cache.lookup( z1, z2, (unsigned)zdd_operation::symmetric_difference, r ) ) { return r; }
 
-  const auto& node1 = nodes.at( z1 );
-  const auto& node2 = nodes.at( z2 );
+  const auto node1 = nodes.at( z1 );
+  const auto node2 = nodes.at( z2 );
   unsigned rlow, rhigh;
   if ( node1.var < node2.var )
   {
@@ -195,8 +195,8 @@ unsigned zdd_manager::zdd_symmetric_difference( unsigned z1, unsigned z2 )
 unsigned zdd_manager::zdd_join( unsigned z1, unsigned z2 )
 {
   /* swapping */
-  const auto& node1 = nodes.at( z1 );
-  const auto& node2 = nodes.at( z2 );
+  const auto node1 = nodes.at( z1 );
+  const auto node2 = nodes.at( z2 );
 
   /* commutativity */
   if ( node1.var < node2.var || ( ( node1.var == node2.var ) && ( z1 > z2 ) ) ) { return zdd_join( z2, z1 ); }
@@ -205,8 +205,8 @@ unsigned zdd_manager::zdd_join( unsigned z1, unsigned z2 )
   if ( z1 == 0u ) { return 0u; }
   if ( z1 == 1u ) { return z2; }
 
-  const auto r = cache.lookup( z1, z2, (unsigned)zdd_operation::join );
-  if ( r >= 0 ) { return r; }
+  unsigned r;
+  if ( cache.lookup( z1, z2, (unsigned)zdd_operation::join, r ) ) { return r; }
 
   unsigned rlow, rhigh;
   if ( node1.var > node2.var )
@@ -230,8 +230,8 @@ unsigned zdd_manager::zdd_join( unsigned z1, unsigned z2 )
 unsigned zdd_manager::zdd_meet( unsigned z1, unsigned z2 )
 {
   /* swapping */
-  const auto& node1 = nodes.at( z1 );
-  const auto& node2 = nodes.at( z2 );
+  const auto node1 = nodes.at( z1 );
+  const auto node2 = nodes.at( z2 );
 
   /* commutativity */
   if ( node1.var < node2.var || ( ( node1.var == node2.var ) && ( z1 > z2 ) ) ) { return zdd_join( z2, z1 ); }
@@ -239,8 +239,8 @@ unsigned zdd_manager::zdd_meet( unsigned z1, unsigned z2 )
   /* terminating cases */
   if ( z1 <= 1u ) { return z1; }
 
-  const auto r = cache.lookup( z1, z2, (unsigned)zdd_operation::meet );
-  if ( r >= 0 ) { return r; }
+  unsigned r;
+  if ( cache.lookup( z1, z2, (unsigned)zdd_operation::meet, r ) ) { return r; }
 
   if ( node1.var > node2.var )
   {
@@ -263,8 +263,8 @@ unsigned zdd_manager::zdd_meet( unsigned z1, unsigned z2 )
 unsigned zdd_manager::zdd_delta( unsigned z1, unsigned z2 )
 {
   /* swapping */
-  const auto& node1 = nodes.at( z1 );
-  const auto& node2 = nodes.at( z2 );
+  const auto node1 = nodes.at( z1 );
+  const auto node2 = nodes.at( z2 );
 
   /* commutativity */
   if ( node1.var < node2.var || ( ( node1.var == node2.var ) && ( z1 > z2 ) ) ) { return zdd_delta( z2, z1 ); }
@@ -273,8 +273,8 @@ unsigned zdd_manager::zdd_delta( unsigned z1, unsigned z2 )
   if ( z1 == 0u ) { return 0u; }
   if ( z1 == 1u ) { return z2; }
 
-  const auto r = cache.lookup( z1, z2, (unsigned)zdd_operation::delta );
-  if ( r >= 0 ) { return r; }
+  unsigned r;
+  if ( cache.lookup( z1, z2, (unsigned)zdd_operation::delta, r ) ) { return r; }
 
   unsigned rlow, rhigh;
   if ( node1.var > node2.var )
@@ -300,11 +300,11 @@ unsigned zdd_manager::zdd_nonsub( unsigned z1, unsigned z2 )
   if ( z2 == 0u ) { return z1; }
   if ( z1 == z2 ) { return 0u; }
 
-  const auto r = cache.lookup( z1, z2, (unsigned)zdd_operation::nonsub );
-  if ( r >= 0 ) { return r; }
+  unsigned r;
+  if ( cache.lookup( z1, z2, (unsigned)zdd_operation::nonsub, r ) ) { return r; }
 
-  const auto& node1 = nodes.at( z1 );
-  const auto& node2 = nodes.at( z2 );
+  const auto node1 = nodes.at( z1 );
+  const auto node2 = nodes.at( z2 );
 
   unsigned rlow, rhigh;
 
@@ -333,16 +333,16 @@ unsigned zdd_manager::zdd_nonsup( unsigned z1, unsigned z2 )
   if ( z2 == 0u ) { return z1; }
   if ( z1 == z2 ) { return 0u; }
 
-  const auto& node1 = nodes.at( z1 );
-  const auto& node2 = nodes.at( z2 );
+  const auto node1 = nodes.at( z1 );
+  const auto node2 = nodes.at( z2 );
 
   if ( node1.var > node2.var )
   {
     return zdd_nonsup( z1, node2.low );
   }
 
-  const auto r = cache.lookup( z1, z2, (unsigned)zdd_operation::nonsup );
-  if ( r >= 0 ) { return r; }
+  unsigned r;
+  if ( cache.lookup( z1, z2, (unsigned)zdd_operation::nonsup, r ) ) { return r; }
 
   unsigned rlow, rhigh;
 
@@ -368,10 +368,10 @@ unsigned zdd_manager::zdd_minhit( unsigned z )
   if ( z == 0u ) { return 1u; }
   if ( z == 1u ) { return 0u; }
 
-  const auto r = cache.lookup( z, z, (unsigned)zdd_operation::minhit );
-  if ( r >= 0 ) { return r; }
+  unsigned r;
+  if ( cache.lookup( z, z, (unsigned)zdd_operation::minhit, r ) ) { return r; }
 
-  const auto& node = nodes.at( z );
+  const auto node = nodes.at( z );
   auto rtmp = zdd_union( node.low, node.high );
   auto rlow = zdd_minhit( rtmp );
   rtmp = zdd_minhit( node.low );
@@ -408,17 +408,35 @@ std::ostream& operator<<( std::ostream& os, const zdd_manager& mgr )
 zdd& zdd::operator=( const zdd& other )
 {
   if ( this == &other ) { return *this; }
-  assert( !manager || manager == other.manager );
+  assert( !manager || !other.manager || manager == other.manager );
+  if ( other.manager ) { other.manager->ref( other.index ); }
+  if ( manager )       { manager->deref( index ); }
   manager = other.manager;
   index   = other.index;
   return *this;
 }
 
+zdd& zdd::operator=( zdd&& other ) noexcept
+{
+  if ( this == &other ) { return *this; }
+  assert( !manager || !other.manager || manager == other.manager );
+  if ( manager ) { manager->deref( index ); }
+  manager = other.manager;
+  index   = other.index;
+  other.manager = nullptr;
+  return *this;
+}
+
 unsigned zdd::var() const
 {
   return manager->get_var( index );
 }
 
+unsigned zdd::level() const
+{
+  return manager->get_level( index );
+}
+
 zdd zdd::high() const
 {
   return zdd( manager, manager->get_high( index ) );
@@ -432,59 +450,69 @@ zdd zdd::low() const
 zdd zdd::operator-( const zdd& other ) const
 {
   assert( manager == other.manager );
+  manager->safe_point();
   return zdd( manager, manager->zdd_diff( index, other.index ) );
 }
 
 zdd zdd::operator||( const zdd& other ) const
 {
   assert( manager == other.manager );
+  manager->safe_point();
   return zdd( manager, manager->zdd_union( index, other.index ) );
 }
 
 zdd zdd::operator&&( const zdd& other ) const
 {
   assert( manager == other.manager );
+  manager->safe_point();
   return zdd( manager, manager->zdd_intersection( index, other.index ) );
 }
 
 zdd zdd::operator^( const zdd& other ) const
 {
   assert( manager == other.manager );
+  manager->safe_point();
   return zdd( manager, manager->zdd_symmetric_difference( index, other.index ) );
 }
 
 zdd zdd::operator+( const zdd& other ) const
 {
   assert( manager == other.manager );
+  manager->safe_point();
   return zdd( manager, manager->zdd_join( index, other.index ) );
 }
 
 zdd zdd::operator*( const zdd& other ) const
 {
   assert( manager == other.manager );
+  manager->safe_point();
   return zdd( manager, manager->zdd_meet( index, other.index ) );
 }
 
 zdd zdd::delta( const zdd& other ) const
 {
   assert( manager == other.manager );
+  manager->safe_point();
   return zdd( manager, manager->zdd_delta( index, other.index ) );
 }
 
 zdd zdd::nonsub( const zdd& other ) const
 {
   assert( manager == other.manager );
+  manager->safe_point();
   return zdd( manager, manager->zdd_nonsub( index, other.index ) );
 }
 
 zdd zdd::nonsup( const zdd& other ) const
 {
   assert( manager == other.manager );
+  manager->safe_point();
   return zdd( manager, manager->zdd_nonsup( index, other.index ) );
 }
 
 zdd zdd::minhit() const
 {
+  manager->safe_point();
   return zdd( manager, manager->zdd_minhit( index ) );
 }
 
@@ -51,14 +51,16 @@ class zdd_manager;
 struct zdd
 {
   zdd() : manager( nullptr ), index( 0u ) {}
-  zdd( zdd_manager* manager, unsigned index )
-    : manager( manager ),
-      index( index ) {}
-  zdd( const zdd& other ) : manager( other.manager ), index( other.index ) {}
+  zdd( zdd_manager* manager, unsigned index );
+  zdd( const zdd& other );
+  zdd( zdd&& other ) noexcept;
+  ~zdd();
 
   zdd& operator=( const zdd& other );
+  zdd& operator=( zdd&& other ) noexcept;
 
   unsigned var() const;
+  unsigned level() const;
   zdd high() const;
   zdd low() const;
 
@@ -112,6 +114,33 @@ public:
   friend std::ostream& operator<<( std::ostream& os, const zdd_manager& mgr );
 };
 
+/* handles keep their node alive, they must not outlive their manager */
+inline zdd::zdd( zdd_manager* manager, unsigned index )
+  : manager( manager ),
+    index( index )
+{
+  if ( manager ) { manager->ref( index ); }
+}
+
+inline zdd::zdd( const zdd& other )
+  : manager( other.manager ),
+    index( other.index )
+{
+  if ( manager ) { manager->ref( index ); }
+}
+
+inline zdd::zdd( zdd&& other ) noexcept
+  : manager( other.manager ),
+    index( other.index )
+{
+  other.manager = nullptr;
+}
+
+inline zdd::~zdd()
+{
+  if ( manager ) { manager->deref( index ); }
+}
+
 }
 
 #endif
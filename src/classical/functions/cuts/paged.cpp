@@ -26,15 +26,20 @@
 
 #include "paged.hpp"
 
+#include <algorithm>
+#include <iterator>
+#include <limits>
 #include <map>
-#include <mutex>
+#include <unordered_map>
 
 #include <core/utils/bitset_utils.hpp>
 #include <core/utils/range_utils.hpp>
 #include <core/utils/timer.hpp>
 #include <classical/functions/compute_levels.hpp>
+#include <classical/functions/cuts/priority.hpp>
 #include <classical/functions/parallel_compute.hpp>
 #include <classical/functions/simulate_aig.hpp>
+#include <classical/utils/static_cut_simulation.hpp>
 
 #include <boost/assign/std/vector.hpp>
 #include <boost/dynamic_bitset.hpp>
@@ -60,10 +65,10 @@ namespace cirkit
  ******************************************************************************/
 
 paged_aig_cuts::paged_aig_cuts( const aig_graph& aig, unsigned k, bool parallel, unsigned priority )
-  : _aig( aig ),
+  : _aig( &aig ),
     _k( k ),
     _priority( priority ),
-    data( num_vertices( _aig ) )
+    data( num_vertices( aig ) )
 {
   _levels = compute_levels( aig );
 
@@ -77,6 +82,15 @@ paged_aig_cuts::paged_aig_cuts( const aig_graph& aig, unsigned k, bool parallel,
   }
 }
 
+paged_aig_cuts::paged_aig_cuts( const aig_compact& aig, unsigned k, unsigned priority )
+  : _compact( &aig ),
+    _k( k ),
+    _priority( priority ),
+    data( aig.size() )
+{
+  enumerate_compact();
+}
+
 unsigned paged_aig_cuts::total_cut_count() const
 {
   return data.sets_count();
@@ -104,6 +118,27 @@ boost::iterator_range<paged_memory::iterator> paged_aig_cuts::cuts( aig_node nod
 
 tt paged_aig_cuts::simulate( aig_node node, const paged_aig_cuts::cut& c ) const
 {
+  if ( c.size() <= 6u )
+  {
+    return from_kitty( simulate_static<6>( node, c ) );
+  }
+  else if ( c.size() <= 8u )
+  {
+    return from_kitty( simulate_static<8>( node, c ), c.size() );
+  }
+  else if ( c.size() <= 16u )
+  {
+    return from_kitty( simulate_static<16>( node, c ), c.size() );
+  }
+
+  if ( _compact )
+  {
+    return simulate_compact_cone<tt>( node, c, tt_const0(),
+                                      []( unsigned i ) { return tt_nth_var( i ); },
+                                      []( const tt& t ) { return ~t; },
+                                      []( tt t1, tt t2 ) { tt_align( t1, t2 ); return t1 & t2; } );
+  }
+
   std::map<aig_node, tt> inputs;
   auto i = 0u;
   for ( const auto& child : c )
@@ -114,11 +149,42 @@ tt paged_aig_cuts::simulate( aig_node node, const paged_aig_cuts::cut& c ) const
   tt_simulator tt_sim;
   aig_partial_node_assignment_simulator<tt> sim( tt_sim, inputs, tt_const0() );
 
-  return simulate_aig_node( _aig, node, sim );
+  return simulate_aig_node( *_aig, node, sim );
+}
+
+template<int NumVars>
+kitty::static_truth_table<NumVars> paged_aig_cuts::simulate_static( aig_node node, const paged_aig_cuts::cut& c ) const
+{
+  using tt_t = kitty::static_truth_table<NumVars>;
+  assert( c.size() <= static_cast<unsigned>( NumVars ) );
+
+  if ( _compact )
+  {
+    return simulate_compact_cone<tt_t>( node, c, tt_t(),
+                                        []( unsigned i ) { tt_t t; kitty::create_nth_var( t, i ); return t; },
+                                        []( const tt_t& t ) { return ~t; },
+                                        []( const tt_t& t1, const tt_t& t2 ) { return t1 & t2; } );
+  }
+
+  return simulate_cut_static<NumVars>( *_aig, node, c.begin(), c.end(),
+                                       []( const tt_t* v, unsigned ) { return v[0] & v[1]; } );
 }
 
+template kitty::static_truth_table<4> paged_aig_cuts::simulate_static<4>( aig_node, const paged_aig_cuts::cut& ) const;
+template kitty::static_truth_table<6> paged_aig_cuts::simulate_static<6>( aig_node, const paged_aig_cuts::cut& ) const;
+template kitty::static_truth_table<8> paged_aig_cuts::simulate_static<8>( aig_node, const paged_aig_cuts::cut& ) const;
+template kitty::static_truth_table<16> paged_aig_cuts::simulate_static<16>( aig_node, const paged_aig_cuts::cut& ) const;
+
 unsigned paged_aig_cuts::depth( aig_node node, const paged_aig_cuts::cut& c ) const
 {
+  if ( _compact )
+  {
+    return simulate_compact_cone<unsigned>( node, c, 0u,
+                                            []( unsigned i ) { return 0u; },
+                                            []( unsigned d ) { return d; },
+                                            []( unsigned d1, unsigned d2 ) { return std::max( d1, d2 ) + 1u; } );
+  }
+
   std::map<aig_node, unsigned> inputs;
   for ( const auto& child : c )
   {
@@ -128,7 +194,7 @@ unsigned paged_aig_cuts::depth( aig_node node, const paged_aig_cuts::cut& c ) co
   depth_simulator depth_sim;
   aig_partial_node_assignment_simulator<unsigned> sim( depth_sim, inputs, 0u );
 
-  return simulate_aig_node( _aig, node, sim );
+  return simulate_aig_node( *_aig, node, sim );
 }
 
 void paged_aig_cuts::enumerate()
@@ -136,14 +202,14 @@ void paged_aig_cuts::enumerate()
   reference_timer t( &_enumeration_time );
 
   /* topsort */
-  std::vector<unsigned> topsort( num_vertices( _aig ) );
-  boost::topological_sort( _aig, topsort.begin() );
+  std::vector<unsigned> topsort( num_vertices( *_aig ) );
+  boost::topological_sort( *_aig, topsort.begin() );
 
   /* loop */
   _top_index = 0u;
   for ( auto n : topsort )
   {
-    if ( out_degree( n, _aig ) == 0u )
+    if ( out_degree( n, *_aig ) == 0u )
     {
       /* constant */
       if ( n == 0u )
@@ -161,7 +227,7 @@ void paged_aig_cuts::enumerate()
       data.append_begin( n );
 
       /* get children */
-      auto it = adjacent_vertices( n, _aig ).first;
+      auto it = adjacent_vertices( n, *_aig ).first;
       const auto n1 = *it++;
       const auto n2 = *it;
 
@@ -177,114 +243,237 @@ void paged_aig_cuts::enumerate()
 void paged_aig_cuts::enumerate_parallel()
 {
   reference_timer t( &_enumeration_time );
-  std::mutex mutex;
 
   /* constant */
   data.assign_empty( 0u );
 
-  auto on_input = [this, &mutex]( aig_node n ) {
-    mutex.lock();
-    this->data.assign_singleton( n, n );
-    mutex.unlock();
+  /* cuts of a level are computed in parallel from the cuts of lower levels,
+     they are written to data after the level is complete, since appending
+     to data may invalidate the cuts that are read by other workers */
+  const auto size = boost::num_vertices( *_aig );
+  std::vector<std::vector<std::vector<unsigned>>> local_cuts( size );
+
+  auto on_input = []( aig_node n ) {};
+
+  auto on_and = [this, &local_cuts]( aig_node n, const aig_function& c1, const aig_function& c2 ) {
+    auto& node_cuts = local_cuts[n];
+    for ( auto& cut : this->enumerate_local_cuts( c1.node, c2.node ) )
+    {
+      node_cuts.push_back( std::move( cut.first ) );
+    }
   };
 
-  const auto size = boost::num_vertices( _aig );
-  auto on_and = [this, &mutex, &size]( aig_node n, const aig_function& c1, const aig_function& c2 ) {
-    const auto local_cuts = this->enumerate_local_cuts( c1.node, c2.node, size );
+  auto on_level = [this, &local_cuts]( const std::vector<aig_node>& level ) {
+    for ( auto n : level )
+    {
+      if ( out_degree( n, *this->_aig ) == 0u )
+      {
+        this->data.assign_singleton( n, n );
+        continue;
+      }
+
+      this->data.append_begin( n );
+      for ( const auto& cut : local_cuts[n] )
+      {
+        this->data.append_set( n, cut );
+      }
+      this->data.append_singleton( n, n );
 
-    mutex.lock();
-    this->data.append_begin( n );
-    for ( const auto& cut : local_cuts )
+      std::vector<std::vector<unsigned>>().swap( local_cuts[n] );
+    }
+  };
+
+  parallel_process( *_aig, on_input, on_and, on_level );
+}
+
+void paged_aig_cuts::enumerate_compact()
+{
+  reference_timer t( &_enumeration_time );
+
+  const auto& aig = *_compact;
+
+  /* node indexes are a topological order */
+  auto hint = _levels.end();
+  for ( aig_compact::node_t n = 0u; n < aig.size(); ++n )
+  {
+    if ( aig.is_constant( n ) )
+    {
+      data.assign_empty( 0u );
+      hint = _levels.emplace_hint( hint, n, 0u );
+    }
+    else if ( aig.is_ci( n ) )
     {
-      this->data.append_set( n, get_index_vector( cut.first ) );
+      data.assign_singleton( n, n );
+      hint = _levels.emplace_hint( hint, n, 0u );
     }
+    else
+    {
+      const auto n1 = aig.fanin( n, 0u ).node;
+      const auto n2 = aig.fanin( n, 1u ).node;
+      hint = _levels.emplace_hint( hint, n, std::max( _levels.at( n1 ), _levels.at( n2 ) ) + 1u );
 
-    this->data.append_singleton( n, n );
-    mutex.unlock();
+      data.append_begin( n );
+      for ( const auto& cut : enumerate_local_cuts( n1, n2 ) )
+      {
+        data.append_set( n, cut.first );
+      }
+      data.append_singleton( n, n );
+    }
+  }
+}
+
+template<typename T, typename LeafFn, typename InvertFn, typename AndFn>
+T paged_aig_cuts::simulate_compact_cone( aig_node node, const cut& c, const T& constant, LeafFn&& leaf, InvertFn&& invert, AndFn&& and_op ) const
+{
+  const auto& aig = *_compact;
+
+  /* scratch memory is reused across calls */
+  thread_local std::vector<std::pair<aig_node, T>> values;
+  thread_local std::vector<aig_node>               cone;
+  thread_local std::vector<aig_node>               stack;
+  values.clear();
+  cone.clear();
+  stack.assign( 1u, node );
+
+  values.emplace_back( 0u, constant );
+  auto i = 0u;
+  for ( const auto& child : c )
+  {
+    values.emplace_back( child, leaf( i++ ) );
+  }
+
+  const auto find = []( aig_node n ) -> const T* {
+    for ( const auto& v : values )
+    {
+      if ( v.first == n ) { return &v.second; }
+    }
+    return nullptr;
+  };
+
+  /* collect cone, sorted node indexes are a topological order */
+  while ( !stack.empty() )
+  {
+    const auto n = stack.back();
+    stack.pop_back();
+
+    if ( find( n ) || boost::find( cone, n ) != cone.end() ) { continue; }
+    assert( aig.is_and( n ) && "cut does not cover node" );
+
+    cone.push_back( n );
+    stack.push_back( aig.fanin( n, 0u ).node );
+    stack.push_back( aig.fanin( n, 1u ).node );
+  }
+  boost::sort( cone );
+
+  const auto value = [&find, &invert]( const aig_function& f ) -> T {
+    const auto& v = *find( f.node );
+    return f.complemented ? invert( v ) : v;
   };
 
-  parallel_process( _aig, on_input, on_and );
+  for ( const auto& n : cone )
+  {
+    const auto v1 = value( aig.fanin( n, 0u ) );
+    const auto v2 = value( aig.fanin( n, 1u ) );
+    values.emplace_back( n, and_op( v1, v2 ) );
+  }
+
+  return *find( node );
 }
 
-std::vector<std::pair<boost::dynamic_bitset<>, unsigned>> paged_aig_cuts::enumerate_local_cuts( aig_node n1, aig_node n2, unsigned max_cut_size )
+std::vector<std::pair<std::vector<unsigned>, unsigned>> paged_aig_cuts::enumerate_local_cuts( aig_node n1, aig_node n2 )
 {
-  std::vector<std::pair<boost::dynamic_bitset<>, unsigned>> local_cuts;
+  /* leaves are sorted, signatures filter the subset checks */
+  struct local_cut
+  {
+    std::vector<unsigned> leaves;
+    uint64_t              signature;
+    unsigned              min_level;
+  };
+  std::vector<local_cut> local_cuts;
+
+  const auto subset = []( const local_cut& c1, const local_cut& c2 ) {
+    return ( c1.signature & c2.signature ) == c1.signature && c1.leaves.size() <= c2.leaves.size() &&
+           std::includes( c2.leaves.begin(), c2.leaves.end(), c1.leaves.begin(), c1.leaves.end() );
+  };
 
+  local_cut new_cut;
   for ( const auto& c1 : cuts( n1 ) )
   {
     for ( const auto& c2 : cuts( n2 ) )
     {
-      auto min_level = std::numeric_limits<unsigned>::max();
-      boost::dynamic_bitset<> new_cut( max_cut_size );
-      auto f = [&new_cut, &min_level, this]( unsigned pos ) {
-        new_cut.set( pos );
-        min_level = std::min( min_level, this->_levels.at( pos ) );
-      };
-      std::for_each( c1.begin(), c1.end(), f );
-      std::for_each( c2.begin(), c2.end(), f );
-
-      const auto size = new_cut.count();
-
-      if ( size <= _k )
-      {
-        auto first_subsume = true;
-        auto add = true;
+      new_cut.signature = 0u;
+      for ( auto l : c1 ) { new_cut.signature |= cut_signature( l ); }
+      for ( auto l : c2 ) { new_cut.signature |= cut_signature( l ); }
+      if ( static_cast<unsigned>( __builtin_popcountll( new_cut.signature ) ) > _k ) { continue; }
 
-        auto l = 0u;
-        while ( l < local_cuts.size() )
-        {
-          auto cut = local_cuts[l].first;
+      new_cut.leaves.clear();
+      std::set_union( c1.begin(), c1.end(), c2.begin(), c2.end(), std::back_inserter( new_cut.leaves ) );
+      if ( new_cut.leaves.size() > _k ) { continue; }
+
+      new_cut.min_level = std::numeric_limits<unsigned>::max();
+      for ( auto l : new_cut.leaves )
+      {
+        new_cut.min_level = std::min( new_cut.min_level, _levels.at( l ) );
+      }
 
-          /* same cut */
-          if ( cut == new_cut ) { add = false; break; }
+      auto first_subsume = true;
+      auto add = true;
 
-          /* cut subsumes new_cut */
-          if ( ( cut & new_cut ) == new_cut ) { add = false; break; }
+      auto l = 0u;
+      while ( l < local_cuts.size() )
+      {
+        /* cut subsumes new_cut (or is the same) */
+        if ( subset( local_cuts[l], new_cut ) ) { add = false; break; }
 
-          /* new_cut subsumes cut */
-          if ( ( cut & new_cut ) == cut )
+        /* new_cut subsumes cut */
+        if ( subset( new_cut, local_cuts[l] ) )
+        {
+          add = false;
+          if ( first_subsume )
           {
-            add = false;
-            if ( first_subsume )
-            {
-              local_cuts[l] = {new_cut, min_level};
-              first_subsume = false;
-            }
-            else
-            {
-              local_cuts[l] = local_cuts.back();
-              local_cuts.pop_back();
-            }
+            local_cuts[l] = new_cut;
+            first_subsume = false;
+          }
+          else
+          {
+            local_cuts[l] = std::move( local_cuts.back() );
+            local_cuts.pop_back();
+            continue;
           }
-
-          ++l;
         }
 
-        if ( add )
-        {
-          local_cuts += std::make_pair( new_cut, min_level );
-        }
+        ++l;
+      }
+
+      if ( add )
+      {
+        local_cuts.push_back( new_cut );
       }
     }
   }
 
-  boost::sort( local_cuts, []( const std::pair<boost::dynamic_bitset<>, unsigned>& e1,
-                               const std::pair<boost::dynamic_bitset<>, unsigned>& e2 ) {
-                 return ( e1.second > e2.second ) || ( e1.second == e2.second && e1.first.count() < e2.first.count() ); } );
+  boost::sort( local_cuts, []( const local_cut& e1, const local_cut& e2 ) {
+                 return ( e1.min_level > e2.min_level ) || ( e1.min_level == e2.min_level && e1.leaves.size() < e2.leaves.size() ); } );
 
   if ( local_cuts.size() > _priority )
   {
     local_cuts.resize( _priority );
   }
 
-  return local_cuts;
+  std::vector<std::pair<std::vector<unsigned>, unsigned>> result;
+  result.reserve( local_cuts.size() );
+  for ( auto& c : local_cuts )
+  {
+    result.emplace_back( std::move( c.leaves ), c.min_level );
+  }
+  return result;
 }
 
 void paged_aig_cuts::enumerate_node_with_bitsets( aig_node n, aig_node n1, aig_node n2 )
 {
-  for ( const auto& cut : enumerate_local_cuts( n1, n2, _top_index ) )
+  for ( const auto& cut : enumerate_local_cuts( n1, n2 ) )
   {
-    data.append_set( n, get_index_vector( cut.first ) );
+    data.append_set( n, cut.first );
   }
 }
 
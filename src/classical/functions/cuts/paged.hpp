@@ -44,6 +44,7 @@
 
 #include <core/utils/paged_memory.hpp>
 #include <classical/aig.hpp>
+#include <classical/aig_compact.hpp>
 #include <classical/utils/truth_table_utils.hpp>
 
 namespace cirkit
@@ -55,6 +56,7 @@ public:
   using cut = paged_memory::set;
 
   paged_aig_cuts( const aig_graph& aig, unsigned k, bool parallel = true, unsigned priority = 8u );
+  paged_aig_cuts( const aig_compact& aig, unsigned k, unsigned priority = 8u );
 
   unsigned total_cut_count() const;
   double enumeration_time() const;
@@ -64,17 +66,26 @@ public:
   boost::iterator_range<paged_memory::iterator> cuts( aig_node node );
 
   tt simulate( aig_node node, const cut& c ) const;
+
+  /* does not allocate memory, c must not have more than NumVars leafs */
+  template<int NumVars>
+  kitty::static_truth_table<NumVars> simulate_static( aig_node node, const cut& c ) const;
   unsigned depth( aig_node node, const cut& c ) const;
 
 private:
   void enumerate();
   void enumerate_node_with_bitsets( aig_node n, aig_node n1, aig_node n2 );
-  std::vector<std::pair<boost::dynamic_bitset<>, unsigned>> enumerate_local_cuts( aig_node n1, aig_node n2, unsigned max_cut_size );
+  std::vector<std::pair<std::vector<unsigned>, unsigned>> enumerate_local_cuts( aig_node n1, aig_node n2 );
 
   void enumerate_parallel();
+  void enumerate_compact();
+
+  template<typename T, typename LeafFn, typename InvertFn, typename AndFn>
+  T simulate_compact_cone( aig_node node, const cut& c, const T& constant, LeafFn&& leaf, InvertFn&& invert, AndFn&& and_op ) const;
 
 private:
-  const aig_graph&             _aig;
+  const aig_graph*             _aig = nullptr;
+  const aig_compact*           _compact = nullptr;
   unsigned                     _k;
   unsigned                     _priority = 8u;
   paged_memory                 data;
@@ -0,0 +1,203 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#include "priority.hpp"
+
+#include <boost/graph/topological_sort.hpp>
+
+#include <core/utils/graph_utils.hpp>
+#include <core/utils/timer.hpp>
+#include <classical/utils/aig_utils.hpp>
+#include <classical/mig/mig_utils.hpp>
+
+namespace cirkit
+{
+
+/******************************************************************************
+ * Types                                                                      *
+ ******************************************************************************/
+
+/******************************************************************************
+ * Private functions                                                          *
+ ******************************************************************************/
+
+template<unsigned K>
+priority_cuts<K> make_priority_cuts( std::size_t num_nodes, const properties::ptr& settings )
+{
+  const auto priority = get( settings, "priority", 8u );
+  const auto cost     = get( settings, "cost",     cut_cost::area_flow );
+
+  return priority_cuts<K>( num_nodes, priority, make_cut_compare<K>( cost ) );
+}
+
+/* fanout counts including references from outputs */
+template<typename Graph, typename Outputs>
+std::vector<unsigned> compute_fanout_counts( const Graph& g, const Outputs& outputs )
+{
+  auto fanout = precompute_in_degrees( g );
+  for ( const auto& o : outputs )
+  {
+    fanout[o.first.node]++;
+  }
+  return fanout;
+}
+
+template<unsigned K, typename Graph, typename Outputs, typename GateFn>
+priority_cuts<K> compute_priority_cuts_for_graph( const Graph& g, unsigned constant, const Outputs& outputs,
+                                                  const properties::ptr& settings, const properties::ptr& statistics, GateFn&& gate )
+{
+  properties_timer t( statistics );
+
+  auto cuts = make_priority_cuts<K>( boost::num_vertices( g ), settings );
+  const auto fanout = compute_fanout_counts( g, outputs );
+
+  /* reverse topological order, fanins come first */
+  std::vector<unsigned> topsort( boost::num_vertices( g ) );
+  boost::topological_sort( g, topsort.begin() );
+
+  for ( auto n : topsort )
+  {
+    if ( n == constant )
+    {
+      cuts.add_constant( n );
+    }
+    else if ( boost::out_degree( n, g ) == 0u )
+    {
+      cuts.add_input( n );
+    }
+    else
+    {
+      gate( cuts, n, fanout[n] );
+    }
+  }
+
+  set( statistics, "total_cut_count", cuts.total_cut_count() );
+  set( statistics, "memory", cuts.memory() );
+
+  return cuts;
+}
+
+template<unsigned K, unsigned M, typename Graph, typename GateFn>
+void add_graph_gate( priority_cuts<K>& cuts, const Graph& g, unsigned n, unsigned fanout, GateFn&& gate )
+{
+  const auto& complement = boost::get( boost::edge_complement, g );
+
+  std::array<unsigned, M> fanins;
+  std::array<bool, M>     complements;
+
+  auto i = 0u;
+  for ( const auto& e : boost::make_iterator_range( boost::out_edges( n, g ) ) )
+  {
+    assert( i < M );
+    fanins[i] = boost::target( e, g );
+    complements[i] = complement[e];
+    ++i;
+  }
+
+  cuts.template add_gate<M>( n, fanins, complements, fanout, gate );
+}
+
+template<unsigned K>
+inline kitty::static_truth_table<K> gate_and( const std::array<kitty::static_truth_table<K>, 2u>& v )
+{
+  return v[0] & v[1];
+}
+
+template<unsigned K>
+inline kitty::static_truth_table<K> gate_xor( const std::array<kitty::static_truth_table<K>, 2u>& v )
+{
+  return v[0] ^ v[1];
+}
+
+template<unsigned K>
+inline kitty::static_truth_table<K> gate_maj( const std::array<kitty::static_truth_table<K>, 3u>& v )
+{
+  return kitty::ternary_majority( v[0], v[1], v[2] );
+}
+
+/******************************************************************************
+ * Public functions                                                           *
+ ******************************************************************************/
+
+template<unsigned K>
+priority_cuts<K> compute_priority_cuts( const aig_graph& aig, const properties::ptr& settings, const properties::ptr& statistics )
+{
+  const auto& info = aig_info( aig );
+
+  return compute_priority_cuts_for_graph<K>( aig, info.constant, info.outputs, settings, statistics,
+                                             [&aig]( priority_cuts<K>& cuts, unsigned n, unsigned fanout ) {
+                                               add_graph_gate<K, 2u>( cuts, aig, n, fanout, gate_and<K> );
+                                             } );
+}
+
+template<unsigned K>
+priority_cuts<K> compute_priority_cuts( const mig_graph& mig, const properties::ptr& settings, const properties::ptr& statistics )
+{
+  const auto& info = mig_info( mig );
+
+  return compute_priority_cuts_for_graph<K>( mig, info.constant, info.outputs, settings, statistics,
+                                             [&mig]( priority_cuts<K>& cuts, unsigned n, unsigned fanout ) {
+                                               add_graph_gate<K, 3u>( cuts, mig, n, fanout, gate_maj<K> );
+                                             } );
+}
+
+template<unsigned K>
+priority_cuts<K> compute_priority_cuts( const xmg_graph& xmg, const properties::ptr& settings, const properties::ptr& statistics )
+{
+  const auto& g = xmg.graph();
+
+  return compute_priority_cuts_for_graph<K>( g, xmg.get_constant( false ).node, xmg.outputs(), settings, statistics,
+                                             [&g, &xmg]( priority_cuts<K>& cuts, unsigned n, unsigned fanout ) {
+                                               if ( xmg.is_xor( n ) )
+                                               {
+                                                 add_graph_gate<K, 2u>( cuts, g, n, fanout, gate_xor<K> );
+                                               }
+                                               else
+                                               {
+                                                 add_graph_gate<K, 3u>( cuts, g, n, fanout, gate_maj<K> );
+                                               }
+                                             } );
+}
+
+#define INSTANTIATE_PRIORITY_CUTS( k )                                                                                                  \
+  template priority_cuts<k> compute_priority_cuts<k>( const aig_graph&, const properties::ptr&, const properties::ptr& );             \
+  template priority_cuts<k> compute_priority_cuts<k>( const mig_graph&, const properties::ptr&, const properties::ptr& );             \
+  template priority_cuts<k> compute_priority_cuts<k>( const xmg_graph&, const properties::ptr&, const properties::ptr& );
+
+INSTANTIATE_PRIORITY_CUTS( 4u )
+INSTANTIATE_PRIORITY_CUTS( 6u )
+INSTANTIATE_PRIORITY_CUTS( 8u )
+
+#undef INSTANTIATE_PRIORITY_CUTS
+
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
@@ -0,0 +1,413 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+/**
+ * @file priority.hpp
+ *
+ * @brief Priority cut enumeration with bounded memory
+ *
+ * Keeps at most `priority' cuts per node (plus the trivial cut), ordered by
+ * a cost function.  Leaves are stored in fixed-size sorted arrays with a
+ * 64-bit signature that is used to filter merges and dominance checks, and
+ * the function of each cut is computed as a static truth table during the
+ * enumeration.  The same engine is used for AIGs, MIGs, and XMGs.
+ *
+ * @author Mathias Soeken
+ * @since  2.3
+ */
+
+#ifndef CUTS_PRIORITY_HPP
+#define CUTS_PRIORITY_HPP
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include <boost/range/iterator_range.hpp>
+
+#include <kitty/kitty.hpp>
+
+#include <core/properties.hpp>
+#include <classical/aig.hpp>
+#include <classical/mig/mig.hpp>
+#include <classical/xmg/xmg.hpp>
+
+namespace cirkit
+{
+
+/******************************************************************************
+ * Cuts                                                                       *
+ ******************************************************************************/
+
+template<unsigned K>
+struct priority_cut
+{
+  static_assert( K >= 1u && K <= 16u, "cut size must be between 1 and 16" );
+
+  inline const unsigned* begin() const { return leaves.data(); }
+  inline const unsigned* end()   const { return leaves.data() + size; }
+
+  std::array<unsigned, K>      leaves;
+  unsigned                     size      = 0u;
+  uint64_t                     signature = 0u;
+  unsigned                     depth     = 0u;
+  float                        area_flow = 0.0f;
+  kitty::static_truth_table<K> function;         /* variable i is leaves[i] */
+};
+
+inline uint64_t cut_signature( unsigned leaf )
+{
+  return uint64_t( 1 ) << ( leaf & 63u );
+}
+
+/* true, if the leaves of c1 are a subset of the leaves of c2 */
+template<unsigned K>
+bool cut_dominates( const priority_cut<K>& c1, const priority_cut<K>& c2 )
+{
+  if ( c1.size > c2.size || ( c1.signature & c2.signature ) != c1.signature ) { return false; }
+  return std::includes( c2.begin(), c2.end(), c1.begin(), c1.end() );
+}
+
+/* merges the sorted leaves of c1 and c2 into r, returns false if there are more than K leaves */
+template<unsigned K>
+bool cut_merge( const priority_cut<K>& c1, const priority_cut<K>& c2, priority_cut<K>& r )
+{
+  auto i1 = c1.begin(), e1 = c1.end();
+  auto i2 = c2.begin(), e2 = c2.end();
+  auto size = 0u;
+
+  while ( i1 != e1 || i2 != e2 )
+  {
+    if ( size == K ) { return false; }
+
+    if ( i2 == e2 || ( i1 != e1 && *i1 < *i2 ) )
+    {
+      r.leaves[size++] = *i1++;
+    }
+    else
+    {
+      if ( i1 != e1 && *i1 == *i2 ) { ++i1; }
+      r.leaves[size++] = *i2++;
+    }
+  }
+
+  r.size = size;
+  r.signature = c1.signature | c2.signature;
+  return true;
+}
+
+/* function of sub expressed over the leaves of super, requires that the
+   leaves of sub are a subset of the leaves of super */
+template<unsigned K>
+kitty::static_truth_table<K> cut_expand( const priority_cut<K>& sub, const priority_cut<K>& super )
+{
+  auto t = sub.function;
+  if ( sub.size == super.size ) { return t; }
+
+  /* move variables from the top, the target positions are free */
+  auto p = super.size;
+  for ( auto j = sub.size; j > 0u; --j )
+  {
+    do { --p; } while ( super.leaves[p] != sub.leaves[j - 1u] );
+    if ( p != j - 1u )
+    {
+      kitty::swap_inplace( t, j - 1u, p );
+    }
+  }
+  return t;
+}
+
+enum class cut_cost { depth, area_flow, size };
+
+template<unsigned K>
+using cut_compare_t = std::function<bool(const priority_cut<K>&, const priority_cut<K>&)>;
+
+template<unsigned K>
+cut_compare_t<K> make_cut_compare( cut_cost cost )
+{
+  switch ( cost )
+  {
+  case cut_cost::depth:
+    return []( const priority_cut<K>& c1, const priority_cut<K>& c2 ) {
+      if ( c1.depth != c2.depth ) { return c1.depth < c2.depth; }
+      if ( c1.size != c2.size ) { return c1.size < c2.size; }
+      return c1.area_flow < c2.area_flow;
+    };
+  case cut_cost::area_flow:
+    return []( const priority_cut<K>& c1, const priority_cut<K>& c2 ) {
+      if ( c1.area_flow != c2.area_flow ) { return c1.area_flow < c2.area_flow; }
+      if ( c1.size != c2.size ) { return c1.size < c2.size; }
+      return c1.depth < c2.depth;
+    };
+  case cut_cost::size:
+  default:
+    return []( const priority_cut<K>& c1, const priority_cut<K>& c2 ) {
+      if ( c1.size != c2.size ) { return c1.size < c2.size; }
+      if ( c1.depth != c2.depth ) { return c1.depth < c2.depth; }
+      return c1.area_flow < c2.area_flow;
+    };
+  }
+}
+
+/******************************************************************************
+ * Engine                                                                     *
+ ******************************************************************************/
+
+/* Nodes must be added in topological order.  The cuts of each node are
+ * stored contiguously, the trivial cut of a gate is its last cut and is not
+ * counted in the priority. */
+template<unsigned K>
+class priority_cuts final
+{
+public:
+  using cut_t = priority_cut<K>;
+
+  priority_cuts( std::size_t num_nodes, unsigned priority = 8u, const cut_compare_t<K>& compare = make_cut_compare<K>( cut_cost::area_flow ) )
+    : _priority( priority ),
+      _compare( compare ),
+      _first( num_nodes, 0u ),
+      _count( num_nodes, 0u ),
+      _depth( num_nodes, 0u ),
+      _area_flow( num_nodes, 0.0f )
+  {
+    _cuts.reserve( num_nodes * 2u );
+  }
+
+  void add_constant( unsigned n )
+  {
+    cut_t c;
+    c.function = kitty::static_truth_table<K>();
+    _first[n] = _cuts.size();
+    _count[n] = 1u;
+    _cuts.push_back( c );
+  }
+
+  void add_input( unsigned n )
+  {
+    _first[n] = _cuts.size();
+    _count[n] = 1u;
+    _cuts.push_back( trivial_cut( n ) );
+  }
+
+  /* gate computes the function of n from the (complemented) fanin functions */
+  template<unsigned M, typename GateFn>
+  void add_gate( unsigned n, const std::array<unsigned, M>& fanins, const std::array<bool, M>& complements, unsigned fanout, GateFn&& gate )
+  {
+    static_assert( M >= 1u && M <= 3u, "gates must have between 1 and 3 fanins" );
+
+    /* scratch memory is reused across calls */
+    thread_local std::vector<std::pair<cut_t, std::array<std::size_t, M>>> candidates;
+    candidates.clear();
+
+    std::array<std::size_t, M> sources;
+    cut_t merged;
+    enumerate_products<M, 0u>( fanins, sources, merged, candidates );
+
+    for ( auto& c : candidates )
+    {
+      compute_cost( c.first, fanout );
+    }
+
+    const auto compare = [this]( const std::pair<cut_t, std::array<std::size_t, M>>& c1,
+                                 const std::pair<cut_t, std::array<std::size_t, M>>& c2 ) {
+      return _compare( c1.first, c2.first );
+    };
+    if ( candidates.size() > _priority )
+    {
+      std::partial_sort( candidates.begin(), candidates.begin() + _priority, candidates.end(), compare );
+      candidates.resize( _priority );
+    }
+    else
+    {
+      std::sort( candidates.begin(), candidates.end(), compare );
+    }
+
+    /* sources are indexes, since _cuts may be reallocated */
+    const auto first = _cuts.size();
+    for ( auto& c : candidates )
+    {
+      std::array<kitty::static_truth_table<K>, M> values;
+      for ( auto i = 0u; i < M; ++i )
+      {
+        values[i] = cut_expand( _cuts[c.second[i]], c.first );
+        if ( complements[i] ) { values[i] = ~values[i]; }
+      }
+      c.first.function = gate( values );
+      _cuts.push_back( c.first );
+    }
+
+    if ( !candidates.empty() )
+    {
+      _depth[n] = candidates.front().first.depth;
+      _area_flow[n] = candidates.front().first.area_flow;
+    }
+
+    _cuts.push_back( trivial_cut( n ) );
+    _first[n] = first;
+    _count[n] = _cuts.size() - first;
+  }
+
+  inline boost::iterator_range<const cut_t*> cuts( unsigned n ) const
+  {
+    const auto* first = _cuts.data() + _first[n];
+    return boost::make_iterator_range( first, first + _count[n] );
+  }
+
+  /* first non-trivial cut, or the trivial cut for inputs */
+  inline const cut_t& best_cut( unsigned n ) const { return _cuts[_first[n]]; }
+
+  inline unsigned count( unsigned n ) const { return _count[n]; }
+  inline unsigned depth( unsigned n ) const { return _depth[n]; }
+  inline float area_flow( unsigned n ) const { return _area_flow[n]; }
+
+  inline std::size_t total_cut_count() const { return _cuts.size(); }
+  inline std::size_t memory() const
+  {
+    return _cuts.capacity() * sizeof( cut_t ) + _first.capacity() * sizeof( std::size_t ) +
+           _count.capacity() * sizeof( unsigned ) + _depth.capacity() * sizeof( unsigned ) + _area_flow.capacity() * sizeof( float );
+  }
+
+private:
+  cut_t trivial_cut( unsigned n ) const
+  {
+    cut_t c;
+    c.leaves[0] = n;
+    c.size = 1u;
+    c.signature = cut_signature( n );
+    c.depth = _depth[n];
+    c.area_flow = _area_flow[n];
+    kitty::create_nth_var( c.function, 0u );
+    return c;
+  }
+
+  template<unsigned M, unsigned I, typename Candidates>
+  void enumerate_products( const std::array<unsigned, M>& fanins, std::array<std::size_t, M>& sources, const cut_t& merged, Candidates& candidates )
+  {
+    for ( auto index = _first[fanins[I]]; index < _first[fanins[I]] + _count[fanins[I]]; ++index )
+    {
+      const auto& c = _cuts[index];
+      cut_t next;
+      if ( I == 0u )
+      {
+        next = c;
+      }
+      else
+      {
+        /* signature filter before merging leaves */
+        if ( __builtin_popcountll( merged.signature | c.signature ) > static_cast<int>( K ) ) { continue; }
+        if ( !cut_merge( merged, c, next ) ) { continue; }
+      }
+      sources[I] = index;
+
+      if ( I + 1u == M )
+      {
+        add_candidate<M>( next, sources, candidates );
+      }
+      else
+      {
+        enumerate_products<M, ( I + 1u < M ? I + 1u : I )>( fanins, sources, next, candidates );
+      }
+    }
+  }
+
+  template<unsigned M, typename Candidates>
+  void add_candidate( const cut_t& cut, const std::array<std::size_t, M>& sources, Candidates& candidates ) const
+  {
+    auto i = 0u;
+    while ( i < candidates.size() )
+    {
+      const auto& other = candidates[i].first;
+      if ( cut_dominates( other, cut ) ) { return; }
+      if ( cut_dominates( cut, other ) )
+      {
+        candidates[i] = candidates.back();
+        candidates.pop_back();
+        continue;
+      }
+      ++i;
+    }
+    candidates.emplace_back( cut, sources );
+  }
+
+  void compute_cost( cut_t& cut, unsigned fanout ) const
+  {
+    cut.depth = 0u;
+    cut.area_flow = 1.0f;
+    for ( auto l : cut )
+    {
+      cut.depth = std::max( cut.depth, _depth[l] );
+      cut.area_flow += _area_flow[l];
+    }
+    ++cut.depth;
+    cut.area_flow /= std::max( fanout, 1u );
+  }
+
+private:
+  unsigned                 _priority;
+  cut_compare_t<K>         _compare;
+
+  std::vector<cut_t>       _cuts;
+  std::vector<std::size_t> _first;
+  std::vector<unsigned>    _count;
+
+  /* cost of the best cut */
+  std::vector<unsigned>    _depth;
+  std::vector<float>       _area_flow;
+};
+
+/******************************************************************************
+ * Enumeration for AIGs, MIGs, and XMGs                                       *
+ ******************************************************************************/
+
+/* settings: priority (8), cost (cut_cost::area_flow) */
+template<unsigned K>
+priority_cuts<K> compute_priority_cuts( const aig_graph& aig,
+                                        const properties::ptr& settings = properties::ptr(),
+                                        const properties::ptr& statistics = properties::ptr() );
+
+template<unsigned K>
+priority_cuts<K> compute_priority_cuts( const mig_graph& mig,
+                                        const properties::ptr& settings = properties::ptr(),
+                                        const properties::ptr& statistics = properties::ptr() );
+
+template<unsigned K>
+priority_cuts<K> compute_priority_cuts( const xmg_graph& xmg,
+                                        const properties::ptr& settings = properties::ptr(),
+                                        const properties::ptr& statistics = properties::ptr() );
+
+}
+
+#endif
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
@@ -0,0 +1,1082 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "exact_mig_cnf.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <boost/dynamic_bitset.hpp>
+#include <boost/format.hpp>
+
+#include <core/utils/timer.hpp>
+#include <classical/mig/mig_utils.hpp>
+#include <classical/sat/minisat.hpp>
+#include <classical/sat/sat_solver.hpp>
+#include <classical/sat/operations/cardinality.hpp>
+#include <classical/sat/operations/logic.hpp>
+#include <classical/utils/exact_database.hpp>
+#include <classical/utils/spec_representation.hpp>
+
+using boost::format;
+using boost::str;
+
+namespace cirkit
+{
+
+/******************************************************************************
+ * Types                                                                      *
+ ******************************************************************************/
+
+struct exact_cnf_gate
+{
+  std::vector<int> sel[3];  /* one-hot, 0: constant, 1 .. n: inputs, n + 1 + l: gate l */
+  int              neg[3];
+  int              type = 0; /* only with XOR, true for XOR gates */
+  std::vector<int> out;     /* output value for each minterm */
+  std::vector<int> deeper;  /* deeper[t - 1] holds if depth is larger than t */
+  int              act;     /* enables the output constraint with this gate as output */
+};
+
+class exact_cnf_instance
+{
+public:
+  exact_cnf_instance( const tt& spec, bool with_xor, bool with_depth,
+                      const boost::dynamic_bitset<>& symmetry_breaking,
+                      const boost::dynamic_bitset<>& support,
+                      const std::vector<std::pair<unsigned, unsigned>>& symmetries,
+                      const boost::optional<unsigned>& timeout,
+                      const std::function<bool()>& cancel )
+    : spec( spec ),
+      num_vars( tt_num_vars( spec ) ),
+      with_xor( with_xor ),
+      with_depth( with_depth ),
+      symmetry_breaking( symmetry_breaking ),
+      support( support ),
+      symmetries( symmetries ),
+      timeout( timeout ),
+      cancel( cancel ),
+      solver( make_solver<minisat_solver>() )
+  {
+  }
+
+  inline unsigned num_gates() const
+  {
+    return gates.size();
+  }
+
+  /* adds a gate that can use all previous gates as inputs */
+  void add_gate()
+  {
+    const auto i = num_gates();
+
+    gates.push_back( exact_cnf_gate() );
+    auto& g = gates.back();
+
+    for ( auto x = 0u; x < 3u; ++x )
+    {
+      for ( auto j = 0u; j <= num_vars + i; ++j )
+      {
+        g.sel[x].push_back( add_var() );
+      }
+      one_hot( solver, g.sel[x] );
+      g.neg[x] = add_var();
+    }
+
+    if ( with_xor )
+    {
+      /* the third input of an XOR gate is fixed, as in the SMT encoding */
+      g.type = add_var();
+      add_clause( solver )( {-g.type, g.sel[2u][num_vars + i]} );
+      add_clause( solver )( {-g.type, -g.neg[2u]} );
+    }
+
+    add_symmetry_breaking( i );
+    add_function( i );
+    if ( with_depth )
+    {
+      add_depth( i );
+    }
+
+    g.act = add_var();
+    for ( auto m = 0u; m < spec.size(); ++m )
+    {
+      add_clause( solver )( {-g.act, spec[m] ? g.out[m] : -g.out[m]} );
+    }
+  }
+
+  /* looks for a network with k gates and depth at most max_depth (if not 0), returns none on timeout or cancellation */
+  boost::optional<bool> solve( unsigned k, unsigned max_depth, bool associativity )
+  {
+    assert( k > 0u && k <= num_gates() );
+
+    std::vector<int> assumptions{gates[k - 1u].act};
+    if ( assoc )
+    {
+      assumptions.push_back( associativity ? assoc : -assoc );
+    }
+    if ( max_depth > 0u && max_depth < k )
+    {
+      assert( with_depth );
+      assumptions.push_back( -gates[k - 1u].deeper[max_depth - 1u] );
+    }
+
+    if ( !(bool)timeout && !cancel )
+    {
+      result = cirkit::solve( solver, statistics, assumptions );
+      return (bool)result;
+    }
+
+    /* MiniSAT has no time limit, interrupt it from a watchdog thread that
+       also polls the cancel function */
+    std::mutex              mutex;
+    std::condition_variable cv;
+    auto                    done = false;
+    auto                    fired = false;
+
+    std::thread watchdog( [&]() {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds( timeout ? *timeout : 0u );
+        const auto period = std::chrono::milliseconds( cancel ? 10 : 1000 );
+
+        std::unique_lock<std::mutex> lock( mutex );
+        while ( !cv.wait_for( lock, period, [&]() { return done; } ) )
+        {
+          if ( fired || ( timeout && std::chrono::steady_clock::now() >= deadline ) || ( cancel && cancel() ) )
+          {
+            fired = true;
+            solver.solver->interrupt();
+          }
+        }
+      } );
+
+    result = cirkit::solve( solver, statistics, assumptions );
+
+    {
+      std::lock_guard<std::mutex> lock( mutex );
+      done = true;
+    }
+    cv.notify_one();
+    watchdog.join();
+    solver.solver->clearInterrupt();
+
+    if ( fired && !(bool)result )
+    {
+      return boost::none;
+    }
+    return (bool)result;
+  }
+
+  mig_graph extract_mig( unsigned k, const std::string& model_name, const std::string& output_name, bool invert ) const
+  {
+    mig_graph mig;
+    mig_initialize( mig, model_name );
+
+    std::vector<mig_function> inputs, nodes;
+    for ( auto i = 0u; i < num_vars; ++i )
+    {
+      inputs.push_back( mig_create_pi( mig, str( format( "x%d" ) % i ) ) );
+    }
+
+    for ( auto i = 0u; i < k; ++i )
+    {
+      mig_function children[3];
+
+      for ( auto x = 0u; x < 3u; ++x )
+      {
+        const auto sel_val = sel_value( i, x );
+
+        if ( sel_val == 0u )
+        {
+          children[x] = mig_get_constant( mig, false );
+        }
+        else if ( sel_val <= num_vars )
+        {
+          children[x] = inputs[sel_val - 1u];
+        }
+        else
+        {
+          children[x] = nodes[sel_val - num_vars - 1u];
+        }
+
+        if ( value( gates[i].neg[x] ) )
+        {
+          children[x] = !children[x];
+        }
+      }
+
+      nodes.push_back( mig_create_maj( mig, children[0], children[1], children[2] ) );
+    }
+
+    mig_create_po( mig, nodes[k - 1u] ^ invert, output_name );
+
+    return mig;
+  }
+
+  xmg_graph extract_xmg( unsigned k, const std::string& model_name, const std::string& output_name, bool invert ) const
+  {
+    xmg_graph xmg( model_name );
+
+    std::vector<xmg_function> inputs, nodes;
+    for ( auto i = 0u; i < num_vars; ++i )
+    {
+      inputs.push_back( xmg.create_pi( str( format( "x%d" ) % i ) ) );
+    }
+
+    for ( auto i = 0u; i < k; ++i )
+    {
+      const auto type = value( gates[i].type );
+
+      xmg_function children[3];
+
+      for ( auto x = 0u; x < ( type ? 2u : 3u ); ++x )
+      {
+        const auto sel_val = sel_value( i, x );
+
+        if ( sel_val == 0u )
+        {
+          children[x] = xmg.get_constant( false );
+        }
+        else if ( sel_val <= num_vars )
+        {
+          children[x] = inputs[sel_val - 1u];
+        }
+        else
+        {
+          children[x] = nodes[sel_val - num_vars - 1u];
+        }
+
+        if ( value( gates[i].neg[x] ) )
+        {
+          children[x] = !children[x];
+        }
+      }
+
+      if ( type )
+      {
+        nodes.push_back( xmg.create_xor( children[0], children[1] ) );
+      }
+      else
+      {
+        nodes.push_back( xmg.create_maj( children[0], children[1], children[2] ) );
+      }
+    }
+
+    xmg.create_po( nodes[k - 1u] ^ invert, output_name );
+
+    return xmg;
+  }
+
+  /* excludes the structure of the last solution for the first k gates */
+  void block_solution( unsigned k )
+  {
+    clause_t clause;
+
+    for ( auto i = 0u; i < k; ++i )
+    {
+      const auto& g = gates[i];
+
+      for ( auto x = 0u; x < 3u; ++x )
+      {
+        clause.push_back( -g.sel[x][sel_value( i, x )] );
+        clause.push_back( value( g.neg[x] ) ? -g.neg[x] : g.neg[x] );
+      }
+
+      if ( with_xor )
+      {
+        clause.push_back( value( g.type ) ? -g.type : g.type );
+      }
+    }
+
+    add_clause( solver )( clause );
+  }
+
+  solver_execution_statistics statistics;
+
+private:
+  inline int add_var()
+  {
+    return next_var++;
+  }
+
+  inline bool value( int var ) const
+  {
+    return result->first[var - 1];
+  }
+
+  unsigned sel_value( unsigned i, unsigned x ) const
+  {
+    const auto& sel = gates[i].sel[x];
+    const auto it = std::find_if( sel.begin(), sel.end(), [this]( int var ) { return value( var ); } );
+    assert( it != sel.end() );
+    return std::distance( sel.begin(), it );
+  }
+
+  /* clause is only active if gate i is a MAJ gate */
+  inline clause_t if_maj( unsigned i, clause_t clause ) const
+  {
+    if ( with_xor )
+    {
+      clause.push_back( gates[i].type );
+    }
+    return clause;
+  }
+
+  /* returns a variable that is implied if input x of gate i and input y of gate l
+     select the same signal (with the same polarity if with_neg is true) */
+  int equal_inputs( unsigned i, unsigned x, unsigned l, unsigned y, bool with_neg )
+  {
+    const auto e = add_var();
+    const auto& a = gates[i];
+    const auto& b = gates[l];
+
+    for ( auto j = 0u; j < std::min( a.sel[x].size(), b.sel[y].size() ); ++j )
+    {
+      if ( with_neg )
+      {
+        add_clause( solver )( {-a.sel[x][j], -b.sel[y][j], -a.neg[x], -b.neg[y], e} );
+        add_clause( solver )( {-a.sel[x][j], -b.sel[y][j], a.neg[x], b.neg[y], e} );
+      }
+      else
+      {
+        add_clause( solver )( {-a.sel[x][j], -b.sel[y][j], e} );
+      }
+    }
+
+    return e;
+  }
+
+  /* returns a variable that implies that gate j is a MAJ gate with its third input being signal s */
+  int maj_input( unsigned j, unsigned s )
+  {
+    const auto m = add_var();
+    add_clause( solver )( {-m, -gates[j].type} );
+    add_clause( solver )( {-m, gates[j].sel[2u][s]} );
+    return m;
+  }
+
+  /* same symmetry breaking as exact_mig_instance::add_level */
+  void add_symmetry_breaking( unsigned i )
+  {
+    const auto& g = gates[i];
+    const auto n = num_vars;
+
+    /* commutativity: selections are strictly increasing */
+    if ( symmetry_breaking[0u] )
+    {
+      for ( auto a = 0u; a <= n + i; ++a )
+      {
+        for ( auto b = 0u; b <= a; ++b )
+        {
+          add_clause( solver )( {-g.sel[0u][a], -g.sel[1u][b]} );
+          add_clause( solver )( if_maj( i, {-g.sel[1u][a], -g.sel[2u][b]} ) );
+        }
+      }
+    }
+
+    /* inverters: at most one inverted input for MAJ, none for XOR */
+    if ( symmetry_breaking[1u] )
+    {
+      add_clause( solver )( if_maj( i, {-g.neg[0u], -g.neg[1u]} ) );
+      add_clause( solver )( if_maj( i, {-g.neg[0u], -g.neg[2u]} ) );
+      add_clause( solver )( if_maj( i, {-g.neg[1u], -g.neg[2u]} ) );
+
+      if ( with_xor )
+      {
+        add_clause( solver )( {-g.type, -g.neg[0u]} );
+        add_clause( solver )( {-g.type, -g.neg[1u]} );
+      }
+    }
+
+    /* structural hashing: no two gates are equal */
+    if ( symmetry_breaking[2u] )
+    {
+      for ( auto l = 0u; l < i; ++l )
+      {
+        const auto e0 = equal_inputs( i, 0u, l, 0u, true );
+        const auto e1 = equal_inputs( i, 1u, l, 1u, true );
+        const auto e2 = equal_inputs( i, 2u, l, 2u, true );
+
+        if ( with_xor )
+        {
+          add_clause( solver )( {-e0, -e1, -e2, g.type, gates[l].type} );
+          add_clause( solver )( {-e0, -e1, -g.type, -gates[l].type} );
+        }
+        else
+        {
+          add_clause( solver )( {-e0, -e1, -e2} );
+        }
+      }
+    }
+
+    /* associativity, can be disabled by assumption when depth is constrained */
+    if ( symmetry_breaking[3u] && !with_xor )
+    {
+      if ( !assoc && i > 0u )
+      {
+        assoc = add_var();
+      }
+
+      for ( auto l = 0u; l < i; ++l )
+      {
+        const auto& c = gates[l];
+
+        for ( auto alpha = 0u; alpha < 3u; ++alpha )
+        {
+          for ( auto gamma = 0u; gamma < 3u; ++gamma )
+          {
+            const auto has_same = equal_inputs( i, alpha, l, gamma, true );
+            const auto c_child  = gamma == 2u ? 1u : 2u;
+
+            for ( auto beta = 0u; beta < 3u; ++beta )
+            {
+              if ( alpha == beta ) { continue; }
+
+              const auto is_child = g.sel[beta][n + 1u + l];
+              const auto p_child  = 3u - alpha - beta;
+
+              for ( auto u = 0u; u < c.sel[c_child].size(); ++u )
+              {
+                for ( auto v = 0u; v < u; ++v )
+                {
+                  add_clause( solver )( {-assoc, -is_child, -has_same, -c.sel[c_child][u], -g.sel[p_child][v]} );
+                }
+              }
+            }
+          }
+        }
+      }
+    }
+
+    if ( with_xor )
+    {
+      add_clause( solver )( {-g.type, -g.sel[0u][0u]} );
+    }
+
+    /* co-lexicographic order: if the previous gate is not an input, its inputs are not larger */
+    if ( symmetry_breaking[4u] && !with_xor && i > 0u )
+    {
+      const auto& p = gates[i - 1u];
+      const auto guard = g.sel[2u][n + i];
+      const auto eq0 = equal_inputs( i, 0u, i - 1u, 0u, false );
+      const auto eq1 = equal_inputs( i, 1u, i - 1u, 1u, false );
+
+      for ( auto u = 0u; u < p.sel[0u].size(); ++u )
+      {
+        for ( auto v = 0u; v < u; ++v )
+        {
+          add_clause( solver )( {guard, -p.sel[0u][u], -g.sel[0u][v]} );
+          add_clause( solver )( {guard, -eq0, -p.sel[1u][u], -g.sel[1u][v]} );
+          add_clause( solver )( {guard, -eq0, -eq1, -p.sel[2u][u], -g.sel[2u][v]} );
+        }
+      }
+    }
+
+    /* support */
+    if ( symmetry_breaking[5u] )
+    {
+      for ( auto pos = 0u; pos < n; ++pos )
+      {
+        if ( support[pos] ) { continue; }
+
+        add_clause( solver )( {-g.sel[0u][pos + 1u]} );
+        add_clause( solver )( {-g.sel[1u][pos + 1u]} );
+        add_clause( solver )( if_maj( i, {-g.sel[2u][pos + 1u]} ) );
+      }
+    }
+
+    /* symmetric variables: the first one is used before the second one */
+    if ( symmetry_breaking[6u] )
+    {
+      for ( const auto& p : symmetries )
+      {
+        const auto a = p.first + 1u;
+        const auto b = p.second + 1u;
+
+        for ( auto c = 0u; c < 3u; ++c )
+        {
+          if ( i == 0u && c == 0u ) { continue; }
+
+          /* not_a is the negation of "c selects a, and a was not selected before" */
+          clause_t not_a = {-g.sel[c][a]};
+          std::vector<clause_t> b_unused;
+
+          if ( with_xor && c == 2u )
+          {
+            not_a.push_back( g.type );
+          }
+
+          for ( auto j = 0u; j < i; ++j )
+          {
+            const auto& h = gates[j];
+
+            for ( auto d = 0u; d < ( with_xor ? 2u : 3u ); ++d )
+            {
+              not_a.push_back( h.sel[d][a] );
+              b_unused.push_back( {-h.sel[d][b]} );
+            }
+
+            if ( with_xor )
+            {
+              not_a.push_back( maj_input( j, a ) );
+              b_unused.push_back( {h.type, -h.sel[2u][b]} );
+            }
+          }
+
+          for ( auto d = 0u; d < c; ++d )
+          {
+            not_a.push_back( g.sel[d][a] );
+            b_unused.push_back( {-g.sel[d][b]} );
+          }
+
+          for ( const auto& unused : b_unused )
+          {
+            auto clause = not_a;
+            clause.insert( clause.end(), unused.begin(), unused.end() );
+            add_clause( solver )( clause );
+          }
+        }
+      }
+    }
+  }
+
+  /* output values of gate i for all minterms */
+  void add_function( unsigned i )
+  {
+    auto& g = gates[i];
+    const auto n = num_vars;
+
+    for ( auto m = 0u; m < spec.size(); ++m )
+    {
+      const auto o = add_var();
+      int in[3];
+
+      for ( auto x = 0u; x < 3u; ++x )
+      {
+        in[x] = add_var();
+        const auto neg = g.neg[x];
+
+        for ( auto j = 0u; j <= n + i; ++j )
+        {
+          const auto s = g.sel[x][j];
+
+          if ( j <= n )
+          {
+            /* constant or primary input: in = neg XOR value */
+            const auto v = j > 0u && ( ( m >> ( j - 1u ) ) & 1u );
+            add_clause( solver )( {-s, -in[x], v ? -neg : neg} );
+            add_clause( solver )( {-s, in[x], v ? neg : -neg} );
+          }
+          else
+          {
+            /* gate: in = neg XOR out */
+            const auto src = gates[j - n - 1u].out[m];
+            add_clause( solver )( {-s, -in[x], neg, src} );
+            add_clause( solver )( {-s, -in[x], -neg, -src} );
+            add_clause( solver )( {-s, in[x], neg, -src} );
+            add_clause( solver )( {-s, in[x], -neg, src} );
+          }
+        }
+      }
+
+      /* o = MAJ( in0, in1, in2 ) */
+      add_clause( solver )( if_maj( i, {-in[0], -in[1], o} ) );
+      add_clause( solver )( if_maj( i, {-in[0], -in[2], o} ) );
+      add_clause( solver )( if_maj( i, {-in[1], -in[2], o} ) );
+      add_clause( solver )( if_maj( i, {in[0], in[1], -o} ) );
+      add_clause( solver )( if_maj( i, {in[0], in[2], -o} ) );
+      add_clause( solver )( if_maj( i, {in[1], in[2], -o} ) );
+
+      /* o = XOR( in0, in1 ) */
+      if ( with_xor )
+      {
+        blocking_xor( solver, g.type, in[0], in[1], o );
+      }
+
+      g.out.push_back( o );
+    }
+  }
+
+  /* order encoding of depth, only lower bounds are propagated */
+  void add_depth( unsigned i )
+  {
+    auto& g = gates[i];
+
+    for ( auto t = 1u; t <= i; ++t )
+    {
+      g.deeper.push_back( add_var() );
+    }
+
+    for ( auto x = 0u; x < 3u; ++x )
+    {
+      for ( auto l = 0u; l < i; ++l )
+      {
+        const auto s = g.sel[x][num_vars + 1u + l];
+
+        add_clause( solver )( {-s, g.deeper[0u]} );
+        for ( auto t = 1u; t <= l; ++t )
+        {
+          add_clause( solver )( {-s, -gates[l].deeper[t - 1u], g.deeper[t]} );
+        }
+      }
+    }
+  }
+
+private:
+  tt                                         spec;
+  unsigned                                   num_vars;
+  bool                                       with_xor;
+  bool                                       with_depth;
+  boost::dynamic_bitset<>                    symmetry_breaking;
+  boost::dynamic_bitset<>                    support;
+  std::vector<std::pair<unsigned, unsigned>> symmetries;
+  boost::optional<unsigned>                  timeout;
+  std::function<bool()>                      cancel;
+
+  minisat_solver                             solver;
+  solver_result_t                            result;
+  int                                        next_var = 1;
+  int                                        assoc = 0; /* enables associativity symmetry breaking */
+
+  std::vector<exact_cnf_gate>                gates;
+};
+
+/******************************************************************************
+ * Private functions                                                          *
+ ******************************************************************************/
+
+template<typename T>
+class exact_cnf_manager
+{
+public:
+  exact_cnf_manager( const tt& spec, const properties::ptr& settings )
+    : spec( spec ),
+      normal( !spec[0u] )
+  {
+    /* meta data */
+    model_name          = get( settings, "model_name",          std::string( "exact" ) );
+    output_name         = get( settings, "output_name",         std::string( "f" ) );
+
+    /* control algorithm */
+    objective           = get( settings, "objective",           0u );   /* 0: size, 1: size/depth, 2: depth/size */
+    start               = get( settings, "start",               1u );
+    stop                = get( settings, "stop",                1000u );
+    start_depth         = get( settings, "start_depth",         1u );
+    max_solutions       = get( settings, "max_solutions",       1u );
+
+    /* encoding */
+    breaking            = get( settings, "breaking",            std::string( "CIsalty" ) );
+
+    timeout             = get( settings, "timeout",             boost::optional<unsigned>() );
+    timeout_heuristic   = get( settings, "timeout_heuristic",   false );
+    cancel              = get( settings, "cancel",              std::function<bool()>() );
+    verbose             = get( settings, "verbose",             false );
+
+    make_symmetry_breaking_bitset();
+  }
+
+  std::vector<T> run()
+  {
+    const spec_representation rep( spec );
+
+    /* check trivial case */
+    const auto triv = rep.is_trivial();
+    if ( (bool)triv )
+    {
+      return {create_trivial<T>( triv->first, triv->second )};
+    }
+
+    if ( !normal )
+    {
+      spec.flip();
+    }
+
+    support    = rep.support();
+    symmetries = rep.symmetric_variables();
+
+    switch ( objective )
+    {
+    case 0u:
+      return exact_size();
+    case 1u:
+      return exact_size_depth();
+    case 2u:
+      return exact_depth_size();
+    default:
+      assert( false );
+      return std::vector<T>();
+    }
+  }
+
+  std::vector<T> exact_size()
+  {
+    auto inst = create_instance( false );
+
+    for ( auto k = start; ; ++k )
+    {
+      add_gates( *inst, k );
+
+      if ( verbose )
+      {
+        std::cout << format( "[i] check for realization with %d gates" ) % k << std::endl;
+      }
+
+      const auto result = solve( *inst, k, 0u, true );
+      if ( (bool)result && *result )
+      {
+        return extract_solutions( *inst, k, 0u, true );
+      }
+      else if ( ( !(bool)result && ( !timeout_heuristic || is_cancelled() ) ) || k == stop )
+      {
+        last_size = k;
+        return std::vector<T>();
+      }
+    }
+  }
+
+  std::vector<T> exact_size_depth()
+  {
+    auto inst = create_instance( true );
+
+    auto k = start;
+    for ( ; ; ++k )
+    {
+      add_gates( *inst, k );
+
+      if ( verbose )
+      {
+        std::cout << format( "[i] check for realization with %d gates" ) % k << std::endl;
+      }
+
+      const auto result = solve( *inst, k, 0u, true );
+      if ( (bool)result && *result )
+      {
+        break;
+      }
+      else if ( ( !(bool)result && ( !timeout_heuristic || is_cancelled() ) ) || k == stop )
+      {
+        last_size = k;
+        return std::vector<T>();
+      }
+    }
+
+    /* depth k is always possible with k gates */
+    for ( auto d = start_depth; ; ++d )
+    {
+      if ( verbose )
+      {
+        std::cout << format( "[i] check for realization with %d gates and depth %d" ) % k % d << std::endl;
+      }
+
+      const auto result = solve( *inst, k, d, false );
+      if ( (bool)result && *result )
+      {
+        return extract_solutions( *inst, k, d, false );
+      }
+      else if ( !(bool)result && ( !timeout_heuristic || is_cancelled() ) )
+      {
+        last_size = k;
+        return std::vector<T>();
+      }
+    }
+  }
+
+  std::vector<T> exact_depth_size()
+  {
+    for ( auto d = start_depth; ; ++d )
+    {
+      auto inst = create_instance( true );
+      const auto max_gates = ( static_cast<unsigned>( pow( 3, d ) ) - 1u ) / 2u;
+
+      for ( auto k = ( d == start_depth ) ? start : 1u; k <= max_gates; ++k )
+      {
+        add_gates( *inst, k );
+
+        if ( verbose )
+        {
+          std::cout << format( "[i] check for realization with depth %d and %d gates" ) % d % k << std::endl;
+        }
+
+        const auto result = solve( *inst, k, d, false );
+        if ( (bool)result && *result )
+        {
+          return extract_solutions( *inst, k, d, false );
+        }
+        else if ( !(bool)result && ( !timeout_heuristic || is_cancelled() ) )
+        {
+          last_size = k;
+          return std::vector<T>();
+        }
+      }
+    }
+  }
+
+private:
+  std::unique_ptr<exact_cnf_instance> create_instance( bool with_depth ) const
+  {
+    return std::unique_ptr<exact_cnf_instance>( new exact_cnf_instance( spec, std::is_same<T, xmg_graph>::value, with_depth,
+                                                                        symmetry_breaking, support, symmetries, timeout, cancel ) );
+  }
+
+  inline bool is_cancelled() const
+  {
+    return cancel && cancel();
+  }
+
+  /* none on timeout */
+  boost::optional<bool> solve( exact_cnf_instance& inst, unsigned k, unsigned d, bool associativity )
+  {
+    const auto result = inst.solve( k, d, associativity );
+    statistics = inst.statistics;
+    return result;
+  }
+
+  void add_gates( exact_cnf_instance& inst, unsigned k ) const
+  {
+    while ( inst.num_gates() < k )
+    {
+      inst.add_gate();
+    }
+  }
+
+  std::vector<T> extract_solutions( exact_cnf_instance& inst, unsigned k, unsigned d, bool associativity )
+  {
+    std::vector<T> networks;
+
+    while ( true )
+    {
+      networks.push_back( extract_solution<T>( inst, k ) );
+
+      if ( networks.size() == max_solutions ) { break; }
+
+      inst.block_solution( k );
+      const auto result = solve( inst, k, d, associativity );
+      if ( !(bool)result || !*result ) { break; }
+    }
+
+    return networks;
+  }
+
+  template<typename C, typename std::enable_if<std::is_same<mig_graph, C>::value>::type* = nullptr>
+  mig_graph extract_solution( const exact_cnf_instance& inst, unsigned k ) const
+  {
+    return inst.extract_mig( k, model_name, output_name, !normal );
+  }
+
+  template<typename C, typename std::enable_if<std::is_same<xmg_graph, C>::value>::type* = nullptr>
+  xmg_graph extract_solution( const exact_cnf_instance& inst, unsigned k ) const
+  {
+    return inst.extract_xmg( k, model_name, output_name, !normal );
+  }
+
+  template<typename C, typename std::enable_if<std::is_same<mig_graph, C>::value>::type* = nullptr>
+  mig_graph create_trivial( unsigned id, bool complement ) const
+  {
+    mig_graph mig;
+    mig_initialize( mig, model_name );
+
+    if ( id == 0u )
+    {
+      mig_create_po( mig, mig_get_constant( mig, complement ), output_name );
+    }
+    else
+    {
+      const auto& info = mig_info( mig );
+
+      for ( auto i = 0u; i < id; ++i )
+      {
+        mig_create_pi( mig, str( format( "x%d" ) % i ) );
+      }
+      mig_create_po( mig, {info.inputs.back(), complement}, output_name );
+    }
+    return mig;
+  }
+
+  template<typename C, typename std::enable_if<std::is_same<xmg_graph, C>::value>::type* = nullptr>
+  xmg_graph create_trivial( unsigned id, bool complement ) const
+  {
+    xmg_graph xmg( model_name );
+    if ( id == 0u )
+    {
+      xmg.create_po( xmg.get_constant( complement ), output_name );
+    }
+    else
+    {
+      for ( auto i = 0u; i < id; ++i )
+      {
+        xmg.create_pi( str( format( "x%d" ) % i ) );
+      }
+      xmg.create_po( xmg_function( xmg.inputs().back().first, complement ), output_name );
+    }
+    return xmg;
+  }
+
+  void make_symmetry_breaking_bitset()
+  {
+    symmetry_breaking.resize( 7u );
+
+    for ( auto c : breaking )
+    {
+      switch ( c )
+      {
+      case 'C': symmetry_breaking.set( 0u ); break;
+      case 'I': symmetry_breaking.set( 1u ); break;
+      case 's': symmetry_breaking.set( 2u ); break;
+      case 'a': symmetry_breaking.set( 3u ); break;
+      case 'l': symmetry_breaking.set( 4u ); break;
+      case 't': symmetry_breaking.set( 5u ); break;
+      case 'y': symmetry_breaking.set( 6u ); break;
+      };
+    }
+  }
+
+private:
+  tt spec;
+  bool normal;
+  unsigned start;
+  unsigned stop;
+  unsigned start_depth;
+  std::string model_name;
+  std::string output_name;
+  unsigned objective;
+  unsigned max_solutions;
+  std::string breaking;
+  boost::optional<unsigned> timeout;
+  bool timeout_heuristic;
+  std::function<bool()> cancel;
+  bool verbose;
+
+  /* pre-computed function properties */
+  boost::dynamic_bitset<>                    support;
+  std::vector<std::pair<unsigned, unsigned>> symmetries;
+
+  /* bits as in exact_mig_manager */
+  boost::dynamic_bitset<> symmetry_breaking;
+
+public:
+  unsigned                    last_size = 0u;
+  solver_execution_statistics statistics; /* of the last SAT call */
+};
+
+/* same conditions as for exact_mig_with_sat */
+bool is_optimum_cnf_run( const properties::ptr& settings )
+{
+  return get( settings, "start", 1u ) <= 1u && get( settings, "start_depth", 1u ) <= 1u &&
+         !get( settings, "timeout_heuristic", false );
+}
+
+template<typename T>
+boost::optional<T> exact_with_cnf( const tt& spec, const properties::ptr& settings, const properties::ptr& statistics,
+                                   const std::function<boost::optional<T>( exact_database&, unsigned )>& find,
+                                   const std::function<void( exact_database&, unsigned, const T& )>& insert )
+{
+  /* timing */
+  properties_timer t( statistics );
+
+  assert( !spec.empty() );
+
+  const auto db        = get( settings, "max_solutions", 1u ) == 1u ? exact_database_from_settings( settings ) : nullptr;
+  const auto objective = get( settings, "objective", 0u );
+  if ( db )
+  {
+    const auto network = find( *db, objective );
+    if ( (bool)network )
+    {
+      set( statistics, "all_solutions", std::vector<T>{*network} );
+      set( statistics, "last_size", 0u );
+      set( statistics, "database_hit", true );
+      return network;
+    }
+  }
+
+  exact_cnf_manager<T> mgr( spec, settings );
+
+  const auto networks = mgr.run();
+  set( statistics, "all_solutions", networks );
+  set( statistics, "last_size", mgr.last_size );
+  set( statistics, "database_hit", false );
+  set( statistics, "num_vars", mgr.statistics.num_vars );
+  set( statistics, "num_clauses", mgr.statistics.num_clauses );
+  set( statistics, "num_conflicts", mgr.statistics.num_conflicts );
+
+  if ( db && !networks.empty() && is_optimum_cnf_run( settings ) )
+  {
+    insert( *db, objective, networks.front() );
+  }
+
+  if ( networks.empty() )
+  {
+    return boost::none;
+  }
+  else
+  {
+    return networks.front();
+  }
+}
+
+/******************************************************************************
+ * Public functions                                                           *
+ ******************************************************************************/
+
+boost::optional<mig_graph> exact_mig_with_cnf( const tt& spec,
+                                               const properties::ptr& settings,
+                                               const properties::ptr& statistics )
+{
+  const auto model_name  = get( settings, "model_name",  std::string( "exact" ) );
+  const auto output_name = get( settings, "output_name", std::string( "f" ) );
+
+  return exact_with_cnf<mig_graph>( spec, settings, statistics,
+                                    [&]( exact_database& db, unsigned objective ) { return db.find_mig( spec, objective, true, model_name, output_name ); },
+                                    [&]( exact_database& db, unsigned objective, const mig_graph& mig ) { db.insert_mig( spec, objective, mig ); } );
+}
+
+boost::optional<xmg_graph> exact_xmg_with_cnf( const tt& spec,
+                                               const properties::ptr& settings,
+                                               const properties::ptr& statistics )
+{
+  const auto model_name  = get( settings, "model_name",  std::string( "exact" ) );
+  const auto output_name = get( settings, "output_name", std::string( "f" ) );
+
+  return exact_with_cnf<xmg_graph>( spec, settings, statistics,
+                                    [&]( exact_database& db, unsigned objective ) { return db.find_xmg( spec, objective, true, model_name, output_name ); },
+                                    [&]( exact_database& db, unsigned objective, const xmg_graph& xmg ) { db.insert_xmg( spec, objective, xmg ); } );
+}
+
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
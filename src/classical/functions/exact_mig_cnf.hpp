@@ -0,0 +1,106 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * @file exact_mig_cnf.hpp
+ *
+ * @brief Exact MIG and XMG synthesis with a native CNF encoding
+ *
+ * The encoding follows the one of exact_mig_with_sat, but selection
+ * variables are one-hot encoded and all constraints are given directly as
+ * clauses to MiniSAT.  Gates are added to a single solver instance as the
+ * gate count grows; the output constraint for k gates and the depth bound
+ * are passed as assumptions.
+ *
+ * @author Mathias Soeken
+ * @since  2.3
+ */
+
+#ifndef EXACT_MIG_CNF_HPP
+#define EXACT_MIG_CNF_HPP
+
+#include <boost/optional.hpp>
+
+#include <core/properties.hpp>
+#include <classical/mig/mig.hpp>
+#include <classical/utils/truth_table_utils.hpp>
+#include <classical/xmg/xmg.hpp>
+
+namespace cirkit
+{
+
+/**
+ * @settings
+ *
+   |-------------------+-----------------------------------------------+--------------------------|
+   | Settings          | Description                                   | Default                  |
+   |-------------------+-----------------------------------------------+--------------------------|
+   | objective         | 0: size, 1: size/depth, 2: depth/size         | 0u                       |
+   | start             | Initial number of gates                       | 1u                       |
+   | stop              | Maximum number of gates                       | 1000u                    |
+   | start_depth       | Initial depth                                 | 1u                       |
+   | max_solutions     | Number of solutions to enumerate              | 1u                       |
+   | breaking          | Symmetry breaking (as in exact_mig_with_sat)  | std::string( "CIsalty" ) |
+   | timeout           | Timeout in seconds for each SAT call          | boost::none              |
+   | timeout_heuristic | Continue with next gate count on timeout      | false                    |
+   | cancel            | Polled during SAT calls, stops search if true | std::function<bool()>()  |
+   | model_name        | Name of the model                             | std::string( "exact" )   |
+   | output_name       | Name of the output                            | std::string( "f" )       |
+   | database          | File name of the database of optimum networks | std::string()            |
+   | verbose           | Be verbose                                    | false                    |
+   |-------------------+-----------------------------------------------+--------------------------|
+ *
+ * @statistics
+ *
+   |---------------+------------------------------------------------|
+   | Statistics    | Description                                    |
+   |---------------+------------------------------------------------|
+   | runtime       | Runtime in seconds                             |
+   | all_solutions | Vector of all found networks                   |
+   | last_size     | Last gate count that has been tried on failure |
+   | num_vars      | Number of SAT variables                        |
+   | num_clauses   | Number of clauses                              |
+   | num_conflicts | Number of conflicts                            |
+   | database_hit  | Whether the network was taken from database    |
+   |---------------+------------------------------------------------|
+ */
+boost::optional<mig_graph> exact_mig_with_cnf( const tt& spec,
+                                               const properties::ptr& settings = properties::ptr(),
+                                               const properties::ptr& statistics = properties::ptr() );
+
+boost::optional<xmg_graph> exact_xmg_with_cnf( const tt& spec,
+                                               const properties::ptr& settings = properties::ptr(),
+                                               const properties::ptr& statistics = properties::ptr() );
+
+}
+
+#endif
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
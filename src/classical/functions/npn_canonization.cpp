@@ -26,7 +26,11 @@
 
 #include "npn_canonization.hpp"
 
+#include <array>
+#include <atomic>
 #include <iostream>
+#include <memory>
+#include <mutex>
 #include <strings.h>
 
 #include <boost/graph/adjacency_list.hpp>
@@ -35,6 +39,7 @@
 #include <boost/range/algorithm_ext/iota.hpp>
 
 #include <core/utils/range_utils.hpp>
+#include <core/utils/thread_pool.hpp>
 #include <core/utils/timer.hpp>
 #include <classical/abc/abc_api.hpp>
 
@@ -106,6 +111,29 @@ std::vector<unsigned> compute_flips( unsigned n )
   return flip_array;
 }
 
+/* tt_store has the sequences for up to 6 variables */
+const std::vector<unsigned>& npn_swaps( unsigned n )
+{
+  if ( n <= 6u )
+  {
+    return tt_store::i().swaps( n );
+  }
+
+  static const std::vector<std::vector<unsigned>> swaps = { compute_swaps( 7u ), compute_swaps( 8u ) };
+  return swaps.at( n - 7u );
+}
+
+const std::vector<unsigned>& npn_flips( unsigned n )
+{
+  if ( n <= 6u )
+  {
+    return tt_store::i().flips( n );
+  }
+
+  static const std::vector<std::vector<unsigned>> flips = { compute_flips( 7u ), compute_flips( 8u ) };
+  return flips.at( n - 7u );
+}
+
 inline void bitset_swap( boost::dynamic_bitset<>& bs, unsigned i, unsigned j )
 {
   auto t = bs[i];
@@ -177,14 +205,8 @@ void npn_canonization_sifting_loop( tt& npn, unsigned n, boost::dynamic_bitset<>
   }
 }
 
-/******************************************************************************
- * Public functions                                                           *
- ******************************************************************************/
-
-tt exact_npn_canonization( const tt& t, boost::dynamic_bitset<>& phase, std::vector<unsigned>& perm, const properties::ptr& settings, const properties::ptr& statistics )
+tt exact_npn_canonization_dynamic( const tt& t, boost::dynamic_bitset<>& phase, std::vector<unsigned>& perm )
 {
-  properties_timer tim( statistics );
-
   /* initialize */
   auto n = tt_num_vars( t );
   phase.resize( n + 1u );
@@ -277,6 +299,271 @@ tt exact_npn_canonization( const tt& t, boost::dynamic_bitset<>& phase, std::vec
   return min;
 }
 
+template<int NumVars>
+tt exact_npn_canonization_static( const tt& t, boost::dynamic_bitset<>& phase, std::vector<unsigned>& perm )
+{
+  unsigned                      static_phase;
+  std::array<unsigned, NumVars> static_perm;
+
+  const auto npn = exact_npn_canonization<NumVars>( to_kitty_static<NumVars>( t ), static_phase, static_perm );
+
+  phase = boost::dynamic_bitset<>( NumVars + 1u, static_phase );
+  perm.assign( static_perm.begin(), static_perm.end() );
+  return from_kitty( npn, NumVars );
+}
+
+/* calls fn( t' ) for all NPN transformations t' of t, in the same order as
+   exact_npn_canonization; transformations can be visited more than once */
+template<int NumVars, typename Fn>
+void foreach_npn_transformation( const kitty::static_truth_table<NumVars>& t, Fn&& fn )
+{
+  const auto& swap_array = npn_swaps( NumVars );
+  const auto& flip_array = npn_flips( NumVars );
+
+  auto t1 = t;
+  fn( t1 ); fn( ~t1 );
+
+  for ( int i = swap_array.size() - 1; i >= 0; --i )
+  {
+    kitty::swap_adjacent_inplace( t1, swap_array[i] );
+    fn( t1 ); fn( ~t1 );
+  }
+
+  for ( int j = flip_array.size() - 1; j >= 0; --j )
+  {
+    kitty::swap_adjacent_inplace( t1, 0u );
+    kitty::flip_inplace( t1, flip_array[j] );
+    fn( t1 ); fn( ~t1 );
+
+    for ( int i = swap_array.size() - 1; i >= 0; --i )
+    {
+      kitty::swap_adjacent_inplace( t1, swap_array[i] );
+      fn( t1 ); fn( ~t1 );
+    }
+  }
+}
+
+/* Each class is claimed by setting the bit of its representative (the
+ * smallest function in the class), the thread that claims it marks all
+ * other functions of the class.  Functions are scanned in parallel, a thread
+ * that meets an unmarked function of a class that has already been claimed
+ * only computes the representative. */
+template<unsigned N>
+std::unordered_map<unsigned long, unsigned long> exact_npn_classes_static( const properties::ptr& settings )
+{
+  static_assert( N <= 5u, "exhaustive enumeration is limited to 5 variables" );
+
+  /* settings */
+  const auto num_threads = get( settings, "num_threads", 0u );
+
+  constexpr uint64_t num_functions = uint64_t( 1 ) << ( 1u << N );
+  constexpr uint64_t num_words     = ( num_functions + 63u ) >> 6u;
+
+  std::unique_ptr<std::atomic<uint64_t>[]> visited( new std::atomic<uint64_t>[num_words] );
+  for ( auto w = 0u; w < num_words; ++w )
+  {
+    visited[w].store( 0u, std::memory_order_relaxed );
+  }
+
+  const auto mark = [&visited]( uint64_t f ) {
+    const auto bit = uint64_t( 1 ) << ( f & 63u );
+    return !( visited[f >> 6u].fetch_or( bit, std::memory_order_relaxed ) & bit );
+  };
+
+  std::unordered_map<unsigned long, unsigned long> classes;
+  std::mutex classes_mutex;
+
+  std::unique_ptr<thread_pool> local_pool;
+  if ( num_threads > 0u )
+  {
+    local_pool.reset( new thread_pool( num_threads ) );
+  }
+  auto& pool = local_pool ? *local_pool : shared_thread_pool();
+
+  pool.parallel_for( 0u, num_words, 64u, [&]( std::size_t w ) {
+      for ( auto b = 0u; b < 64u && ( w << 6u ) + b < num_functions; ++b )
+      {
+        if ( visited[w].load( std::memory_order_relaxed ) & ( uint64_t( 1 ) << b ) ) { continue; }
+
+        /* tables with less than 6 variables fit into one word */
+        kitty::static_truth_table<N> t;
+        *t.begin() = ( w << 6u ) + b;
+
+        auto min = t;
+        foreach_npn_transformation<N>( t, [&min]( const kitty::static_truth_table<N>& t2 ) {
+            if ( t2 < min ) { min = t2; }
+          } );
+
+        if ( !mark( *min.cbegin() ) ) { continue; }
+
+        unsigned long size = 1u;
+        foreach_npn_transformation<N>( t, [&]( const kitty::static_truth_table<N>& t2 ) {
+            if ( mark( *t2.cbegin() ) ) { ++size; }
+          } );
+
+        std::lock_guard<std::mutex> lock( classes_mutex );
+        classes[*min.cbegin()] = size;
+      }
+    } );
+
+  return classes;
+}
+
+/******************************************************************************
+ * Public functions                                                           *
+ ******************************************************************************/
+
+template<int NumVars>
+kitty::static_truth_table<NumVars> exact_npn_canonization( const kitty::static_truth_table<NumVars>& t, unsigned& phase, std::array<unsigned, NumVars>& perm )
+{
+  static_assert( NumVars >= 2 && NumVars <= 8, "exact NPN canonization requires between 2 and 8 variables" );
+
+  phase = 0u;
+  for ( auto i = 0u; i < perm.size(); ++i ) { perm[i] = i; }
+
+  const auto& swap_array = npn_swaps( NumVars );
+  const auto& flip_array = npn_flips( NumVars );
+  const int total_swaps = swap_array.size();
+  const int total_flips = flip_array.size();
+
+  /* swaps and flips commute with the inversion, the inverted table is ~t1 */
+  auto t1 = t;
+  auto min = std::min( t1, ~t1 );
+
+  auto invo = ( min != t1 );
+
+  int best_flip = total_flips;
+  int best_swap = total_swaps;
+
+  const auto update = [&]() {
+    const auto t2 = ~t1;
+    if ( t1 < min || t2 < min )
+    {
+      invo = t2 < t1;
+      min = invo ? t2 : t1;
+      return true;
+    }
+    return false;
+  };
+
+  for ( int i = total_swaps - 1; i >= 0; --i )
+  {
+    kitty::swap_adjacent_inplace( t1, swap_array[i] );
+    if ( update() )
+    {
+      best_swap = i;
+    }
+  }
+
+  for ( int j = total_flips - 1; j >= 0; --j )
+  {
+    kitty::swap_adjacent_inplace( t1, 0u );
+    kitty::flip_inplace( t1, flip_array[j] );
+    if ( update() )
+    {
+      best_swap = total_swaps;
+      best_flip = j;
+    }
+
+    for ( int i = total_swaps - 1; i >= 0; --i )
+    {
+      kitty::swap_adjacent_inplace( t1, swap_array[i] );
+      if ( update() )
+      {
+        best_swap = i;
+        best_flip = j;
+      }
+    }
+  }
+
+  for ( int i = total_swaps - 1; i >= best_swap; --i )
+  {
+    const auto pos = swap_array[i];
+    std::swap( perm[pos], perm[pos + 1] );
+  }
+
+  for ( int j = total_flips - 1; j >= best_flip; --j )
+  {
+    phase ^= 1u << flip_array[j];
+  }
+
+  /* output inverted? */
+  if ( invo )
+  {
+    phase ^= 1u << NumVars;
+  }
+
+  return min;
+}
+
+template kitty::static_truth_table<2> exact_npn_canonization<2>( const kitty::static_truth_table<2>&, unsigned&, std::array<unsigned, 2>& );
+template kitty::static_truth_table<3> exact_npn_canonization<3>( const kitty::static_truth_table<3>&, unsigned&, std::array<unsigned, 3>& );
+template kitty::static_truth_table<4> exact_npn_canonization<4>( const kitty::static_truth_table<4>&, unsigned&, std::array<unsigned, 4>& );
+template kitty::static_truth_table<5> exact_npn_canonization<5>( const kitty::static_truth_table<5>&, unsigned&, std::array<unsigned, 5>& );
+template kitty::static_truth_table<6> exact_npn_canonization<6>( const kitty::static_truth_table<6>&, unsigned&, std::array<unsigned, 6>& );
+template kitty::static_truth_table<7> exact_npn_canonization<7>( const kitty::static_truth_table<7>&, unsigned&, std::array<unsigned, 7>& );
+template kitty::static_truth_table<8> exact_npn_canonization<8>( const kitty::static_truth_table<8>&, unsigned&, std::array<unsigned, 8>& );
+
+tt exact_npn_canonization( const tt& t, boost::dynamic_bitset<>& phase, std::vector<unsigned>& perm, const properties::ptr& settings, const properties::ptr& statistics )
+{
+  properties_timer tim( statistics );
+
+  switch ( tt_num_vars( t ) )
+  {
+  case 2u: return exact_npn_canonization_static<2>( t, phase, perm );
+  case 3u: return exact_npn_canonization_static<3>( t, phase, perm );
+  case 4u: return exact_npn_canonization_static<4>( t, phase, perm );
+  case 5u: return exact_npn_canonization_static<5>( t, phase, perm );
+  case 6u: return exact_npn_canonization_static<6>( t, phase, perm );
+  case 7u: return exact_npn_canonization_static<7>( t, phase, perm );
+  case 8u: return exact_npn_canonization_static<8>( t, phase, perm );
+  default: return exact_npn_canonization_dynamic( t, phase, perm );
+  }
+}
+
+std::vector<tt> exact_npn_canonization_batch( const std::vector<tt>& ts, std::vector<boost::dynamic_bitset<>>& phases, std::vector<std::vector<unsigned>>& perms,
+                                              const properties::ptr& settings, const properties::ptr& statistics )
+{
+  /* settings */
+  const auto num_threads = get( settings, "num_threads", 0u );
+  const auto grain       = get( settings, "grain",       16u );
+
+  properties_timer tim( statistics );
+
+  std::vector<tt> npns( ts.size() );
+  phases.resize( ts.size() );
+  perms.resize( ts.size() );
+
+  std::unique_ptr<thread_pool> local_pool;
+  if ( num_threads > 0u )
+  {
+    local_pool.reset( new thread_pool( num_threads ) );
+  }
+  auto& pool = local_pool ? *local_pool : shared_thread_pool();
+
+  pool.parallel_for( 0u, ts.size(), grain, [&]( std::size_t i ) {
+      npns[i] = exact_npn_canonization( ts[i], phases[i], perms[i] );
+    } );
+
+  return npns;
+}
+
+std::unordered_map<unsigned long, unsigned long> exact_npn_classes( unsigned num_vars, const properties::ptr& settings, const properties::ptr& statistics )
+{
+  properties_timer tim( statistics );
+
+  switch ( num_vars )
+  {
+  case 2u: return exact_npn_classes_static<2u>( settings );
+  case 3u: return exact_npn_classes_static<3u>( settings );
+  case 4u: return exact_npn_classes_static<4u>( settings );
+  case 5u: return exact_npn_classes_static<5u>( settings );
+  default:
+    assert( false );
+    return std::unordered_map<unsigned long, unsigned long>();
+  }
+}
+
 tt npn_canonization( const tt& t, boost::dynamic_bitset<>& phase, std::vector<unsigned>& perm, const properties::ptr& settings, const properties::ptr& statistics )
 {
   properties_timer tim( statistics );
@@ -36,6 +36,10 @@
 #ifndef NPN_CANONIZATION_HPP
 #define NPN_CANONIZATION_HPP
 
+#include <array>
+#include <unordered_map>
+#include <vector>
+
 #include <boost/dynamic_bitset.hpp>
 
 #include <core/properties.hpp>
@@ -49,6 +53,25 @@ tt exact_npn_canonization(
     const properties::ptr& settings = properties::ptr(),
     const properties::ptr& statistics = properties::ptr() );
 
+/* does not allocate memory, 2 <= NumVars <= 8; bit i of phase is set if x_i
+   is flipped, bit NumVars if the output is inverted */
+template<int NumVars>
+kitty::static_truth_table<NumVars> exact_npn_canonization( const kitty::static_truth_table<NumVars>& t, unsigned& phase, std::array<unsigned, NumVars>& perm );
+
+/* canonizes all functions with the thread pool (setting num_threads, 0 uses
+   the shared pool) */
+std::vector<tt> exact_npn_canonization_batch(
+    const std::vector<tt>& ts, std::vector<boost::dynamic_bitset<>>& phases, std::vector<std::vector<unsigned>>& perms,
+    const properties::ptr& settings = properties::ptr(),
+    const properties::ptr& statistics = properties::ptr() );
+
+/* all NPN classes of functions with 2 <= num_vars <= 5 variables; maps the
+   smallest function of each class to the number of functions in it */
+std::unordered_map<unsigned long, unsigned long> exact_npn_classes(
+    unsigned num_vars,
+    const properties::ptr& settings = properties::ptr(),
+    const properties::ptr& statistics = properties::ptr() );
+
 tt npn_canonization( const tt& t, boost::dynamic_bitset<>& phase,
                      std::vector<unsigned>& perm,
                      const properties::ptr& settings = properties::ptr(),
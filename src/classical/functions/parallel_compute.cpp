@@ -26,6 +26,14 @@
 
 #include "parallel_compute.hpp"
 
+#include <algorithm>
+#include <memory>
+#include <thread>
+
+#include <boost/graph/topological_sort.hpp>
+
+#include <core/utils/thread_pool.hpp>
+
 namespace cirkit
 {
 
@@ -33,29 +41,41 @@ namespace cirkit
  * Types                                                                      *
  ******************************************************************************/
 
+constexpr unsigned aig_level_schedule::no_input;
+
 /******************************************************************************
  * Private functions                                                          *
  ******************************************************************************/
 
+void process_chunk( const std::vector<aig_node>& level, std::size_t first, std::size_t last,
+                    const std::function<void( aig_node )>& on_node )
+{
+  for ( auto i = first; i < last; ++i )
+  {
+    on_node( level[i] );
+  }
+}
+
 /******************************************************************************
  * Public functions                                                           *
  ******************************************************************************/
 
-void parallel_process(
-    const aig_graph& aig,
-    const std::function<void( aig_node )>& on_input,
-    const std::function<void( aig_node, const aig_function&, const aig_function& )>& on_and )
+aig_level_schedule::aig_level_schedule( const aig_graph& aig )
+  : input_index( num_vertices( aig ), no_input ),
+    children( num_vertices( aig ) << 1u )
 {
+  const auto& info = aig_info( aig );
+
+  for ( auto i = 0u; i < info.inputs.size(); ++i )
+  {
+    input_index[info.inputs[i]] = i;
+  }
+
   /* topological order */
   std::vector<aig_node> topsort( num_vertices( aig ) );
   boost::topological_sort( aig, topsort.begin() );
 
-  boost::dynamic_bitset<>              processed( num_vertices( aig ) );
-  std::mutex                           vector_mutex;
-  std::vector<std::thread>             workers;
-  std::vector<std::condition_variable> guards( num_vertices( aig ) );
-  std::vector<std::mutex>              guard_locks( num_vertices( aig ) );
-  processed.set( 0u );
+  std::vector<unsigned> node_level( num_vertices( aig ), 0u );
 
   for ( auto n : topsort )
   {
@@ -64,47 +84,95 @@ void parallel_process(
     {
       if ( n == 0u ) { continue; }
 
-      workers.emplace_back( [&vector_mutex, &processed, n, &on_input, &guards, &guard_locks]() {
-          on_input( n );
-          vector_mutex.lock();
-          processed.set( n );
-          vector_mutex.unlock();
+      /* nodes without fanin that are not registered as inputs */
+      if ( input_index[n] == no_input )
+      {
+        input_index[n] = info.inputs.size();
+      }
 
-          std::unique_lock<std::mutex> lck( guard_locks[n] );
-          guards[n].notify_all();
-        } );
+      if ( levels.empty() ) { levels.resize( 1u ); }
+      levels[0u].push_back( n );
     }
     else
     {
-      const auto children = get_children( aig, n );
-
-      workers.emplace_back( [&vector_mutex, &processed, n, &on_and, children, &guards, &guard_locks]() {
-          {
-            std::unique_lock<std::mutex> lck( guard_locks[children[0].node] );
-            while ( !processed[children[0].node] ) { guards[children[0].node].wait( lck ); }
-          }
-          {
-            std::unique_lock<std::mutex> lck( guard_locks[children[1].node] );
-            while ( !processed[children[1].node] ) { guards[children[1].node].wait( lck ); }
-          }
-
-          on_and( n, children[0], children[1] );
-          vector_mutex.lock();
-          processed.set( n );
-          vector_mutex.unlock();
-
-          std::unique_lock<std::mutex> lck( guard_locks[n] );
-          guards[n].notify_all();
-        } );
+      auto level = 0u;
+      auto i = 0u;
+      for ( const auto& edge : boost::make_iterator_range( boost::out_edges( n, aig ) ) )
+      {
+        const auto f = aig_to_function( aig, edge );
+        children[( n << 1u ) + i++] = f;
+        level = std::max( level, node_level[f.node] );
+      }
+      node_level[n] = ++level;
+
+      if ( levels.size() <= level ) { levels.resize( level + 1u ); }
+      levels[level].push_back( n );
     }
   }
+}
+
+void parallel_process_levels(
+    const aig_level_schedule& schedule,
+    const std::function<void( aig_node )>& on_node,
+    const std::function<void( const std::vector<aig_node>& )>& on_level,
+    unsigned num_threads, unsigned grain )
+{
+  grain = std::max( 1u, grain );
+
+  /* the shared pool is used unless a specific number of threads is requested */
+  std::unique_ptr<thread_pool> local_pool;
+  if ( num_threads > 1u )
+  {
+    local_pool.reset( new thread_pool( num_threads ) );
+  }
+  auto& pool = local_pool ? *local_pool : shared_thread_pool();
+  const std::size_t workers = num_threads == 1u ? 1u : pool.size();
 
-  for ( auto& worker : workers )
+  for ( const auto& level : schedule.levels )
   {
-    worker.join();
+    if ( workers == 1u || level.size() <= grain )
+    {
+      process_chunk( level, 0u, level.size(), on_node );
+    }
+    else
+    {
+      /* at least grain nodes per chunk, at most a few chunks per thread to balance load */
+      const std::size_t chunk = std::max<std::size_t>( grain, ( level.size() + 4u * workers - 1u ) / ( 4u * workers ) );
+      const auto chunks = ( level.size() + chunk - 1u ) / chunk;
+
+      pool.parallel_for( 0u, chunks, 1u, [&level, &on_node, chunk]( std::size_t c ) {
+          process_chunk( level, c * chunk, std::min( ( c + 1u ) * chunk, level.size() ), on_node );
+        } );
+    }
+
+    if ( on_level )
+    {
+      on_level( level );
+    }
   }
 }
 
+void parallel_process(
+    const aig_graph& aig,
+    const std::function<void( aig_node )>& on_input,
+    const std::function<void( aig_node, const aig_function&, const aig_function& )>& on_and,
+    const std::function<void( const std::vector<aig_node>& )>& on_level,
+    unsigned num_threads, unsigned grain )
+{
+  const aig_level_schedule schedule( aig );
+
+  parallel_process_levels( schedule, [&]( aig_node n ) {
+      if ( schedule.is_input( n ) )
+      {
+        on_input( n );
+      }
+      else
+      {
+        on_and( n, schedule.child( n, 0u ), schedule.child( n, 1u ) );
+      }
+    }, on_level, num_threads, grain );
+}
+
 void parallel_simulate( const aig_graph& aig, const boost::dynamic_bitset<>& pattern )
 {
   std::vector<bool> computed_values;
@@ -29,6 +29,10 @@
  *
  * @brief Parallel computation on data structures
  *
+ * Nodes are grouped into levels such that all nodes in one level only
+ * depend on nodes in lower levels.  Each level is split into chunks which
+ * are processed by a thread pool; levels are separated by a barrier.
+ *
  * @author Mathias Soeken
  * @since  2.3
  */
@@ -36,15 +40,11 @@
 #ifndef PARALLEL_COMPUTE_HPP
 #define PARALLEL_COMPUTE_HPP
 
-#include <condition_variable>
 #include <functional>
 #include <iostream>
-#include <mutex>
-#include <thread>
 #include <vector>
 
 #include <boost/dynamic_bitset.hpp>
-#include <boost/graph/topological_sort.hpp>
 
 #include <classical/aig.hpp>
 #include <classical/utils/aig_utils.hpp>
@@ -52,84 +52,92 @@
 namespace cirkit
 {
 
+/******************************************************************************
+ * Level schedule                                                             *
+ ******************************************************************************/
+
+struct aig_level_schedule
+{
+  explicit aig_level_schedule( const aig_graph& aig );
+
+  inline bool is_input( aig_node n ) const { return input_index[n] != no_input; }
+  inline const aig_function& child( aig_node n, unsigned i ) const { return children[( n << 1u ) + i]; }
+
+  static constexpr unsigned no_input = static_cast<unsigned>( -1 );
+
+  /* levels[0] contains the primary inputs, the constant is not scheduled */
+  std::vector<std::vector<aig_node>> levels;
+
+  /* position in aig_info( aig ).inputs, or no_input */
+  std::vector<unsigned>              input_index;
+
+  /* two children for each AND gate, indexed by 2 * node */
+  std::vector<aig_function>          children;
+};
+
+/* calls on_node for every scheduled node such that all children of a node
+ * have been processed before; on_level is called from the calling thread
+ * after all nodes of a level have been processed
+ *
+ * num_threads = 0 uses shared_thread_pool(), levels with at most grain
+ * nodes are processed by the calling thread */
+void parallel_process_levels(
+    const aig_level_schedule& schedule,
+    const std::function<void( aig_node )>& on_node,
+    const std::function<void( const std::vector<aig_node>& )>& on_level = nullptr,
+    unsigned num_threads = 0u, unsigned grain = 256u );
+
+namespace detail
+{
+
+/* prevents data races on packed containers such as std::vector<bool> */
+template<typename T>
+struct parallel_value
+{
+  T value;
+};
+
+}
+
 template<typename T>
 void parallel_compute(
     const aig_graph& aig, const T& constant_result,
     const std::function<T( unsigned )>& on_input,
     const std::function<T( const T&, bool, const T&, bool )>& on_and,
-    std::vector<T>& computed_values )
+    std::vector<T>& computed_values,
+    unsigned num_threads = 0u, unsigned grain = 256u )
 {
-  /* topological order */
-  std::vector<aig_node> topsort( num_vertices( aig ) );
-  boost::topological_sort( aig, topsort.begin() );
-
-  const auto& info = aig_info( aig );
-
-  computed_values.resize( num_vertices( aig ) );
-  boost::dynamic_bitset<>              computed( num_vertices( aig ) );
-  std::mutex                           vector_mutex;
-  std::vector<std::thread>             workers;
-  std::vector<std::condition_variable> guards( num_vertices( aig ) );
-  std::vector<std::mutex>              guard_locks( num_vertices( aig ) );
-  computed.set( 0u );
-  computed_values[0u] = constant_result;
-
-  for ( auto n : topsort )
-  {
-    /* primary input */
-    if ( out_degree( n, aig ) == 0u )
-    {
-      if ( n == 0u ) { continue; }
-
-      const auto index = aig_input_index( info, n );
-      workers.emplace_back( [&vector_mutex, &computed_values, &computed, n, &on_input, index, &guards, &guard_locks]() {
-          const auto v = on_input( index );
-          vector_mutex.lock();
-          computed_values[n] = v;
-          computed.set( n );
-          vector_mutex.unlock();
-
-          std::unique_lock<std::mutex> lck( guard_locks[n] );
-          guards[n].notify_all();
-        } );
-    }
-    else
-    {
-      const auto children = get_children( aig, n );
-
-      workers.emplace_back( [&vector_mutex, &computed_values, &computed, n, &on_and, children, &guards, &guard_locks]() {
-          {
-            std::unique_lock<std::mutex> lck( guard_locks[children[0].node] );
-            while ( !computed[children[0].node] ) { guards[children[0].node].wait( lck ); }
-          }
-          {
-            std::unique_lock<std::mutex> lck( guard_locks[children[1].node] );
-            while ( !computed[children[1].node] ) { guards[children[1].node].wait( lck ); }
-          }
-
-          const auto v = on_and( computed_values[children[0].node], children[0].complemented,
-                                 computed_values[children[1].node], children[1].complemented );
-          vector_mutex.lock();
-          computed_values[n] = v;
-          computed.set( n );
-          vector_mutex.unlock();
-
-          std::unique_lock<std::mutex> lck( guard_locks[n] );
-          guards[n].notify_all();
-        } );
-    }
-  }
-
-  for ( auto& worker : workers )
+  const aig_level_schedule schedule( aig );
+
+  std::vector<detail::parallel_value<T>> values( num_vertices( aig ) );
+  values[0u].value = constant_result;
+
+  parallel_process_levels( schedule, [&]( aig_node n ) {
+      if ( schedule.is_input( n ) )
+      {
+        values[n].value = on_input( schedule.input_index[n] );
+      }
+      else
+      {
+        const auto& c1 = schedule.child( n, 0u );
+        const auto& c2 = schedule.child( n, 1u );
+        values[n].value = on_and( values[c1.node].value, c1.complemented, values[c2.node].value, c2.complemented );
+      }
+    }, nullptr, num_threads, grain );
+
+  computed_values.resize( values.size() );
+  for ( auto i = 0u; i < values.size(); ++i )
   {
-    worker.join();
+    computed_values[i] = std::move( values[i].value );
   }
 }
 
 void parallel_process(
     const aig_graph& aig,
     const std::function<void( aig_node )>& on_input,
-    const std::function<void( aig_node, const aig_function&, const aig_function& )>& on_and );
+    const std::function<void( aig_node, const aig_function&, const aig_function& )>& on_and,
+    const std::function<void( const std::vector<aig_node>& )>& on_level = nullptr,
+    unsigned num_threads = 0u, unsigned grain = 256u );
 
 /* this is a usage demo */
 void parallel_simulate( const aig_graph& aig, const boost::dynamic_bitset<>& pattern );
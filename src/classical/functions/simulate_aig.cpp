@@ -40,6 +40,11 @@ bool pattern_simulator::get_input( const aig_node& node, const std::string& name
   return pattern[pos];
 }
 
+bool pattern_simulator::get_input( aig_compact::node_t node, const std::string& name, unsigned pos, const aig_compact& aig ) const
+{
+  return pattern[pos];
+}
+
 bool pattern_simulator::get_constant() const
 {
   return false;
@@ -55,6 +60,11 @@ bool pattern_simulator::and_op( const aig_node& node, const bool& v1, const bool
   return v1 && v2;
 }
 
+bool pattern_simulator::and_op( aig_compact::node_t node, const bool& v1, const bool& v2 ) const
+{
+  return v1 && v2;
+}
+
 /******************************************************************************
  * Boolean simulation                                                         *
  ******************************************************************************/
@@ -62,6 +72,11 @@ bool pattern_simulator::and_op( const aig_node& node, const bool& v1, const bool
 simple_assignment_simulator::simple_assignment_simulator( const aig_name_value_map& assignment ) : assignment( assignment ) {}
 
 bool simple_assignment_simulator::get_input( const aig_node& node, const std::string& name, unsigned pos, const aig_graph& aig ) const
+{
+  return lookup( name );
+}
+
+bool simple_assignment_simulator::lookup( const std::string& name ) const
 {
   auto it = assignment.find( name );
   if ( it == assignment.end() )
@@ -75,6 +90,11 @@ bool simple_assignment_simulator::get_input( const aig_node& node, const std::st
   }
 }
 
+bool simple_assignment_simulator::get_input( aig_compact::node_t node, const std::string& name, unsigned pos, const aig_compact& aig ) const
+{
+  return lookup( name );
+}
+
 bool simple_assignment_simulator::get_constant() const
 {
   return false;
@@ -90,6 +110,11 @@ bool simple_assignment_simulator::and_op( const aig_node& node, const bool& v1,
   return v1 && v2;
 }
 
+bool simple_assignment_simulator::and_op( aig_compact::node_t node, const bool& v1, const bool& v2 ) const
+{
+  return v1 && v2;
+}
+
 /******************************************************************************
  * Boolean simulation (on nodes)                                              *
  ******************************************************************************/
@@ -138,6 +163,11 @@ bool simple_node_assignment_simulator::terminate( const aig_node& node, const ai
 word_assignment_simulator::word_assignment_simulator( const aig_name_value_map& assignment ) : assignment( assignment ) {}
 
 boost::dynamic_bitset<> word_assignment_simulator::get_input( const aig_node& node, const std::string& name, unsigned pos, const aig_graph& aig ) const
+{
+  return lookup( name );
+}
+
+boost::dynamic_bitset<> word_assignment_simulator::lookup( const std::string& name ) const
 {
   auto it = assignment.find( name );
   if ( it == assignment.end() )
@@ -152,6 +182,11 @@ boost::dynamic_bitset<> word_assignment_simulator::get_input( const aig_node& no
   }
 }
 
+boost::dynamic_bitset<> word_assignment_simulator::get_input( aig_compact::node_t node, const std::string& name, unsigned pos, const aig_compact& aig ) const
+{
+  return lookup( name );
+}
+
 boost::dynamic_bitset<> word_assignment_simulator::get_constant() const
 {
   return boost::dynamic_bitset<>( assignment.begin()->second.size() );
@@ -167,6 +202,11 @@ boost::dynamic_bitset<> word_assignment_simulator::and_op( const aig_node& node,
   return v1 & v2;
 }
 
+boost::dynamic_bitset<> word_assignment_simulator::and_op( aig_compact::node_t node, const boost::dynamic_bitset<>& v1, const boost::dynamic_bitset<>& v2 ) const
+{
+  return v1 & v2;
+}
+
 /******************************************************************************
  * Word simulation (on nodes)                                                 *
  ******************************************************************************/
@@ -218,6 +258,11 @@ tt tt_simulator::get_input( const aig_node& node, const std::string& name, unsig
   return tt_nth_var( pos );
 }
 
+tt tt_simulator::get_input( aig_compact::node_t node, const std::string& name, unsigned pos, const aig_compact& aig ) const
+{
+  return tt_nth_var( pos );
+}
+
 tt tt_simulator::get_constant() const
 {
   return tt_const0();
@@ -230,7 +275,16 @@ tt tt_simulator::invert( const tt& v ) const
 
 tt tt_simulator::and_op( const aig_node& node, const tt& v1, const tt& v2 ) const
 {
+  return aligned_and( v1, v2 );
+}
+
+tt tt_simulator::and_op( aig_compact::node_t node, const tt& v1, const tt& v2 ) const
+{
+  return aligned_and( v1, v2 );
+}
 
+tt tt_simulator::aligned_and( const tt& v1, const tt& v2 ) const
+{
   // NOTE: make this more performant?
   tt _v1 = v1;
   tt _v2 = v2;
@@ -271,6 +325,11 @@ unsigned depth_simulator::get_input( const aig_node& node, const std::string& na
   return 0u;
 }
 
+unsigned depth_simulator::get_input( aig_compact::node_t node, const std::string& name, unsigned pos, const aig_compact& aig ) const
+{
+  return 0u;
+}
+
 unsigned depth_simulator::get_constant() const
 {
   return 0u;
@@ -286,6 +345,11 @@ unsigned depth_simulator::and_op( const aig_node& node, const unsigned& v1, cons
   return std::max( v1, v2 ) + 1u;
 }
 
+unsigned depth_simulator::and_op( aig_compact::node_t node, const unsigned& v1, const unsigned& v2 ) const
+{
+  return std::max( v1, v2 ) + 1u;
+}
+
 }
 
 // Local Variables:
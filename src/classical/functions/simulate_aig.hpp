@@ -48,6 +48,7 @@
 #include <core/properties.hpp>
 #include <core/utils/timer.hpp>
 #include <classical/aig.hpp>
+#include <classical/aig_compact.hpp>
 #include <classical/utils/aig_dfs.hpp>
 #include <classical/utils/aig_utils.hpp>
 #include <classical/utils/truth_table_utils.hpp>
@@ -84,25 +85,49 @@ public:
   }
 };
 
+/**
+ * @brief Simulator interface for compact AIGs
+ *
+ * Same as aig_simulator, but nodes are indexes into the compact AIG that
+ * is passed to the callbacks.  Simulators that do not depend on the
+ * graph implement both interfaces.
+ */
+template<typename T>
+class aig_compact_simulator
+{
+public:
+  virtual T get_input( aig_compact::node_t node, const std::string& name, unsigned pos, const aig_compact& aig ) const = 0;
+  virtual T get_constant() const = 0;
+  virtual T invert( const T& v ) const = 0;
+  virtual T and_op( aig_compact::node_t node, const T& v1, const T& v2 ) const = 0;
+
+  virtual bool terminate( aig_compact::node_t node, const aig_compact& aig ) const
+  {
+    return false;
+  }
+};
+
 /******************************************************************************
  * Several simulator implementations                                          *
  ******************************************************************************/
 
-class pattern_simulator : public aig_simulator<bool>
+class pattern_simulator : public aig_simulator<bool>, public aig_compact_simulator<bool>
 {
 public:
   pattern_simulator( const boost::dynamic_bitset<>& pattern );
 
   bool get_input( const aig_node& node, const std::string& name, unsigned pos, const aig_graph& aig ) const;
+  bool get_input( aig_compact::node_t node, const std::string& name, unsigned pos, const aig_compact& aig ) const;
   bool get_constant() const;
   bool invert( const bool& v ) const;
   bool and_op( const aig_node& node, const bool& v1, const bool& v2 ) const;
+  bool and_op( aig_compact::node_t node, const bool& v1, const bool& v2 ) const;
 
 private:
   boost::dynamic_bitset<> pattern;
 };
 
-class simple_assignment_simulator : public aig_simulator<bool>
+class simple_assignment_simulator : public aig_simulator<bool>, public aig_compact_simulator<bool>
 {
 public:
   using aig_name_value_map = std::unordered_map<std::string, bool>;
@@ -110,11 +135,15 @@ public:
   simple_assignment_simulator( const aig_name_value_map& assignment );
 
   bool get_input( const aig_node& node, const std::string& name, unsigned pos, const aig_graph& aig ) const;
+  bool get_input( aig_compact::node_t node, const std::string& name, unsigned pos, const aig_compact& aig ) const;
   bool get_constant() const;
   bool invert( const bool& v ) const;
   bool and_op( const aig_node& node, const bool& v1, const bool& v2 ) const;
+  bool and_op( aig_compact::node_t node, const bool& v1, const bool& v2 ) const;
 
 private:
+  bool lookup( const std::string& name ) const;
+
   const aig_name_value_map& assignment;
 };
 
@@ -135,7 +164,7 @@ private:
   const aig_node_value_map& assignment;
 };
 
-class word_assignment_simulator : public aig_simulator<boost::dynamic_bitset<>>
+class word_assignment_simulator : public aig_simulator<boost::dynamic_bitset<>>, public aig_compact_simulator<boost::dynamic_bitset<>>
 {
 public:
   using aig_name_value_map = std::unordered_map<std::string, boost::dynamic_bitset<>>;
@@ -143,11 +172,15 @@ public:
   word_assignment_simulator( const aig_name_value_map& assignment );
 
   boost::dynamic_bitset<> get_input( const aig_node& node, const std::string& name, unsigned pos, const aig_graph& aig ) const;
+  boost::dynamic_bitset<> get_input( aig_compact::node_t node, const std::string& name, unsigned pos, const aig_compact& aig ) const;
   boost::dynamic_bitset<> get_constant() const;
   boost::dynamic_bitset<> invert( const boost::dynamic_bitset<>& v ) const;
   boost::dynamic_bitset<> and_op( const aig_node& node, const boost::dynamic_bitset<>& v1, const boost::dynamic_bitset<>& v2 ) const;
+  boost::dynamic_bitset<> and_op( aig_compact::node_t node, const boost::dynamic_bitset<>& v1, const boost::dynamic_bitset<>& v2 ) const;
 
 private:
+  boost::dynamic_bitset<> lookup( const std::string& name ) const;
+
   const aig_name_value_map& assignment;
 };
 
@@ -168,13 +201,18 @@ private:
   const aig_node_value_map& assignment;
 };
 
-class tt_simulator : public aig_simulator<tt>
+class tt_simulator : public aig_simulator<tt>, public aig_compact_simulator<tt>
 {
 public:
   tt get_input( const aig_node& node, const std::string& name, unsigned pos, const aig_graph& aig ) const;
+  tt get_input( aig_compact::node_t node, const std::string& name, unsigned pos, const aig_compact& aig ) const;
   tt get_constant() const;
   tt invert( const tt& v ) const;
   tt and_op( const aig_node& node, const tt& v1, const tt& v2 ) const;
+  tt and_op( aig_compact::node_t node, const tt& v1, const tt& v2 ) const;
+
+private:
+  tt aligned_and( const tt& v1, const tt& v2 ) const;
 };
 
 class bdd_simulator : public aig_simulator<BDD>
@@ -192,13 +230,15 @@ protected:
   Cudd mgr;
 };
 
-class depth_simulator : public aig_simulator<unsigned>
+class depth_simulator : public aig_simulator<unsigned>, public aig_compact_simulator<unsigned>
 {
 public:
   unsigned get_input( const aig_node& node, const std::string& name, unsigned pos, const aig_graph& aig ) const;
+  unsigned get_input( aig_compact::node_t node, const std::string& name, unsigned pos, const aig_compact& aig ) const;
   unsigned get_constant() const;
   unsigned invert( const unsigned& v ) const;
   unsigned and_op( const aig_node& node, const unsigned& v1, const unsigned& v2 ) const;
+  unsigned and_op( aig_compact::node_t node, const unsigned& v1, const unsigned& v2 ) const;
 };
 
 template<typename T>
@@ -539,6 +579,106 @@ std::map<aig_function, T> simulate_aig( const aig_graph& aig, const aig_simulato
   return results;
 }
 
+/******************************************************************************
+ * Simulation of compact AIGs                                                 *
+ ******************************************************************************/
+
+/**
+ * @brief Simulates all nodes in the cones of `fs'
+ *
+ * Since node indexes of compact AIGs are in topological order, this is
+ * a single sweep over the node array.  The returned vector is indexed
+ * by node, values of nodes outside the cones are default constructed.
+ */
+template<typename T>
+std::vector<T> simulate_aig_nodes( const aig_compact& aig, const aig_compact_simulator<T>& simulator,
+                                   const std::vector<aig_function>& fs )
+{
+  /* mark cones */
+  std::vector<unsigned char> in_cone( aig.size(), 0u );
+  for ( const auto& f : fs )
+  {
+    in_cone[f.node] = 1u;
+  }
+  for ( auto n = aig.size() - 1u; n > 0u; --n )
+  {
+    if ( !in_cone[n] || !aig.is_and( n ) || simulator.terminate( n, aig ) ) { continue; }
+    in_cone[aig.fanin( n, 0u ).node] = in_cone[aig.fanin( n, 1u ).node] = 1u;
+  }
+
+  std::vector<unsigned> input_pos( aig.size(), aig.inputs().size() );
+  for ( auto i = 0u; i < aig.inputs().size(); ++i )
+  {
+    input_pos[aig.inputs()[i]] = i;
+  }
+
+  /* simulate */
+  std::vector<T> node_values( aig.size() );
+  for ( aig_compact::node_t n = 0u; n < aig.size(); ++n )
+  {
+    if ( !in_cone[n] ) { continue; }
+
+    if ( aig.is_constant( n ) )
+    {
+      node_values[n] = simulator.get_constant();
+    }
+    else if ( aig.is_ci( n ) )
+    {
+      node_values[n] = simulator.get_input( n, aig.names().name( n ), input_pos[n], aig );
+    }
+    else if ( simulator.terminate( n, aig ) )
+    {
+      node_values[n] = simulator.and_op( n, T(), T() );
+    }
+    else
+    {
+      const auto left  = aig.fanin( n, 0u );
+      const auto right = aig.fanin( n, 1u );
+      node_values[n] = simulator.and_op( n,
+                                         left.complemented ? simulator.invert( node_values[left.node] ) : node_values[left.node],
+                                         right.complemented ? simulator.invert( node_values[right.node] ) : node_values[right.node] );
+    }
+  }
+
+  return node_values;
+}
+
+template<typename T>
+std::map<aig_function, T> simulate_aig( const aig_compact& aig, const aig_compact_simulator<T>& simulator,
+                                        const std::vector< aig_function >& fs,
+                                        const properties::ptr& settings = properties::ptr(),
+                                        const properties::ptr& statistics = properties::ptr() )
+{
+  /* timer */
+  properties_timer t( statistics );
+
+  const auto node_values = simulate_aig_nodes( aig, simulator, fs );
+
+  std::map<aig_function, T> results;
+  for ( const auto& f : fs )
+  {
+    results[f] = f.complemented ? simulator.invert( node_values[f.node] ) : node_values[f.node];
+  }
+
+  set( statistics, "node_values", node_values );
+
+  return results;
+}
+
+template<typename T>
+std::map<aig_function, T> simulate_aig( const aig_compact& aig, const aig_compact_simulator<T>& simulator,
+                                        const properties::ptr& settings = properties::ptr(),
+                                        const properties::ptr& statistics = properties::ptr() )
+{
+  std::vector<aig_function> fs;
+  for ( auto i = 0u; i < aig.outputs().size(); ++i )
+  {
+    fs.push_back( aig.output( i ) );
+  }
+
+  return simulate_aig( aig, simulator, fs, settings, statistics );
+}
+
 }
 
 #endif
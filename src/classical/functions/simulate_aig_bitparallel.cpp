@@ -0,0 +1,317 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "simulate_aig_bitparallel.hpp"
+
+#include <algorithm>
+#include <random>
+
+#include <boost/graph/topological_sort.hpp>
+#include <boost/range/iterator_range.hpp>
+
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+#include <core/utils/timer.hpp>
+#include <classical/utils/aig_utils.hpp>
+
+namespace cirkit
+{
+
+/******************************************************************************
+ * Types                                                                      *
+ ******************************************************************************/
+
+/******************************************************************************
+ * Private functions                                                          *
+ ******************************************************************************/
+
+/* out = ( a ^ ma ) & ( b ^ mb ), where ma and mb are all-zero or all-one complement masks */
+inline void and_words( std::uint64_t* out,
+                       const std::uint64_t* a, std::uint64_t ma,
+                       const std::uint64_t* b, std::uint64_t mb,
+                       std::size_t n )
+{
+  std::size_t w = 0u;
+
+#if defined(__AVX512F__)
+  const auto vma = _mm512_set1_epi64( static_cast<long long>( ma ) );
+  const auto vmb = _mm512_set1_epi64( static_cast<long long>( mb ) );
+  for ( ; w + 8u <= n; w += 8u )
+  {
+    const auto va = _mm512_xor_si512( _mm512_loadu_si512( a + w ), vma );
+    const auto vb = _mm512_xor_si512( _mm512_loadu_si512( b + w ), vmb );
+    _mm512_storeu_si512( out + w, _mm512_and_si512( va, vb ) );
+  }
+#endif
+
+#if defined(__AVX2__)
+  const auto yma = _mm256_set1_epi64x( static_cast<long long>( ma ) );
+  const auto ymb = _mm256_set1_epi64x( static_cast<long long>( mb ) );
+  for ( ; w + 4u <= n; w += 4u )
+  {
+    const auto va = _mm256_xor_si256( _mm256_loadu_si256( reinterpret_cast<const __m256i*>( a + w ) ), yma );
+    const auto vb = _mm256_xor_si256( _mm256_loadu_si256( reinterpret_cast<const __m256i*>( b + w ) ), ymb );
+    _mm256_storeu_si256( reinterpret_cast<__m256i*>( out + w ), _mm256_and_si256( va, vb ) );
+  }
+#endif
+
+  for ( ; w < n; ++w )
+  {
+    out[w] = ( a[w] ^ ma ) & ( b[w] ^ mb );
+  }
+}
+
+/******************************************************************************
+ * Public functions                                                           *
+ ******************************************************************************/
+
+aig_bitparallel_simulator::aig_bitparallel_simulator( const aig_graph& aig )
+{
+  const auto& info = aig_info( aig );
+  const auto& complementmap = boost::get( boost::edge_complement, aig );
+  const auto n = num_vertices( aig );
+
+  _node_to_index.resize( n, 0u );
+  _fanins.resize( n << 1u, 0u );
+
+  /* children come first in the topological sort of the edge direction parent -> child */
+  std::vector<aig_node> topsort;
+  topsort.reserve( n );
+  boost::topological_sort( aig, std::back_inserter( topsort ) );
+
+  _node_to_index[info.constant] = 0u;
+  auto index = 1u;
+  for ( const auto& node : topsort )
+  {
+    if ( node == info.constant ) { continue; }
+
+    _node_to_index[node] = index;
+
+    if ( out_degree( node, aig ) != 0u )
+    {
+      auto pos = index << 1u;
+      for ( const auto& e : boost::make_iterator_range( out_edges( node, aig ) ) )
+      {
+        _fanins[pos++] = ( _node_to_index[target( e, aig )] << 1u ) | ( complementmap[e] ? 1u : 0u );
+      }
+      _gates.push_back( index );
+    }
+
+    ++index;
+  }
+
+  for ( const auto& input : info.inputs )
+  {
+    _inputs.push_back( _node_to_index[input] );
+  }
+  for ( const auto& ci : info.cis )
+  {
+    _inputs.push_back( _node_to_index[ci] );
+  }
+  for ( const auto& output : info.outputs )
+  {
+    _outputs.push_back( output.first );
+  }
+}
+
+aig_bitparallel_simulator::aig_bitparallel_simulator( const aig_compact& aig )
+  : _fanins( aig.fanins() )
+{
+  /* node indexes of compact AIGs are already a topological order */
+  _node_to_index.resize( aig.size() );
+  for ( aig_compact::node_t n = 0u; n < aig.size(); ++n )
+  {
+    _node_to_index[n] = n;
+    if ( aig.is_and( n ) )
+    {
+      _gates.push_back( n );
+    }
+  }
+
+  _inputs.insert( _inputs.end(), aig.inputs().begin(), aig.inputs().end() );
+  _inputs.insert( _inputs.end(), aig.cis().begin(), aig.cis().end() );
+  for ( auto i = 0u; i < aig.outputs().size(); ++i )
+  {
+    _outputs.push_back( aig.output( i ) );
+  }
+}
+
+unsigned aig_bitparallel_simulator::lane_width()
+{
+#if defined(__AVX512F__)
+  return 512u;
+#elif defined(__AVX2__)
+  return 256u;
+#else
+  return 64u;
+#endif
+}
+
+void aig_bitparallel_simulator::simulate_random( unsigned num_patterns, unsigned seed )
+{
+  std::mt19937_64 gen( seed );
+  run( num_patterns, [this, &gen]( unsigned offset, unsigned n ) {
+      for ( const auto& input : _inputs )
+      {
+        auto* w = block_words_of( input );
+        for ( auto i = 0u; i < n; ++i )
+        {
+          w[i] = gen();
+        }
+      }
+    } );
+}
+
+void aig_bitparallel_simulator::simulate( const std::vector<boost::dynamic_bitset<>>& patterns )
+{
+  run( patterns.size(), [this, &patterns]( unsigned offset, unsigned n ) {
+      const auto first = offset << 6u;
+      const auto last = std::min<std::size_t>( ( offset + n ) << 6u, patterns.size() );
+      for ( auto p = first; p < last; ++p )
+      {
+        const auto& pattern = patterns[p];
+        for ( auto i = 0u; i < _inputs.size() && i < pattern.size(); ++i )
+        {
+          if ( pattern[i] )
+          {
+            block_words_of( _inputs[i] )[( p - first ) >> 6u] |= std::uint64_t( 1u ) << ( p & 63u );
+          }
+        }
+      }
+    } );
+}
+
+void aig_bitparallel_simulator::simulate_words( const std::vector<std::vector<std::uint64_t>>& input_words, unsigned num_patterns )
+{
+  run( num_patterns, [this, &input_words]( unsigned offset, unsigned n ) {
+      for ( auto i = 0u; i < _inputs.size() && i < input_words.size(); ++i )
+      {
+        assert( input_words[i].size() >= _num_words );
+        std::copy( input_words[i].begin() + offset, input_words[i].begin() + offset + n, block_words_of( _inputs[i] ) );
+      }
+    } );
+}
+
+boost::dynamic_bitset<> aig_bitparallel_simulator::output_signature( unsigned output ) const
+{
+  const auto* w = &_output_data[output * _num_words];
+
+  boost::dynamic_bitset<> sig;
+  sig.append( w, w + _num_words );
+  sig.resize( _num_patterns );
+
+  if ( _outputs[output].complemented )
+  {
+    sig.flip();
+  }
+
+  return sig;
+}
+
+std::vector<boost::dynamic_bitset<>> aig_bitparallel_simulator::output_signatures() const
+{
+  std::vector<boost::dynamic_bitset<>> sigs;
+  sigs.reserve( _outputs.size() );
+
+  for ( auto i = 0u; i < _outputs.size(); ++i )
+  {
+    sigs.push_back( output_signature( i ) );
+  }
+
+  return sigs;
+}
+
+void aig_bitparallel_simulator::run( unsigned num_patterns, const std::function<void(unsigned, unsigned)>& fill_inputs )
+{
+  _num_patterns = num_patterns;
+  _num_words = ( num_patterns + 63u ) >> 6u;
+  _block_words = std::min( _num_words, block_words );
+  _data.assign( _node_to_index.size() * _block_words, 0u );
+  _output_data.assign( _outputs.size() * _num_words, 0u );
+
+  for ( auto offset = 0u; offset < _num_words; offset += _block_words )
+  {
+    const auto n = std::min( _block_words, _num_words - offset );
+
+    /* inputs that are not filled (e.g., latch outputs) are 0 */
+    for ( const auto& input : _inputs )
+    {
+      std::fill_n( block_words_of( input ), n, std::uint64_t( 0u ) );
+    }
+    fill_inputs( offset, n );
+
+    simulate_block( n );
+
+    for ( auto i = 0u; i < _outputs.size(); ++i )
+    {
+      const auto* w = block_words_of( _node_to_index[_outputs[i].node] );
+      std::copy( w, w + n, _output_data.begin() + i * _num_words + offset );
+    }
+  }
+}
+
+void aig_bitparallel_simulator::simulate_block( unsigned n )
+{
+  auto* data = _data.data();
+
+  for ( const auto& g : _gates )
+  {
+    const auto l0 = _fanins[g << 1u];
+    const auto l1 = _fanins[( g << 1u ) + 1u];
+
+    and_words( data + g * _block_words,
+               data + ( l0 >> 1u ) * _block_words, ( l0 & 1u ) ? ~std::uint64_t( 0u ) : 0u,
+               data + ( l1 >> 1u ) * _block_words, ( l1 & 1u ) ? ~std::uint64_t( 0u ) : 0u,
+               n );
+  }
+}
+
+std::vector<boost::dynamic_bitset<>> simulate_aig_signatures( const aig_graph& aig, unsigned num_patterns,
+                                                             const properties::ptr& settings,
+                                                             const properties::ptr& statistics )
+{
+  /* settings */
+  const auto seed = get( settings, "seed", 0u );
+
+  /* timer */
+  properties_timer t( statistics );
+
+  aig_bitparallel_simulator sim( aig );
+  sim.simulate_random( num_patterns, seed );
+  return sim.output_signatures();
+}
+
+constexpr unsigned aig_bitparallel_simulator::block_words;
+
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
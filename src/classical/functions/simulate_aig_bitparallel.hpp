@@ -0,0 +1,136 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * @file simulate_aig_bitparallel.hpp
+ *
+ * @brief Bit-parallel word-level AIG simulation
+ *
+ * Simulates many input patterns at once.  Patterns are processed in
+ * blocks of at most block_words 64-bit words, each node owns a
+ * contiguous slice of one block-sized buffer, so memory is bounded by
+ * the network size and not by the number of patterns.  Only the output
+ * words of each block are kept.  The AND gates are evaluated in a
+ * precomputed topological order with a kernel that uses AVX-512 or
+ * AVX2 instructions if the library is compiled for such a target (see
+ * the cirkit_ENABLE_NATIVE_ARCH option) and plain 64-bit operations
+ * otherwise.
+ *
+ * @author Mathias Soeken
+ * @since  2.3
+ */
+
+#ifndef SIMULATE_AIG_BITPARALLEL_HPP
+#define SIMULATE_AIG_BITPARALLEL_HPP
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include <boost/dynamic_bitset.hpp>
+
+#include <core/properties.hpp>
+#include <classical/aig.hpp>
+#include <classical/aig_compact.hpp>
+
+namespace cirkit
+{
+
+class aig_bitparallel_simulator
+{
+public:
+  /* precomputes the topological order, inputs are PIs followed by latch outputs */
+  explicit aig_bitparallel_simulator( const aig_graph& aig );
+  explicit aig_bitparallel_simulator( const aig_compact& aig );
+
+  /* number of bits processed by one kernel instruction (64, 256, or 512) */
+  static unsigned lane_width();
+
+  /* simulates num_patterns random patterns */
+  void simulate_random( unsigned num_patterns, unsigned seed = 0u );
+
+  /* simulates user patterns, patterns[p][i] is the value of input i in pattern p,
+     missing inputs (e.g., latch outputs) are assigned 0 */
+  void simulate( const std::vector<boost::dynamic_bitset<>>& patterns );
+
+  /* simulates given input words, input_words[i] must contain num_words() words */
+  void simulate_words( const std::vector<std::vector<std::uint64_t>>& input_words, unsigned num_patterns );
+
+  inline unsigned num_patterns() const { return _num_patterns; }
+  inline unsigned num_words() const    { return _num_words; }
+  inline unsigned num_inputs() const   { return _inputs.size(); }
+  inline unsigned num_outputs() const  { return _outputs.size(); }
+
+  /* output signatures of the last simulation */
+  boost::dynamic_bitset<> output_signature( unsigned output ) const;
+  std::vector<boost::dynamic_bitset<>> output_signatures() const;
+
+  /* maximum number of words per node that are simulated at once (4096 patterns) */
+  static constexpr unsigned block_words = 64u;
+
+private:
+  /* fill_inputs( offset, n ) writes words [offset, offset + n) of the inputs into the block */
+  void run( unsigned num_patterns, const std::function<void(unsigned, unsigned)>& fill_inputs );
+  void simulate_block( unsigned n );
+
+  inline std::uint64_t* block_words_of( unsigned index ) { return &_data[index * _block_words]; }
+
+private:
+  std::vector<unsigned>      _node_to_index;  /* network node -> index in simulation order */
+  std::vector<unsigned>      _inputs;         /* indexes of inputs */
+  std::vector<unsigned>      _gates;          /* indexes of AND gates in topological order */
+  std::vector<std::uint32_t> _fanins;         /* two fanin literals (2 * index + complement) per index */
+  std::vector<aig_function>  _outputs;        /* output functions (network nodes) */
+
+  unsigned                   _num_patterns = 0u;
+  unsigned                   _num_words = 0u;
+  unsigned                   _block_words = 0u;
+  std::vector<std::uint64_t> _data;           /* one block of words per index */
+  std::vector<std::uint64_t> _output_data;    /* all words per output, not complemented */
+};
+
+/**
+ * @brief Computes output signatures under random patterns
+ *
+ * Settings:
+ *   seed: random seed (default: 0)
+ *
+ * Statistics:
+ *   runtime: run-time
+ */
+std::vector<boost::dynamic_bitset<>> simulate_aig_signatures( const aig_graph& aig, unsigned num_patterns,
+                                                             const properties::ptr& settings = properties::ptr(),
+                                                             const properties::ptr& statistics = properties::ptr() );
+
+}
+
+#endif
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
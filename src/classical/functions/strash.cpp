@@ -36,6 +36,45 @@ namespace cirkit
  * Types                                                                      *
  ******************************************************************************/
 
+class strash_compact_simulator : public aig_compact_simulator<aig_function>
+{
+public:
+  strash_compact_simulator( aig_compact& aig_new, unsigned offset,
+                            const std::map<unsigned, unsigned>& reorder,
+                            const boost::dynamic_bitset<>& invert )
+    : aig_new( aig_new ),
+      offset( offset ),
+      reorder( reorder ),
+      _invert( invert ) {}
+
+  aig_function get_input( aig_compact::node_t node, const std::string& name, unsigned pos, const aig_compact& aig ) const
+  {
+    const auto it = reorder.find( pos );
+    return { aig_new.inputs().at( offset + ( it == reorder.end() ? pos : it->second ) ), _invert[pos] };
+  }
+
+  aig_function get_constant() const
+  {
+    return aig_new.get_constant( false );
+  }
+
+  aig_function invert( const aig_function& v ) const
+  {
+    return !v;
+  }
+
+  aig_function and_op( aig_compact::node_t node, const aig_function& v1, const aig_function& v2 ) const
+  {
+    return aig_new.create_and( v1, v2 );
+  }
+
+private:
+  aig_compact& aig_new;
+  unsigned offset;
+  const std::map<unsigned, unsigned>& reorder;
+  const boost::dynamic_bitset<>& _invert;
+};
+
 /******************************************************************************
  * Private functions                                                          *
  ******************************************************************************/
@@ -55,6 +94,12 @@ aig_function strash_simulator::get_input( const aig_node& node, const std::strin
   return { info.inputs.at( offset + ( it == reorder.end() ? pos : it->second ) ), _invert[pos] };
 }
 
+aig_function strash_simulator::get_input( aig_compact::node_t node, const std::string& name, unsigned pos, const aig_compact& aig ) const
+{
+  const auto it = reorder.find( pos );
+  return { info.inputs.at( offset + ( it == reorder.end() ? pos : it->second ) ), _invert[pos] };
+}
+
 aig_function strash_simulator::get_constant() const
 {
   return aig_get_constant( aig_new, false );
@@ -70,6 +115,64 @@ aig_function strash_simulator::and_op( const aig_node& node, const aig_function&
   return aig_create_and( aig_new, v1, v2 );
 }
 
+aig_function strash_simulator::and_op( aig_compact::node_t node, const aig_function& v1, const aig_function& v2 ) const
+{
+  return aig_create_and( aig_new, v1, v2 );
+}
+
+inline std::size_t strash_num_inputs( const aig_graph& aig )   { return aig_info( aig ).inputs.size(); }
+inline std::size_t strash_num_inputs( const aig_compact& aig ) { return aig.inputs().size(); }
+
+inline void strash_set_model_name( aig_graph& aig, const std::string& name )   { aig_info( aig ).model_name = name; }
+inline void strash_set_model_name( aig_compact& aig, const std::string& name ) { aig.set_model_name( name ); }
+
+inline strash_simulator make_strash_simulator( aig_graph& dest, unsigned offset,
+                                               const std::map<unsigned, unsigned>& reorder,
+                                               const boost::dynamic_bitset<>& invert )
+{
+  return strash_simulator( dest, offset, reorder, invert );
+}
+
+inline strash_compact_simulator make_strash_simulator( aig_compact& dest, unsigned offset,
+                                                       const std::map<unsigned, unsigned>& reorder,
+                                                       const boost::dynamic_bitset<>& invert )
+{
+  return strash_compact_simulator( dest, offset, reorder, invert );
+}
+
+template<typename Dest>
+void strash_compact( const aig_compact& aig,
+                     Dest& aig_dest,
+                     const properties::ptr& settings,
+                     const properties::ptr& statistics )
+{
+  /* settings */
+  const auto reorder      = get( settings, "reorder",      std::map<unsigned, unsigned>() );
+  const auto invert       = get( settings, "invert",       boost::dynamic_bitset<>( aig.inputs().size() ) );
+  const auto reuse_inputs = get( settings, "reuse_inputs", false );
+
+  const auto offset = !reuse_inputs ? strash_num_inputs( aig_dest ) : 0u;
+
+  /* copy inputs */
+  if ( !reuse_inputs )
+  {
+    for ( const auto& input : aig.inputs() )
+    {
+      aig_create_pi( aig_dest, aig.names().name( input ) );
+    }
+  }
+
+  /* copy other info */
+  strash_set_model_name( aig_dest, aig.model_name() );
+
+  auto result = simulate_aig( aig, make_strash_simulator( aig_dest, offset, reorder, invert ), properties::ptr(), statistics );
+
+  for ( auto i = 0u; i < aig.outputs().size(); ++i )
+  {
+    aig_create_po( aig_dest, result[aig.output( i )], aig.names().output_names[i] );
+  }
+}
+
 /******************************************************************************
  * Public functions                                                           *
  ******************************************************************************/
@@ -81,6 +184,10 @@ aig_graph strash( const aig_graph& aig,
   aig_graph aig_new;
   aig_initialize( aig_new );
 
+  auto& strash_table = aig_info( aig_new ).strash;
+  strash_table.set_max_load_factor( get( settings, "max_load_factor", strash_table.max_load_factor() ) );
+  strash_table.reserve( num_vertices( aig ) );
+
   strash( aig, aig_new, settings, statistics );
 
   return aig_new;
@@ -126,6 +233,38 @@ void strash( const aig_graph& aig,
   {
     aig_create_po( aig_dest, result[output.first], output.second );
   }
+
+  set( statistics, "strash_lookups", info_dest.strash.statistics().lookups );
+  set( statistics, "strash_hits", info_dest.strash.statistics().hits );
+}
+
+aig_compact strash( const aig_compact& aig,
+                    const properties::ptr& settings,
+                    const properties::ptr& statistics )
+{
+  aig_compact aig_new;
+  aig_new.strash().set_max_load_factor( get( settings, "max_load_factor", aig_new.strash().max_load_factor() ) );
+  aig_new.reserve( aig.size() );
+
+  strash( aig, aig_new, settings, statistics );
+
+  return aig_new;
+}
+
+void strash( const aig_compact& aig,
+             aig_graph& aig_dest,
+             const properties::ptr& settings,
+             const properties::ptr& statistics )
+{
+  strash_compact( aig, aig_dest, settings, statistics );
+}
+
+void strash( const aig_compact& aig,
+             aig_compact& aig_dest,
+             const properties::ptr& settings,
+             const properties::ptr& statistics )
+{
+  strash_compact( aig, aig_dest, settings, statistics );
 }
 
 }
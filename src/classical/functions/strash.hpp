@@ -43,12 +43,13 @@
 
 #include <core/properties.hpp>
 #include <classical/aig.hpp>
+#include <classical/aig_compact.hpp>
 #include <classical/functions/simulate_aig.hpp>
 
 namespace cirkit
 {
 
-class strash_simulator : public aig_simulator<aig_function>
+class strash_simulator : public aig_simulator<aig_function>, public aig_compact_simulator<aig_function>
 {
 public:
   strash_simulator( aig_graph& aig_new, unsigned offset,
@@ -56,9 +57,11 @@ public:
                     const boost::dynamic_bitset<>& invert );
 
   aig_function get_input( const aig_node& node, const std::string& name, unsigned pos, const aig_graph& aig ) const;
+  aig_function get_input( aig_compact::node_t node, const std::string& name, unsigned pos, const aig_compact& aig ) const;
   aig_function get_constant() const;
   aig_function invert( const aig_function& v ) const;
   aig_function and_op( const aig_node& node, const aig_function& v1, const aig_function& v2 ) const;
+  aig_function and_op( aig_compact::node_t node, const aig_function& v1, const aig_function& v2 ) const;
 
 private:
   aig_graph& aig_new;
@@ -77,6 +80,21 @@ void strash( const aig_graph& aig,
              const properties::ptr& settings = properties::ptr(),
              const properties::ptr& statistics = properties::ptr() );
 
+/* strashing compact AIGs, the second variant also converts into an aig_graph */
+aig_compact strash( const aig_compact& aig,
+                    const properties::ptr& settings = properties::ptr(),
+                    const properties::ptr& statistics = properties::ptr() );
+
+void strash( const aig_compact& aig,
+             aig_graph& dest,
+             const properties::ptr& settings = properties::ptr(),
+             const properties::ptr& statistics = properties::ptr() );
+
+void strash( const aig_compact& aig,
+             aig_compact& dest,
+             const properties::ptr& settings = properties::ptr(),
+             const properties::ptr& statistics = properties::ptr() );
+
 }
 
 #endif
@@ -27,19 +27,19 @@
 #include "read_aiger.hpp"
 
 #include <classical/utils/aig_utils.hpp>
+#include <core/utils/mapped_file.hpp>
 #include <core/utils/range_utils.hpp>
-#include <core/utils/string_utils.hpp>
 
-#include <boost/algorithm/string/trim.hpp>
 #include <boost/assign/std/vector.hpp>
 #include <boost/assign/std/map.hpp>
 #include <boost/filesystem.hpp>
-#include <boost/lexical_cast.hpp>
-#include <boost/range/counting_range.hpp>
 
 #include <fstream>
+#include <iterator>
 #include <sstream>
 
+#include <sys/mman.h>
+
 namespace cirkit
 {
 
@@ -329,110 +329,312 @@ void read_aiger( aig_graph& aig, std::string& comment, std::istream& in )
   }
 }
 
-unsigned aiger_decode( std::istream& in )
+/******************************************************************************
+ * Binary AIGER                                                               *
+ ******************************************************************************/
+
+namespace
+{
+
+/* cursor over the whole file contents, e.g., a memory mapped file */
+class aiger_buffer
 {
-  auto i = 0u;
-  auto res = 0u;
+public:
+  aiger_buffer( const char* begin, const char* end ) : _pos( begin ), _end( end ) {}
 
-  while ( true )
+  inline bool at_end() const { return _pos == _end; }
+
+  inline void skip_spaces()
   {
-    auto c = in.get();
-    res |= ( ( c & 0x7F ) << ( 7 * i++ ) );
-    if ( !( c & 0x80 ) ) { break; }
+    while ( _pos != _end && ( *_pos == ' ' || *_pos == '\t' || *_pos == '\r' ) ) { ++_pos; }
   }
 
-  return res;
-}
+  inline void skip_line()
+  {
+    while ( _pos != _end && *_pos++ != '\n' ) {}
+  }
 
-void read_aiger_binary( aig_graph& aig, std::istream& in, bool noopt )
-{
-  std::string line;
+  /* ASCII number, skips leading spaces */
+  unsigned read_unsigned()
+  {
+    skip_spaces();
+    if ( _pos == _end || *_pos < '0' || *_pos > '9' ) { throw "Error: expected a number"; }
+
+    auto res = 0u;
+    while ( _pos != _end && *_pos >= '0' && *_pos <= '9' )
+    {
+      res = res * 10u + ( *_pos++ - '0' );
+    }
+    return res;
+  }
+
+  bool read_unsigned_in_line( unsigned& value )
+  {
+    skip_spaces();
+    if ( _pos == _end || *_pos == '\n' ) { return false; }
+    value = read_unsigned();
+    return true;
+  }
+
+  /* 7-bit groups, least significant first, MSB of each byte marks continuation */
+  inline unsigned decode()
+  {
+    auto res = 0u;
+    auto shift = 0u;
 
-  /* read header */
-  std::getline( in, line );
-  if ( in.fail() ) { throw "Error: could not read input file (check path and permissions)"; }
+    while ( true )
+    {
+      if ( _pos == _end ) { throw "Error: unexpected end of file in AND gate section"; }
+      const auto c = static_cast<unsigned char>( *_pos++ );
+      if ( shift == 28u && ( c & 0x70u ) ) { throw "Error: delta in AND gate section exceeds 32 bits"; }
+      res |= ( c & 0x7Fu ) << shift;
+      if ( !( c & 0x80u ) ) { break; }
+      shift += 7u;
+      if ( shift > 28u ) { throw "Error: delta in AND gate section exceeds 32 bits"; }
+    }
 
-  std::vector<std::string> header;
-  split_string( header, line, " " );
+    return res;
+  }
 
-  if ( header.size() != 6u || header[0u] != "aig" ) { throw "Error: expect 'aig M I L O A' as header"; }
+  inline char peek() const { return *_pos; }
+  inline char get() { return *_pos++; }
 
-  if ( header[3u] != "0" ) { throw "Error: latches are not supported yet"; }
+  std::string read_line()
+  {
+    const auto* begin = _pos;
+    while ( _pos != _end && *_pos != '\n' ) { ++_pos; }
+    std::string line( begin, _pos );
+    if ( _pos != _end ) { ++_pos; }
+    if ( !line.empty() && line.back() == '\r' ) { line.pop_back(); }
+    return line;
+  }
 
-  const auto num_inputs  = boost::lexical_cast<unsigned>( header[2u] );
-  const auto num_outputs = boost::lexical_cast<unsigned>( header[4u] );
-  const auto num_ands    = boost::lexical_cast<unsigned>( header[5u] );
+private:
+  const char* _pos;
+  const char* _end;
+};
 
-  /* create AIG */
-  aig_initialize( aig );
+inline void set_input_name( aig_graph& aig, unsigned pos, const std::string& name )
+{
   auto& info = aig_info( aig );
+  if ( pos < info.inputs.size() ) { info.node_names[info.inputs[pos]] = name; }
+}
+
+inline void set_input_name( aig_compact& aig, unsigned pos, const std::string& name )
+{
+  if ( pos < aig.inputs().size() ) { aig.names().node_names[aig.inputs()[pos]] = name; }
+}
+
+inline void set_latch_name( aig_graph& aig, unsigned pos, const std::string& name )
+{
+  auto& info = aig_info( aig );
+  if ( pos < info.cis.size() ) { info.node_names[info.cis[pos]] = name; }
+}
+
+inline void set_latch_name( aig_compact& aig, unsigned pos, const std::string& name )
+{
+  if ( pos < aig.cis().size() ) { aig.names().node_names[aig.cis()[pos]] = name; }
+}
 
+inline void set_output_name( aig_graph& aig, unsigned pos, const std::string& name )
+{
+  auto& info = aig_info( aig );
+  if ( pos < info.outputs.size() ) { info.outputs[pos].second = name; }
+}
+
+inline void set_output_name( aig_compact& aig, unsigned pos, const std::string& name )
+{
+  if ( pos < aig.names().output_names.size() ) { aig.names().output_names[pos] = name; }
+}
+
+inline void prepare( aig_graph& aig, unsigned num_nodes, bool noopt )
+{
+  aig_initialize( aig );
   if ( noopt )
   {
+    auto& info = aig_info( aig );
     info.enable_strashing = info.enable_local_optimization = false;
   }
+}
 
-  /* store nodes */
-  std::vector<aig_function> fs = {aig_get_constant( aig, false )};
+inline void prepare( aig_compact& aig, unsigned num_nodes, bool noopt )
+{
+  aig = aig_compact();
+  if ( noopt )
+  {
+    aig.set_structural_hashing( false );
+    aig.set_local_optimization( false );
+  }
+  aig.reserve( num_nodes );
+}
 
-  /* create PIs */
-  ntimes( num_inputs, [&]() { fs.push_back( aig_create_pi( aig, "" ) ); } );
+inline void create_latch( aig_graph& aig, const aig_function& ci, const aig_function& next )
+{
+  aig_create_co( aig, next );
+  aig_info( aig ).latch[next] = ci;
+}
 
-  /* store output addresses */
-  std::vector<unsigned> oids;
-  ntimes( num_outputs, [&]() {
-      std::getline( in, line );
-      boost::trim( line );
-      oids += boost::lexical_cast<unsigned>( line );
-    } );
+inline void create_latch( aig_compact& aig, const aig_function& ci, const aig_function& next )
+{
+  aig_create_co( aig, next );
+}
 
-  for ( auto i : boost::counting_range( num_inputs + 1u, num_inputs + num_ands + 1u ) )
+template<typename AIG>
+void read_aiger_binary_buffer( AIG& aig, const char* begin, const char* end, bool noopt )
+{
+  aiger_buffer buf( begin, end );
+
+  /* header */
+  if ( end - begin < 4 || std::string( begin, begin + 3 ) != "aig" || ( begin[3] != ' ' && begin[3] != '\t' ) )
   {
-    const auto g  = i << 1u;
-    const auto o1 = g - aiger_decode( in );
-    const auto o2 = o1 - aiger_decode( in );
+    throw "Error: expect 'aig M I L O A' as header";
+  }
+  buf.get(); buf.get(); buf.get();
 
-    const auto f = aig_create_and( aig, make_function( fs[o1 / 2u], o1 % 2u ), make_function( fs[o2 / 2u], o2 % 2u ) );
-    assert( fs.size() == i );
-    assert( !noopt || f.node == i );
+  const auto num_ids     = buf.read_unsigned();
+  const auto num_inputs  = buf.read_unsigned();
+  const auto num_latches = buf.read_unsigned();
+  const auto num_outputs = buf.read_unsigned();
+  const auto num_ands    = buf.read_unsigned();
 
-    fs.push_back( f );
+  /* AIGER 1.9 extensions (bad, constraint, justice, fairness) */
+  unsigned extra;
+  while ( buf.read_unsigned_in_line( extra ) )
+  {
+    if ( extra != 0u ) { throw "Error: bad, constraint, justice, and fairness properties are not supported"; }
   }
+  buf.skip_line();
 
-  for ( const auto& oid : oids )
+  if ( num_ids != num_inputs + num_latches + num_ands ) { throw "Error: broken AIG header"; }
+
+  prepare( aig, num_ids + 1u, noopt );
+
+  /* literal -> function, preallocated for all variables */
+  std::vector<aig_function> fs( num_ids + 1u );
+  fs[0u] = aig_get_constant( aig, false );
+
+  for ( auto i = 1u; i <= num_inputs; ++i )
   {
-    aig_create_po( aig, make_function( fs[oid / 2u], oid % 2u ), "" );
+    fs[i] = aig_create_pi( aig, "" );
   }
 
-  while ( std::getline( in, line ) )
+  for ( auto i = 1u; i <= num_latches; ++i )
   {
-    if ( line.size() != 0u && line[0] == 'c' ) { break; }
-    if ( line.size() == 0u || ( line[0] != 'i' && line[0] != 'o' ) ) { continue; }
+    fs[num_inputs + i] = aig_create_ci( aig, "" );
+  }
 
-    std::vector<std::string> list;
-    split_string( list, line, " " );
+  /* latch next-state and output literals precede the AND gates */
+  std::vector<unsigned> lids( num_latches );
+  for ( auto& lid : lids )
+  {
+    lid = buf.read_unsigned();
+    unsigned init;
+    if ( buf.read_unsigned_in_line( init ) && init != 0u ) { throw "Error: only latches with reset value 0 are supported"; }
+    buf.skip_line();
+  }
+
+  std::vector<unsigned> oids( num_outputs );
+  for ( auto& oid : oids )
+  {
+    oid = buf.read_unsigned();
+    buf.skip_line();
+  }
+
+  const auto literal = [&fs, num_ids]( unsigned l ) {
+    if ( ( l >> 1u ) > num_ids ) { throw "Error: literal out of range"; }
+    return make_function( fs[l >> 1u], l & 1u );
+  };
+
+  for ( auto i = num_inputs + num_latches + 1u; i <= num_ids; ++i )
+  {
+    const auto g  = i << 1u;
+    const auto d0 = buf.decode();
+    const auto d1 = buf.decode();
+    if ( d0 == 0u || d0 > g || d1 > g - d0 ) { throw "Error: invalid delta in AND gate section"; }
+
+    const auto o1 = g - d0;
+    const auto o2 = o1 - d1;
+
+    fs[i] = aig_create_and( aig, make_function( fs[o1 >> 1u], o1 & 1u ), make_function( fs[o2 >> 1u], o2 & 1u ) );
+  }
+
+  for ( auto l = 0u; l < num_latches; ++l )
+  {
+    create_latch( aig, fs[num_inputs + 1u + l], literal( lids[l] ) );
+  }
 
-    const auto pos = boost::lexical_cast<unsigned>( list[0u].substr( 1u ) );
-    std::string name = list.size() == 1u ? "unknown" : list[1u];
+  for ( const auto& oid : oids )
+  {
+    aig_create_po( aig, literal( oid ), "" );
+  }
 
-    if ( list[0][0] == 'i' )
+  /* symbol table */
+  while ( !buf.at_end() )
+  {
+    const auto c = buf.peek();
+    if ( c == 'c' ) { break; }
+    if ( c != 'i' && c != 'l' && c != 'o' )
     {
-      info.node_names[info.inputs[pos]] = name;
+      buf.skip_line();
+      continue;
     }
-    else if ( list[0][0] == 'o' )
+
+    buf.get();
+    const auto pos = buf.read_unsigned();
+    if ( !buf.at_end() && buf.peek() == ' ' ) { buf.get(); }
+    auto name = buf.read_line();
+    if ( name.empty() ) { name = "unknown"; }
+
+    switch ( c )
     {
-      info.outputs[pos].second = name;
+    case 'i': set_input_name( aig, pos, name );  break;
+    case 'l': set_latch_name( aig, pos, name );  break;
+    case 'o': set_output_name( aig, pos, name ); break;
     }
   }
 }
 
-void read_aiger_binary( aig_graph& aig, const std::string& filename, bool noopt )
+template<typename AIG>
+void read_aiger_binary_stream( AIG& aig, std::istream& in, bool noopt )
+{
+  const std::string contents( ( std::istreambuf_iterator<char>( in ) ), std::istreambuf_iterator<char>() );
+  if ( contents.empty() ) { throw "Error: could not read input file (check path and permissions)"; }
+  read_aiger_binary_buffer( aig, contents.data(), contents.data() + contents.size(), noopt );
+}
+
+template<typename AIG>
+void read_aiger_binary_file( AIG& aig, const std::string& filename, bool noopt )
 {
-  std::ifstream in( filename.c_str(), std::ifstream::in );
-  read_aiger_binary( aig, in, noopt );
+  mapped_file file( filename );
+  if ( !file.is_open() || file.size() == 0u ) { throw "Error: could not read input file (check path and permissions)"; }
 
+  /* hint sequential access to the kernel, the file is read exactly once */
+  madvise( const_cast<char*>( file.data() ), file.size(), MADV_SEQUENTIAL );
+  read_aiger_binary_buffer( aig, file.begin(), file.end(), noopt );
+}
+
+}
+
+void read_aiger_binary( aig_graph& aig, std::istream& in, bool noopt )
+{
+  read_aiger_binary_stream( aig, in, noopt );
+}
+
+void read_aiger_binary( aig_graph& aig, const std::string& filename, bool noopt )
+{
+  read_aiger_binary_file( aig, filename, noopt );
   aig_info( aig ).model_name = boost::filesystem::path( filename ).stem().string();
-  in.close();
+}
+
+void read_aiger_binary( aig_compact& aig, std::istream& in, bool noopt )
+{
+  read_aiger_binary_stream( aig, in, noopt );
+}
+
+void read_aiger_binary( aig_compact& aig, const std::string& filename, bool noopt )
+{
+  read_aiger_binary_file( aig, filename, noopt );
+  aig.set_model_name( boost::filesystem::path( filename ).stem().string() );
 }
 
 }
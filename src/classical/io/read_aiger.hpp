@@ -27,7 +27,12 @@
 /**
  * @file read_aiger.hpp
  *
- * @brief Read AIGs in ASCII AIGER format
+ * @brief Read AIGs in ASCII and binary AIGER format
+ *
+ * The binary reader maps the file into memory and decodes the delta
+ * encoded AND gates directly into the network, node arrays are
+ * allocated in advance from the header.  It can read into both
+ * aig_graph and the array-based aig_compact.
  *
  * @author Heinz Riener
  * @since  2.0
@@ -37,6 +42,7 @@
 #define READ_AIGER_HPP
 
 #include <classical/aig.hpp>
+#include <classical/aig_compact.hpp>
 #include <iostream>
 #include <string>
 
@@ -53,6 +59,9 @@ void read_aiger( aig_graph& aig, std::string& comment, const std::string& filena
 void read_aiger_binary( aig_graph& aig, std::istream& in, bool noopt = false );
 void read_aiger_binary( aig_graph& aig, const std::string& filename, bool noopt = false );
 
+void read_aiger_binary( aig_compact& aig, std::istream& in, bool noopt = false );
+void read_aiger_binary( aig_compact& aig, const std::string& filename, bool noopt = false );
+
 }
 
 #endif
@@ -26,221 +26,230 @@
 
 #include "read_bench.hpp"
 
-#include <core/utils/conversion_utils.hpp>
 #include <core/utils/range_utils.hpp>
-#include <core/utils/string_utils.hpp>
+#include <core/utils/tokenizer.hpp>
 #include <classical/utils/aig_utils.hpp>
 
-#include <boost/algorithm/string.hpp>
-#include <boost/algorithm/string/join.hpp>
-#include <boost/algorithm/string/predicate.hpp>
-#include <boost/algorithm/string/trim.hpp>
 #include <boost/filesystem.hpp>
-#include <boost/range/algorithm.hpp>
+#include <boost/format.hpp>
 
 #include <range/v3/algorithm/find.hpp>
-#include <range/v3/algorithm/find_if.hpp>
 
+#include <cctype>
 #include <fstream>
-#include <sstream>
-#include <iomanip>
-#include <iterator>
+#include <stack>
+#include <tuple>
+#include <unordered_map>
 
 namespace cirkit
 {
 
-namespace detail
-{
+/******************************************************************************
+ * Types                                                                      *
+ ******************************************************************************/
 
-/**
- * Based on http://stackoverflow.com/questions/5607589/right-way-to-split-an-stdstring-into-a-vectorstring
- */
-struct tokens : std::ctype< char >
+using gate_def_t = std::tuple<std::string, std::string, std::vector<std::string>>;
+
+/******************************************************************************
+ * Private functions                                                          *
+ ******************************************************************************/
+
+tokenizer::options bench_tokenizer_options()
 {
-  tokens() : std::ctype<char>( get_table() ) {}
+  tokenizer::options opts;
+  opts.separators    = "(),=";
+  opts.newlines      = true;
+  opts.hash_comments = true;
+  return opts;
+}
 
-  static std::ctype_base::mask const* get_table()
+inline bool token_equals_upper( token_t token, const char* upper )
+{
+  auto i = 0u;
+  for ( ; upper[i]; ++i )
   {
-    static constexpr const char SYM_COMMA  = ',';
-    static constexpr const char SYM_ASSIGN = '=';
-    static constexpr const char SYM_LPAREN = '(';
-    static constexpr const char SYM_RPAREN = ')';
-    static constexpr const char SYM_SPACE  = ' ';
-
-    using cctype = std::ctype< char >;
-    static const cctype::mask* const_rc = cctype::classic_table();
-
-    static cctype::mask rc[ cctype::table_size ];
-    std::memcpy( rc, const_rc, cctype::table_size * sizeof(cctype::mask) );
-
-    rc[static_cast<int>( SYM_COMMA )]  = std::ctype_base::space;
-    rc[static_cast<int>( SYM_ASSIGN )] = std::ctype_base::space;
-    rc[static_cast<int>( SYM_LPAREN )] = std::ctype_base::space;
-    rc[static_cast<int>( SYM_RPAREN )] = std::ctype_base::space;
-    rc[static_cast<int>( SYM_SPACE )]  = std::ctype_base::space;
-    return &rc[0];
+    if ( i == token.size() || std::toupper( static_cast<unsigned char>( token[i] ) ) != upper[i] ) { return false; }
   }
-};
-
+  return i == token.size();
 }
 
-void read_bench( aig_graph& aig, std::ifstream& is )
+void read_bench( aig_graph& aig, tokenizer& tok )
 {
-  std::map< std::string, aig_function > the_map;
-  std::list< std::string > pos;
+  symbol_table symbols;
+  std::vector<aig_function> fs;
+  std::vector<bool> defined;
+  std::vector<unsigned> pos;
+
+  const auto id = [&]( token_t name ) {
+    const auto id = symbols.intern( name );
+    if ( id >= fs.size() )
+    {
+      fs.resize( id + 1u );
+      defined.resize( id + 1u, false );
+    }
+    return id;
+  };
+
+  const auto define = [&]( unsigned id, const aig_function& f ) {
+    if ( !defined[id] )
+    {
+      fs[id] = f;
+      defined[id] = true;
+    }
+  };
 
   aig_initialize( aig );
 
-  std::string line;
-  while ( std::getline( is, line ) )
+  std::vector<token_t> tokens;
+  std::vector<aig_function> ops;
+  while ( tok.next_line( tokens ) )
   {
-    // std::cout << line << '\n';
-    if ( line == "" || boost::starts_with( line, "#" ) ) continue;
-    std::istringstream iis( line );
-    iis.imbue( std::locale( std::locale(), new detail::tokens() ) );
+    if ( tokens.size() < 2u ) { continue; }
 
-    std::istream_iterator< std::string > iit( iis ), eos;
-    while ( iit != eos )
+    if ( tokens[0u] == "INPUT" )
     {
-      const auto token = *iit;
-      // std::cout << token << '\n';
-      if ( token == "INPUT" )
-      {
-        ++iit;
-        const auto name = *iit;
-        the_map.insert( {name, aig_create_pi( aig, name )} );
-        ++iit;
-        continue;
-      }
+      define( id( tokens[1u] ), aig_create_pi( aig, tokens[1u].to_string() ) );
+      continue;
+    }
 
-      if ( token == "OUTPUT" )
-      {
-        ++iit;
-        const auto name = *iit;
-        pos.push_back( name );
-        ++iit;
-        continue;
-      }
+    if ( tokens[0u] == "OUTPUT" )
+    {
+      pos.push_back( id( tokens[1u] ) );
+      continue;
+    }
 
-      const std::string res = *iit; ++iit;
-      const std::string kind = boost::to_upper_copy( *iit ); ++iit;
-      std::vector< aig_function > ops;
-      while ( iit != eos )
+    const auto res = id( tokens[0u] );
+    const auto kind = tokens[1u];
+    ops.clear();
+    for ( auto i = 2u; i < tokens.size(); ++i )
+    {
+      const auto op = id( tokens[i] );
+      if ( !defined[op] )
       {
-        ops.push_back( the_map[ *iit ] );
-        ++iit;
+        throw boost::str( boost::format( "undefined signal '%s' in line %d" ) % tokens[i] % tok.token_line() );
       }
+      ops.push_back( fs[op] );
+    }
 
-      const auto num_ops = ops.size();
-      assert( num_ops > 0u );
-
-      /* unary operators */
-      if ( num_ops == 1u )
-      {
-        assert( kind == "NOT" || kind == "BUF" );
-        if ( kind == "NOT" )
-        {
-          the_map.insert( {res, !ops[0u]} );
-        }
-        else if ( kind == "BUF" )
-        {
-          the_map.insert( {res, aig_create_and( aig, ops[0u], ops[0u] ) } );
-        }
-        continue;
-      }
+    const auto num_ops = ops.size();
+    assert( num_ops > 0u );
 
-      /* nary operators */
-      if ( kind == "AND" )
-      {
-        the_map.insert( {res, aig_create_nary_and( aig, ops ) } );
-        continue;
-      }
-      else if ( kind == "NAND" )
-      {
-        the_map.insert( {res, aig_create_nary_nand( aig, ops ) } );
-        continue;
-      }
-      else if ( kind == "OR" )
-      {
-        the_map.insert( {res, aig_create_nary_or( aig, ops ) } );
-        continue;
-      }
-      else if ( kind == "NOR" )
+    /* unary operators */
+    if ( num_ops == 1u )
+    {
+      assert( token_equals_upper( kind, "NOT" ) || token_equals_upper( kind, "BUF" ) );
+      if ( token_equals_upper( kind, "NOT" ) )
       {
-        the_map.insert( {res, aig_create_nary_nor( aig, ops ) } );
-        continue;
+        define( res, !ops[0u] );
       }
-      else if ( kind == "XOR" )
+      else if ( token_equals_upper( kind, "BUF" ) )
       {
-        the_map.insert( {res, aig_create_nary_xor( aig, ops ) } );
-        continue;
+        define( res, aig_create_and( aig, ops[0u], ops[0u] ) );
       }
+      continue;
+    }
 
-      // std::cout << kind << '\n';
+    /* nary operators */
+    if ( token_equals_upper( kind, "AND" ) )
+    {
+      define( res, aig_create_nary_and( aig, ops ) );
+    }
+    else if ( token_equals_upper( kind, "NAND" ) )
+    {
+      define( res, aig_create_nary_nand( aig, ops ) );
+    }
+    else if ( token_equals_upper( kind, "OR" ) )
+    {
+      define( res, aig_create_nary_or( aig, ops ) );
+    }
+    else if ( token_equals_upper( kind, "NOR" ) )
+    {
+      define( res, aig_create_nary_nor( aig, ops ) );
+    }
+    else if ( token_equals_upper( kind, "XOR" ) )
+    {
+      define( res, aig_create_nary_xor( aig, ops ) );
+    }
+    else
+    {
       assert( false && "Yet not implemented gate type" );
     }
   }
 
   for ( const auto po : pos )
   {
-    aig_create_po( aig, the_map[ po ], po );
+    if ( !defined[po] )
+    {
+      throw boost::str( boost::format( "undefined output '%s'" ) % symbols.name( po ) );
+    }
+    aig_create_po( aig, fs[po], symbols.str( po ) );
   }
 }
 
+/* INPUT(x), OUTPUT(x), x = LUT 0x.. ( a, b, ... ), x = gnd, x = vdd */
+void parse_lut_bench( const std::string& filename, std::vector<std::string>& inputs, std::vector<std::string>& outputs, std::vector<gate_def_t>& gates )
+{
+  tokenizer tok( filename, bench_tokenizer_options() );
+  if ( !tok.is_open() )
+  {
+    std::cout << "[e] could not open " << filename << std::endl;
+    return;
+  }
+
+  std::vector<token_t> tokens;
+  while ( tok.next_line( tokens ) )
+  {
+    if ( tokens.size() == 2u && tokens[0u] == "INPUT" )
+    {
+      inputs.push_back( tokens[1u].to_string() );
+    }
+    else if ( tokens.size() == 2u && tokens[0u] == "OUTPUT" )
+    {
+      outputs.push_back( tokens[1u].to_string() );
+    }
+    else if ( tokens.size() >= 3u && tokens[1u] == "LUT" && tokens[2u].size() > 2u && tokens[2u].starts_with( "0x" ) )
+    {
+      std::vector<std::string> arguments;
+      for ( auto i = 3u; i < tokens.size(); ++i )
+      {
+        arguments.push_back( tokens[i].to_string() );
+      }
+      gates.push_back( std::make_tuple( tokens[0u].to_string(), tokens[2u].substr( 2u ).to_string(), arguments ) );
+    }
+    else if ( tokens.size() == 2u && ( tokens[1u] == "gnd" || tokens[1u] == "vdd" ) )
+    {
+      gates.push_back( std::make_tuple( tokens[0u].to_string(), tokens[1u].to_string(), std::vector<std::string>() ) );
+    }
+    else
+    {
+      std::cout << "[w] could not match line " << tok.token_line() << std::endl;
+    }
+  }
+}
+
+/******************************************************************************
+ * Public functions                                                           *
+ ******************************************************************************/
+
+void read_bench( aig_graph& aig, std::ifstream& is )
+{
+  tokenizer tok( is, bench_tokenizer_options() );
+  read_bench( aig, tok );
+}
+
 void read_bench( aig_graph& aig, const std::string& filename )
 {
-  std::ifstream is( filename.c_str() );
-  read_bench( aig, is );
+  tokenizer tok( filename, bench_tokenizer_options() );
+  read_bench( aig, tok );
   auto& info = aig_info( aig );
   info.model_name = boost::filesystem::path( filename ).stem().string();
-  is.close();
 }
 
 void read_bench( lut_graph_t& lut, const std::string& filename )
 {
-  using gate_def_t = std::tuple<std::string, std::string, std::vector<std::string>>;
-
   std::vector<std::string> inputs, outputs;
   std::vector<gate_def_t> gates;
-
-  line_parser( filename, {
-      {std::regex( "^INPUT\\((.*)\\)$" ), [&inputs]( const std::smatch& m ) {
-          inputs.push_back( std::string( m[1] ) );
-        }},
-      {std::regex( "^OUTPUT\\((.*)\\)$" ), [&outputs]( const std::smatch& m ) {
-          outputs.push_back( std::string( m[1] ) );
-        }},
-      {std::regex( "^(.*) = LUT (.*) \\( (.*) \\)$" ), [&gates]( const std::smatch& m ) {
-          unsigned value;
-          std::stringstream converter( m[2] );
-          converter >> std::hex >> value;
-
-          std::vector<std::string> arguments;
-          split_string( arguments, m[3], ", " );
-
-          std::string name( m[1] );
-          boost::trim( name );
-          gates.push_back( std::make_tuple( name, std::string( m[2] ).substr( 2u ), arguments ) );
-
-          //boost::dynamic_bitset<> direct( 1u << arguments.size(), value );
-          //boost::dynamic_bitset<> indirect( convert_hex2bin( std::string( m[2] ).substr( 2u ) ) );
-
-          //std::cout << "value: " << value << " orig: " << m[2] << " " << direct << " " << indirect << std::endl;
-        }},
-      {std::regex( "^(.*) = gnd" ), [&gates]( const std::smatch& m ) {
-          std::string name( m[1] );
-          boost::trim( name );
-
-          gates.push_back( std::make_tuple( name, "gnd", std::vector<std::string>() ) );
-        }},
-      {std::regex( "^(.*) = vdd" ), [&gates]( const std::smatch& m ) {
-          std::string name( m[1] );
-          boost::trim( name );
-
-          gates.push_back( std::make_tuple( name, "vdd", std::vector<std::string>() ) );
-        }},
-      {std::regex( "^#" ), []( const std::smatch& m ) {}}
-    }, true );
+  parse_lut_bench( filename, inputs, outputs, gates );
 
   std::map<std::string, lut_vertex_t> gate_to_node;
 
@@ -269,6 +278,12 @@ void read_bench( lut_graph_t& lut, const std::string& filename )
   std::vector<int>              waiting_refs( gates.size(), -1 ); /* if -1, gate has not been processed or is done, otherwise gives the number of fanins to wait for */
   std::vector<std::vector<int>> notify_list( gates.size() );      /* which parents to notify that they may complete */
 
+  std::unordered_map<std::string, unsigned> gate_index;
+  for ( auto i = 0u; i < gates.size(); ++i )
+  {
+    gate_index.insert( {std::get<0>( gates[i] ), i} );
+  }
+
   for ( const auto& it : index( gates ) )
   {
     const auto& gate = it.value;
@@ -288,7 +303,8 @@ void read_bench( lut_graph_t& lut, const std::string& filename )
         if ( gate_to_node.find( arg ) == gate_to_node.end() )
         {
           waiting_refs[index]++;
-          notify_list[std::distance( begin( gates ), ranges::find_if( gates, [&arg]( const gate_def_t& g ) { return std::get<0>( g ) == arg; } ) )].push_back( index );
+          assert( gate_index.find( arg ) != gate_index.end() );
+          notify_list[gate_index.at( arg )].push_back( index );
         }
       }
     }
@@ -367,49 +383,9 @@ void read_bench( lut_graph_t& lut, const std::string& filename )
 
 void read_bench( lut_graph& graph, const std::string& filename )
 {
-  using gate_def_t = std::tuple<std::string, std::string, std::vector<std::string>>;
-
   std::vector<std::string> inputs, outputs;
   std::vector<gate_def_t> gates;
-
-  line_parser( filename, {
-      {std::regex( "^INPUT\\((.*)\\)$" ), [&inputs]( const std::smatch& m ) {
-          inputs.push_back( std::string( m[1] ) );
-        }},
-      {std::regex( "^OUTPUT\\((.*)\\)$" ), [&outputs]( const std::smatch& m ) {
-          outputs.push_back( std::string( m[1] ) );
-        }},
-      {std::regex( "^(.*) = LUT (.*) \\( (.*) \\)$" ), [&gates]( const std::smatch& m ) {
-          unsigned value;
-          std::stringstream converter( m[2] );
-          converter >> std::hex >> value;
-
-          std::vector<std::string> arguments;
-          split_string( arguments, m[3], ", " );
-
-          std::string name( m[1] );
-          boost::trim( name );
-          gates.push_back( std::make_tuple( name, std::string( m[2] ).substr( 2u ), arguments ) );
-
-          //boost::dynamic_bitset<> direct( 1u << arguments.size(), value );
-          //boost::dynamic_bitset<> indirect( convert_hex2bin( std::string( m[2] ).substr( 2u ) ) );
-
-          //std::cout << "value: " << value << " orig: " << m[2] << " " << direct << " " << indirect << std::endl;
-        }},
-      {std::regex( "^(.*) = gnd" ), [&gates]( const std::smatch& m ) {
-          std::string name( m[1] );
-          boost::trim( name );
-
-          gates.push_back( std::make_tuple( name, "gnd", std::vector<std::string>() ) );
-        }},
-      {std::regex( "^(.*) = vdd" ), [&gates]( const std::smatch& m ) {
-          std::string name( m[1] );
-          boost::trim( name );
-
-          gates.push_back( std::make_tuple( name, "vdd", std::vector<std::string>() ) );
-        }},
-      {std::regex( "^#" ), []( const std::smatch& m ) {}}
-    }, true );
+  parse_lut_bench( filename, inputs, outputs, gates );
 
   std::map<std::string, lut_vertex_t> gate_to_node;
 
@@ -425,6 +401,12 @@ void read_bench( lut_graph& graph, const std::string& filename )
   std::vector<int>              waiting_refs( gates.size(), -1 ); /* if -1, gate has not been processed or is done, otherwise gives the number of fanins to wait for */
   std::vector<std::vector<int>> notify_list( gates.size() );      /* which parents to notify that they may complete */
 
+  std::unordered_map<std::string, unsigned> gate_index;
+  for ( auto i = 0u; i < gates.size(); ++i )
+  {
+    gate_index.insert( {std::get<0>( gates[i] ), i} );
+  }
+
   for ( const auto& it : index( gates ) )
   {
     const auto& gate = it.value;
@@ -444,7 +426,8 @@ void read_bench( lut_graph& graph, const std::string& filename )
         if ( gate_to_node.find( arg ) == gate_to_node.end() )
         {
           waiting_refs[index]++;
-          notify_list[std::distance( begin( gates ), ranges::find_if( gates, [&arg]( const gate_def_t& g ) { return std::get<0>( g ) == arg; } ) )].push_back( index );
+          assert( gate_index.find( arg ) != gate_index.end() );
+          notify_list[gate_index.at( arg )].push_back( index );
         }
       }
     }
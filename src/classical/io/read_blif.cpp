@@ -26,11 +26,9 @@
 
 #include "read_blif.hpp"
 
-#include <unordered_map>
+#include <limits>
 
-#include <boost/algorithm/string/predicate.hpp>
-
-#include <core/utils/string_utils.hpp>
+#include <core/utils/tokenizer.hpp>
 #include <classical/utils/truth_table_utils.hpp>
 
 namespace cirkit
@@ -63,185 +61,221 @@ lut_graph_t read_blif( const std::string& filename, bool store_cubes )
   name[vdd] = "vdd";
   type[vdd] = lut_type_t::vdd;
 
-  std::unordered_map<std::string, lut_vertex_t> name_to_node;
-  std::vector<std::string> faninout;
-  std::string outputs;
+  tokenizer::options opts;
+  opts.newlines          = true;
+  opts.hash_comments     = true;
+  opts.line_continuation = true;
+
+  tokenizer tok( filename, opts );
+
+  /* node of each symbol id, or none if not yet created */
+  constexpr auto none = std::numeric_limits<lut_vertex_t>::max();
+  symbol_table symbols;
+  std::vector<lut_vertex_t> nodes;
+  const auto id = [&]( token_t token ) {
+    const auto id = symbols.intern( token );
+    if ( id >= nodes.size() )
+    {
+      nodes.resize( id + 1u, none );
+    }
+    return id;
+  };
+
+  const auto create_node = [&]( unsigned id, lut_type_t t ) {
+    const auto v = add_vertex( g );
+    name[v] = symbols.str( id );
+    type[v] = t;
+    nodes[id] = v;
+    return v;
+  };
+
+  std::vector<token_t> tokens;
+  std::vector<unsigned> faninout;
+  std::vector<unsigned> outputs;
 
   enum class pla_type_t { none, on, off };
   auto pla_type = pla_type_t::none;
   tt f( 1u );
   std::string cubes;
 
-  foreach_line_in_file_escape( filename, [&, gnd, vdd, store_cubes]( const std::string& line ) {
-      /* empty line or comment */
-      if ( line.empty() || line[0u] == '#' ) return true;
+  /* we need to add a node for the previous .names command */
+  const auto add_names_node = [&]() {
+    if ( faninout.empty() ) return;
 
-      if ( boost::starts_with( line, ".model" ) )
+    const auto out = faninout.back();
+    const auto v_out = nodes[out];
+    if ( v_out != none && !func[v_out].empty() )
+    {
+      std::cout << "[w] duplicate node " << symbols.name( out ) << std::endl;
+    }
+    else if ( faninout.size() == 1u )
+    {
+      nodes[out] = f[0] ? vdd : gnd;
+    }
+    else
+    {
+      auto v = v_out;
+      if ( v == none )
       {
-        /* skip */
+        v = create_node( out, lut_type_t::internal );
       }
-      else if ( boost::starts_with( line, ".inputs" ) )
-      {
-        foreach_string( line.substr( 8u ), " ", [&g, &name, &type, &name_to_node]( const std::string& str ) {
-            auto v = add_vertex( g );
-            name[v] = str;
-            type[v] = lut_type_t::pi;
-            name_to_node[str] = v;
-          } );
-      }
-      else if ( boost::starts_with( line, ".outputs" ) )
+      else
       {
-        outputs = line.substr( 9u );
+        assert( type[v] == lut_type_t::internal );
       }
-      else if ( boost::starts_with( line, ".names" ) || boost::starts_with( line, ".end" ) )
+
+      func[v] = store_cubes ? cubes : tt_to_hex( f );
+
+      for ( auto i = 0u; i < faninout.size() - 1; ++i )
       {
-        /* we need to add a node for the previous .names command */
-        if ( !faninout.empty() )
+        auto tgt = nodes[faninout[i]];
+        if ( tgt == none )
         {
-          auto it_out = name_to_node.find( faninout.back() );
-          if ( it_out != name_to_node.end() && !func[it_out->second].empty() )
-          {
-            std::cout << "[w] duplicate node " << faninout.back() << std::endl;
-          }
-          else if ( faninout.size() == 1u )
-          {
-            name_to_node[faninout.back()] = f[0] ? vdd : gnd;
-          }
-          else
-          {
-            lut_vertex_t v;
-            if ( it_out == name_to_node.end() )
-            {
-              v = add_vertex( g );
-              name[v] = faninout.back();
-              type[v] = lut_type_t::internal;
-              name_to_node[faninout.back()] = v;
-            }
-            else
-            {
-              v = it_out->second;
-              assert( name[v] == faninout.back() );
-              assert( type[v] == lut_type_t::internal );
-            }
-
-            func[v] = store_cubes ? cubes : tt_to_hex( f );
-
-            for ( auto i = 0u; i < faninout.size() - 1; ++i )
-            {
-              lut_vertex_t tgt;
-              const auto it = name_to_node.find( faninout[i] );
-              if ( it == name_to_node.end() )
-              {
-                /* precreate node */
-                tgt = add_vertex( g );
-                name[tgt] = faninout[i];
-                type[tgt] = lut_type_t::internal;
-                name_to_node[faninout[i]] = tgt;
-              }
-              else
-              {
-                tgt = it->second;
-              }
-
-              add_edge( v, tgt, g );
-            }
-          }
+          /* precreate node */
+          tgt = create_node( faninout[i], lut_type_t::internal );
         }
 
-        if ( line[1u] == 'e' ) return false;
+        add_edge( v, tgt, g );
+      }
+    }
+
+    faninout.clear();
+  };
 
-        faninout.clear();
-        split_string( faninout, line.substr( 7u ), " " );
+  while ( tok.is_open() && tok.next_line( tokens ) )
+  {
+    const auto& cmd = tokens.front();
 
-        f = tt( 1u << ( faninout.size() - 1 ) );
-        cubes.clear();
-        pla_type = pla_type_t::none;
+    if ( cmd == ".model" )
+    {
+      /* skip */
+    }
+    else if ( cmd == ".inputs" )
+    {
+      for ( auto i = 1u; i < tokens.size(); ++i )
+      {
+        create_node( id( tokens[i] ), lut_type_t::pi );
+      }
+    }
+    else if ( cmd == ".outputs" )
+    {
+      for ( auto i = 1u; i < tokens.size(); ++i )
+      {
+        outputs.push_back( id( tokens[i] ) );
+      }
+    }
+    else if ( cmd == ".names" || cmd == ".end" )
+    {
+      add_names_node();
+
+      if ( cmd == ".end" ) break;
+
+      for ( auto i = 1u; i < tokens.size(); ++i )
+      {
+        faninout.push_back( id( tokens[i] ) );
       }
-      else if ( faninout.size() == 1 )
+
+      f = tt( 1u << ( faninout.size() - 1 ) );
+      cubes.clear();
+      pla_type = pla_type_t::none;
+    }
+    else if ( faninout.size() == 1 )
+    {
+      if ( cmd == "1" )
       {
-        if ( line == "1" )
+        if ( store_cubes )
         {
-          if ( store_cubes )
-          {
-            cubes = line;
-          }
-          else
-          {
-            f = tt( 1u, 1u );
-          }
+          cubes = "1";
+        }
+        else
+        {
+          f = tt( 1u, 1u );
         }
       }
-      else if ( store_cubes )
+    }
+    else if ( store_cubes )
+    {
+      cubes.append( tokens[0u].data(), tokens[0u].size() );
+      for ( auto i = 1u; i < tokens.size(); ++i )
       {
-        cubes += line + "\n";
+        cubes += ' ';
+        cubes.append( tokens[i].data(), tokens[i].size() );
       }
-      else
-      {
-        const auto pair = split_string_pair( line, " " );
-        const auto p = pair.first;
-        assert( p.size() + 1 == faninout.size() );
+      cubes += '\n';
+    }
+    else
+    {
+      assert( tokens.size() == 2u );
+      const auto p = tokens[0u];
+      const auto out = tokens[1u];
+      assert( p.size() + 1 == faninout.size() );
 
-        switch ( pla_type )
+      switch ( pla_type )
+      {
+      case pla_type_t::none:
+        pla_type = ( out == "1" ) ? pla_type_t::on : pla_type_t::off;
+        if ( pla_type == pla_type_t::off )
         {
-        case pla_type_t::none:
-          pla_type = ( pair.second == "1" ) ? pla_type_t::on : pla_type_t::off;
-          if ( pla_type == pla_type_t::off )
-          {
-            f.flip();
-          }
-          break;
-        case pla_type_t::on:   assert( pair.second == "1" ); break;
-        case pla_type_t::off:  assert( pair.second == "0" ); break;
+          f.flip();
         }
+        break;
+      case pla_type_t::on:   assert( out == "1" ); break;
+      case pla_type_t::off:  assert( out == "0" ); break;
+      }
 
-        auto cube = ( pla_type == pla_type_t::on ) ? ~tt( 1 << p.size() ) : tt( 1 << p.size() );
-        for ( auto i = 0u; i < p.size(); ++i )
+      auto cube = ( pla_type == pla_type_t::on ) ? ~tt( 1 << p.size() ) : tt( 1 << p.size() );
+      for ( auto i = 0u; i < p.size(); ++i )
+      {
+        if ( p[i] == '-' ) continue;
+        auto v = ( p[i] == '0' ) != ( pla_type == pla_type_t::off ) ? ~tt_nth_var( i ) : tt_nth_var( i );
+        if ( p.size() < 6 )
         {
-          if ( p[i] == '-' ) continue;
-          auto v = ( p[i] == '0' ) != ( pla_type == pla_type_t::off ) ? ~tt_nth_var( i ) : tt_nth_var( i );
-          if ( p.size() < 6 )
-          {
-            tt_shrink( v, p.size() );
-          }
-          else
-          {
-            tt_align( v, cube );
-          }
-
-          if ( pla_type == pla_type_t::on )
-          {
-            cube &= v;
-          }
-          else
-          {
-            cube |= v;
-          }
+          tt_shrink( v, p.size() );
+        }
+        else
+        {
+          tt_align( v, cube );
         }
 
         if ( pla_type == pla_type_t::on )
         {
-          f |= cube;
+          cube &= v;
         }
         else
         {
-          f &= cube;
+          cube |= v;
         }
       }
 
-      return true;
-    } );
+      if ( pla_type == pla_type_t::on )
+      {
+        f |= cube;
+      }
+      else
+      {
+        f &= cube;
+      }
+    }
+  }
 
-  foreach_string( outputs, " ", [&g, &name, &type, &name_to_node]( const std::string& str ) {
-      auto v = add_vertex( g );
-      name[v] = str;
-      type[v] = lut_type_t::po;
+  /* files without .end */
+  add_names_node();
 
-      add_edge( v, name_to_node.at( str ), g );
-    } );
+  for ( const auto o : outputs )
+  {
+    const auto v = add_vertex( g );
+    name[v] = symbols.str( o );
+    type[v] = lut_type_t::po;
+
+    if ( nodes[o] == none )
+    {
+      throw "Error: output without driver in BLIF file";
+    }
+    add_edge( v, nodes[o], g );
+  }
 
   return g;
 }
-
 }
 
 // Local Variables:
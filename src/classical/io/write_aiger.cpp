@@ -27,9 +27,14 @@
 #include "write_aiger.hpp"
 
 #include <boost/format.hpp>
+#include <boost/graph/topological_sort.hpp>
 #include <boost/range/iterator_range.hpp>
 
+#include <classical/utils/aig_utils.hpp>
+
 #include <fstream>
+#include <iterator>
+#include <vector>
 
 namespace cirkit
 {
@@ -148,6 +153,325 @@ void write_aiger( const aig_graph& aig, const std::string& filename, const bool
   fb.close();
 }
 
+void write_aiger( const aig_compact& aig, std::ostream& os, const bool fill_sym_table )
+{
+  const auto& names = aig.names();
+
+  /* header */
+  const unsigned _num_inputs = aig.inputs().size();
+  const unsigned _num_outputs = aig.outputs().size();
+  const unsigned _num_latches = aig.cis().size();
+  const unsigned _num_vertices = aig.size() - 1u;
+
+  os << boost::format( "aag %d %d %d %d %d" )
+    % _num_vertices % _num_inputs % _num_latches % _num_outputs % aig.num_ands() << '\n';
+
+  /* inputs */
+  for ( const auto& input : aig.inputs() )
+  {
+    os << ( input << 1u ) << '\n';
+  }
+
+  /* latches */
+  assert( aig.cis().size() == aig.cos().size() );
+  for ( unsigned u = 0u; u < aig.cis().size(); ++u )
+  {
+    os << ( aig.cis()[u] << 1u ) << ' ' << aig.cos()[u] << '\n';
+  }
+
+  /* outputs */
+  for ( const auto& output : aig.outputs() )
+  {
+    os << output << '\n';
+  }
+
+  /* AND gates */
+  for ( aig_compact::node_t node = 1u; node < aig.size(); ++node )
+  {
+    if ( aig.is_and( node ) )
+    {
+      os << ( node << 1u ) << ' ' << aig.fanin_literal( node, 1u ) << ' ' << aig.fanin_literal( node, 0u ) << '\n';
+    }
+  }
+
+  /* input and latch names */
+  const auto write_names = [&]( const std::vector<aig_compact::node_t>& nodes, char prefix, const std::string& fill ) {
+    unsigned index = 0u;
+    for ( const auto& n : nodes )
+    {
+      if ( names.has_name( n ) )
+      {
+        os << prefix << index << " " << names.name( n ) << '\n';
+      }
+      else if ( fill_sym_table )
+      {
+        os << prefix << index << " " << fill << index << '\n';
+      }
+      ++index;
+    }
+  };
+  write_names( aig.inputs(), 'i', "input" );
+  write_names( aig.cis(), 'l', "latch" );
+
+  /* output names */
+  for ( unsigned index = 0u; index < names.output_names.size(); ++index )
+  {
+    const std::string& name = names.output_names[index];
+    if ( name != "" )
+    {
+      os << "o" << index << " " << name << '\n';
+    }
+    else if ( fill_sym_table )
+    {
+      os << "o" << index << " output" << index << '\n';
+    }
+  }
+
+  os.flush();
+}
+
+void write_aiger( const aig_compact& aig, const std::string& filename, const bool fill_sym_table )
+{
+  std::filebuf fb;
+  fb.open( filename.c_str(), std::ios::out );
+  std::ostream os( &fb );
+  write_aiger( aig, os, fill_sym_table );
+  fb.close();
+}
+
+/******************************************************************************
+ * Binary AIGER                                                               *
+ ******************************************************************************/
+
+namespace
+{
+
+/* collects output in large chunks instead of formatting into the stream */
+class aiger_output_buffer
+{
+public:
+  explicit aiger_output_buffer( std::ostream& os ) : os( os ), buffer( 1u << 20u ) {}
+  ~aiger_output_buffer() { flush(); }
+
+  inline void put( char c )
+  {
+    if ( pos == buffer.size() ) { flush(); }
+    buffer[pos++] = c;
+  }
+
+  void put_unsigned( unsigned value )
+  {
+    char digits[10];
+    auto n = 0u;
+    do { digits[n++] = '0' + ( value % 10u ); value /= 10u; } while ( value );
+    while ( n ) { put( digits[--n] ); }
+  }
+
+  void put_string( const std::string& str )
+  {
+    for ( auto c : str ) { put( c ); }
+  }
+
+  /* 7-bit groups, least significant first */
+  inline void encode( unsigned value )
+  {
+    while ( value & ~0x7Fu )
+    {
+      put( static_cast<char>( ( value & 0x7Fu ) | 0x80u ) );
+      value >>= 7u;
+    }
+    put( static_cast<char>( value ) );
+  }
+
+  void flush()
+  {
+    os.write( buffer.data(), pos );
+    pos = 0u;
+  }
+
+private:
+  std::ostream&     os;
+  std::vector<char> buffer;
+  std::size_t       pos = 0u;
+};
+
+void write_binary_header( aiger_output_buffer& buf, unsigned num_inputs, unsigned num_latches, unsigned num_outputs, unsigned num_ands )
+{
+  buf.put_string( "aig " );
+  buf.put_unsigned( num_inputs + num_latches + num_ands ); buf.put( ' ' );
+  buf.put_unsigned( num_inputs );                          buf.put( ' ' );
+  buf.put_unsigned( num_latches );                         buf.put( ' ' );
+  buf.put_unsigned( num_outputs );                         buf.put( ' ' );
+  buf.put_unsigned( num_ands );                            buf.put( '\n' );
+}
+
+/* lhs > rhs0 >= rhs1 is required by the delta encoding */
+inline void write_binary_and( aiger_output_buffer& buf, unsigned lhs, unsigned rhs0, unsigned rhs1 )
+{
+  if ( rhs0 < rhs1 ) { std::swap( rhs0, rhs1 ); }
+  assert( lhs > rhs0 );
+  buf.encode( lhs - rhs0 );
+  buf.encode( rhs0 - rhs1 );
+}
+
+inline void write_binary_symbol( aiger_output_buffer& buf, char prefix, unsigned index, const std::string& name, bool fill_sym_table, const char* fill )
+{
+  if ( name.empty() && !fill_sym_table ) { return; }
+
+  buf.put( prefix );
+  buf.put_unsigned( index );
+  buf.put( ' ' );
+  if ( name.empty() )
+  {
+    buf.put_string( fill );
+    buf.put_unsigned( index );
+  }
+  else
+  {
+    buf.put_string( name );
+  }
+  buf.put( '\n' );
+}
+
+}
+
+void write_aiger_binary( const aig_graph& aig, std::ostream& os, const bool fill_sym_table )
+{
+  assert( num_vertices( aig ) != 0u && "Uninitialized AIG" );
+
+  const auto& graph_info = aig_info( aig );
+  const auto& complementmap = boost::get( boost::edge_complement, aig );
+
+  /* AIGER variables: inputs, latch outputs, then AND gates in topological order */
+  std::vector<unsigned> lits( num_vertices( aig ), 0u );
+  auto var = 0u;
+  for ( const auto& input : graph_info.inputs ) { lits[input] = ++var << 1u; }
+  for ( const auto& ci : graph_info.cis )       { lits[ci] = ++var << 1u; }
+
+  std::vector<aig_node> topsort;
+  topsort.reserve( num_vertices( aig ) );
+  boost::topological_sort( aig, std::back_inserter( topsort ) );
+
+  const auto num_inputs_latches = var;
+  for ( const auto& node : topsort )
+  {
+    if ( out_degree( node, aig ) ) { lits[node] = ++var << 1u; }
+  }
+
+  const auto literal = [&lits]( const aig_function& f ) { return lits[f.node] | ( f.complemented ? 1u : 0u ); };
+
+  aiger_output_buffer buf( os );
+  write_binary_header( buf, graph_info.inputs.size(), graph_info.cis.size(), graph_info.outputs.size(), var - num_inputs_latches );
+
+  assert( graph_info.cis.size() == graph_info.cos.size() );
+  for ( const auto& co : graph_info.cos )
+  {
+    buf.put_unsigned( literal( co ) ); buf.put( '\n' );
+  }
+  for ( const auto& output : graph_info.outputs )
+  {
+    buf.put_unsigned( literal( output.first ) ); buf.put( '\n' );
+  }
+
+  for ( const auto& node : topsort )
+  {
+    if ( !out_degree( node, aig ) ) { continue; }
+    assert( out_degree( node, aig ) == 2u );
+
+    auto it = out_edges( node, aig ).first;
+    const auto rhs0 = literal( {target( *it, aig ), complementmap[*it]} ); ++it;
+    const auto rhs1 = literal( {target( *it, aig ), complementmap[*it]} );
+    write_binary_and( buf, lits[node], rhs0, rhs1 );
+  }
+
+  const auto node_name = [&graph_info]( aig_node n ) {
+    const auto it = graph_info.node_names.find( n );
+    return it == graph_info.node_names.end() ? std::string() : it->second;
+  };
+
+  for ( auto i = 0u; i < graph_info.inputs.size(); ++i )
+  {
+    write_binary_symbol( buf, 'i', i, node_name( graph_info.inputs[i] ), fill_sym_table, "input" );
+  }
+  for ( auto i = 0u; i < graph_info.cis.size(); ++i )
+  {
+    write_binary_symbol( buf, 'l', i, node_name( graph_info.cis[i] ), fill_sym_table, "latch" );
+  }
+  for ( auto i = 0u; i < graph_info.outputs.size(); ++i )
+  {
+    write_binary_symbol( buf, 'o', i, graph_info.outputs[i].second, fill_sym_table, "output" );
+  }
+}
+
+void write_aiger_binary( const aig_graph& aig, const std::string& filename, const bool fill_sym_table )
+{
+  std::filebuf fb;
+  fb.open( filename.c_str(), std::ios::out | std::ios::binary );
+  std::ostream os( &fb );
+  write_aiger_binary( aig, os, fill_sym_table );
+  fb.close();
+}
+
+void write_aiger_binary( const aig_compact& aig, std::ostream& os, const bool fill_sym_table )
+{
+  const auto& names = aig.names();
+
+  /* node indexes are topological, only inputs and latches need to be moved to the front */
+  std::vector<unsigned> lits( aig.size(), 0u );
+  auto var = 0u;
+  for ( const auto& input : aig.inputs() ) { lits[input] = ++var << 1u; }
+  for ( const auto& ci : aig.cis() )       { lits[ci] = ++var << 1u; }
+  for ( aig_compact::node_t node = 1u; node < aig.size(); ++node )
+  {
+    if ( aig.is_and( node ) ) { lits[node] = ++var << 1u; }
+  }
+
+  const auto literal = [&lits]( aig_compact::literal_t l ) { return lits[l >> 1u] | ( l & 1u ); };
+
+  aiger_output_buffer buf( os );
+  write_binary_header( buf, aig.inputs().size(), aig.cis().size(), aig.outputs().size(), aig.num_ands() );
+
+  assert( aig.cis().size() == aig.cos().size() );
+  for ( const auto& co : aig.cos() )
+  {
+    buf.put_unsigned( literal( co ) ); buf.put( '\n' );
+  }
+  for ( const auto& output : aig.outputs() )
+  {
+    buf.put_unsigned( literal( output ) ); buf.put( '\n' );
+  }
+
+  for ( aig_compact::node_t node = 1u; node < aig.size(); ++node )
+  {
+    if ( aig.is_and( node ) )
+    {
+      write_binary_and( buf, lits[node], literal( aig.fanin_literal( node, 0u ) ), literal( aig.fanin_literal( node, 1u ) ) );
+    }
+  }
+
+  for ( auto i = 0u; i < aig.inputs().size(); ++i )
+  {
+    write_binary_symbol( buf, 'i', i, names.name( aig.inputs()[i] ), fill_sym_table, "input" );
+  }
+  for ( auto i = 0u; i < aig.cis().size(); ++i )
+  {
+    write_binary_symbol( buf, 'l', i, names.name( aig.cis()[i] ), fill_sym_table, "latch" );
+  }
+  for ( auto i = 0u; i < names.output_names.size(); ++i )
+  {
+    write_binary_symbol( buf, 'o', i, names.output_names[i], fill_sym_table, "output" );
+  }
+}
+
+void write_aiger_binary( const aig_compact& aig, const std::string& filename, const bool fill_sym_table )
+{
+  std::filebuf fb;
+  fb.open( filename.c_str(), std::ios::out | std::ios::binary );
+  std::ostream os( &fb );
+  write_aiger_binary( aig, os, fill_sym_table );
+  fb.close();
+}
+
 }
 
 // Local Variables:
@@ -29,6 +29,11 @@
  *
  * @brief Write AIG to aiger format
  *
+ * write_aiger writes the ASCII format (aag), write_aiger_binary the
+ * binary format (aig) through a large output buffer.  The binary writer
+ * renumbers nodes as required by AIGER: inputs, latches, then AND gates
+ * in topological order.
+ *
  * @author Mathias Soeken
  * @author Heinz Riener
  * @since  2.0
@@ -38,6 +43,7 @@
 #define WRITE_AIGER_HPP
 
 #include <classical/aig.hpp>
+#include <classical/aig_compact.hpp>
 
 #include <iostream>
 #include <string>
@@ -48,6 +54,15 @@ namespace cirkit
 void write_aiger( const aig_graph& aig, std::ostream& os, const bool fill_sym_table = false );
 void write_aiger( const aig_graph& aig, const std::string& filename, const bool fill_sym_table = false );
 
+void write_aiger( const aig_compact& aig, std::ostream& os, const bool fill_sym_table = false );
+void write_aiger( const aig_compact& aig, const std::string& filename, const bool fill_sym_table = false );
+
+void write_aiger_binary( const aig_graph& aig, std::ostream& os, const bool fill_sym_table = false );
+void write_aiger_binary( const aig_graph& aig, const std::string& filename, const bool fill_sym_table = false );
+
+void write_aiger_binary( const aig_compact& aig, std::ostream& os, const bool fill_sym_table = false );
+void write_aiger_binary( const aig_compact& aig, const std::string& filename, const bool fill_sym_table = false );
+
 }
 
 #endif
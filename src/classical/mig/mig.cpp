@@ -203,12 +203,11 @@ mig_function mig_create_maj( mig_graph& mig, const mig_function& a, const mig_fu
   mig_function children[] = {a, b, c};
   std::sort( children, children + 3 );
 
-  const auto key = std::make_tuple( children[0], children[1], children[2] );
+  const strash_table<3u>::key_t key = {{strash_literal( children[0] ), strash_literal( children[1] ), strash_literal( children[2] )}};
 
-  const auto it = info.strash.find( key );
-  if ( it != info.strash.end() )
+  if ( const auto* n = info.strash.find( key ) )
   {
-    return it->second;
+    return { *n, false };
   }
 
   mig_node node = add_vertex( mig );
@@ -224,7 +223,8 @@ mig_function mig_create_maj( mig_graph& mig, const mig_function& a, const mig_fu
   complement[eb] = children[1].complemented;
   complement[ec] = children[2].complemented;
 
-  return info.strash[key] = { node, false };
+  info.strash.insert( key, node );
+  return { node, false };
 }
 
 mig_function mig_create_and( mig_graph& mig, const mig_function& a, const mig_function& b )
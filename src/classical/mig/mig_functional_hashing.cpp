@@ -26,6 +26,7 @@
 
 #include "mig_functional_hashing.hpp"
 
+#include <array>
 #include <iostream>
 #include <unordered_map>
 #include <vector>
@@ -51,6 +52,7 @@
 #include <classical/mig/mig_functional_hashing_constants.hpp>
 #include <classical/utils/cut_enumeration.hpp>
 #include <classical/utils/cut_enumeration_traits.hpp>
+#include <classical/utils/static_cut_simulation.hpp>
 #include <classical/mig/mig_utils.hpp>
 #include <classical/utils/truth_table_utils.hpp>
 
@@ -161,16 +163,15 @@ void add_candidate( candidate_vec_t& vec, const candidate_t& c, unsigned max_siz
   }
 }
 
+using npn_tt_t   = kitty::static_truth_table<4>;
+using npn_perm_t = std::array<unsigned, 4u>;
+
 struct npn_hash_table_entry_t
 {
-  npn_hash_table_entry_t() {}
-  npn_hash_table_entry_t( int tt, int npn, const std::vector<unsigned>& perm, const boost::dynamic_bitset<>& phase )
-    : tt( tt ), npn( npn ), perm( perm ), phase( phase ) {}
-
-  int                     tt  = -1;
-  int                     npn = -1;
-  std::vector<unsigned>   perm;
-  boost::dynamic_bitset<> phase;
+  int        tt    = -1;
+  npn_tt_t   npn;
+  npn_perm_t perm;
+  unsigned   phase = 0u;
 };
 
 using npn_hash_table_t = std::vector<npn_hash_table_entry_t>;
@@ -184,7 +185,7 @@ public:
 
 private:
   int find_best_cut( const mig_node& node, const std::map<aig_node, structural_cut>& cuts,
-                     boost::dynamic_bitset<>& phase, std::vector<unsigned>& perm, std::string& expr );
+                     unsigned& phase, npn_perm_t& perm, std::string& expr );
 
   mig_function optimize_node( const std::vector<mig_node>& ffr_leafs, const mig_node& node,
                               const std::map<aig_node, structural_cut>& cuts );
@@ -192,7 +193,8 @@ private:
   mig_function optimize_node( const mig_node& node,
                               const std::map<aig_node, structural_cut>& cuts );
 
-  tt compute_npn( const tt& tt, boost::dynamic_bitset<>& phase, std::vector<unsigned>& perm );
+  npn_tt_t simulate_cut( const mig_node& node, const boost::dynamic_bitset<>& cut ) const;
+  npn_tt_t compute_npn( const npn_tt_t& tt, unsigned& phase, npn_perm_t& perm );
 
   bool is_fanout_free_cut( const mig_node& node, const boost::dynamic_bitset<>& cut ) const;
 
@@ -201,9 +203,9 @@ private:
   mig_function copy_tmp_to_new( const mig_node& node, const mig_graph& mig_tmp, std::map<mig_node, mig_function>& visited );
 
 private:
-  inline std::vector<unsigned> inv( const std::vector<unsigned>& perm ) const
+  inline npn_perm_t inv( const npn_perm_t& perm ) const
   {
-    std::vector<unsigned> invperm( perm.size() );
+    npn_perm_t invperm;
     for ( auto i = 0u; i < perm.size(); ++i ) { invperm[perm[i]] = i; }
     return invperm;
   }
@@ -382,7 +384,7 @@ void mig_functional_hashing_manager::run()
 }
 
 int mig_functional_hashing_manager::find_best_cut( const mig_node& node, const std::map<mig_node, structural_cut>& cuts,
-                                                   boost::dynamic_bitset<>& phase, std::vector<unsigned>& perm, std::string& expr )
+                                                   unsigned& phase, npn_perm_t& perm, std::string& expr )
 {
   auto best_gain  = 0u;
   auto best_index = -1;
@@ -397,24 +399,21 @@ int mig_functional_hashing_manager::find_best_cut( const mig_node& node, const s
     auto cut_copy = cut.value; cut_copy.reset( 0u );
     if ( cut_copy.count() >= 4u ) { continue; }
 
-    auto tt         = simulate_cut_tt<mig_graph>( node, cut.value, mig );
-    //const auto vars = tt_num_vars( tt );
-
-    tt_shrink( tt, 4u );
+    const auto tt = simulate_cut( node, cut.value );
 
-    boost::dynamic_bitset<> local_phase;
-    std::vector<unsigned>   local_perm;
+    unsigned   local_phase;
+    npn_perm_t local_perm;
     const auto npn = compute_npn( tt, local_phase, local_perm );
 
     /* better result? */
-    const auto best_area  = std::get<0>( mig_functional_hashing_constants::min_depth_mig_sizes.at( npn.to_ulong() ) );
-    const auto best_depth = std::get<1>( mig_functional_hashing_constants::min_depth_mig_sizes.at( npn.to_ulong() ) );
+    const auto best_area  = std::get<0>( mig_functional_hashing_constants::min_depth_mig_sizes.at( *npn.cbegin() ) );
+    const auto best_depth = std::get<1>( mig_functional_hashing_constants::min_depth_mig_sizes.at( *npn.cbegin() ) );
 
     if ( verbose )
     {
       std::cout << "[i]   analyze cut ";
-      print_as_set( std::cout, cut.value ) << ", tt: " << tt_to_hex( tt )
-                                           << ", npn: " << tt_to_hex( npn )
+      print_as_set( std::cout, cut.value ) << ", tt: " << tt_to_hex( from_kitty( tt ) )
+                                           << ", npn: " << tt_to_hex( from_kitty( npn ) )
                                            << ", cur. area:  " << current_area
                                            << ", cur. depth: " << current_depth
                                            << ", best area:  " << best_area
@@ -428,7 +427,7 @@ int mig_functional_hashing_manager::find_best_cut( const mig_node& node, const s
       best_index = cut.index;
       phase      = local_phase;
       perm       = local_perm;
-      expr       = std::get<3>( mig_functional_hashing_constants::min_depth_mig_sizes.at( npn.to_ulong() ) );
+      expr       = std::get<3>( mig_functional_hashing_constants::min_depth_mig_sizes.at( *npn.cbegin() ) );
     }
   }
 
@@ -446,8 +445,8 @@ mig_function mig_functional_hashing_manager::optimize_node( const std::vector<mi
     return old_to_new.at( node );
   }
 
-  boost::dynamic_bitset<> phase;
-  std::vector<unsigned>   perm;
+  unsigned   phase;
+  npn_perm_t perm;
   std::string             expr;
   auto best_cut = find_best_cut( node, cuts, phase, perm, expr );
 
@@ -471,7 +470,7 @@ mig_function mig_functional_hashing_manager::optimize_node( const std::vector<mi
       if ( child != 0u )
       {
         const auto childf = optimize_node( ffr_leafs, child, cuts );
-        var_to_function.insert( {vars[invperm[index]], phase.test( index ) ? !childf : childf} );
+        var_to_function.insert( {vars[invperm[index]], ( ( phase >> index ) & 1u ) ? !childf : childf} );
         ++index;
       }
     } );
@@ -479,7 +478,7 @@ mig_function mig_functional_hashing_manager::optimize_node( const std::vector<mi
   auto mfs_settings = std::make_shared<properties>();
   mfs_settings->set( "variable_map", var_to_function );
 
-  return make_function( mig_from_string( mig_new, expr, mfs_settings ), phase.test( phase.size() - 1u ) );
+  return make_function( mig_from_string( mig_new, expr, mfs_settings ), ( phase >> 4u ) & 1u );
 }
 
 mig_function mig_functional_hashing_manager::optimize_node( const mig_node& node,
@@ -491,8 +490,8 @@ mig_function mig_functional_hashing_manager::optimize_node( const mig_node& node
   const auto it = old_to_new.find( node );
   if ( it != old_to_new.end() ) { return it->second; }
 
-  boost::dynamic_bitset<> phase;
-  std::vector<unsigned>   perm;
+  unsigned   phase;
+  npn_perm_t perm;
   std::string             expr;
   auto best_cut = find_best_cut( node, cuts, phase, perm, expr );
 
@@ -519,7 +518,7 @@ mig_function mig_functional_hashing_manager::optimize_node( const mig_node& node
       if ( child != 0u )
       {
         const auto childf = optimize_node( child, cuts );
-        var_to_function.insert( {vars[invperm[index]], phase.test( index ) ? !childf : childf} );
+        var_to_function.insert( {vars[invperm[index]], ( ( phase >> index ) & 1u ) ? !childf : childf} );
         ++index;
       }
     } );
@@ -529,7 +528,7 @@ mig_function mig_functional_hashing_manager::optimize_node( const mig_node& node
 
   auto f = mig_from_string( mig_new, expr, mfs_settings );
 
-  if ( phase.test( phase.size() - 1u ) )
+  if ( ( phase >> 4u ) & 1u )
   {
     f = !f;
   }
@@ -539,43 +538,54 @@ mig_function mig_functional_hashing_manager::optimize_node( const mig_node& node
   return f;
 }
 
-tt mig_functional_hashing_manager::compute_npn( const tt& tt, boost::dynamic_bitset<>& phase, std::vector<unsigned>& perm )
+npn_tt_t mig_functional_hashing_manager::simulate_cut( const mig_node& node, const boost::dynamic_bitset<>& cut ) const
 {
-  boost::dynamic_bitset<> npn;
+  std::array<mig_node, 4u> leafs;
+  auto count = 0u;
+  foreach_bit( cut, [&]( unsigned pos ) {
+      if ( pos == 0u ) { return; }
+      assert( count < 4u );
+      leafs[count++] = pos;
+    } );
+
+  return simulate_cut_static<4>( mig, node, leafs.begin(), leafs.begin() + count,
+                                  []( const npn_tt_t* v, unsigned ) { return kitty::ternary_majority( v[0], v[1], v[2] ); } );
+}
 
+npn_tt_t mig_functional_hashing_manager::compute_npn( const npn_tt_t& tt, unsigned& phase, npn_perm_t& perm )
+{
   /* compute NPN and use hash table if possible */
   if ( !npn_table.empty() )
   {
-    const auto ttu      = tt.to_ulong();
+    const auto ttu      = *tt.cbegin();
     const auto hash_key = ttu % npn_table.size();
     auto& entry   = npn_table[hash_key];
 
     if ( static_cast<unsigned long>( entry.tt ) == ttu )
     {
       ++cache_hit;
-      npn = boost::dynamic_bitset<>( 16u, entry.npn );
-      perm = std::vector<unsigned>( entry.perm );
-      phase = boost::dynamic_bitset<>( entry.phase );
+      perm  = entry.perm;
+      phase = entry.phase;
+      return entry.npn;
     }
     else
     {
       ++cache_miss;
       increment_timer t( &runtime_npn );
-      npn = exact_npn_canonization( tt, phase, perm );
+      const auto npn = exact_npn_canonization<4>( tt, phase, perm );
 
       entry.tt    = ttu;
-      entry.npn   = npn.to_ulong();
+      entry.npn   = npn;
       entry.perm  = perm;
       entry.phase = phase;
+      return npn;
     }
   }
   else
   {
     increment_timer t( &runtime_npn );
-    npn = exact_npn_canonization( tt, phase, perm );
+    return exact_npn_canonization<4>( tt, phase, perm );
   }
-
-  return npn;
 }
 
 bool mig_functional_hashing_manager::is_fanout_free_cut( const mig_node& node, const boost::dynamic_bitset<>& cut ) const
@@ -712,16 +722,13 @@ void mig_functional_hashing_manager::depth_preserving_functional_hashing( const
 
         if ( current_area <= 1u ) { continue; }
 
-        auto tt         = simulate_cut_tt( node, cut, mig );
-        //const auto vars = tt_num_vars( tt );
-
-        tt_shrink( tt, 4u );
+        const auto tt = simulate_cut( node, cut );
 
-        boost::dynamic_bitset<> phase;
-        std::vector<unsigned>   perm;
+        unsigned   phase;
+        npn_perm_t perm;
         const auto npn = compute_npn( tt, phase, perm );
 
-        const auto best_area = std::get<0>( mig_functional_hashing_constants::min_depth_mig_sizes.at( npn.to_ulong() ) );
+        const auto best_area = std::get<0>( mig_functional_hashing_constants::min_depth_mig_sizes.at( *npn.cbegin() ) );
 
         if ( !allow_area_inc && best_area > current_area ) { continue; }
 
@@ -746,7 +753,7 @@ void mig_functional_hashing_manager::depth_preserving_functional_hashing( const
 
             /* depth of new_f */
             auto max_depth = 0u;
-            const auto& arrival = std::get<2>( mig_functional_hashing_constants::min_depth_mig_sizes.at( npn.to_ulong() ) );
+            const auto& arrival = std::get<2>( mig_functional_hashing_constants::min_depth_mig_sizes.at( *npn.cbegin() ) );
 
             auto index = 0u;
             for ( auto i = 0u; i < leafs.size(); ++i )
@@ -755,7 +762,7 @@ void mig_functional_hashing_manager::depth_preserving_functional_hashing( const
               const auto childf = cand.f;
 
               const auto key = 'a' + invperm[index];
-              var_to_function.insert( {key, make_function( childf, phase.test( i ) ) } );
+              var_to_function.insert( {key, make_function( childf, ( phase >> i ) & 1u ) } );
 
               const auto it_arrival = arrival.find( key );
               if ( it_arrival != arrival.end() )
@@ -770,8 +777,8 @@ void mig_functional_hashing_manager::depth_preserving_functional_hashing( const
             auto mfs_settings = std::make_shared<properties>();
             mfs_settings->set( "variable_map", var_to_function );
 
-            const auto& expr = std::get<3>( mig_functional_hashing_constants::min_depth_mig_sizes.at( npn.to_ulong() ) );
-            const auto new_f = make_function( mig_from_string( mig_tmp, expr, mfs_settings ), phase.test( phase.size() - 1u ) );
+            const auto& expr = std::get<3>( mig_functional_hashing_constants::min_depth_mig_sizes.at( *npn.cbegin() ) );
+            const auto new_f = make_function( mig_from_string( mig_tmp, expr, mfs_settings ), ( phase >> 4u ) & 1u );
 
             /* area of new_f */
             const auto new_f_area = compute_coi_size( mig_tmp, new_f.node );
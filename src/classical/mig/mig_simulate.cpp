@@ -143,6 +143,17 @@ unsigned mig_depth_simulator::maj_op( const mig_node& node, const unsigned& v1,
   return std::max( v1, std::max( v2, v3 ) ) + 1u;
 }
 
+/******************************************************************************
+ * Utility functions for simulation                                           *
+ ******************************************************************************/
+
+tt mig_simulate_output( const mig_graph& mig, unsigned num_vars, unsigned index )
+{
+  auto t = simulate_mig_function( mig, mig_info( mig ).outputs.at( index ).first, mig_tt_simulator() );
+  tt_num_vars( t ) < num_vars ? tt_extend( t, num_vars ) : tt_shrink( t, num_vars );
+  return t;
+}
+
 }
 
 // Local Variables:
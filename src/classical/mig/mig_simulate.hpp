@@ -344,6 +344,13 @@ std::map<mig_function, T> simulate_mig( const mig_graph& mig, const mig_simulato
   return results;
 }
 
+/******************************************************************************
+ * Utility functions for simulation                                           *
+ ******************************************************************************/
+
+/* truth table of an output over num_vars variables, also if the MIG has fewer inputs */
+tt mig_simulate_output( const mig_graph& mig, unsigned num_vars, unsigned index = 0u );
+
 }
 
 #endif
@@ -74,7 +74,7 @@ void mig_print_stats( const mig_graph& mig, std::ostream& os )
   std::vector<unsigned> depths;
   const auto depth = compute_depth( mig, outputs, depths );
 
-  os << boost::format( "[i] %20s: i/o = %7d / %7d  maj = %7d  lev = %4d" ) % name % n % info.outputs.size() % ( boost::num_vertices( mig ) - n - 1u ) % depth << std::endl;
+  os << boost::format( "[i] %20s: i/o = %7d / %7d  maj = %7d  lev = %4d" ) % name % n % info.outputs.size() % number_of_gates( mig ) % depth << std::endl;
 }
 
 std::vector<mig_function> get_children( const mig_graph& mig, const mig_node& node )
@@ -89,6 +89,12 @@ std::vector<mig_function> get_children( const mig_graph& mig, const mig_node& no
   return children;
 }
 
+unsigned number_of_gates( const mig_graph& mig )
+{
+  /* all nodes but the constant and the inputs */
+  return boost::num_vertices( mig ) - mig_info( mig ).inputs.size() - 1u;
+}
+
 unsigned number_of_complemented_edges( const mig_graph& mig )
 {
   const auto& complement = boost::get( boost::edge_complement, mig );
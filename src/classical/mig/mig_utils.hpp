@@ -62,6 +62,7 @@ inline mig_function make_function( const mig_function& f, bool complemented )
 void mig_print_stats( const mig_graph& mig, std::ostream& os = std::cout );
 std::vector<mig_function> get_children( const mig_graph& mig, const mig_node& node );
 
+unsigned number_of_gates( const mig_graph& mig );
 unsigned number_of_complemented_edges( const mig_graph& mig );
 unsigned number_of_inverters( const mig_graph& mig );
 
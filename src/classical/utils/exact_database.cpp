@@ -0,0 +1,429 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "exact_database.hpp"
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <boost/format.hpp>
+
+#include <classical/functions/npn_canonization.hpp>
+#include <classical/mig/mig_from_string.hpp>
+#include <classical/mig/mig_utils.hpp>
+#include <classical/utils/expression_parser.hpp>
+#include <classical/xmg/xmg_expr.hpp>
+
+namespace cirkit
+{
+
+/******************************************************************************
+ * Types                                                                      *
+ ******************************************************************************/
+
+namespace
+{
+
+struct file_header_t
+{
+  char     magic[8];
+  uint32_t version;
+  uint32_t reserved;
+};
+
+constexpr char     file_magic[8] = {'C', 'K', 'E', 'X', 'A', 'C', 'T', '\0'};
+constexpr uint32_t file_version  = 1u;
+constexpr uint32_t record_magic  = 0x52425845u; /* "EXBR" */
+
+/* releases the file lock when leaving the scope */
+class file_lock
+{
+public:
+  file_lock( int fd, int operation ) : fd( fd ) { while ( ::flock( fd, operation ) != 0 && errno == EINTR ) {} }
+  ~file_lock() { ::flock( fd, LOCK_UN ); }
+
+private:
+  int fd;
+};
+
+}
+
+/******************************************************************************
+ * Private functions                                                          *
+ ******************************************************************************/
+
+namespace
+{
+
+inline std::size_t padded_size( std::size_t expr_size )
+{
+  return sizeof( exact_database::record_t ) + ( ( expr_size + 7u ) & ~std::size_t( 7u ) );
+}
+
+tt npn_canonize( const tt& spec, boost::dynamic_bitset<>& phase, std::vector<unsigned>& perm )
+{
+  /* same classifiers as in xmg_minlib_manager */
+  if ( tt_num_vars( spec ) <= 5u )
+  {
+    return exact_npn_canonization( spec, phase, perm );
+  }
+  else
+  {
+    return npn_canonization_lucky( spec, phase, perm );
+  }
+}
+
+}
+
+std::size_t exact_database::key_hash::operator()( const key_t& key ) const
+{
+  auto h = key.tt * 0x9e3779b97f4a7c15ull;
+  h ^= ( static_cast<uint64_t>( key.num_vars ) << 16u ) | ( static_cast<uint64_t>( key.type ) << 8u ) | key.objective;
+  return static_cast<std::size_t>( h ^ ( h >> 29u ) );
+}
+
+void exact_database::refresh()
+{
+  struct stat st;
+  if ( ::fstat( fd, &st ) != 0 ) { return; }
+
+  const auto size = static_cast<std::size_t>( st.st_size );
+  if ( size == file.size() && file.is_open() ) { return; }
+
+  /* map again to cover the appended records */
+  file = mapped_file( filename );
+  if ( !file.is_open() ) { return; }
+
+  auto offset = std::max( indexed, sizeof( file_header_t ) );
+  while ( offset + sizeof( record_t ) <= file.size() )
+  {
+    record_t record;
+    std::memcpy( &record, file.data() + offset, sizeof( record ) );
+
+    /* a torn record at the end of the file, see insert */
+    if ( record.magic != record_magic || offset + padded_size( record.expr_size ) > file.size() ) { break; }
+
+    index.insert( {{record.tt, record.num_vars, record.type, record.objective}, offset} );
+    offset += padded_size( record.expr_size );
+  }
+  indexed = offset;
+}
+
+const exact_database::record_t* exact_database::find_record( const key_t& key ) const
+{
+  const auto it = index.find( key );
+  return it == index.end() ? nullptr : reinterpret_cast<const record_t*>( file.data() + it->second );
+}
+
+/******************************************************************************
+ * Public functions                                                           *
+ ******************************************************************************/
+
+exact_database::exact_database( const std::string& filename )
+  : filename( filename )
+{
+  fd = ::open( filename.c_str(), O_RDWR | O_CREAT, 0644 );
+  if ( fd == -1 ) { return; }
+
+  file_lock lock( fd, LOCK_EX );
+
+  struct stat st;
+  auto valid = ::fstat( fd, &st ) == 0;
+
+  if ( valid && st.st_size == 0 )
+  {
+    file_header_t header;
+    std::memcpy( header.magic, file_magic, sizeof( file_magic ) );
+    header.version  = file_version;
+    header.reserved = 0u;
+    valid = ::pwrite( fd, &header, sizeof( header ), 0 ) == sizeof( header );
+  }
+  else if ( valid )
+  {
+    file_header_t header;
+    valid = ::pread( fd, &header, sizeof( header ), 0 ) == sizeof( header ) &&
+            std::memcmp( header.magic, file_magic, sizeof( file_magic ) ) == 0 &&
+            header.version == file_version;
+  }
+
+  if ( valid )
+  {
+    refresh();
+    valid = file.is_open();
+  }
+
+  /* never write into files of a different format */
+  if ( !valid )
+  {
+    ::close( fd );
+    fd = -1;
+  }
+}
+
+exact_database::~exact_database()
+{
+  if ( fd != -1 )
+  {
+    ::close( fd );
+  }
+}
+
+std::shared_ptr<exact_database> exact_database::open( const std::string& filename )
+{
+  /* kept open for the lifetime of the process, such that the index is only built once */
+  static std::mutex registry_mutex;
+  static std::map<std::string, std::shared_ptr<exact_database>> registry;
+
+  std::lock_guard<std::mutex> lock( registry_mutex );
+
+  auto& db = registry[filename];
+  if ( !db )
+  {
+    db = std::make_shared<exact_database>( filename );
+  }
+  return db->is_open() ? db : nullptr;
+}
+
+bool exact_database::supports( const tt& spec )
+{
+  return !spec.empty() && spec.size() <= 64u;
+}
+
+boost::optional<exact_database::entry_t> exact_database::find( network_type type, unsigned objective, const tt& npn_spec )
+{
+  if ( !is_open() || !supports( npn_spec ) ) { return boost::none; }
+
+  const key_t key{npn_spec.to_ulong(), static_cast<uint8_t>( tt_num_vars( npn_spec ) ), static_cast<uint8_t>( type ), static_cast<uint8_t>( objective )};
+
+  std::lock_guard<std::mutex> lock( mutex );
+
+  auto record = find_record( key );
+  if ( !record )
+  {
+    /* other processes may have added it */
+    file_lock flock( fd, LOCK_SH );
+    refresh();
+    record = find_record( key );
+  }
+
+  if ( !record )
+  {
+    ++num_misses;
+    return boost::none;
+  }
+
+  ++num_hits;
+  return entry_t{std::string( reinterpret_cast<const char*>( record + 1 ), record->expr_size ), record->gates, record->optimum != 0u};
+}
+
+bool exact_database::insert( network_type type, unsigned objective, const tt& npn_spec, const entry_t& entry )
+{
+  if ( !is_open() || !supports( npn_spec ) || entry.expression.size() > 0xffffu ) { return false; }
+
+  const key_t key{npn_spec.to_ulong(), static_cast<uint8_t>( tt_num_vars( npn_spec ) ), static_cast<uint8_t>( type ), static_cast<uint8_t>( objective )};
+
+  std::lock_guard<std::mutex> lock( mutex );
+  file_lock flock( fd, LOCK_EX );
+
+  refresh();
+  if ( find_record( key ) ) { return false; }
+
+  std::vector<char> buffer( padded_size( entry.expression.size() ), '\0' );
+  record_t record;
+  std::memset( &record, 0, sizeof( record ) );
+  record.magic     = record_magic;
+  record.expr_size = static_cast<uint16_t>( entry.expression.size() );
+  record.type      = key.type;
+  record.objective = key.objective;
+  record.tt        = key.tt;
+  record.num_vars  = key.num_vars;
+  record.optimum   = entry.optimum ? 1u : 0u;
+  record.gates     = static_cast<uint16_t>( std::min( entry.gates, 0xffffu ) );
+  std::memcpy( buffer.data(), &record, sizeof( record ) );
+  std::memcpy( buffer.data() + sizeof( record ), entry.expression.data(), entry.expression.size() );
+
+  /* drop a torn record of a process that died while appending */
+  if ( file.size() > indexed && ::ftruncate( fd, indexed ) != 0 ) { return false; }
+
+  if ( ::pwrite( fd, buffer.data(), buffer.size(), indexed ) != static_cast<ssize_t>( buffer.size() ) ) { return false; }
+
+  ++num_inserts;
+  refresh();
+  return true;
+}
+
+boost::optional<mig_graph> exact_database::find_mig( const tt& spec, unsigned objective, bool optimum_only,
+                                                     const std::string& model_name, const std::string& output_name )
+{
+  if ( !supports( spec ) ) { return boost::none; }
+
+  boost::dynamic_bitset<> phase;
+  std::vector<unsigned> perm;
+  const auto entry = find( network_type::mig, objective, npn_canonize( spec, phase, perm ) );
+  if ( !entry || ( optimum_only && !entry->optimum ) ) { return boost::none; }
+
+  const auto num_vars = tt_num_vars( spec );
+
+  mig_graph mig;
+  mig_initialize( mig, model_name );
+  std::vector<mig_function> inputs, pis;
+  for ( auto i = 0u; i < num_vars; ++i )
+  {
+    inputs.push_back( mig_create_pi( mig, boost::str( boost::format( "x%d" ) % i ) ) );
+  }
+  for ( auto i = 0u; i < num_vars; ++i )
+  {
+    pis.push_back( inputs[perm[i]] ^ phase[perm[i]] );
+  }
+  mig_create_po( mig, mig_from_expression( mig, pis, parse_expression( entry->expression ) ) ^ phase[num_vars], output_name );
+
+  return mig;
+}
+
+boost::optional<xmg_graph> exact_database::find_xmg( const tt& spec, unsigned objective, bool optimum_only,
+                                                     const std::string& model_name, const std::string& output_name )
+{
+  if ( !supports( spec ) ) { return boost::none; }
+
+  boost::dynamic_bitset<> phase;
+  std::vector<unsigned> perm;
+  const auto entry = find( network_type::xmg, objective, npn_canonize( spec, phase, perm ) );
+  if ( !entry || ( optimum_only && !entry->optimum ) ) { return boost::none; }
+
+  const auto num_vars = tt_num_vars( spec );
+
+  xmg_graph xmg( model_name );
+  std::vector<xmg_function> inputs, pis;
+  for ( auto i = 0u; i < num_vars; ++i )
+  {
+    inputs.push_back( xmg.create_pi( boost::str( boost::format( "x%d" ) % i ) ) );
+  }
+  for ( auto i = 0u; i < num_vars; ++i )
+  {
+    pis.push_back( inputs[perm[i]] ^ phase[perm[i]] );
+  }
+  xmg.create_po( xmg_from_expression( xmg, pis, parse_expression( entry->expression ) ) ^ phase[num_vars], output_name );
+
+  return xmg;
+}
+
+bool exact_database::insert_mig( const tt& spec, unsigned objective, const mig_graph& mig, bool optimum )
+{
+  if ( !supports( spec ) ) { return false; }
+
+  /* the network for the representative is obtained by synthesizing it
+     from the stored network of spec with the inverse transformation */
+  boost::dynamic_bitset<> phase;
+  std::vector<unsigned> perm;
+  const auto npn_spec = npn_canonize( spec, phase, perm );
+  const auto num_vars = tt_num_vars( spec );
+  const auto& info = mig_info( mig );
+
+  mig_graph npn_mig;
+  mig_initialize( npn_mig );
+  std::vector<mig_function> npn_inputs, pis( num_vars );
+  for ( auto i = 0u; i < num_vars; ++i )
+  {
+    npn_inputs.push_back( mig_create_pi( npn_mig, boost::str( boost::format( "x%d" ) % i ) ) );
+  }
+  for ( auto i = 0u; i < num_vars; ++i )
+  {
+    pis[perm[i]] = npn_inputs[i] ^ phase[perm[i]];
+  }
+  const auto f = mig_from_expression( npn_mig, pis, mig_to_expression( mig, info.outputs.front().first ) ) ^ phase[num_vars];
+
+  return insert( network_type::mig, objective, npn_spec,
+                 {expression_to_string( mig_to_expression( npn_mig, f ) ), number_of_gates( mig ), optimum} );
+}
+
+bool exact_database::insert_xmg( const tt& spec, unsigned objective, const xmg_graph& xmg, bool optimum )
+{
+  if ( !supports( spec ) ) { return false; }
+
+  boost::dynamic_bitset<> phase;
+  std::vector<unsigned> perm;
+  const auto npn_spec = npn_canonize( spec, phase, perm );
+  const auto num_vars = tt_num_vars( spec );
+
+  xmg_graph npn_xmg;
+  std::vector<xmg_function> npn_inputs, pis( num_vars );
+  for ( auto i = 0u; i < num_vars; ++i )
+  {
+    npn_inputs.push_back( npn_xmg.create_pi( boost::str( boost::format( "x%d" ) % i ) ) );
+  }
+  for ( auto i = 0u; i < num_vars; ++i )
+  {
+    pis[perm[i]] = npn_inputs[i] ^ phase[perm[i]];
+  }
+  const auto f = xmg_from_expression( npn_xmg, pis, xmg_to_expression( xmg, xmg.outputs().front().first ) ) ^ phase[num_vars];
+
+  return insert( network_type::xmg, objective, npn_spec,
+                 {expression_to_string( xmg_to_expression( npn_xmg, f ) ), xmg.num_gates(), optimum} );
+}
+
+std::size_t exact_database::size() const
+{
+  std::lock_guard<std::mutex> lock( mutex );
+  return index.size();
+}
+
+void exact_database::print_statistics( std::ostream& os ) const
+{
+  std::lock_guard<std::mutex> lock( mutex );
+
+  os << boost::format( "[i] exact database %s: %d entries, %d hits, %d misses, %d inserts" )
+        % filename % index.size() % num_hits % num_misses % num_inserts << std::endl;
+}
+
+std::string default_exact_database_filename()
+{
+  if ( const auto* path = std::getenv( "CIRKIT_HOME" ) )
+  {
+    return boost::str( boost::format( "%s/exact.db" ) % path );
+  }
+  return std::string();
+}
+
+std::shared_ptr<exact_database> exact_database_from_settings( const properties::ptr& settings )
+{
+  const auto filename = get( settings, "database", std::string() );
+  return filename.empty() ? nullptr : exact_database::open( filename );
+}
+
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
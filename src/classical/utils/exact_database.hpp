@@ -0,0 +1,178 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * @file exact_database.hpp
+ *
+ * @brief Persistent database of optimum MIGs and XMGs
+ *
+ * Networks are stored for NPN representatives of functions with up to 6
+ * variables, since permuting and complementing inputs and complementing
+ * the output does not change size or depth of MIGs and XMGs.  The file is
+ * append-only and memory mapped; lookups are answered from an index of
+ * file offsets.  Several processes can share the same file: appending
+ * takes an exclusive and reading new records a shared file lock.  When
+ * another process has appended records, they are indexed on the next
+ * lookup miss.
+ *
+ * @author Mathias Soeken
+ * @since  2.3
+ */
+
+#ifndef EXACT_DATABASE_HPP
+#define EXACT_DATABASE_HPP
+
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/optional.hpp>
+
+#include <core/properties.hpp>
+#include <core/utils/mapped_file.hpp>
+#include <classical/mig/mig.hpp>
+#include <classical/utils/truth_table_utils.hpp>
+#include <classical/xmg/xmg.hpp>
+
+namespace cirkit
+{
+
+class exact_database
+{
+public:
+  enum class network_type : uint8_t { mig = 0u, xmg = 1u };
+
+  /* objectives as in exact_mig_with_sat: 0: size, 1: size/depth, 2: depth/size */
+  struct entry_t
+  {
+    std::string expression;  /* of the NPN representative over variables a, b, ... */
+    unsigned    gates;
+    bool        optimum;     /* false for heuristic results */
+  };
+
+  /* opens or creates the file, is_open() is false on failure */
+  explicit exact_database( const std::string& filename );
+  ~exact_database();
+
+  exact_database( const exact_database& ) = delete;
+  exact_database& operator=( const exact_database& ) = delete;
+
+  /* shared instance per file in this process, nullptr if the file cannot be opened */
+  static std::shared_ptr<exact_database> open( const std::string& filename );
+
+  inline bool is_open() const { return fd != -1; }
+
+  /* functions with more than 6 variables are never stored */
+  static bool supports( const tt& spec );
+
+  boost::optional<entry_t> find( network_type type, unsigned objective, const tt& npn_spec );
+  /* returns false if an entry for the key exists already */
+  bool insert( network_type type, unsigned objective, const tt& npn_spec, const entry_t& entry );
+
+  /* look up and store networks for arbitrary functions, taking care of the NPN transformation */
+  boost::optional<mig_graph> find_mig( const tt& spec, unsigned objective, bool optimum_only = true,
+                                       const std::string& model_name = std::string( "exact" ),
+                                       const std::string& output_name = std::string( "f" ) );
+  boost::optional<xmg_graph> find_xmg( const tt& spec, unsigned objective, bool optimum_only = true,
+                                       const std::string& model_name = std::string( "exact" ),
+                                       const std::string& output_name = std::string( "f" ) );
+  bool insert_mig( const tt& spec, unsigned objective, const mig_graph& mig, bool optimum = true );
+  bool insert_xmg( const tt& spec, unsigned objective, const xmg_graph& xmg, bool optimum = true );
+
+  std::size_t size() const;
+  void print_statistics( std::ostream& os = std::cout ) const;
+
+public:
+  /* layout of records in the file, followed by the expression padded to 8 bytes */
+  struct record_t
+  {
+    uint32_t magic;
+    uint16_t expr_size;
+    uint8_t  type;
+    uint8_t  objective;
+    uint64_t tt;
+    uint8_t  num_vars;
+    uint8_t  optimum;
+    uint16_t gates;
+    uint32_t reserved;
+  };
+
+private:
+  struct key_t
+  {
+    uint64_t tt;
+    uint8_t  num_vars;
+    uint8_t  type;
+    uint8_t  objective;
+
+    bool operator==( const key_t& other ) const
+    {
+      return tt == other.tt && num_vars == other.num_vars && type == other.type && objective == other.objective;
+    }
+  };
+
+  struct key_hash
+  {
+    std::size_t operator()( const key_t& key ) const;
+  };
+
+  /* indexes records appended since the last call, expects a file lock */
+  void refresh();
+  const record_t* find_record( const key_t& key ) const;
+
+private:
+  std::string                                   filename;
+  int                                           fd = -1;
+  mapped_file                                   file;
+  std::size_t                                   indexed = 0u; /* end of last valid record */
+  std::unordered_map<key_t, std::size_t, key_hash> index;
+  mutable std::mutex                            mutex;
+
+  /* statistics */
+  unsigned long                                 num_hits = 0ul;
+  unsigned long                                 num_misses = 0ul;
+  unsigned long                                 num_inserts = 0ul;
+};
+
+/* $CIRKIT_HOME/exact.db, or empty if CIRKIT_HOME is not set */
+std::string default_exact_database_filename();
+
+/* database given by the file name in the database setting, nullptr if not set */
+std::shared_ptr<exact_database> exact_database_from_settings( const properties::ptr& settings );
+
+}
+
+#endif
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
@@ -26,9 +26,14 @@
 
 #include "npn_manager.hpp"
 
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
 #include <boost/format.hpp>
 
-#include <core/utils/timer.hpp>
 #include <classical/functions/npn_canonization.hpp>
 
 namespace cirkit
@@ -38,54 +43,207 @@ namespace cirkit
  * Types                                                                      *
  ******************************************************************************/
 
+constexpr uint8_t npn_manager::empty_record;
+
+namespace
+{
+
+enum slot_state : uint32_t { slot_empty = 0u, slot_busy = 1u, slot_ready = 2u };
+
+struct file_header_t
+{
+  char     magic[8];
+  uint32_t version;
+  uint32_t record_size;
+  uint64_t capacity;
+  uint64_t count;
+};
+
+constexpr char     file_magic[8] = { 'c', 'i', 'r', 'k', 'n', 'p', 'n', '\0' };
+constexpr uint32_t file_version  = 1u;
+
+}
+
 /******************************************************************************
  * Private functions                                                          *
  ******************************************************************************/
 
+inline std::size_t npn_cache_hash( uint64_t key, uint8_t num_vars )
+{
+  auto h = ( key ^ ( static_cast<uint64_t>( num_vars ) << 58u ) ) * 0x9e3779b97f4a7c15ull;
+  h ^= h >> 29u;
+  h *= 0xbf58476d1ce4e5b9ull;
+  h ^= h >> 32u;
+  return static_cast<std::size_t>( h );
+}
+
+inline std::size_t next_power_of_two( std::size_t n )
+{
+  std::size_t c = 1u;
+  while ( c < n ) { c <<= 1u; }
+  return c;
+}
+
+npn_manager::table_t::table_t( std::size_t capacity )
+  : capacity( capacity ),
+    slots( new slot_t[capacity] )
+{
+}
+
+const npn_manager::record_t* npn_manager::find( uint64_t key, uint8_t num_vars ) const
+{
+  const auto h = npn_cache_hash( key, num_vars );
+
+  /* entries loaded from file */
+  if ( file_records )
+  {
+    const auto mask = file_capacity - 1u;
+    for ( auto i = 0u; i < file_capacity; ++i )
+    {
+      const auto& r = file_records[( h + i ) & mask];
+      if ( r.num_vars == empty_record ) { break; }
+      if ( r.tt == key && r.num_vars == num_vars ) { return &r; }
+    }
+  }
+
+  const auto* t = table.load( std::memory_order_acquire );
+  const auto mask = t->capacity - 1u;
+  for ( auto i = 0u; i < t->capacity; ++i )
+  {
+    const auto& slot = t->slots[( h + i ) & mask];
+    const auto state = slot.state.load( std::memory_order_acquire );
+    if ( state == slot_empty ) { break; }
+    if ( state == slot_ready && slot.record.tt == key && slot.record.num_vars == num_vars )
+    {
+      return &slot.record;
+    }
+  }
+
+  return nullptr;
+}
+
+void npn_manager::insert( const record_t& record )
+{
+  auto* t = table.load( std::memory_order_acquire );
+  const auto h = npn_cache_hash( record.tt, record.num_vars );
+  const auto mask = t->capacity - 1u;
+
+  for ( auto i = 0u; i < t->capacity; ++i )
+  {
+    auto& slot = t->slots[( h + i ) & mask];
+    auto state = slot.state.load( std::memory_order_acquire );
+
+    if ( state == slot_ready && slot.record.tt == record.tt && slot.record.num_vars == record.num_vars )
+    {
+      return; /* inserted by another thread */
+    }
+
+    if ( state == slot_empty && slot.state.compare_exchange_strong( state, slot_busy, std::memory_order_acq_rel ) )
+    {
+      slot.record = record;
+      slot.state.store( slot_ready, std::memory_order_release );
+
+      if ( ++count > ( t->capacity >> 1u ) )
+      {
+        grow( t );
+      }
+      return;
+    }
+  }
+}
+
+/* entries that are inserted into the old table while copying are lost, which
+   is fine for a cache; old tables are kept since other threads may read them */
+void npn_manager::grow( table_t* t )
+{
+  std::unique_lock<std::mutex> lock( grow_mutex, std::try_to_lock );
+  if ( !lock.owns_lock() || table.load( std::memory_order_acquire ) != t ) { return; }
+
+  std::unique_ptr<table_t> new_table( new table_t( t->capacity << 1u ) );
+  const auto mask = new_table->capacity - 1u;
+  std::size_t new_count = 0u;
+
+  for ( auto i = 0u; i < t->capacity; ++i )
+  {
+    const auto& slot = t->slots[i];
+    if ( slot.state.load( std::memory_order_acquire ) != slot_ready ) { continue; }
+
+    auto pos = npn_cache_hash( slot.record.tt, slot.record.num_vars ) & mask;
+    while ( new_table->slots[pos].state.load( std::memory_order_relaxed ) != slot_empty )
+    {
+      pos = ( pos + 1u ) & mask;
+    }
+    new_table->slots[pos].record = slot.record;
+    new_table->slots[pos].state.store( slot_ready, std::memory_order_relaxed );
+    ++new_count;
+  }
+
+  count = new_count;
+  table.store( new_table.get(), std::memory_order_release );
+  tables.push_back( std::move( new_table ) );
+}
+
 /******************************************************************************
  * Public functions                                                           *
  ******************************************************************************/
 
 npn_manager::npn_manager( unsigned hash_table_size, const npn_classifier_t& npn_func )
-  : table( hash_table_size ),
-    npn_func( npn_func )
+  : npn_func( npn_func ),
+    enabled( hash_table_size != 0u )
+{
+  tables.emplace_back( new table_t( next_power_of_two( std::max( 16u, hash_table_size ) ) ) );
+  table = tables.back().get();
+}
+
+npn_manager::~npn_manager()
 {
 }
 
 tt npn_manager::compute( const tt& tt, boost::dynamic_bitset<>& phase, std::vector<unsigned>& perm )
 {
-  boost::dynamic_bitset<> npn;
+  const auto num_vars = tt_num_vars( tt );
+  const auto cacheable = enabled && tt.size() <= 64u;
 
   /* compute NPN and use hash table if possible */
-  if ( !table.empty() )
+  if ( cacheable )
   {
-    const auto ttu      = tt.to_ulong();
-    const auto hash_key = ttu % table.size();
-    auto& entry         = table[hash_key];
-
-    if ( entry.tt == to_string( tt ) )
+    if ( const auto* r = find( tt.to_ulong(), num_vars ) )
     {
       ++cache_hit;
-      npn = boost::dynamic_bitset<>( entry.npn );
-      perm = std::vector<unsigned>( entry.perm );
-      phase = boost::dynamic_bitset<>( entry.phase );
-    }
-    else
-    {
-      ++cache_miss;
-      increment_timer t( &runtime );
-      npn = npn_func( tt, phase, perm );
-
-      entry.tt    = to_string( tt );
-      entry.npn   = to_string( npn );
-      entry.perm  = perm;
-      entry.phase = phase;
+      phase.resize( num_vars + 1u );
+      for ( auto i = 0u; i <= num_vars; ++i )
+      {
+        phase[i] = ( r->phase >> i ) & 1u;
+      }
+      perm.resize( num_vars );
+      for ( auto i = 0u; i < num_vars; ++i )
+      {
+        perm[i] = ( r->perm >> ( i << 2u ) ) & 0xf;
+      }
+      return boost::dynamic_bitset<>( 1u << r->npn_vars, r->npn );
     }
   }
-  else
+
+  ++cache_miss;
+  const auto start = std::chrono::steady_clock::now();
+  const auto npn = npn_func( tt, phase, perm );
+  runtime_ns += std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::steady_clock::now() - start ).count();
+
+  if ( cacheable && npn.size() <= 64u && phase.size() == num_vars + 1u && perm.size() == num_vars )
   {
-    increment_timer t( &runtime );
-    npn = npn_func( tt, phase, perm );
+    record_t r;
+    r.tt       = tt.to_ulong();
+    r.npn      = npn.to_ulong();
+    r.perm     = 0u;
+    r.phase    = static_cast<uint8_t>( phase.to_ulong() );
+    r.num_vars = num_vars;
+    r.npn_vars = tt_num_vars( npn );
+    r.reserved = 0u;
+    for ( auto i = 0u; i < num_vars; ++i )
+    {
+      r.perm |= perm[i] << ( i << 2u );
+    }
+    insert( r );
   }
 
   return npn;
@@ -93,7 +251,97 @@ tt npn_manager::compute( const tt& tt, boost::dynamic_bitset<>& phase, std::vect
 
 void npn_manager::print_statistics( std::ostream& os ) const
 {
-  os << boost::format( "[i] NPN manager: size = %d   cache hits = %d   cache misses = %d   run-time = %.2f secs" ) % table.size() % cache_hit % cache_miss % runtime << std::endl;
+  os << boost::format( "[i] NPN manager: size = %d   loaded = %d   cache hits = %d   cache misses = %d   run-time = %.2f secs" )
+    % size() % file_count % cache_hit.load() % cache_miss.load() % ( runtime_ns.load() / 1.0e9 ) << std::endl;
+}
+
+bool npn_manager::load( const std::string& filename )
+{
+  mapped_file f( filename );
+  if ( !f.is_open() || f.size() < sizeof( file_header_t ) ) { return false; }
+
+  file_header_t header;
+  std::memcpy( &header, f.data(), sizeof( header ) );
+
+  if ( std::memcmp( header.magic, file_magic, sizeof( file_magic ) ) != 0 ||
+       header.version != file_version || header.record_size != sizeof( record_t ) ||
+       header.capacity == 0u || ( header.capacity & ( header.capacity - 1u ) ) != 0u ||
+       f.size() != sizeof( header ) + header.capacity * sizeof( record_t ) )
+  {
+    return false;
+  }
+
+  file = std::move( f );
+  file_records  = reinterpret_cast<const record_t*>( file.data() + sizeof( header ) );
+  file_capacity = header.capacity;
+  file_count    = header.count;
+  return true;
+}
+
+bool npn_manager::save( const std::string& filename ) const
+{
+  /* collect entries from the file and from the current table */
+  std::vector<record_t> records;
+  for ( auto i = 0u; i < file_capacity; ++i )
+  {
+    if ( file_records[i].num_vars != empty_record )
+    {
+      records.push_back( file_records[i] );
+    }
+  }
+  const auto* t = table.load( std::memory_order_acquire );
+  for ( auto i = 0u; i < t->capacity; ++i )
+  {
+    if ( t->slots[i].state.load( std::memory_order_acquire ) == slot_ready )
+    {
+      records.push_back( t->slots[i].record );
+    }
+  }
+
+  /* lay out as hash table with load factor at most 0.5 */
+  const auto capacity = next_power_of_two( std::max<std::size_t>( 16u, records.size() << 1u ) );
+  const auto mask = capacity - 1u;
+
+  record_t empty;
+  std::memset( &empty, 0, sizeof( empty ) );
+  empty.num_vars = empty_record;
+  std::vector<record_t> layout( capacity, empty );
+
+  std::size_t count = 0u;
+  for ( const auto& r : records )
+  {
+    auto pos = npn_cache_hash( r.tt, r.num_vars ) & mask;
+    while ( layout[pos].num_vars != empty_record && !( layout[pos].tt == r.tt && layout[pos].num_vars == r.num_vars ) )
+    {
+      pos = ( pos + 1u ) & mask;
+    }
+    if ( layout[pos].num_vars == empty_record ) { ++count; }
+    layout[pos] = r;
+  }
+
+  file_header_t header;
+  std::memcpy( header.magic, file_magic, sizeof( file_magic ) );
+  header.version     = file_version;
+  header.record_size = sizeof( record_t );
+  header.capacity    = capacity;
+  header.count       = count;
+
+  /* write to a temporary file first, the old file may be mapped */
+  const auto tmp = filename + ".tmp";
+  {
+    std::ofstream os( tmp.c_str(), std::ofstream::out | std::ofstream::binary );
+    if ( !os ) { return false; }
+    os.write( reinterpret_cast<const char*>( &header ), sizeof( header ) );
+    os.write( reinterpret_cast<const char*>( layout.data() ), layout.size() * sizeof( record_t ) );
+    if ( !os ) { return false; }
+  }
+
+  return std::rename( tmp.c_str(), filename.c_str() ) == 0;
+}
+
+std::size_t npn_manager::size() const
+{
+  return file_count + count.load();
 }
 
 }
@@ -29,6 +29,12 @@
  *
  * @brief NPN manager
  *
+ * Caches NPN classification results for truth tables with up to 6
+ * variables.  The cache is keyed on the packed truth table word, can be
+ * shared by several threads (lookups and insertions are lock-free, only
+ * growing the table takes a lock), and can be saved to a file which is
+ * memory mapped when it is loaded again.
+ *
  * @author Mathias Soeken
  * @since  2.3
  */
@@ -36,12 +42,18 @@
 #ifndef NPN_MANAGER_HPP
 #define NPN_MANAGER_HPP
 
+#include <atomic>
+#include <cstdint>
 #include <functional>
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
 #include <vector>
 
 #include <boost/dynamic_bitset.hpp>
 
+#include <core/utils/mapped_file.hpp>
 #include <classical/functions/npn_canonization.hpp>
 #include <classical/utils/truth_table_utils.hpp>
 
@@ -60,33 +72,78 @@ class npn_manager
 public:
   using npn_classifier_t = std::function<tt(const tt&, boost::dynamic_bitset<>&, std::vector<unsigned>&)>;
 
+  /* hash_table_size is the initial capacity, the table grows on demand; 0 disables the cache */
   npn_manager( unsigned hash_table_size = 4096, const npn_classifier_t& npn_func = make_exact_npn_canonization_wrapper() );
+  ~npn_manager();
+
+  npn_manager( const npn_manager& ) = delete;
+  npn_manager& operator=( const npn_manager& ) = delete;
 
+  /* thread-safe if npn_func is */
   tt compute( const tt& tt, boost::dynamic_bitset<>& phase, std::vector<unsigned>& perm );
   void print_statistics( std::ostream& os = std::cout ) const;
 
+  /* entries from a file are looked up in the memory mapped file, returns false
+     if the file does not exist or is not a valid cache file */
+  bool load( const std::string& filename );
+
+  /* writes all entries, including the loaded ones */
+  bool save( const std::string& filename ) const;
+
+  std::size_t size() const;
+
+public:
+  /* layout of entries in memory and in files */
+  struct record_t
+  {
+    uint64_t tt;
+    uint64_t npn;
+    uint32_t perm;       /* 4 bits per variable */
+    uint8_t  phase;      /* bit num_vars is output phase */
+    uint8_t  num_vars;   /* empty_record for empty entries in files */
+    uint8_t  npn_vars;
+    uint8_t  reserved;
+  };
+
+  static constexpr uint8_t empty_record = 0xff;
+
 private:
-  struct table_entry_t
+  struct slot_t
   {
-    table_entry_t() {}
-    table_entry_t( const std::string& tt, const std::string& npn, const std::vector<unsigned>& perm, const boost::dynamic_bitset<>& phase )
-      : tt( tt ), npn( npn ), perm( perm ), phase( phase ) {}
-
-    std::string             tt;
-    std::string             npn;
-    std::vector<unsigned>   perm;
-    boost::dynamic_bitset<> phase;
+    std::atomic<uint32_t> state{ 0u };
+    record_t              record;
   };
 
-  using table_t = std::vector<table_entry_t>;
+  struct table_t
+  {
+    explicit table_t( std::size_t capacity );
 
-  table_t          table;
+    std::size_t               capacity;
+    std::unique_ptr<slot_t[]> slots;
+  };
 
-  npn_classifier_t npn_func;
+  const record_t* find( uint64_t key, uint8_t num_vars ) const;
+  void insert( const record_t& record );
+  void grow( table_t* table );
 
-  double           runtime    = 0.0;
-  unsigned long    cache_hit  = 0;
-  unsigned long    cache_miss = 0;
+private:
+  npn_classifier_t                      npn_func;
+  bool                                  enabled;
+
+  std::atomic<table_t*>                 table{ nullptr };
+  std::vector<std::unique_ptr<table_t>> tables; /* old tables may still be read */
+  std::atomic<std::size_t>              count{ 0u };
+  std::mutex                            grow_mutex;
+
+  /* loaded entries */
+  mapped_file                           file;
+  const record_t*                       file_records = nullptr;
+  std::size_t                           file_capacity = 0u;
+  std::size_t                           file_count = 0u;
+
+  std::atomic<uint64_t>                 runtime_ns{ 0u };
+  std::atomic<unsigned long>            cache_hit{ 0u };
+  std::atomic<unsigned long>            cache_miss{ 0u };
 };
 
 }
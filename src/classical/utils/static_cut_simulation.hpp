@@ -0,0 +1,157 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * @file static_cut_simulation.hpp
+ *
+ * @brief Simulates cut functions with kitty's static truth tables
+ *
+ * Works for all graph types in which edges have the edge_complement
+ * property and nodes without fanin are inputs or the constant (AIG, MIG,
+ * XMG).  Scratch memory is kept per thread, so that no memory is allocated
+ * once it has grown to the size of the largest cone.  Values are looked up
+ * through a per-thread table indexed by node, which costs two words per node
+ * of the largest graph but keeps simulating a cone linear in its size.
+ *
+ * @author Mathias Soeken
+ * @since  2.3
+ */
+
+#ifndef STATIC_CUT_SIMULATION_HPP
+#define STATIC_CUT_SIMULATION_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <utility>
+#include <vector>
+
+#include <boost/graph/graph_traits.hpp>
+#include <boost/range/iterator_range.hpp>
+
+#include <kitty/kitty.hpp>
+
+#include <core/utils/graph_utils.hpp>
+
+namespace cirkit
+{
+
+/* leaves in [first, last) are assigned to x_0, x_1, ...; other nodes without
+ * fanin are constant 0; gate( values, count ) computes the function of a node
+ * from the complemented values of its fanins */
+template<int NumVars, typename Graph, typename LeafIt, typename GateFn>
+kitty::static_truth_table<NumVars> simulate_cut_static( const Graph& g,
+                                                        typename boost::graph_traits<Graph>::vertex_descriptor root,
+                                                        LeafIt first, LeafIt last, GateFn&& gate )
+{
+  using node_t  = typename boost::graph_traits<Graph>::vertex_descriptor;
+  using value_t = kitty::static_truth_table<NumVars>;
+
+  /* slots[n] = ( call, position in values ); entries from earlier calls are stale */
+  thread_local std::vector<std::pair<unsigned, unsigned>> slots;
+  thread_local std::vector<value_t>                       values;
+  thread_local std::vector<node_t>                        stack;
+  thread_local unsigned                                   call = 0u;
+
+  if ( slots.size() < boost::num_vertices( g ) )
+  {
+    slots.resize( boost::num_vertices( g ), {0u, 0u} );
+  }
+  if ( ++call == 0u )
+  {
+    std::fill( slots.begin(), slots.end(), std::make_pair( 0u, 0u ) );
+    call = 1u;
+  }
+  values.clear();
+  stack.clear();
+
+  const auto assign = [&]( node_t n, const value_t& v ) {
+    slots[n] = {call, static_cast<unsigned>( values.size() )};
+    values.push_back( v );
+  };
+
+  const auto find = [&]( node_t n ) -> const value_t* {
+    return slots[n].first == call ? &values[slots[n].second] : nullptr;
+  };
+
+  auto i = 0u;
+  for ( ; first != last; ++first )
+  {
+    value_t var;
+    kitty::create_nth_var( var, i++ );
+    assign( *first, var );
+  }
+
+  const auto complement = boost::get( boost::edge_complement, g );
+
+  stack.push_back( root );
+  while ( !stack.empty() )
+  {
+    const auto n = stack.back();
+    if ( find( n ) ) { stack.pop_back(); continue; }
+
+    if ( boost::out_degree( n, g ) == 0u )
+    {
+      assign( n, value_t() );
+      stack.pop_back();
+      continue;
+    }
+
+    auto ready = true;
+    for ( const auto& e : boost::make_iterator_range( boost::out_edges( n, g ) ) )
+    {
+      if ( !find( boost::target( e, g ) ) )
+      {
+        stack.push_back( boost::target( e, g ) );
+        ready = false;
+      }
+    }
+    if ( !ready ) { continue; }
+
+    value_t fanins[3];
+    auto count = 0u;
+    for ( const auto& e : boost::make_iterator_range( boost::out_edges( n, g ) ) )
+    {
+      assert( count < 3u );
+      const auto& v = *find( boost::target( e, g ) );
+      fanins[count++] = complement[e] ? ~v : v;
+    }
+
+    assign( n, gate( fanins, count ) );
+    stack.pop_back();
+  }
+
+  return *find( root );
+}
+
+}
+
+#endif
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
@@ -36,6 +36,8 @@
 #ifndef TRUTH_TABLE_UTILS_HPP
 #define TRUTH_TABLE_UTILS_HPP
 
+#include <algorithm>
+
 #include <boost/dynamic_bitset.hpp>
 
 #include <core/utils/bitset_utils.hpp>
@@ -322,6 +324,26 @@ tt from_kitty( const TT& f )
   return res;
 }
 
+/* the first 2^num_vars bits of f, e.g., for a cut with fewer leaves than variables in f */
+template<typename TT>
+tt from_kitty( const TT& f, unsigned num_vars )
+{
+  auto res = from_kitty( f );
+  tt_shrink( res, num_vars );
+  return res;
+}
+
+/* tt must have at most NumVars variables */
+template<int NumVars>
+kitty::static_truth_table<NumVars> to_kitty_static( tt t )
+{
+  kitty::static_truth_table<NumVars> f;
+  tt_extend( t, std::max( NumVars, 6 ) );
+  boost::to_block_range( t, f.begin() );
+  f.mask_bits();
+  return f;
+}
+
 }
 
 #endif
@@ -463,14 +463,7 @@ boost::dynamic_bitset<> unateness_split_parallel( const aig_graph& aig,
     result_mutex.unlock();
   };
 
-  {
-    thread_pool pool;
-
-    for ( auto j = 0u; j < m; ++j )
-    {
-      pool.enqueue( thread, j );
-    }
-  }
+  shared_thread_pool().parallel_for( 0u, m, 1u, thread );
 
   return result;
 }
@@ -497,14 +490,7 @@ boost::dynamic_bitset<> unateness_split_inputs_parallel( const aig_graph& aig,
     result_mutex.unlock();
   };
 
-  {
-    thread_pool pool;
-
-    for ( auto i = 0u; i < n; ++i )
-    {
-      pool.enqueue( thread, i );
-    }
-  }
+  shared_thread_pool().parallel_for( 0u, n, 1u, thread );
 
   return result;
 }
@@ -126,12 +126,14 @@ xmg_function xmg_graph::create_maj( const xmg_function& a, const xmg_function& b
     children[2].complemented = !children[2].complemented;
   }
 
-  auto key = std::make_tuple( children[0], children[1], children[2] );
+  const strash_table<3u>::key_t key = {{strash_literal( children[0] ), strash_literal( children[1] ), strash_literal( children[2] )}};
 
-  const auto it = maj_strash.find( key );
-  if ( _enable_structural_hashing && it != maj_strash.end() )
+  if ( _enable_structural_hashing )
   {
-    return xmg_function( it->second, node_complement );
+    if ( const auto* n = maj_strash.find( key ) )
+    {
+      return xmg_function( *n, node_complement );
+    }
   }
 
   /* insert node */
@@ -148,7 +150,7 @@ xmg_function xmg_graph::create_maj( const xmg_function& a, const xmg_function& b
 
   mark_as_modified();
 
-  maj_strash[key] = node;
+  maj_strash.insert( key, node );
   return xmg_function( node, node_complement );
 }
 
@@ -174,10 +176,14 @@ xmg_function xmg_graph::create_xor( const xmg_function& a, const xmg_function& b
       key.first.complemented = key.second.complemented = false;
     }
 
-    const auto it = xor_strash.find( key );
-    if ( _enable_structural_hashing && it != xor_strash.end() )
+    const strash_table<2u>::key_t xor_key = {{strash_literal( key.first ), strash_literal( key.second )}};
+
+    if ( _enable_structural_hashing )
     {
-      return xmg_function( it->second, node_complement );
+      if ( const auto* n = xor_strash.find( xor_key ) )
+      {
+        return xmg_function( *n, node_complement );
+      }
     }
 
     /* insert node */
@@ -192,7 +198,7 @@ xmg_function xmg_graph::create_xor( const xmg_function& a, const xmg_function& b
 
     mark_as_modified();
 
-    xor_strash[key] = node;
+    xor_strash.insert( xor_key, node );
     return xmg_function( node, node_complement );
   }
   else
@@ -48,6 +48,7 @@
 #include <core/utils/dirty.hpp>
 #include <core/utils/graph_utils.hpp>
 #include <core/utils/hash_utils.hpp>
+#include <core/utils/strash_table.hpp>
 
 namespace cirkit
 {
@@ -196,10 +197,8 @@ private:
   output_vec_t _outputs;
   std::unordered_map<xmg_node, unsigned> _input_to_id;
 
-  using maj_strash_key_t = std::tuple<xmg_function, xmg_function, xmg_function>;
-  using xor_strash_key_t = std::pair<xmg_function, xmg_function>;
-  std::unordered_map<maj_strash_key_t, node_t, hash<maj_strash_key_t>> maj_strash;
-  std::unordered_map<xor_strash_key_t, node_t, hash<xor_strash_key_t>> xor_strash;
+  strash_table<3u> maj_strash;
+  strash_table<2u> xor_strash;
 
   complement_property_map_t               _complement;
 
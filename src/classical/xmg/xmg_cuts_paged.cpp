@@ -174,6 +174,11 @@ boost::iterator_range<paged_memory::iterator> xmg_cuts_paged::cut_cones( xmg_nod
 
 tt xmg_cuts_paged::simulate( xmg_node node, const xmg_cuts_paged::cut& c ) const
 {
+  if ( c.size() <= 6u )
+  {
+    return from_kitty( simulate_static<6>( node, c ), c.size() );
+  }
+
   std::vector<xmg_node> leafs;
   for ( auto child : c )
   {
@@ -182,6 +187,18 @@ tt xmg_cuts_paged::simulate( xmg_node node, const xmg_cuts_paged::cut& c ) const
   return xmg_simulate_cut( _xmg, node, leafs );
 }
 
+template<int NumVars>
+kitty::static_truth_table<NumVars> xmg_cuts_paged::simulate_static( xmg_node node, const xmg_cuts_paged::cut& c ) const
+{
+  assert( c.size() <= static_cast<unsigned>( NumVars ) );
+  return xmg_simulate_cut_static<NumVars>( _xmg, node, c.begin(), c.end() );
+}
+
+template kitty::static_truth_table<4> xmg_cuts_paged::simulate_static<4>( xmg_node, const xmg_cuts_paged::cut& ) const;
+template kitty::static_truth_table<6> xmg_cuts_paged::simulate_static<6>( xmg_node, const xmg_cuts_paged::cut& ) const;
+template kitty::static_truth_table<8> xmg_cuts_paged::simulate_static<8>( xmg_node, const xmg_cuts_paged::cut& ) const;
+template kitty::static_truth_table<16> xmg_cuts_paged::simulate_static<16>( xmg_node, const xmg_cuts_paged::cut& ) const;
+
 unsigned xmg_cuts_paged::depth( xmg_node node, const xmg_cuts_paged::cut& c ) const
 {
   return c.extra( 0u );
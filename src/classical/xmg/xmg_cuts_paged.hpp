@@ -79,6 +79,10 @@ public:
   boost::iterator_range<paged_memory::iterator> cut_cones( xmg_node node );
 
   tt simulate( xmg_node node, const cut& c ) const;
+
+  /* does not allocate memory, c must not have more than NumVars leafs */
+  template<int NumVars>
+  kitty::static_truth_table<NumVars> simulate_static( xmg_node node, const cut& c ) const;
   unsigned depth( xmg_node node, const cut& c ) const;
   unsigned size( xmg_node node, const cut& c ) const;
 
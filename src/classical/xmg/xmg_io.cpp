@@ -26,7 +26,6 @@
 
 #include "xmg_io.hpp"
 
-#include <sys/stat.h>
 #include <fstream>
 #include <unordered_map>
 
@@ -34,6 +33,7 @@
 #include <boost/format.hpp>
 
 #include <core/utils/string_utils.hpp>
+#include <core/utils/tokenizer.hpp>
 #include <classical/xmg/xmg_xor_blocks.hpp>
 
 using boost::format;
@@ -314,18 +314,6 @@ void write_smtlib2( const xmg_graph& xmg, std::ostream& os, const properties::pt
   os << "(check-sat)" << std::endl;
 }
 
-xmg_function find_function( const std::unordered_map<std::string, xmg_function>& name_to_function, const std::string& name )
-{
-  if ( name[0] == '~' )
-  {
-    return !name_to_function.at( name.substr( 1u ) );
-  }
-  else
-  {
-    return name_to_function.at( name );
-  }
-}
-
 std::string make_regular( const std::string& name )
 {
   if ( !name.empty() && name[0] == '~' )
@@ -344,152 +332,240 @@ std::string make_regular( const std::string& name )
 
 xmg_graph read_verilog( const std::string& filename, bool native_xor, bool enable_structural_hashing, bool enable_inverter_propagation )
 {
-  {
-    /* check if file exists */
-    struct stat buffer;
-    if ( stat(filename.c_str(), &buffer) != 0 )
-    {
-      std::cout << (boost::format("[w] file '%s' does not exists\n") % filename);
-    }
-  }
-
-  std::unordered_map<std::string, xmg_function> name_to_function;
-  std::vector<std::string> output_names;
-
   xmg_graph xmg;
   xmg.set_native_xor( native_xor );
   xmg.set_structural_hashing( enable_structural_hashing );
   xmg.set_inverter_propagation( enable_inverter_propagation );
 
-  name_to_function.insert( {"1'b0", xmg.get_constant( false )} );
-  name_to_function.insert( {"1'b1", xmg.get_constant( true )} );
+  tokenizer::options opts;
+  opts.punctuation         = "(),;=&|^~";
+  opts.slash_comments      = true;
+  opts.escaped_identifiers = true;
+
+  tokenizer tok( filename, opts );
+  if ( !tok.is_open() )
+  {
+    std::cout << (boost::format("[w] file '%s' does not exists\n") % filename);
+    return xmg;
+  }
 
-  /* to store the instructions */
+  /* to store the instructions, operands are symbol ids with complement flag */
   struct inst_t
   {
     enum op_t { OP_AND, OP_OR, OP_XOR, OP_MAJ, OP_CONST, OP_BUF };
 
-    std::string target;
-    std::array<std::string, 3> operands;
+    unsigned target;
+    std::array<std::pair<unsigned, bool>, 3> operands;
     op_t opcode;
+    unsigned line;
   };
-  digraph_t<inst_t> instructions;
-  std::unordered_map<std::string, unsigned> name_to_vertex;
-
-  std::regex re_and( "^( *[^ ]+ *) & ( *[^ ]+ *)$" );
-  std::regex re_or( "^( *[^ ]+ *) \\| ( *[^ ]+ *)$" );
-  std::regex re_xor( "^( *[^ ]+ *) \\^ ( *[^ ]+ *)$" );
-  std::regex re_maj( "^\\( *([^ ]+) & ([^ ]+) *\\) \\| \\( *([^ ]+) & ([^ ]+) *\\) \\| \\( *([^ ]+) & ([^ ]+) *\\)$" );
-
-  const auto add_instruction = [&instructions, &name_to_vertex]( const std::string& name, const inst_t& inst ) {
-    const auto v = add_vertex( instructions );
-    instructions[v] = inst;
-    name_to_vertex.insert( {name, v} );
+
+  symbol_table symbols;
+  std::vector<xmg_function> fs;
+  std::vector<unsigned> definition; /* instruction index of a symbol or none */
+  std::vector<bool> is_input;       /* primary inputs and constants */
+  std::vector<inst_t> instructions;
+  std::vector<unsigned> output_names;
+
+  constexpr auto none = symbol_table::npos;
+  const auto id = [&]( token_t name ) {
+    const auto id = symbols.intern( name );
+    if ( id >= fs.size() )
+    {
+      fs.resize( id + 1u );
+      definition.resize( id + 1u, none );
+      is_input.resize( id + 1u, false );
+    }
+    return id;
   };
 
-  line_parser( filename, {
-      {std::regex( "assign (.*) = (.*);" ), [&output_names, &instructions, &name_to_vertex, &re_and, &re_or, &re_xor, &re_maj, &add_instruction]( const std::smatch& m ) {
-          auto name = std::string( m[1] );
-          auto expr = std::string( m[2] );
+  const auto define_input = [&]( token_t name, const xmg_function& f ) {
+    const auto i = id( name );
+    fs[i] = f;
+    is_input[i] = true;
+  };
 
-          boost::trim( name );
-          boost::trim( expr );
+  define_input( "1'b0", xmg.get_constant( false ) );
+  define_input( "1'b1", xmg.get_constant( true ) );
 
-          std::smatch match;
+  std::vector<token_t> tokens;
+  std::vector<std::pair<unsigned, bool>> operands;
+  std::string ops;
 
-          if ( std::regex_search( expr, match, re_and ) )
-          {
-            add_instruction( name, {name, {{std::string( match[1] ), std::string( match[2] )}}, inst_t::OP_AND} );
-          }
-          else if ( std::regex_search( expr, match, re_or ) )
-          {
-            add_instruction( name, {name, {{std::string( match[1] ), std::string( match[2] )}}, inst_t::OP_OR} );
-          }
-          else if ( std::regex_search( expr, match, re_xor ) )
-          {
-            add_instruction( name, {name, {{std::string( match[1] ), std::string( match[2] )}}, inst_t::OP_XOR} );
-          }
-          else if ( std::regex_search( expr, match, re_maj ) )
-          {
-            add_instruction( name, {name, {{std::string( match[1] ), std::string( match[2] ), std::string( match[4] )}}, inst_t::OP_MAJ} );
-          }
-          else if ( expr == "0" )
-          {
-            add_instruction( name, {name, {{std::string( "0" )}}, inst_t::OP_CONST} );
-          }
-          else if ( expr == "1" )
-          {
-            add_instruction( name, {name, {{std::string( "1" )}}, inst_t::OP_CONST} );
-          }
-          else
-          {
-            if ( boost::find( output_names, name ) == output_names.end() )
-            {
-              std::cout << "[e] expected " << name << " not be part of output_names" << std::endl;
-              std::cout << "[e] in line: " << m[0] << std::endl;
-              assert( false );
-            }
-            add_instruction( name, {name, {{expr}}, inst_t::OP_BUF} );
-          }
-        }},
-      {std::regex( "^module +(.*) +\\(" ), [&xmg]( const std::smatch& m ) {
-          xmg.set_name( std::string( m[1] ) );
-        }},
-      {std::regex( "input (.*);" ), [&xmg, &name_to_function]( const std::smatch& m ) {
-          foreach_string( m[1], ", ", [&xmg, &name_to_function]( const std::string& name ) {
-              name_to_function.insert( {name, xmg.create_pi( unescape_name( name ) )} );
-            } );
-        }},
-      {std::regex( "output (.*);" ), [&output_names]( const std::smatch& m ) {
-          split_string( output_names, m[1], ", " );
-        }}}, false );
-
-  for ( const auto v : boost::make_iterator_range( vertices( instructions ) ) )
+  token_t token;
+  tokenizer::token_kind kind;
+  while ( ( kind = tok.next( token ) ) != tokenizer::token_kind::end )
   {
-    const auto& inst = instructions[v];
-    const auto s = name_to_vertex[inst.target];
-    for ( auto t : inst.operands )
+    if ( kind != tokenizer::token_kind::identifier ) { continue; }
+
+    if ( token == "module" )
+    {
+      if ( tok.next( token ) == tokenizer::token_kind::identifier )
+      {
+        xmg.set_name( token.to_string() );
+      }
+      tok.next_until( ';', tokens );
+    }
+    else if ( token == "input" )
+    {
+      tok.next_until( ';', tokens );
+      for ( const auto& name : tokens )
+      {
+        if ( name == "," ) { continue; }
+        define_input( name, xmg.create_pi( unescape_name( name.to_string() ) ) );
+      }
+    }
+    else if ( token == "output" )
     {
-      const auto it = name_to_vertex.find( make_regular( t ) );
-      if ( it != name_to_vertex.end() )
+      tok.next_until( ';', tokens );
+      for ( const auto& name : tokens )
       {
-        add_edge( s, it->second, instructions );
+        if ( name == "," ) { continue; }
+        output_names.push_back( id( name ) );
       }
     }
+    else if ( token == "assign" )
+    {
+      const auto line = tok.token_line();
+      tok.next_until( ';', tokens );
+      if ( tokens.size() < 3u || tokens[1u] != "=" )
+      {
+        std::cout << "[e] cannot parse assignment in line " << line << std::endl;
+        assert( false );
+        continue;
+      }
+
+      /* flatten expression into operands and operators, parentheses only appear in MAJ */
+      operands.clear();
+      ops.clear();
+      auto complemented = false;
+      for ( auto i = 2u; i < tokens.size(); ++i )
+      {
+        const auto& t = tokens[i];
+        if ( t == "~" )                                { complemented = !complemented; }
+        else if ( t == "&" || t == "|" || t == "^" )   { ops += t[0]; }
+        else if ( t == "(" || t == ")" )               { /* skip */ }
+        else
+        {
+          operands.push_back( {id( t ), complemented} );
+          complemented = false;
+        }
+      }
+
+      const auto target = id( tokens[0u] );
+      inst_t inst{target, {}, inst_t::OP_BUF, line};
+
+      if ( operands.size() == 2u && ops.size() == 1u )
+      {
+        inst.opcode = ops[0u] == '&' ? inst_t::OP_AND : ( ops[0u] == '|' ? inst_t::OP_OR : inst_t::OP_XOR );
+        inst.operands = {{operands[0u], operands[1u], {none, false}}};
+      }
+      else if ( operands.size() == 6u && ops == "&|&|&" )
+      {
+        inst.opcode = inst_t::OP_MAJ;
+        inst.operands = {{operands[0u], operands[1u], operands[3u]}};
+      }
+      else if ( operands.size() == 1u && ops.empty() && ( tokens[2u] == "0" || tokens[2u] == "1" ) )
+      {
+        inst.opcode = inst_t::OP_CONST;
+        inst.operands[0u] = {none, tokens[2u] == "1"};
+      }
+      else if ( operands.size() == 1u && ops.empty() )
+      {
+        if ( boost::find( output_names, target ) == output_names.end() )
+        {
+          std::cout << "[e] expected " << symbols.name( target ) << " not be part of output_names" << std::endl;
+          std::cout << "[e] in line: " << line << std::endl;
+          assert( false );
+        }
+        inst.operands[0u] = operands[0u];
+      }
+      else
+      {
+        std::cout << "[e] unsupported expression for " << symbols.name( target ) << " in line " << line << std::endl;
+        assert( false );
+        continue;
+      }
+
+      definition[target] = instructions.size();
+      instructions.push_back( inst );
+    }
+    else if ( token != "endmodule" )
+    {
+      tok.next_until( ';', tokens );
+    }
   }
 
-  std::vector<unsigned> top( num_vertices( instructions ) );
-  boost::topological_sort( instructions, top.begin() );
+  /* assignments may appear in any order, create them depth-first from their operands */
+  std::vector<unsigned char> state( instructions.size(), 0u ); /* 0: new, 1: on stack, 2: done */
+  std::vector<unsigned> stack;
 
-  for ( const auto v : top )
+  const auto operand = [&fs]( const std::pair<unsigned, bool>& op ) { return fs[op.first] ^ op.second; };
+
+  for ( auto root = 0u; root < instructions.size(); ++root )
   {
-    const auto& inst = instructions[v];
-    switch ( inst.opcode )
+    if ( state[root] ) { continue; }
+    stack.push_back( root );
+
+    while ( !stack.empty() )
     {
-    case inst_t::OP_AND:
-      name_to_function.insert( {inst.target, xmg.create_and( find_function( name_to_function, inst.operands[0] ), find_function( name_to_function, inst.operands[1] ) )} );
-      break;
-    case inst_t::OP_OR:
-      name_to_function.insert( {inst.target, xmg.create_or( find_function( name_to_function, inst.operands[0] ), find_function( name_to_function, inst.operands[1] ) )} );
-      break;
-    case inst_t::OP_XOR:
-      name_to_function.insert( {inst.target, xmg.create_xor( find_function( name_to_function, inst.operands[0] ), find_function( name_to_function, inst.operands[1] ) )} );
-      break;
-    case inst_t::OP_MAJ:
-      name_to_function.insert( {inst.target, xmg.create_maj( find_function( name_to_function, inst.operands[0] ), find_function( name_to_function, inst.operands[1] ), find_function( name_to_function, inst.operands[2] ) )} );
-      break;
-    case inst_t::OP_CONST:
-      name_to_function.insert( {inst.target, xmg.get_constant( inst.operands[0] == "0" ? false : true )} );
-      break;
-    case inst_t::OP_BUF:
-      name_to_function.insert( {inst.target, find_function( name_to_function, inst.operands[0] )} );
-      break;
+      const auto index = stack.back();
+      const auto& inst = instructions[index];
+
+      if ( state[index] == 0u )
+      {
+        state[index] = 1u;
+        for ( const auto& op : inst.operands )
+        {
+          if ( op.first == none ) { continue; }
+          const auto def = definition[op.first];
+          if ( def == none && !is_input[op.first] )
+          {
+            throw boost::str( boost::format( "undefined signal '%s' in line %d" ) % symbols.name( op.first ) % inst.line );
+          }
+          if ( def != none && state[def] == 0u )
+          {
+            stack.push_back( def );
+          }
+        }
+        continue;
+      }
+
+      stack.pop_back();
+      if ( state[index] == 2u ) { continue; }
+      state[index] = 2u;
+
+      switch ( inst.opcode )
+      {
+      case inst_t::OP_AND:
+        fs[inst.target] = xmg.create_and( operand( inst.operands[0] ), operand( inst.operands[1] ) );
+        break;
+      case inst_t::OP_OR:
+        fs[inst.target] = xmg.create_or( operand( inst.operands[0] ), operand( inst.operands[1] ) );
+        break;
+      case inst_t::OP_XOR:
+        fs[inst.target] = xmg.create_xor( operand( inst.operands[0] ), operand( inst.operands[1] ) );
+        break;
+      case inst_t::OP_MAJ:
+        fs[inst.target] = xmg.create_maj( operand( inst.operands[0] ), operand( inst.operands[1] ), operand( inst.operands[2] ) );
+        break;
+      case inst_t::OP_CONST:
+        fs[inst.target] = xmg.get_constant( inst.operands[0].second );
+        break;
+      case inst_t::OP_BUF:
+        fs[inst.target] = operand( inst.operands[0] );
+        break;
+      }
     }
   }
 
   for ( const auto& name : output_names )
   {
-    xmg.create_po( name_to_function[name], unescape_name( name ) );
+    if ( definition[name] == none && !is_input[name] )
+    {
+      throw boost::str( boost::format( "undefined output '%s'" ) % symbols.name( name ) );
+    }
+    xmg.create_po( fs[name], unescape_name( symbols.str( name ) ) );
   }
 
   return xmg;
@@ -151,6 +151,13 @@ boost::dynamic_bitset<> xmg_simulate_pattern( const xmg_graph& xmg, const boost:
   return opattern;
 }
 
+tt xmg_simulate_output( const xmg_graph& xmg, unsigned num_vars, unsigned index )
+{
+  auto t = simulate_xmg_function( xmg, xmg.outputs().at( index ).first, xmg_tt_simulator() );
+  tt_num_vars( t ) < num_vars ? tt_extend( t, num_vars ) : tt_shrink( t, num_vars );
+  return t;
+}
+
 
 }
 
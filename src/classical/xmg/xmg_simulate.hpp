@@ -325,6 +325,9 @@ std::map<xmg_function, T> simulate_xmg( const xmg_graph& xmg, const xmg_simulato
 
 boost::dynamic_bitset<> xmg_simulate_pattern( const xmg_graph& xmg, const boost::dynamic_bitset<>& pattern );
 
+/* truth table of an output over num_vars variables, also if the XMG has fewer inputs */
+tt xmg_simulate_output( const xmg_graph& xmg, unsigned num_vars, unsigned index = 0u );
+
 }
 
 #endif
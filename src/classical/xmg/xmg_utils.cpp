@@ -177,6 +177,19 @@ std::deque<xmg_node> xmg_output_deque( const xmg_graph& xmg )
 
 tt xmg_simulate_cut( const xmg_graph& xmg, xmg_node root, const std::vector<xmg_node>& leafs )
 {
+  if ( leafs.size() <= 6u )
+  {
+    return from_kitty( xmg_simulate_cut_static<6>( xmg, root, leafs.begin(), leafs.end() ), leafs.size() );
+  }
+  else if ( leafs.size() <= 8u )
+  {
+    return from_kitty( xmg_simulate_cut_static<8>( xmg, root, leafs.begin(), leafs.end() ), leafs.size() );
+  }
+  else if ( leafs.size() <= 16u )
+  {
+    return from_kitty( xmg_simulate_cut_static<16>( xmg, root, leafs.begin(), leafs.end() ), leafs.size() );
+  }
+
   std::map<xmg_node, tt> inputs;
   auto i = 0u;
   for ( auto child : leafs )
@@ -187,14 +200,7 @@ tt xmg_simulate_cut( const xmg_graph& xmg, xmg_node root, const std::vector<xmg_
   xmg_tt_simulator tt_sim;
   xmg_partial_node_assignment_simulator<tt> sim( tt_sim, inputs, tt_const0() );
 
-  auto tt = simulate_xmg_node( xmg, root, sim );
-
-  if ( leafs.size() < 6u )
-  {
-    tt_shrink( tt, leafs.size() );
-  }
-
-  return tt;
+  return simulate_xmg_node( xmg, root, sim );
 }
 
 boost::dynamic_bitset<> xmg_output_mask( const xmg_graph& xmg )
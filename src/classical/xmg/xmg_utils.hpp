@@ -43,6 +43,7 @@
 
 #include <boost/dynamic_bitset.hpp>
 
+#include <classical/utils/static_cut_simulation.hpp>
 #include <classical/utils/truth_table_utils.hpp>
 #include <classical/xmg/xmg.hpp>
 
@@ -65,6 +66,15 @@ std::deque<xmg_node> xmg_output_deque( const xmg_graph& xmg );
 
 tt xmg_simulate_cut( const xmg_graph& xmg, xmg_node root, const std::vector<xmg_node>& leafs );
 
+/* does not allocate memory, leafs must not contain more than NumVars nodes */
+template<int NumVars, typename LeafIt>
+kitty::static_truth_table<NumVars> xmg_simulate_cut_static( const xmg_graph& xmg, xmg_node root, LeafIt first, LeafIt last )
+{
+  return simulate_cut_static<NumVars>( xmg.graph(), root, first, last, []( const kitty::static_truth_table<NumVars>* v, unsigned count ) {
+      return count == 2u ? v[0] ^ v[1] : kitty::ternary_majority( v[0], v[1], v[2] );
+    } );
+}
+
 boost::dynamic_bitset<> xmg_output_mask( const xmg_graph& xmg );
 
 /* returns the edge in between parent and child and fails if no such edge exists */
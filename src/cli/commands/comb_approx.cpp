@@ -70,6 +70,7 @@ comb_approx_command::comb_approx_command( const environment::ptr& env )
     ( "mode,m",         value_with_default( &mode ),           "Approximation mode:\n0: round-down\n1: round-up\n2: round-closest\n3: co-factor 0\n4: co-factor 1\n5: copy" )
     ( "level,l",        value_with_default( &level ),          "Round or co-factor at level (round is inclusive)" )
     ( "maximum_method", value_with_default( &maximum_method ), "Maximum method:\n0: shift\n1: chi" )
+    ( "threads",        value_with_default( &threads ),        "Threads for parallel BDD operations (0: one per core)" )
     ( "print,p",                                               "Print implicants of both functions" )
     ( "truthtable,t",                                          "Print truth table of both functions" )
     ( "new,n",                                                 "Create new store element for result" )
@@ -102,6 +103,10 @@ bool comb_approx_command::execute()
   if ( is_set( "aig" ) )
   {
     cirkit_bdd_simulator sim( aigs.current(), 24u );
+    if ( threads != 1u )
+    {
+      sim.mgr->set_parallel_apply( true, threads );
+    }
     auto map = simulate_aig( aigs.current(), sim );
     manager = sim.mgr;
 
@@ -54,6 +54,7 @@ private:
   unsigned mode           = 0u;
   unsigned level          = 0u;
   unsigned maximum_method = 0u;
+  unsigned threads        = 1u;
 };
 
 }
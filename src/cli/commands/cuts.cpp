@@ -35,6 +35,7 @@
 #include <core/utils/program_options.hpp>
 #include <core/utils/range_utils.hpp>
 #include <classical/functions/cuts/paged.hpp>
+#include <classical/functions/cuts/priority.hpp>
 #include <classical/mig/mig_cuts_paged.hpp>
 #include <classical/functions/cuts/traits.hpp>
 #include <classical/utils/cut_enumeration.hpp>
@@ -54,6 +55,52 @@ namespace cirkit
  * Private functions                                                          *
  ******************************************************************************/
 
+template<unsigned K, typename Graph>
+void cuts_print_priority_cuts( const Graph& g, unsigned priority, bool verbose, bool print_depth, bool print_tt )
+{
+  const auto settings = std::make_shared<properties>();
+  settings->set( "priority", priority );
+  const auto statistics = std::make_shared<properties>();
+
+  const auto cuts = compute_priority_cuts<K>( g, settings, statistics );
+  std::cout << boost::format( "[i] found %d cuts in %.2f secs (%d KB)" ) % cuts.total_cut_count() % statistics->get<double>( "runtime" ) % ( cuts.memory() >> 10u ) << std::endl;
+
+  if ( verbose )
+  {
+    for ( const auto& p : boost::make_iterator_range( vertices( g ) ) )
+    {
+      std::cout << boost::format( "[i] node %d has %d cuts" ) % p % cuts.count( p ) << std::endl;
+      for ( const auto& cut : cuts.cuts( p ) )
+      {
+        std::cout << "[i] - {" << any_join( boost::make_iterator_range( cut.begin(), cut.end() ), ", " ) << "}";
+
+        if ( print_depth )
+        {
+          std::cout << format( " (depth: %d)" ) % cut.depth;
+        }
+
+        if ( print_tt )
+        {
+          std::cout << " " << tt_to_hex( from_kitty( cut.function, cut.size ) );
+        }
+
+        std::cout << std::endl;
+      }
+    }
+  }
+}
+
+template<typename Graph>
+void cuts_print_priority_cuts( const Graph& g, unsigned node_count, unsigned priority, bool verbose, bool print_depth, bool print_tt )
+{
+  switch ( node_count )
+  {
+  case 4u: cuts_print_priority_cuts<4u>( g, priority, verbose, print_depth, print_tt ); break;
+  case 6u: cuts_print_priority_cuts<6u>( g, priority, verbose, print_depth, print_tt ); break;
+  case 8u: cuts_print_priority_cuts<8u>( g, priority, verbose, print_depth, print_tt ); break;
+  }
+}
+
 /******************************************************************************
  * Public functions                                                           *
  ******************************************************************************/
@@ -66,12 +113,27 @@ cuts_command::cuts_command( const environment::ptr& env ) : aig_mig_command( env
     ( "cone_count,c",                                    "Prints nodes in cut cone when verbose" )
     ( "depth,d",                                         "Prints depth of cut when verbose " )
     ( "parallel",                                        "Parallel cut enumeration for AIGs" )
+    ( "priority,p",   value_with_default( &priority ),   "Keep only this many cuts per node (priority cuts)" )
     ;
   be_verbose();
 }
 
+command::rules_t cuts_command::validity_rules() const
+{
+  auto rules = aig_mig_command::validity_rules();
+  rules.push_back( {[this]() { return !is_set( "priority" ) || node_count == 4u || node_count == 6u || node_count == 8u; }, "priority cuts support node counts 4, 6, and 8"} );
+  rules.push_back( {[this]() { return !is_set( "priority" ) || priority > 0u; }, "priority must be positive"} );
+  return rules;
+}
+
 bool cuts_command::execute_aig()
 {
+  if ( is_set( "priority" ) )
+  {
+    cuts_print_priority_cuts( aig(), node_count, priority, is_verbose(), is_set( "depth" ), is_set( "truthtable" ) );
+    return true;
+  }
+
   paged_aig_cuts cuts( aig(), node_count, is_set( "parallel" ) );
   std::cout << boost::format( "[i] found %d cuts in %.2f secs (%d KB)" ) % cuts.total_cut_count() % cuts.enumeration_time() % ( cuts.memory() >> 10u ) << std::endl;
 
@@ -104,6 +166,12 @@ bool cuts_command::execute_aig()
 
 bool cuts_command::execute_mig()
 {
+  if ( is_set( "priority" ) )
+  {
+    cuts_print_priority_cuts( mig(), node_count, priority, is_verbose(), is_set( "depth" ), is_set( "truthtable" ) );
+    return true;
+  }
+
   mig_cuts_paged cuts( mig(), node_count );
   std::cout << boost::format( "[i] found %d cuts in %.2f secs (%d KB)" ) % cuts.total_cut_count() % cuts.enumeration_time() % ( cuts.memory() >> 10u ) << std::endl;
 
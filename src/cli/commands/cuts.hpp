@@ -49,11 +49,14 @@ public:
   cuts_command( const environment::ptr& env );
 
 protected:
+  rules_t validity_rules() const;
+
   bool execute_aig();
   bool execute_mig();
 
 private:
   unsigned node_count = 6u;
+  unsigned priority   = 8u;
 };
 
 }
@@ -67,6 +67,7 @@ npn_command::npn_command( const environment::ptr& env )
   opts.add_options()
     ( "approach",     value( &approach ),   "0: Exact\n1: Heuristic (based on number of 1s)\n2: Heuristic (flip-swap)\n3: Heuristic (sifting)" )
     ( "enumerate,m",  value( &enumerate ),  "Computes NPN classes for all functions with given number of variables" )
+    ( "threads",      value_with_default( &threads ), "Number of threads for enumeration (0: one per core)" )
     ( "truthtable,t",                       "Computes NPN class for the current truth table in the store" )
     ( "logname,l",    value( &logname ),    "If enumerate is set, write all classes to this file" )
     ( "store,n",                            "Copy the result to the store (only for truth tables)" )
@@ -81,20 +82,33 @@ command::rules_t npn_command::validity_rules() const
     {[&]() { return !is_set( "truthtable" ) || env->store<tt>().current_index() >= 0; },
         "no current truth table available" },
     {[&]() { return approach <= 3u; },
-        "approach must be value from 0 to 3" }
+        "approach must be value from 0 to 3" },
+    {[&]() { return !is_set( "enumerate" ) || approach != 0u || ( enumerate >= 2u && enumerate <= 5u ); },
+        "exact enumeration requires between 2 and 5 variables" }
   };
 }
 
 bool npn_command::execute()
 {
-  std::vector<npn_func_t> approaches{ &exact_npn_canonization, &npn_canonization, &npn_canonization_flip_swap, &npn_canonization_sifting };
+  using exact_func_t = tt(*)(const tt&, boost::dynamic_bitset<>&, std::vector<unsigned>&, const properties::ptr&, const properties::ptr&);
+  std::vector<npn_func_t> approaches{ static_cast<exact_func_t>( &exact_npn_canonization ), &npn_canonization, &npn_canonization_flip_swap, &npn_canonization_sifting };
   const auto& func = approaches[approach];
 
   if ( is_set( "enumerate" ) )
   {
     double runtime;
-    std::unordered_map<unsigned, unsigned> classes;
+    std::unordered_map<unsigned long, unsigned long> classes;
 
+    if ( approach == 0u )
+    {
+      /* visits each class once instead of canonizing every function */
+      const auto settings = make_settings();
+      settings->set( "num_threads", threads );
+      const auto enum_statistics = std::make_shared<properties>();
+      classes = exact_npn_classes( enumerate, settings, enum_statistics );
+      runtime = enum_statistics->get<double>( "runtime" );
+    }
+    else
     {
       reference_timer t( &runtime );
 
@@ -62,6 +62,7 @@ public:
 private:
   unsigned                approach = 1u;
   unsigned                enumerate;
+  unsigned                threads = 0u;
   std::string             logname;
 
   boost::dynamic_bitset<> phase;
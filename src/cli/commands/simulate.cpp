@@ -38,6 +38,7 @@
 #include <core/utils/program_options.hpp>
 #include <cli/stores.hpp>
 #include <classical/functions/simulate_aig.hpp>
+#include <classical/functions/simulate_aig_bitparallel.hpp>
 #include <classical/mig/mig_simulate.hpp>
 
 using namespace boost::program_options;
@@ -65,6 +66,8 @@ simulate_command::simulate_command( const environment::ptr& env )
     ( "assignment,s",    value( &assignment ), "Simulates an input assignment, e.g. \"x1=0 x2=1 x3=1 y=1010 z=01\"" )
     ( "tt,t",                                  "Simulates a truth table" )
     ( "bdd,b",                                 "Simulates a BDD" )
+    ( "random,r",        value( &random_patterns ), "Simulates a number of random patterns bit-parallel and prints output signatures (only AIGs)" )
+    ( "seed",            value_with_default( &seed ), "Random seed for random simulation" )
     ( "little_endian,l",                       "Change bit endianness to little-endian in assignment method (default: big-endian)" )
     ( "quiet,q",                               "Don't print simulation results" )
     ;
@@ -84,7 +87,7 @@ command::rule_t simulate_command::one_simulation_method() const
   const auto assertion = [&]() {
     auto total = 0u;
 
-    for ( const auto& o : {"pattern","assignment","tt","bdd"} )
+    for ( const auto& o : {"pattern","assignment","tt","bdd","random"} )
     {
       if ( is_set( o ) ) { ++total; }
     }
@@ -236,6 +239,21 @@ bool simulate_command::execute_aig()
 
     store<bdd_function_t>( {mgr, bdds} );
   }
+  else if ( is_set( "random" ) )
+  {
+    auto settings = make_settings();
+    settings->set( "seed", seed );
+    const auto sigs = simulate_aig_signatures( aig(), random_patterns, settings, statistics );
+
+    if ( !is_set( "quiet" ) )
+    {
+      auto i = 0u;
+      for ( const auto& o : aig_info().outputs )
+      {
+        std::cout << boost::format( "[i] %s : " ) % o.second << sigs[i++] << std::endl;
+      }
+    }
+  }
 
   if ( statistics->has_key( "runtime" ) )
   {
@@ -249,6 +267,12 @@ bool simulate_command::execute_mig()
 {
   tts.clear();
 
+  if ( is_set( "random" ) )
+  {
+    std::cout << "[e] random simulation is only supported for AIGs" << std::endl;
+    return true;
+  }
+
   if ( is_set( "pattern" ) )
   {
     mig_simple_assignment_simulator::mig_name_value_map m;
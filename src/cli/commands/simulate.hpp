@@ -78,6 +78,8 @@ public:
 private:
   std::string pattern;
   std::string assignment;
+  unsigned    random_patterns = 0u;
+  unsigned    seed = 0u;
 
   std::vector<std::string> tts;
 };
@@ -26,7 +26,11 @@
 
 #include "strash.hpp"
 
+#include <core/utils/program_options.hpp>
 #include <classical/functions/strash.hpp>
+#include <classical/utils/aig_utils.hpp>
+
+using namespace boost::program_options;
 
 namespace cirkit
 {
@@ -46,21 +50,39 @@ namespace cirkit
 strash_command::strash_command( const environment::ptr& env ) : aig_base_command( env, "Strashes an AIG" )
 {
   opts.add_options()
-    ( "new,n", "Stores result in a new AIG" )
+    ( "new,n",                                                "Stores result in a new AIG" )
+    ( "load_factor,l", value_with_default( &max_load_factor ), "Maximum load factor of the structural hashing table" )
+    ( "stats,s",                                              "Prints structural hashing statistics" )
     ;
 }
 
+command::rules_t strash_command::validity_rules() const
+{
+  return {
+    has_store_element<aig_graph>( env ),
+    {[this]() { return max_load_factor > 0.0 && max_load_factor < 1.0; }, "load factor must be in the open interval (0,1)"}
+  };
+}
+
 bool strash_command::execute()
 {
+  auto settings = make_settings();
+  settings->set( "max_load_factor", max_load_factor );
+
   if ( is_set( "new" ) )
   {
     const auto current = aig();
     store.extend();
-    aig() = strash( current );
+    aig() = strash( current, settings );
   }
   else
   {
-    aig() = strash( aig() );
+    aig() = strash( aig(), settings );
+  }
+
+  if ( is_set( "stats" ) )
+  {
+    aig_info( aig() ).strash.print_statistics();
   }
 
   return true;
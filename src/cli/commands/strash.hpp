@@ -47,7 +47,11 @@ public:
   strash_command( const environment::ptr& env );
 
 protected:
+  rules_t validity_rules() const;
   bool execute();
+
+private:
+  double max_load_factor = 0.5;
 };
 
 }
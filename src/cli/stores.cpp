@@ -46,7 +46,6 @@
 #include <core/utils/bitset_utils.hpp>
 #include <core/utils/range_utils.hpp>
 
-#include <classical/abc/utils/abc_run_command.hpp>
 #include <classical/functions/aig_from_truth_table.hpp>
 #include <classical/functions/aig_to_mig.hpp>
 #include <classical/functions/compute_levels.hpp>
@@ -363,7 +362,7 @@ void store_write_io_type<aig_graph, io_aiger_tag_t>( const aig_graph& aig, const
   }
   else
   {
-    abc_run_command_no_output( aig, boost::str( boost::format( "&w %s") % filename ) );
+    write_aiger_binary( aig, filename );
   }
 }
 
@@ -453,7 +452,7 @@ command::log_opt_t log_store_entry_statistics<mig_graph>( const mig_graph& mig )
   return command::log_opt_t({
       {"inputs", static_cast<int>( info.inputs.size() )},
       {"outputs", static_cast<int>( info.outputs.size() )},
-      {"size", static_cast<int>( boost::num_vertices( mig ) - info.inputs.size() - 1u )},
+      {"size", static_cast<int>( number_of_gates( mig ) )},
       {"depth", depth},
       {"complemented_edges", number_of_complemented_edges( mig )},
       {"inverters", number_of_inverters( mig )}
@@ -0,0 +1,122 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "mapped_file.hpp"
+
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace cirkit
+{
+
+/******************************************************************************
+ * Types                                                                      *
+ ******************************************************************************/
+
+/******************************************************************************
+ * Private functions                                                          *
+ ******************************************************************************/
+
+/******************************************************************************
+ * Public functions                                                           *
+ ******************************************************************************/
+
+mapped_file::mapped_file( const std::string& filename )
+{
+  const auto fd = ::open( filename.c_str(), O_RDONLY );
+  if ( fd == -1 ) { return; }
+
+  struct stat st;
+  if ( ::fstat( fd, &st ) == 0 )
+  {
+    if ( st.st_size == 0 )
+    {
+      _is_empty = true;
+    }
+    else
+    {
+      auto* p = ::mmap( nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+      if ( p != MAP_FAILED )
+      {
+        _data = static_cast<const char*>( p );
+        _size = st.st_size;
+      }
+    }
+  }
+
+  /* the mapping stays valid after closing the descriptor */
+  ::close( fd );
+}
+
+mapped_file::~mapped_file()
+{
+  close();
+}
+
+mapped_file::mapped_file( mapped_file&& other )
+  : _data( other._data ),
+    _size( other._size ),
+    _is_empty( other._is_empty )
+{
+  other._data = nullptr;
+  other._size = 0u;
+  other._is_empty = false;
+}
+
+mapped_file& mapped_file::operator=( mapped_file&& other )
+{
+  if ( this != &other )
+  {
+    close();
+    std::swap( _data, other._data );
+    std::swap( _size, other._size );
+    std::swap( _is_empty, other._is_empty );
+  }
+  return *this;
+}
+
+void mapped_file::close()
+{
+  if ( _data )
+  {
+    ::munmap( const_cast<char*>( _data ), _size );
+  }
+  _data = nullptr;
+  _size = 0u;
+  _is_empty = false;
+}
+
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
@@ -0,0 +1,81 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * @file mapped_file.hpp
+ *
+ * @brief Read-only memory mapped files
+ *
+ * @author Mathias Soeken
+ * @since  2.3
+ */
+
+#ifndef MAPPED_FILE_HPP
+#define MAPPED_FILE_HPP
+
+#include <cstddef>
+#include <string>
+
+namespace cirkit
+{
+
+class mapped_file
+{
+public:
+  mapped_file() = default;
+
+  /* is_open() is false if the file cannot be opened or mapped */
+  explicit mapped_file( const std::string& filename );
+  ~mapped_file();
+
+  mapped_file( const mapped_file& ) = delete;
+  mapped_file& operator=( const mapped_file& ) = delete;
+  mapped_file( mapped_file&& other );
+  mapped_file& operator=( mapped_file&& other );
+
+  inline bool        is_open() const { return _data != nullptr || _is_empty; }
+  inline const char* data() const    { return _data; }
+  inline std::size_t size() const    { return _size; }
+  inline const char* begin() const   { return _data; }
+  inline const char* end() const     { return _data + _size; }
+
+  void close();
+
+private:
+  const char* _data = nullptr;
+  std::size_t _size = 0u;
+  bool        _is_empty = false; /* empty files cannot be mapped */
+};
+
+}
+
+#endif
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
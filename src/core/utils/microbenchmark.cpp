@@ -0,0 +1,315 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#include "microbenchmark.hpp"
+
+#include <algorithm>
+#include <ctime>
+#include <numeric>
+
+#include <boost/format.hpp>
+
+namespace cirkit
+{
+
+/******************************************************************************
+ * Types                                                                      *
+ ******************************************************************************/
+
+struct registered_benchmark
+{
+  std::string      name;
+  benchmark_func_t func;
+  std::uint64_t    iterations;
+};
+
+/******************************************************************************
+ * Private functions                                                          *
+ ******************************************************************************/
+
+std::vector<registered_benchmark>& benchmark_registry()
+{
+  static std::vector<registered_benchmark> registry;
+  return registry;
+}
+
+inline std::chrono::nanoseconds process_cpu_time()
+{
+  timespec ts;
+  clock_gettime( CLOCK_PROCESS_CPUTIME_ID, &ts );
+  return std::chrono::seconds( ts.tv_sec ) + std::chrono::nanoseconds( ts.tv_nsec );
+}
+
+benchmark_result run_once( const registered_benchmark& bm, std::uint64_t iterations )
+{
+  benchmark_state state( iterations );
+  bm.func( state );
+
+  benchmark_result result;
+  result.name       = bm.name;
+  result.iterations = state._iteration;
+  result.real_time  = static_cast<double>( state._real_time.count() ) / std::max<std::uint64_t>( state._iteration, 1u );
+  result.cpu_time   = static_cast<double>( state._cpu_time.count() ) / std::max<std::uint64_t>( state._iteration, 1u );
+  result.counters   = state._counters;
+  result.label      = state._label;
+  return result;
+}
+
+/* same strategy as Google Benchmark: grow iterations until min_time is reached */
+benchmark_result run_repetition( const registered_benchmark& bm, double min_time )
+{
+  if ( bm.iterations )
+  {
+    return run_once( bm, bm.iterations );
+  }
+
+  std::uint64_t iterations = 1u;
+  while ( true )
+  {
+    const auto result = run_once( bm, iterations );
+    const auto seconds = result.real_time * result.iterations / 1.0e9;
+
+    if ( seconds >= min_time || iterations >= 1000000000u )
+    {
+      return result;
+    }
+
+    const auto multiplier = seconds <= min_time / 10.0 ? 10.0 : 1.4 * min_time / seconds;
+    iterations = std::max<std::uint64_t>( iterations + 1u, static_cast<std::uint64_t>( iterations * multiplier ) );
+  }
+}
+
+benchmark_result aggregate( const std::vector<benchmark_result>& results, const std::string& suffix, bool median )
+{
+  auto r = results.front();
+  r.name += suffix;
+  r.run_type = "aggregate";
+
+  const auto reduce = [&results, median]( const std::function<double(const benchmark_result&)>& value ) {
+    std::vector<double> values;
+    for ( const auto& result : results ) { values.push_back( value( result ) ); }
+    if ( median )
+    {
+      std::sort( values.begin(), values.end() );
+      const auto n = values.size();
+      return n % 2u ? values[n / 2u] : ( values[n / 2u - 1u] + values[n / 2u] ) / 2.0;
+    }
+    return std::accumulate( values.begin(), values.end(), 0.0 ) / values.size();
+  };
+
+  r.real_time = reduce( []( const benchmark_result& b ) { return b.real_time; } );
+  r.cpu_time  = reduce( []( const benchmark_result& b ) { return b.cpu_time; } );
+  for ( auto& c : r.counters )
+  {
+    const auto& name = c.first;
+    c.second = reduce( [&name]( const benchmark_result& b ) { return b.counters.at( name ); } );
+  }
+  return r;
+}
+
+std::string json_escape( const std::string& s )
+{
+  std::string r;
+  for ( auto c : s )
+  {
+    switch ( c )
+    {
+    case '"':  r += "\\\""; break;
+    case '\\': r += "\\\\"; break;
+    case '\n': r += "\\n";  break;
+    case '\t': r += "\\t";  break;
+    default:   r += c;
+    }
+  }
+  return r;
+}
+
+/******************************************************************************
+ * Public functions                                                           *
+ ******************************************************************************/
+
+benchmark_state::benchmark_state( std::uint64_t max_iterations )
+  : _max_iterations( max_iterations )
+{
+}
+
+bool benchmark_state::keep_running()
+{
+  if ( !_running && _iteration == 0u )
+  {
+    resume_timing();
+  }
+
+  if ( _iteration < _max_iterations )
+  {
+    ++_iteration;
+    return true;
+  }
+
+  pause_timing();
+  return false;
+}
+
+void benchmark_state::pause_timing()
+{
+  if ( !_running ) { return; }
+
+  _real_time += std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::steady_clock::now() - _real_start );
+  _cpu_time  += process_cpu_time() - _cpu_start;
+  _running = false;
+}
+
+void benchmark_state::resume_timing()
+{
+  if ( _running ) { return; }
+
+  _running    = true;
+  _cpu_start  = process_cpu_time();
+  _real_start = std::chrono::steady_clock::now();
+}
+
+void benchmark_state::set_counter( const std::string& name, double value )
+{
+  _counters[name] = value;
+}
+
+void benchmark_state::set_label( const std::string& label )
+{
+  _label = label;
+}
+
+void register_benchmark( const std::string& name, const benchmark_func_t& func, std::uint64_t iterations )
+{
+  benchmark_registry().push_back( {name, func, iterations} );
+}
+
+std::vector<std::string> registered_benchmarks()
+{
+  std::vector<std::string> names;
+  for ( const auto& bm : benchmark_registry() )
+  {
+    names.push_back( bm.name );
+  }
+  std::sort( names.begin(), names.end() );
+  return names;
+}
+
+std::vector<benchmark_result> run_benchmarks( const benchmark_options& options )
+{
+  /* registration order depends on link order, run in name order */
+  auto registry = benchmark_registry();
+  std::sort( registry.begin(), registry.end(), []( const registered_benchmark& a, const registered_benchmark& b ) { return a.name < b.name; } );
+
+  std::vector<benchmark_result> results;
+
+  for ( const auto& bm : registry )
+  {
+    if ( !options.filter.empty() && bm.name.find( options.filter ) == std::string::npos ) { continue; }
+
+    if ( options.verbose )
+    {
+      std::cerr << "[i] running " << bm.name << std::endl;
+    }
+
+    std::vector<benchmark_result> repetitions;
+    for ( auto r = 0u; r < std::max( options.repetitions, 1u ); ++r )
+    {
+      repetitions.push_back( run_repetition( bm, options.min_time ) );
+    }
+    results.insert( results.end(), repetitions.begin(), repetitions.end() );
+
+    if ( repetitions.size() > 1u )
+    {
+      results.push_back( aggregate( repetitions, "_mean", false ) );
+      results.push_back( aggregate( repetitions, "_median", true ) );
+    }
+  }
+
+  return results;
+}
+
+void write_benchmarks_json( std::ostream& os, const std::vector<benchmark_result>& results, const std::map<std::string, std::string>& context )
+{
+  os << "{" << std::endl << "  \"context\": {";
+  auto first = true;
+  for ( const auto& p : context )
+  {
+    os << ( first ? "" : "," ) << std::endl << boost::format( "    \"%s\": \"%s\"" ) % json_escape( p.first ) % json_escape( p.second );
+    first = false;
+  }
+  os << std::endl << "  }," << std::endl << "  \"benchmarks\": [";
+
+  first = true;
+  for ( const auto& r : results )
+  {
+    os << ( first ? "" : "," ) << std::endl
+       << "    {" << std::endl
+       << boost::format( "      \"name\": \"%s\"," ) % json_escape( r.name ) << std::endl
+       << boost::format( "      \"run_type\": \"%s\"," ) % r.run_type << std::endl
+       << boost::format( "      \"iterations\": %d," ) % r.iterations << std::endl
+       << boost::format( "      \"real_time\": %.3f," ) % r.real_time << std::endl
+       << boost::format( "      \"cpu_time\": %.3f," ) % r.cpu_time << std::endl;
+    if ( !r.label.empty() )
+    {
+      os << boost::format( "      \"label\": \"%s\"," ) % json_escape( r.label ) << std::endl;
+    }
+    for ( const auto& c : r.counters )
+    {
+      os << boost::format( "      \"%s\": %g," ) % json_escape( c.first ) % c.second << std::endl;
+    }
+    os << "      \"time_unit\": \"ns\"" << std::endl << "    }";
+    first = false;
+  }
+  os << std::endl << "  ]" << std::endl << "}" << std::endl;
+}
+
+void write_benchmarks_table( std::ostream& os, const std::vector<benchmark_result>& results )
+{
+  os << boost::format( "%-50s %15s %15s %12s" ) % "Benchmark" % "Time (ns)" % "CPU (ns)" % "Iterations" << std::endl
+     << std::string( 95u, '-' ) << std::endl;
+  for ( const auto& r : results )
+  {
+    os << boost::format( "%-50s %15.0f %15.0f %12d" ) % r.name % r.real_time % r.cpu_time % r.iterations;
+    for ( const auto& c : r.counters )
+    {
+      os << boost::format( " %s=%g" ) % c.first % c.second;
+    }
+    if ( !r.label.empty() )
+    {
+      os << " " << r.label;
+    }
+    os << std::endl;
+  }
+}
+
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
@@ -0,0 +1,152 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+/**
+ * @file microbenchmark.hpp
+ *
+ * @brief Registry and runner for performance benchmarks
+ *
+ * Benchmarks are functions that take a benchmark_state and loop while
+ * keep_running() returns true.  The runner increases the number of
+ * iterations until a minimum time is reached and reports real and CPU time
+ * per iteration together with user counters.  Results are written as JSON
+ * in the same layout as Google Benchmark, so existing tools can compare
+ * them.
+ *
+ * @author Mathias Soeken
+ * @since  2.3
+ */
+
+#ifndef MICROBENCHMARK_HPP
+#define MICROBENCHMARK_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace cirkit
+{
+
+class benchmark_state
+{
+public:
+  explicit benchmark_state( std::uint64_t max_iterations );
+
+  /* returns true as long as iterations are left, starts timing on first call */
+  bool keep_running();
+
+  /* excludes setup code inside the loop from timing */
+  void pause_timing();
+  void resume_timing();
+
+  inline std::uint64_t iterations() const { return _max_iterations; }
+
+  /* counters are reported per benchmark, e.g., sizes of results */
+  void set_counter( const std::string& name, double value );
+  void set_label( const std::string& label );
+
+public:
+  std::uint64_t                 _max_iterations;
+  std::uint64_t                 _iteration = 0u;
+  bool                          _running = false;
+
+  std::chrono::nanoseconds      _real_time{ 0 };
+  std::chrono::nanoseconds      _cpu_time{ 0 };
+  std::chrono::steady_clock::time_point _real_start;
+  std::chrono::nanoseconds      _cpu_start{ 0 };
+
+  std::map<std::string, double> _counters;
+  std::string                   _label;
+};
+
+/* prevents the compiler from removing computations whose result is unused */
+template<typename T>
+inline void do_not_optimize( const T& value )
+{
+  asm volatile( "" : : "r,m"( value ) : "memory" );
+}
+
+using benchmark_func_t = std::function<void(benchmark_state&)>;
+
+struct benchmark_result
+{
+  std::string                   name;
+  std::string                   run_type = "iteration"; /* or "aggregate" */
+  std::uint64_t                 iterations = 0u;
+  double                        real_time = 0.0;        /* ns per iteration */
+  double                        cpu_time = 0.0;         /* ns per iteration */
+  std::map<std::string, double> counters;
+  std::string                   label;
+};
+
+struct benchmark_options
+{
+  std::string filter;             /* substring of the benchmark name, empty runs all */
+  double      min_time = 0.5;     /* seconds per repetition */
+  unsigned    repetitions = 1u;   /* reports mean and median if larger than 1 */
+  bool        verbose = false;
+};
+
+/* macrobenchmarks run a fixed number of iterations, 0 determines it from min_time */
+void register_benchmark( const std::string& name, const benchmark_func_t& func, std::uint64_t iterations = 0u );
+std::vector<std::string> registered_benchmarks();
+
+std::vector<benchmark_result> run_benchmarks( const benchmark_options& options );
+
+void write_benchmarks_json( std::ostream& os, const std::vector<benchmark_result>& results, const std::map<std::string, std::string>& context = {} );
+void write_benchmarks_table( std::ostream& os, const std::vector<benchmark_result>& results );
+
+struct benchmark_registrar
+{
+  benchmark_registrar( const std::string& name, const benchmark_func_t& func, std::uint64_t iterations = 0u )
+  {
+    register_benchmark( name, func, iterations );
+  }
+};
+
+}
+
+#define CIRKIT_BENCHMARK_IMPL( name, iterations )                                           \
+  static void name( cirkit::benchmark_state& state );                                       \
+  static cirkit::benchmark_registrar name##_registrar( #name, &name, iterations );          \
+  static void name( cirkit::benchmark_state& state )
+
+/* CIRKIT_BENCHMARK( bm_name ) { while ( state.keep_running() ) { ... } } */
+#define CIRKIT_BENCHMARK( name ) CIRKIT_BENCHMARK_IMPL( name, 0u )
+#define CIRKIT_MACROBENCHMARK( name, iterations ) CIRKIT_BENCHMARK_IMPL( name, iterations )
+
+#endif
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
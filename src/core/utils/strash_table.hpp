@@ -0,0 +1,276 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * @file strash_table.hpp
+ *
+ * @brief Open-addressing hash table for structural hashing
+ *
+ * @author Mathias Soeken
+ * @since  2.3
+ */
+
+#ifndef STRASH_TABLE_HPP
+#define STRASH_TABLE_HPP
+
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+#include <boost/format.hpp>
+
+namespace cirkit
+{
+
+/* strash_table
+ *
+ * Maps gates, given as Arity packed 32-bit literals (2 * node + complement),
+ * to the node index that implements them.  All slots are stored in one
+ * vector and collisions are resolved by linear probing, so a lookup is a
+ * hash computation and (usually) one cache line.  The capacity is a power
+ * of two and doubles whenever the number of entries exceeds the maximum
+ * load factor.  Entries are never removed, which matches the append-only
+ * node creation of AIGs, MIGs, and XMGs.
+ *
+ * A slot is empty if the first literal of its key equals `empty_literal'.
+ */
+
+/* packs a function with members `node' and `complemented' (AIG, MIG, or XMG)
+   into the literal encoding of the keys */
+template<typename Function>
+inline std::uint32_t strash_literal( const Function& f )
+{
+  assert( f.node < 0x7fffffffu );
+  return ( static_cast<std::uint32_t>( f.node ) << 1u ) | ( f.complemented ? 1u : 0u );
+}
+
+struct strash_table_statistics
+{
+  unsigned long lookups  = 0ul;
+  unsigned long hits     = 0ul;
+  unsigned long probes   = 0ul;
+  unsigned long rehashes = 0ul;
+};
+
+template<unsigned Arity>
+class strash_table
+{
+public:
+  using key_t   = std::array<std::uint32_t, Arity>;
+  using value_t = std::uint32_t;
+
+  static constexpr std::uint32_t empty_literal = 0xffffffffu;
+
+public:
+  explicit strash_table( double max_load_factor = 0.5, std::size_t initial_capacity = 64u )
+    : _max_load_factor( max_load_factor )
+  {
+    assert( max_load_factor > 0.0 && max_load_factor < 1.0 );
+    allocate( round_up( initial_capacity ) );
+  }
+
+  /* returns nullptr if key is not in the table */
+  const value_t* find( const key_t& key ) const
+  {
+    ++_stats.lookups;
+
+    auto pos = index( key );
+    while ( true )
+    {
+      ++_stats.probes;
+
+      const auto& slot = _slots[pos];
+      if ( slot.key[0u] == empty_literal )
+      {
+        return nullptr;
+      }
+      if ( slot.key == key )
+      {
+        ++_stats.hits;
+        return &slot.value;
+      }
+      pos = ( pos + 1u ) & _mask;
+    }
+  }
+
+  /* inserts key if not present, returns the value stored for key and whether it was inserted */
+  std::pair<value_t, bool> insert( const key_t& key, value_t value )
+  {
+    assert( key[0u] != empty_literal );
+
+    if ( ( _size + 1u ) > _max_size )
+    {
+      rehash( _slots.size() << 1u );
+    }
+
+    auto pos = index( key );
+    while ( true )
+    {
+      auto& slot = _slots[pos];
+      if ( slot.key[0u] == empty_literal )
+      {
+        slot.key = key;
+        slot.value = value;
+        ++_size;
+        return {value, true};
+      }
+      if ( slot.key == key )
+      {
+        return {slot.value, false};
+      }
+      pos = ( pos + 1u ) & _mask;
+    }
+  }
+
+  void reserve( std::size_t n )
+  {
+    const auto capacity = round_up( static_cast<std::size_t>( n / _max_load_factor ) + 1u );
+    if ( capacity > _slots.size() )
+    {
+      rehash( capacity );
+    }
+  }
+
+  void clear()
+  {
+    for ( auto& slot : _slots )
+    {
+      slot.key[0u] = empty_literal;
+    }
+    _size = 0u;
+  }
+
+  inline std::size_t size() const     { return _size; }
+  inline bool        empty() const    { return _size == 0u; }
+  inline std::size_t capacity() const { return _slots.size(); }
+  inline std::size_t memory() const   { return _slots.capacity() * sizeof( slot_t ); }
+
+  inline double max_load_factor() const { return _max_load_factor; }
+  void set_max_load_factor( double max_load_factor )
+  {
+    assert( max_load_factor > 0.0 && max_load_factor < 1.0 );
+    _max_load_factor = max_load_factor;
+    _max_size = static_cast<std::size_t>( _slots.size() * _max_load_factor );
+    if ( _size + 1u > _max_size )
+    {
+      reserve( _size + 1u );
+    }
+  }
+
+  inline const strash_table_statistics& statistics() const { return _stats; }
+  inline void reset_statistics() { _stats = strash_table_statistics(); }
+
+  void print_statistics( std::ostream& os = std::cout ) const
+  {
+    os << boost::format( "[i] strash: entries = %d  capacity = %d  load = %.2f  lookups = %d  hits = %d  avg. probes = %.2f  rehashes = %d" )
+      % _size % _slots.size() % ( static_cast<double>( _size ) / _slots.size() )
+      % _stats.lookups % _stats.hits
+      % ( _stats.lookups == 0ul ? 0.0 : static_cast<double>( _stats.probes ) / _stats.lookups )
+      % _stats.rehashes << std::endl;
+  }
+
+private:
+  struct slot_t
+  {
+    key_t   key;
+    value_t value;
+  };
+
+  static std::size_t round_up( std::size_t n )
+  {
+    std::size_t capacity = 16u;
+    while ( capacity < n ) { capacity <<= 1u; }
+    return capacity;
+  }
+
+  inline std::size_t index( const key_t& key ) const
+  {
+    std::uint64_t h = 0u;
+    for ( auto l : key )
+    {
+      h = ( h ^ l ) * 0x9e3779b97f4a7c15ull;
+      h ^= h >> 32u;
+    }
+    return static_cast<std::size_t>( h ) & _mask;
+  }
+
+  void allocate( std::size_t capacity )
+  {
+    slot_t empty;
+    empty.key.fill( empty_literal );
+    empty.value = 0u;
+
+    _slots.assign( capacity, empty );
+    _mask = capacity - 1u;
+    _max_size = static_cast<std::size_t>( capacity * _max_load_factor );
+    _size = 0u;
+  }
+
+  void rehash( std::size_t capacity )
+  {
+    ++_stats.rehashes;
+
+    std::vector<slot_t> old_slots;
+    old_slots.swap( _slots );
+    allocate( capacity );
+
+    for ( const auto& slot : old_slots )
+    {
+      if ( slot.key[0u] == empty_literal ) { continue; }
+
+      auto pos = index( slot.key );
+      while ( _slots[pos].key[0u] != empty_literal )
+      {
+        pos = ( pos + 1u ) & _mask;
+      }
+      _slots[pos] = slot;
+      ++_size;
+    }
+  }
+
+private:
+  std::vector<slot_t>             _slots;
+  std::size_t                     _mask = 0u;
+  std::size_t                     _size = 0u;
+  std::size_t                     _max_size = 0u;
+  double                          _max_load_factor;
+  mutable strash_table_statistics _stats; /* updated by const lookups */
+};
+
+template<unsigned Arity>
+constexpr std::uint32_t strash_table<Arity>::empty_literal;
+
+}
+
+#endif
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
@@ -37,6 +37,70 @@ namespace cirkit
  * Private functions                                                          *
  ******************************************************************************/
 
+namespace
+{
+
+/* set in worker threads to push tasks to the local queue */
+thread_local const thread_pool* current_pool = nullptr;
+thread_local unsigned           current_index = 0u;
+
+}
+
+bool thread_pool::pop_task( unsigned index, std::function<void()>& task )
+{
+  const auto n = queues.size();
+
+  /* own queue, LIFO */
+  {
+    auto& q = *queues[index];
+    std::lock_guard<std::mutex> lock( q.mutex );
+    if ( !q.tasks.empty() )
+    {
+      task = std::move( q.tasks.back() );
+      q.tasks.pop_back();
+      --queued;
+      return true;
+    }
+  }
+
+  /* steal, FIFO */
+  for ( auto i = 1u; i < n; ++i )
+  {
+    auto& q = *queues[( index + i ) % n];
+    std::lock_guard<std::mutex> lock( q.mutex );
+    if ( !q.tasks.empty() )
+    {
+      task = std::move( q.tasks.front() );
+      q.tasks.pop_front();
+      --queued;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void thread_pool::worker_loop( unsigned index )
+{
+  current_pool = this;
+  current_index = index;
+
+  while ( true )
+  {
+    std::function<void()> task;
+
+    if ( pop_task( index, task ) )
+    {
+      task();
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock( sleep_mutex );
+    condition.wait( lock, [this]{ return stop || queued.load() != 0u; } );
+    if ( stop && queued.load() == 0u ) { return; }
+  }
+}
+
 /******************************************************************************
  * Public functions                                                           *
  ******************************************************************************/
@@ -48,31 +112,23 @@ thread_pool::thread_pool()
 
 thread_pool::thread_pool( unsigned num_threads )
 {
+  if ( num_threads == 0u ) { num_threads = 1u; }
+
   for ( auto i = 0u; i < num_threads; ++i )
   {
-    workers.emplace_back( [this] {
-        while ( true )
-        {
-          std::function<void()> task;
-
-          {
-            std::unique_lock<std::mutex> lock( this->queue_mutex );
-            this->condition.wait( lock,
-                                  [this]{ return this->stop || !this->tasks.empty(); } );
-            if ( this->stop && this->tasks.empty() ) { return; }
-            task = std::move( this->tasks.front() );
-            this->tasks.pop();
-          }
-          task();
-        }
-      });
+    queues.emplace_back( new worker_queue() );
+  }
+
+  for ( auto i = 0u; i < num_threads; ++i )
+  {
+    workers.emplace_back( [this, i] { worker_loop( i ); } );
   }
 }
 
 thread_pool::~thread_pool()
 {
   {
-    std::unique_lock<std::mutex> lock( queue_mutex );
+    std::unique_lock<std::mutex> lock( sleep_mutex );
     stop = true;
   }
 
@@ -83,6 +139,107 @@ thread_pool::~thread_pool()
   }
 }
 
+unsigned thread_pool::size() const
+{
+  return workers.size();
+}
+
+void thread_pool::submit( std::function<void()> task )
+{
+  const auto index = current_pool == this ? current_index : next_queue++ % queues.size();
+
+  {
+    auto& q = *queues[index];
+    std::lock_guard<std::mutex> lock( q.mutex );
+
+    /* don't allow enqueueing after stopping the pool */
+    if ( stop )
+    {
+      throw std::runtime_error( "enqueue on stopped thread pool" );
+    }
+
+    q.tasks.push_back( std::move( task ) );
+    ++queued;
+  }
+
+  /* taking the lock avoids a lost wake-up between predicate check and wait */
+  {
+    std::lock_guard<std::mutex> lock( sleep_mutex );
+  }
+  condition.notify_one();
+}
+
+bool thread_pool::try_run_one()
+{
+  std::function<void()> task;
+  if ( !pop_task( current_pool == this ? current_index : 0u, task ) )
+  {
+    return false;
+  }
+
+  task();
+  return true;
+}
+
+task_group::task_group( thread_pool& pool )
+  : pool( pool )
+{
+}
+
+task_group::~task_group()
+{
+  /* never leave tasks behind that reference this group */
+  while ( pending.load() != 0u )
+  {
+    if ( !pool.try_run_one() )
+    {
+      std::unique_lock<std::mutex> lock( mutex );
+      done.wait_for( lock, std::chrono::milliseconds( 1 ), [this]{ return pending.load() == 0u; } );
+    }
+  }
+
+  /* the last task may still hold the lock while notifying */
+  std::lock_guard<std::mutex> lock( mutex );
+}
+
+void task_group::wait()
+{
+  while ( pending.load() != 0u )
+  {
+    /* help instead of blocking, this also makes nested groups safe */
+    if ( !pool.try_run_one() )
+    {
+      std::unique_lock<std::mutex> lock( mutex );
+      done.wait_for( lock, std::chrono::milliseconds( 1 ), [this]{ return pending.load() == 0u; } );
+    }
+  }
+
+  std::exception_ptr e;
+  {
+    std::lock_guard<std::mutex> lock( mutex );
+    std::swap( e, exception );
+  }
+
+  if ( e )
+  {
+    std::rethrow_exception( e );
+  }
+}
+
+void task_group::finish()
+{
+  std::lock_guard<std::mutex> lock( mutex );
+  if ( --pending == 0u )
+  {
+    done.notify_all();
+  }
+}
+
+thread_pool& shared_thread_pool()
+{
+  static thread_pool pool;
+  return pool;
+}
 
 }
 
@@ -40,18 +40,27 @@
 #ifndef THREAD_POOL_HPP
 #define THREAD_POOL_HPP
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <deque>
+#include <exception>
 #include <functional>
 #include <future>
 #include <memory>
 #include <mutex>
-#include <queue>
+#include <stdexcept>
 #include <thread>
 #include <vector>
 
 namespace cirkit
 {
 
+/* Each worker owns a deque of tasks.  Workers take tasks from the back of
+ * their own deque and steal from the front of the other deques when they
+ * run out of work.  Tasks that are submitted from a worker thread are pushed
+ * to the deque of that worker, other tasks are distributed round robin. */
 class thread_pool
 {
 public:
@@ -60,6 +69,17 @@ public:
   thread_pool( unsigned num_threads );
   ~thread_pool();
 
+  thread_pool( const thread_pool& ) = delete;
+  thread_pool& operator=( const thread_pool& ) = delete;
+
+  unsigned size() const;
+
+  /* fire and forget, see task_group for waiting on tasks */
+  void submit( std::function<void()> task );
+
+  /* runs one pending task in the calling thread, returns false if there is none */
+  bool try_run_one();
+
   template<class F, class... Args>
   auto enqueue( F&& f, Args&&... args ) -> std::future<typename std::result_of<F(Args...)>::type>
   {
@@ -70,30 +90,116 @@ public:
       );
 
     std::future<return_type> res = task->get_future();
-    {
-      std::unique_lock<std::mutex> lock( queue_mutex );
+    submit( [task]() { (*task)(); } );
+    return res;
+  }
 
-      /* don't allow enqueueing after stopping the pool */
-      if ( stop )
-      {
-        throw std::runtime_error( "enqueue on stopped thread pool" );
-      }
+  /* calls fn( i ) for all first <= i < last, in chunks of grain indexes;
+     the calling thread takes part in the computation */
+  template<class F>
+  void parallel_for( std::size_t first, std::size_t last, std::size_t grain, F&& fn );
 
-      tasks.emplace( [task]() { (*task)(); } );
-    }
+private:
+  struct worker_queue
+  {
+    std::mutex                         mutex;
+    std::deque<std::function<void()>>  tasks;
+  };
 
-    condition.notify_one();
-    return res;
+  bool pop_task( unsigned index, std::function<void()>& task );
+  void worker_loop( unsigned index );
+
+private:
+  std::vector<std::thread>                   workers;
+  std::vector<std::unique_ptr<worker_queue>> queues;
+  std::atomic<std::size_t>                   queued{ 0u };
+  std::atomic<unsigned>                      next_queue{ 0u };
+  std::mutex                                 sleep_mutex;
+  std::condition_variable                    condition;
+  std::atomic<bool>                          stop{ false };
+};
+
+/* A set of tasks that can be waited for.  Tasks are plain std::function
+ * objects, no future or packaged_task is created per task.  wait() executes
+ * pending tasks of the pool while waiting and rethrows the first exception
+ * that was thrown by a task of the group. */
+class task_group
+{
+public:
+  explicit task_group( thread_pool& pool );
+  ~task_group();
+
+  task_group( const task_group& ) = delete;
+  task_group& operator=( const task_group& ) = delete;
+
+  template<class F>
+  void run( F&& f )
+  {
+    ++pending;
+    pool.submit( [this, f]() {
+        try
+        {
+          f();
+        }
+        catch ( ... )
+        {
+          std::lock_guard<std::mutex> lock( mutex );
+          if ( !exception ) { exception = std::current_exception(); }
+        }
+        finish();
+      } );
   }
 
+  void wait();
+
 private:
-  std::vector<std::thread>          workers;
-  std::queue<std::function<void()>> tasks;
-  std::mutex                        queue_mutex;
-  std::condition_variable           condition;
-  bool                              stop = false;
+  void finish();
+
+private:
+  thread_pool&            pool;
+  std::atomic<unsigned>   pending{ 0u };
+  std::mutex              mutex;
+  std::condition_variable done;
+  std::exception_ptr      exception;
 };
 
+/* process-wide pool with one thread per core, created on first use */
+thread_pool& shared_thread_pool();
+
+template<class F>
+void thread_pool::parallel_for( std::size_t first, std::size_t last, std::size_t grain, F&& fn )
+{
+  if ( first >= last ) { return; }
+  if ( grain == 0u ) { grain = 1u; }
+
+  if ( last - first <= grain || size() <= 1u )
+  {
+    for ( auto i = first; i < last; ++i )
+    {
+      fn( i );
+    }
+    return;
+  }
+
+  task_group group( *this );
+  for ( auto b = first + grain; b < last; b += grain )
+  {
+    const auto e = std::min( b + grain, last );
+    group.run( [&fn, b, e]() {
+        for ( auto i = b; i < e; ++i )
+        {
+          fn( i );
+        }
+      } );
+  }
+
+  for ( auto i = first; i < first + grain; ++i )
+  {
+    fn( i );
+  }
+  group.wait();
+}
+
 }
 
 #endif
@@ -0,0 +1,303 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#include "tokenizer.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+namespace cirkit
+{
+
+/******************************************************************************
+ * Types                                                                      *
+ ******************************************************************************/
+
+constexpr unsigned symbol_table::npos;
+
+/******************************************************************************
+ * Private functions                                                          *
+ ******************************************************************************/
+
+token_t symbol_table::store( token_t name )
+{
+  constexpr std::size_t chunk_size = 1u << 16u;
+
+  if ( name.size() > static_cast<std::size_t>( _chunk_end - _chunk_pos ) )
+  {
+    const auto size = std::max( chunk_size, name.size() );
+    _chunks.emplace_back( new char[size] );
+    _chunk_pos = _chunks.back().get();
+    _chunk_end = _chunk_pos + size;
+  }
+
+  auto* dest = _chunk_pos;
+  std::memcpy( dest, name.data(), name.size() );
+  _chunk_pos += name.size();
+
+  return token_t( dest, name.size() );
+}
+
+void tokenizer::initialize( const options& opts )
+{
+  _opts = opts;
+
+  _classes.fill( identifier_char );
+  for ( auto c : std::string( " \t\r\f\v" ) ) { _classes[static_cast<unsigned char>( c )] = space_char; }
+  _classes['\n'] = newline_char;
+  for ( auto c : opts.separators )  { _classes[static_cast<unsigned char>( c )] = space_char; }
+  for ( auto c : opts.punctuation ) { _classes[static_cast<unsigned char>( c )] = punctuation_char; }
+  if ( opts.hash_comments )  { _classes['#'] = comment_char; }
+  if ( opts.slash_comments ) { _classes['/'] = comment_char; }
+  if ( opts.line_continuation || opts.escaped_identifiers ) { _classes['\\'] = escape_char; }
+}
+
+/* skips spaces, comments, and (if not reported) newlines */
+void tokenizer::skip_space()
+{
+  while ( _pos != _end )
+  {
+    switch ( _classes[static_cast<unsigned char>( *_pos )] )
+    {
+    case space_char:
+      ++_pos;
+      break;
+
+    case newline_char:
+      if ( _opts.newlines ) { return; }
+      ++_line;
+      ++_pos;
+      break;
+
+    case comment_char:
+      if ( *_pos == '#' || ( _pos + 1 != _end && _pos[1] == '/' ) )
+      {
+        while ( _pos != _end && *_pos != '\n' ) { ++_pos; }
+      }
+      else if ( _pos + 1 != _end && _pos[1] == '*' )
+      {
+        _pos += 2;
+        while ( _pos != _end && !( *_pos == '*' && _pos + 1 != _end && _pos[1] == '/' ) )
+        {
+          if ( *_pos++ == '\n' ) { ++_line; }
+        }
+        _pos = _pos == _end ? _end : _pos + 2;
+      }
+      else
+      {
+        return; /* single '/' */
+      }
+      break;
+
+    case escape_char:
+      if ( is_line_continuation() )
+      {
+        ++_pos;
+        while ( *_pos == '\r' ) { ++_pos; }
+        ++_pos;
+        ++_line;
+        break;
+      }
+      return;
+
+    default:
+      return;
+    }
+  }
+}
+
+/* '\' followed by the end of the line */
+bool tokenizer::is_line_continuation() const
+{
+  if ( !_opts.line_continuation ) { return false; }
+
+  auto* p = _pos + 1;
+  while ( p != _end && *p == '\r' ) { ++p; }
+  return p != _end && *p == '\n';
+}
+
+/******************************************************************************
+ * Public functions                                                           *
+ ******************************************************************************/
+
+unsigned symbol_table::intern( token_t name )
+{
+  const auto it = _ids.find( name );
+  if ( it != _ids.end() )
+  {
+    return it->second;
+  }
+
+  const auto stored = store( name );
+  const auto id = static_cast<unsigned>( _names.size() );
+  _names.push_back( stored );
+  _ids.emplace( stored, id );
+  return id;
+}
+
+unsigned symbol_table::find( token_t name ) const
+{
+  const auto it = _ids.find( name );
+  return it == _ids.end() ? npos : it->second;
+}
+
+tokenizer::tokenizer( const std::string& filename, const options& opts )
+  : _file( filename )
+{
+  initialize( opts );
+
+  if ( _file.is_open() )
+  {
+    _pos = _file.size() ? _file.begin() : "";
+    _end = _file.size() ? _file.end() : _pos;
+  }
+}
+
+tokenizer::tokenizer( std::istream& in, const options& opts )
+  : _buffer( ( std::istreambuf_iterator<char>( in ) ), std::istreambuf_iterator<char>() )
+{
+  initialize( opts );
+
+  _pos = _buffer.data();
+  _end = _buffer.data() + _buffer.size();
+}
+
+tokenizer::token_kind tokenizer::next( token_t& token )
+{
+  if ( !_pos ) { return token_kind::end; }
+
+  skip_space();
+
+  if ( _pos == _end )
+  {
+    token = token_t();
+    return token_kind::end;
+  }
+
+  const auto* begin = _pos;
+  _token_line = _line;
+
+  switch ( _classes[static_cast<unsigned char>( *_pos )] )
+  {
+  case newline_char:
+    ++_line;
+    token = token_t( _pos++, 1u );
+    return token_kind::newline;
+
+  case punctuation_char:
+    token = token_t( _pos++, 1u );
+    return token_kind::punctuation;
+
+  case escape_char:
+    if ( _opts.escaped_identifiers )
+    {
+      /* Verilog escaped identifier, ends at white space only */
+      ++_pos;
+      while ( _pos != _end && _classes[static_cast<unsigned char>( *_pos )] != space_char && _classes[static_cast<unsigned char>( *_pos )] != newline_char ) { ++_pos; }
+      token = token_t( begin, _pos - begin );
+      return token_kind::identifier;
+    }
+    ++_pos;
+    break;
+
+  default:
+    ++_pos;
+    break;
+  }
+
+  while ( _pos != _end )
+  {
+    const auto cls = _classes[static_cast<unsigned char>( *_pos )];
+    if ( cls == identifier_char || ( cls == comment_char && *_pos == '/' && ( _pos + 1 == _end || ( _pos[1] != '/' && _pos[1] != '*' ) ) ) )
+    {
+      ++_pos;
+    }
+    else if ( cls == escape_char && !is_line_continuation() )
+    {
+      ++_pos;
+    }
+    else
+    {
+      break;
+    }
+  }
+
+  token = token_t( begin, _pos - begin );
+  return token_kind::identifier;
+}
+
+bool tokenizer::next_line( std::vector<token_t>& tokens )
+{
+  tokens.clear();
+
+  token_t token;
+  while ( true )
+  {
+    switch ( next( token ) )
+    {
+    case token_kind::end:
+      return !tokens.empty();
+    case token_kind::newline:
+      if ( !tokens.empty() ) { return true; }
+      break;
+    default:
+      tokens.push_back( token );
+    }
+  }
+}
+
+bool tokenizer::next_until( char c, std::vector<token_t>& tokens )
+{
+  tokens.clear();
+
+  token_t token;
+  while ( true )
+  {
+    switch ( next( token ) )
+    {
+    case token_kind::end:
+      return false;
+    case token_kind::punctuation:
+      if ( token[0] == c ) { return true; }
+      tokens.push_back( token );
+      break;
+    case token_kind::newline:
+      break;
+    default:
+      tokens.push_back( token );
+    }
+  }
+}
+
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
@@ -0,0 +1,175 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+/**
+ * @file tokenizer.hpp
+ *
+ * @brief Streaming tokenizer and symbol table for netlist readers
+ *
+ * The tokenizer walks over a memory mapped file (or an in-memory buffer)
+ * and returns tokens as views into that buffer, no memory is allocated per
+ * token.  A character class table decides which characters separate tokens,
+ * which are single-character punctuation, and where comments start, such
+ * that the same code serves BENCH, structural Verilog, and BLIF.  Names
+ * that need to outlive the buffer are interned into a symbol_table, which
+ * maps them to dense integer ids.
+ *
+ * @author Mathias Soeken
+ * @since  2.3
+ */
+
+#ifndef TOKENIZER_HPP
+#define TOKENIZER_HPP
+
+#include <array>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/utility/string_view.hpp>
+
+#include <core/utils/mapped_file.hpp>
+
+namespace cirkit
+{
+
+using token_t = boost::string_view;
+
+/******************************************************************************
+ * Symbol table                                                               *
+ ******************************************************************************/
+
+class symbol_table
+{
+public:
+  static constexpr unsigned npos = 0xffffffffu;
+
+  /* returns the id of name, adds it if it does not exist */
+  unsigned intern( token_t name );
+
+  /* returns npos if name does not exist */
+  unsigned find( token_t name ) const;
+
+  inline token_t name( unsigned id ) const      { return _names[id]; }
+  inline std::string str( unsigned id ) const   { return _names[id].to_string(); }
+  inline std::size_t size() const               { return _names.size(); }
+
+private:
+  struct hash
+  {
+    std::size_t operator()( token_t s ) const
+    {
+      std::uint64_t h = 0xcbf29ce484222325ull;
+      for ( auto c : s ) { h = ( h ^ static_cast<unsigned char>( c ) ) * 0x100000001b3ull; }
+      return h;
+    }
+  };
+
+  /* copies name into stable storage */
+  token_t store( token_t name );
+
+  std::unordered_map<token_t, unsigned, hash> _ids;
+  std::vector<token_t>                        _names;
+  std::vector<std::unique_ptr<char[]>>        _chunks;
+  char*                                       _chunk_pos = nullptr;
+  char*                                       _chunk_end = nullptr;
+};
+
+/******************************************************************************
+ * Tokenizer                                                                  *
+ ******************************************************************************/
+
+class tokenizer
+{
+public:
+  enum class token_kind { identifier, punctuation, newline, end };
+
+  struct options
+  {
+    std::string punctuation;          /* characters returned as single-character tokens */
+    std::string separators;           /* characters treated like white space, e.g., "(),=" for BENCH */
+    bool newlines            = false; /* returns end of lines as newline tokens */
+    bool hash_comments       = false; /* '#' comments until the end of the line */
+    bool slash_comments      = false; /* '//' and '/ * ... * /' comments */
+    bool line_continuation   = false; /* '\' before end of line joins lines (BLIF) */
+    bool escaped_identifiers = false; /* '\' starts an identifier that ends at whitespace (Verilog) */
+  };
+
+  /* maps the file, is_open() is false if it cannot be read */
+  tokenizer( const std::string& filename, const options& opts );
+
+  /* reads the whole stream into an internal buffer */
+  tokenizer( std::istream& in, const options& opts );
+
+  /* tokens point into the buffer */
+  tokenizer( const tokenizer& ) = delete;
+  tokenizer& operator=( const tokenizer& ) = delete;
+
+  inline bool is_open() const { return _pos != nullptr; }
+  inline unsigned line() const { return _line; }
+
+  /* line of the last token that is not the end of the input */
+  inline unsigned token_line() const { return _token_line; }
+
+  token_kind next( token_t& token );
+
+  /* tokens of the next non-empty line, requires newlines; false at the end of the input */
+  bool next_line( std::vector<token_t>& tokens );
+
+  /* tokens until the next punctuation token c (not included); false at the end of the input */
+  bool next_until( char c, std::vector<token_t>& tokens );
+
+private:
+  enum char_class : unsigned char { identifier_char, space_char, newline_char, punctuation_char, comment_char, escape_char };
+
+  void initialize( const options& opts );
+  void skip_space();
+  bool is_line_continuation() const;
+
+private:
+  mapped_file                        _file;
+  std::string                        _buffer;
+  const char*                        _pos = nullptr;
+  const char*                        _end = nullptr;
+  std::array<char_class, 256u>       _classes;
+  options                            _opts;
+  unsigned                           _line = 1u;
+  unsigned                           _token_line = 1u;
+};
+
+}
+
+#endif
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
@@ -0,0 +1,157 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE aig_compact
+
+#include <sstream>
+
+#include <boost/dynamic_bitset.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <classical/aig.hpp>
+#include <classical/aig_compact.hpp>
+#include <classical/functions/simulate_aig.hpp>
+#include <classical/functions/strash.hpp>
+#include <classical/io/write_aiger.hpp>
+#include <classical/utils/aig_utils.hpp>
+#include <classical/utils/truth_table_utils.hpp>
+
+using namespace cirkit;
+
+/* reads fanins from the graph that is passed to the callbacks */
+class fanin_level_simulator : public aig_compact_simulator<unsigned>
+{
+public:
+  unsigned get_input( aig_compact::node_t node, const std::string& name, unsigned pos, const aig_compact& aig ) const
+  {
+    BOOST_CHECK_EQUAL( aig.names().name( node ), name );
+    BOOST_CHECK( aig.is_ci( node ) );
+    return 0u;
+  }
+
+  unsigned get_constant() const { return 0u; }
+  unsigned invert( const unsigned& v ) const { return v; }
+  unsigned and_op( aig_compact::node_t node, const unsigned& v1, const unsigned& v2 ) const { return std::max( v1, v2 ) + 1u; }
+
+  bool terminate( aig_compact::node_t node, const aig_compact& aig ) const
+  {
+    /* do not go below AND gates with a complemented fanin */
+    return aig.is_and( node ) && aig.fanin( node, 0u ).complemented && aig.fanin( node, 1u ).complemented;
+  }
+};
+
+BOOST_AUTO_TEST_CASE(simple)
+{
+  aig_compact aig;
+
+  const auto a = aig_create_pi( aig, "a" );
+  const auto b = aig_create_pi( aig, "b" );
+  const auto c = aig_create_pi( aig, "c" );
+
+  const auto f = aig_create_maj( aig, a, b, c );
+  const auto g = aig_create_and( aig, b, a );
+
+  /* structural hashing and local optimization */
+  BOOST_CHECK( aig_create_and( aig, a, b ) == g );
+  BOOST_CHECK( aig_create_and( aig, a, !a ) == aig_get_constant( aig, false ) );
+  BOOST_CHECK( aig_create_and( aig, a, aig_get_constant( aig, true ) ) == a );
+
+  aig_create_po( aig, f, "maj" );
+  aig_create_po( aig, !g, "nand" );
+
+  BOOST_CHECK_EQUAL( aig.size(), 9u );
+  BOOST_CHECK_EQUAL( aig.num_ands(), 5u );
+  BOOST_CHECK_EQUAL( aig.inputs().size(), 3u );
+  BOOST_CHECK_EQUAL( aig.names().name( b.node ), "b" );
+
+  /* fanins are stored in topological order */
+  for ( aig_compact::node_t n = 1u; n < aig.size(); ++n )
+  {
+    if ( !aig.is_and( n ) ) { continue; }
+    BOOST_CHECK( aig.fanin( n, 0u ).node < n );
+    BOOST_CHECK( aig.fanin( n, 1u ).node < n );
+  }
+
+  /* simulation */
+  for ( auto p = 0u; p < 8u; ++p )
+  {
+    const boost::dynamic_bitset<> pattern( 3u, p );
+    const auto result = simulate_aig( aig, pattern_simulator( pattern ) );
+
+    BOOST_CHECK_EQUAL( result.at( f ), pattern.count() >= 2u );
+    BOOST_CHECK_EQUAL( result.at( !g ), !( pattern[0u] && pattern[1u] ) );
+  }
+
+  /* simulators get the compact AIG */
+  const auto levels = simulate_aig( aig, fanin_level_simulator() );
+  BOOST_CHECK_EQUAL( levels.at( !g ), 1u );
+  BOOST_CHECK_EQUAL( simulate_aig( aig, depth_simulator() ).at( f ), levels.at( f ) + 1u );
+
+  /* conversion into aig_graph and back */
+  aig_graph aig2;
+  aig_initialize( aig2 );
+  strash( aig, aig2 );
+
+  BOOST_CHECK_EQUAL( aig_info( aig2 ).inputs.size(), 3u );
+  BOOST_CHECK_EQUAL( aig_info( aig2 ).outputs.size(), 2u );
+  BOOST_CHECK_EQUAL( num_vertices( aig2 ), 9u );
+
+  const auto aig3 = aig_to_compact( aig2 );
+  BOOST_CHECK_EQUAL( aig3.size(), 9u );
+  BOOST_CHECK_EQUAL( aig3.num_ands(), 5u );
+
+  std::stringstream s1, s2;
+  write_aiger( aig, s1 );
+  write_aiger( aig3, s2 );
+  BOOST_CHECK_EQUAL( s1.str(), s2.str() );
+}
+
+BOOST_AUTO_TEST_CASE(truth_tables_and_memory)
+{
+  aig_compact aig;
+
+  const auto a = aig_create_pi( aig, "a" );
+  const auto b = aig_create_pi( aig, "b" );
+  const auto c = aig_create_pi( aig, "c" );
+  const auto f = aig_create_maj( aig, a, b, c );
+  aig_create_po( aig, f, "maj" );
+
+  auto t = simulate_aig( aig, tt_simulator() ).at( f );
+  tt_shrink( t, 3u );
+  BOOST_CHECK( t == tt( 8u, 0xe8u ) );
+
+  /* memory includes the name side table */
+  const auto before = aig.memory();
+  aig.names().annotations[f.node]["comment"] = std::string( 100u, 'x' );
+  BOOST_CHECK_GE( aig.memory(), before + 100u );
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
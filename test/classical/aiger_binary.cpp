@@ -0,0 +1,152 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE aiger_binary
+
+#include <cstdio>
+#include <sstream>
+#include <string>
+
+#include <boost/dynamic_bitset.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <classical/aig.hpp>
+#include <classical/aig_compact.hpp>
+#include <classical/functions/simulate_aig.hpp>
+#include <classical/io/read_aiger.hpp>
+#include <classical/io/write_aiger.hpp>
+#include <classical/utils/aig_utils.hpp>
+
+using namespace cirkit;
+
+BOOST_AUTO_TEST_CASE(read_example)
+{
+  /* AND gate from the AIGER format description */
+  std::stringstream s( std::string( "aig 3 2 0 1 1\n6\n\x02\x02i0 x\ni1 y\no0 o\nc\ncomment\n" ) );
+
+  aig_graph aig;
+  read_aiger_binary( aig, s );
+
+  const auto& info = aig_info( aig );
+  BOOST_CHECK_EQUAL( info.inputs.size(), 2u );
+  BOOST_CHECK_EQUAL( info.outputs.size(), 1u );
+  BOOST_CHECK_EQUAL( info.outputs[0u].second, "o" );
+  BOOST_CHECK_EQUAL( info.node_names.at( info.inputs[1u] ), "y" );
+
+  for ( auto p = 0u; p < 4u; ++p )
+  {
+    const boost::dynamic_bitset<> pattern( 2u, p );
+    BOOST_CHECK_EQUAL( simulate_aig( aig, pattern_simulator( pattern ) ).at( info.outputs[0u].first ), p == 3u );
+  }
+}
+
+BOOST_AUTO_TEST_CASE(round_trip)
+{
+  /* inputs are created after gates to check renumbering */
+  aig_compact aig;
+  const auto a = aig_create_pi( aig, "a" );
+  const auto b = aig_create_pi( aig, "b" );
+  const auto g = aig_create_xor( aig, a, b );
+  const auto c = aig_create_pi( aig, "c" );
+  const auto l = aig_create_lat( aig, !g, "state" );
+  aig_create_po( aig, aig_create_maj( aig, g, c, l ), "maj" );
+  aig_create_po( aig, !c, "" );
+
+  std::stringstream s;
+  write_aiger_binary( aig, s );
+
+  aig_compact aig2;
+  read_aiger_binary( aig2, s );
+
+  BOOST_CHECK_EQUAL( aig2.inputs().size(), 3u );
+  BOOST_CHECK_EQUAL( aig2.cis().size(), 1u );
+  BOOST_CHECK_EQUAL( aig2.outputs().size(), 2u );
+  BOOST_CHECK_EQUAL( aig2.num_ands(), aig.num_ands() );
+  BOOST_CHECK_EQUAL( aig2.names().name( aig2.cis()[0u] ), "state" );
+  BOOST_CHECK_EQUAL( aig2.names().output_names[0u], "maj" );
+
+  /* second round trip through aig_graph and a file is stable */
+  const auto filename = std::string( "/tmp/test_aiger_binary.aig" );
+  write_aiger_binary( aig2, filename );
+
+  aig_graph aig3;
+  read_aiger_binary( aig3, filename );
+  std::remove( filename.c_str() );
+
+  BOOST_CHECK_EQUAL( aig_info( aig3 ).cis.size(), 1u );
+  BOOST_CHECK_EQUAL( aig_info( aig3 ).cos.size(), 1u );
+
+  std::stringstream s2, s3;
+  write_aiger_binary( aig2, s2 );
+  write_aiger_binary( aig3, s3 );
+  BOOST_CHECK_EQUAL( s.str(), s2.str() );
+  BOOST_CHECK_EQUAL( s2.str(), s3.str() );
+
+  /* combinational behavior, latch output is the last input of the pattern */
+  for ( auto p = 0u; p < 16u; ++p )
+  {
+    const boost::dynamic_bitset<> pattern( 4u, p );
+    const auto expected = ( ( pattern[0u] != pattern[1u] ) + pattern[2u] + pattern[3u] ) >= 2u;
+    const auto result = simulate_aig( aig2, pattern_simulator( pattern ) );
+    BOOST_CHECK_EQUAL( result.at( aig2.output( 0u ) ), expected );
+    BOOST_CHECK_EQUAL( result.at( aig2.output( 1u ) ), !pattern[2u] );
+  }
+}
+
+BOOST_AUTO_TEST_CASE(broken_files)
+{
+  aig_compact aig;
+
+  std::stringstream s1( std::string( "aig 3 2 0 1 2\n6\n\x02\x02" ) );
+  BOOST_CHECK_THROW( read_aiger_binary( aig, s1 ), const char* );
+
+  std::stringstream s2( std::string( "aig 3 2 0 1 1\n6\n\x02" ) );
+  BOOST_CHECK_THROW( read_aiger_binary( aig, s2 ), const char* );
+
+  std::stringstream s3( std::string( "aig 3 2 0 1 1\n6\n\x08\x02" ) );
+  BOOST_CHECK_THROW( read_aiger_binary( aig, s3 ), const char* );
+
+  /* deltas must fit into 32 bits */
+  const auto is_overflow = []( const char* msg ) { return std::string( msg ) == "Error: delta in AND gate section exceeds 32 bits"; };
+
+  std::stringstream s4( std::string( "aig 3 2 0 1 1\n6\n\x82\x80\x80\x80\x80\x01\x02" ) );
+  BOOST_CHECK_EXCEPTION( read_aiger_binary( aig, s4 ), const char*, is_overflow );
+
+  std::stringstream s5( std::string( "aig 3 2 0 1 1\n6\n\x82\x80\x80\x80\x10\x02" ) );
+  BOOST_CHECK_EXCEPTION( read_aiger_binary( aig, s5 ), const char*, is_overflow );
+
+  /* largest 32-bit delta is decoded and then rejected as invalid */
+  std::stringstream s6( std::string( "aig 3 2 0 1 1\n6\n\xff\xff\xff\xff\x0f\x02" ) );
+  BOOST_CHECK_EXCEPTION( read_aiger_binary( aig, s6 ), const char*, []( const char* msg ) { return std::string( msg ) == "Error: invalid delta in AND gate section"; } );
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
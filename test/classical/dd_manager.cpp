@@ -0,0 +1,384 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE dd_manager
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <classical/dd/bdd.hpp>
+#include <classical/dd/count_solutions.hpp>
+#include <classical/dd/zdd.hpp>
+#include <classical/dd/zdd_to_sets.hpp>
+
+using namespace cirkit;
+
+bool evaluate( const bdd& f, unsigned assignment )
+{
+  auto n = f;
+  while ( n.index > 1u )
+  {
+    n = ( ( assignment >> n.var() ) & 1u ) ? n.high() : n.low();
+  }
+  return n.is_top();
+}
+
+bdd random_function( bdd_manager& mgr, std::mt19937& gen, unsigned depth )
+{
+  if ( depth == 0u )
+  {
+    const auto x = mgr.bdd_var( gen() % mgr.num_vars() );
+    return gen() % 2u ? x : !x;
+  }
+
+  const auto a = random_function( mgr, gen, depth - 1u );
+  const auto b = random_function( mgr, gen, depth - 1u );
+  switch ( gen() % 4u )
+  {
+  case 0u: return a && b;
+  case 1u: return a || b;
+  case 2u: return a ^ b;
+  default: return !( a && !b );
+  }
+}
+
+bdd queens( bdd_manager& mgr, unsigned n )
+{
+  const auto x = [&mgr, n]( unsigned r, unsigned c ) { return mgr.bdd_var( r * n + c ); };
+
+  auto f = mgr.bdd_top();
+  for ( auto r = 0u; r < n; ++r )
+  {
+    auto row = mgr.bdd_bot();
+    for ( auto c = 0u; c < n; ++c )
+    {
+      row = row || x( r, c );
+    }
+    f = f && row;
+  }
+
+  for ( auto r = 0u; r < n; ++r )
+  {
+    for ( auto c = 0u; c < n; ++c )
+    {
+      for ( auto r2 = 0u; r2 < n; ++r2 )
+      {
+        for ( auto c2 = 0u; c2 < n; ++c2 )
+        {
+          if ( r == r2 && c == c2 ) { continue; }
+          if ( r == r2 || c == c2 || r + c2 == r2 + c || r + c == r2 + c2 )
+          {
+            f = f && !( x( r, c ) && x( r2, c2 ) );
+          }
+        }
+      }
+    }
+  }
+
+  return f;
+}
+
+BOOST_AUTO_TEST_CASE( grow_from_small_table )
+{
+  /* 2^4 nodes is far too small, tables must grow on demand */
+  bdd_manager mgr( 36u, 4u );
+  const auto f = queens( mgr, 6u );
+
+  BOOST_CHECK_EQUAL( count_solutions( f ), 4u );
+  BOOST_CHECK( mgr.capacity() > 16u );
+}
+
+BOOST_AUTO_TEST_CASE( garbage_collection )
+{
+  bdd_manager mgr( 16u, 10u );
+  bdd_manager mgr_nogc( 16u, 10u );
+  mgr_nogc.set_garbage_collection( false );
+
+  std::mt19937 gen( 42u );
+  std::vector<bdd> kept, kept_nogc;
+
+  for ( auto i = 0u; i < 2000u; ++i )
+  {
+    /* random function, all intermediate results become garbage */
+    auto f = mgr.bdd_bot();
+    auto g = mgr_nogc.bdd_bot();
+    for ( auto j = 0u; j < 6u; ++j )
+    {
+      auto c = mgr.bdd_top();
+      auto d = mgr_nogc.bdd_top();
+      for ( auto k = 0u; k < 16u; ++k )
+      {
+        switch ( gen() % 3u )
+        {
+        case 0u: c = c && mgr.bdd_var( k ); d = d && mgr_nogc.bdd_var( k ); break;
+        case 1u: c = c && !mgr.bdd_var( k ); d = d && !mgr_nogc.bdd_var( k ); break;
+        default: break;
+        }
+      }
+      f = f ^ c;
+      g = g ^ d;
+    }
+
+    BOOST_CHECK_EQUAL( count_solutions( f ), count_solutions( g ) );
+    if ( i % 100u == 0u )
+    {
+      kept.push_back( f );
+      kept_nogc.push_back( g );
+    }
+  }
+
+  /* kept functions survive collections */
+  for ( auto i = 0u; i < kept.size(); ++i )
+  {
+    BOOST_CHECK_EQUAL( count_solutions( kept[i] ), count_solutions( kept_nogc[i] ) );
+  }
+
+  mgr.garbage_collect();
+  BOOST_CHECK( mgr.size() < mgr_nogc.size() );
+}
+
+BOOST_AUTO_TEST_CASE( complement_edges )
+{
+  bdd_manager mgr( 6u, 8u );
+  std::mt19937 gen( 7u );
+
+  /* parity needs one node per variable */
+  auto parity = mgr.bdd_bot();
+  for ( auto i = 0u; i < 6u; ++i )
+  {
+    parity = parity ^ mgr.bdd_var( i );
+  }
+  mgr.garbage_collect();
+  BOOST_CHECK_EQUAL( mgr.size(), 2u + 6u + 5u );
+
+  for ( auto k = 0u; k < 200u; ++k )
+  {
+    const auto f = random_function( mgr, gen, 3u );
+    const auto g = random_function( mgr, gen, 3u );
+
+    /* canonicity */
+    BOOST_CHECK( ( !!f ).equals( f ) );
+    BOOST_CHECK( ( f ^ g ).equals( ( f && !g ) || ( !f && g ) ) );
+    BOOST_CHECK( ( f || g ).equals( !( !f && !g ) ) );
+
+    const auto c = f.constrain( g );
+    const auto r = f.restrict( g );
+    const auto e = f.exists( mgr.bdd_var( 1u ) && mgr.bdd_var( 3u ) );
+
+    for ( auto x = 0u; x < 64u; ++x )
+    {
+      const auto vf = evaluate( f, x ), vg = evaluate( g, x );
+      BOOST_CHECK_EQUAL( evaluate( f && g, x ), vf && vg );
+      BOOST_CHECK_EQUAL( evaluate( f || g, x ), vf || vg );
+      BOOST_CHECK_EQUAL( evaluate( f ^ g, x ), vf != vg );
+      BOOST_CHECK_EQUAL( evaluate( !f, x ), !vf );
+      BOOST_CHECK_EQUAL( evaluate( f.cof0( 2u ), x ), evaluate( f, x & ~4u ) );
+      BOOST_CHECK_EQUAL( evaluate( f.cof1( 2u ), x ), evaluate( f, x | 4u ) );
+      BOOST_CHECK_EQUAL( evaluate( e, x ), evaluate( f, x & ~10u ) || evaluate( f, ( x & ~10u ) | 2u ) ||
+                                          evaluate( f, ( x & ~10u ) | 8u ) || evaluate( f, x | 10u ) );
+      if ( vg )
+      {
+        BOOST_CHECK_EQUAL( evaluate( c, x ), vf );
+        BOOST_CHECK_EQUAL( evaluate( r, x ), vf );
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE( sifting )
+{
+  /* x0 x4 + x1 x5 + x2 x6 + x3 x7 is exponential in the identity order */
+  const auto n = 4u;
+  bdd_manager mgr( 2u * n, 10u );
+
+  auto f = mgr.bdd_bot();
+  for ( auto i = 0u; i < n; ++i )
+  {
+    f = f || ( mgr.bdd_var( i ) && mgr.bdd_var( i + n ) );
+  }
+
+  std::mt19937 gen( 3u );
+  std::vector<bdd> gs;
+  for ( auto i = 0u; i < 20u; ++i )
+  {
+    gs.push_back( random_function( mgr, gen, 3u ) );
+  }
+
+  std::vector<std::vector<bool>> values;
+  for ( const auto& g : gs )
+  {
+    values.push_back( std::vector<bool>() );
+    for ( auto x = 0u; x < 256u; ++x )
+    {
+      values.back().push_back( evaluate( g, x ) );
+    }
+  }
+  const auto solutions = count_solutions( f );
+
+  gs.push_back( f );
+  mgr.garbage_collect();
+  const auto before = mgr.size();
+  mgr.reorder();
+  BOOST_CHECK( mgr.size() < before );
+
+  /* every variable is on exactly one level */
+  std::vector<bool> seen( 2u * n );
+  for ( auto l = 0u; l < 2u * n; ++l )
+  {
+    BOOST_CHECK_EQUAL( mgr.level( mgr.var_at_level( l ) ), l );
+    seen[mgr.var_at_level( l )] = true;
+  }
+  BOOST_CHECK( std::find( seen.begin(), seen.end(), false ) == seen.end() );
+
+  /* handles keep their functions */
+  BOOST_CHECK_EQUAL( count_solutions( f ), solutions );
+  for ( auto i = 0u; i < values.size(); ++i )
+  {
+    for ( auto x = 0u; x < 256u; ++x )
+    {
+      BOOST_CHECK_EQUAL( evaluate( gs[i], x ), values[i][x] );
+    }
+  }
+
+  /* operations after reordering agree with the old results */
+  auto h = mgr.bdd_bot();
+  for ( auto i = 0u; i < n; ++i )
+  {
+    h = h || ( mgr.bdd_var( i ) && mgr.bdd_var( i + n ) );
+  }
+  BOOST_CHECK( h.equals( f ) );
+  BOOST_CHECK( ( gs[0u] && gs[1u] ).equals( !( !gs[0u] || !gs[1u] ) ) );
+  for ( auto x = 0u; x < 256u; ++x )
+  {
+    BOOST_CHECK_EQUAL( evaluate( gs[2u].cof1( 5u ), x ), values[2u][x | 32u] );
+  }
+}
+
+BOOST_AUTO_TEST_CASE( dynamic_reordering )
+{
+  const auto n = 6u;
+  bdd_manager mgr( 2u * n, 8u );
+  mgr.set_dynamic_reordering( true, 64u );
+
+  auto f = mgr.bdd_bot();
+  for ( auto i = 0u; i < n; ++i )
+  {
+    f = f || ( mgr.bdd_var( i ) && mgr.bdd_var( i + n ) );
+  }
+  BOOST_CHECK_EQUAL( count_solutions( f ), 4096u - 729u );
+
+  std::vector<unsigned> identity( 2u * n );
+  std::iota( identity.begin(), identity.end(), 0u );
+  BOOST_CHECK( mgr.order() != identity );
+}
+
+BOOST_AUTO_TEST_CASE( parallel_apply )
+{
+  const auto n = 10u;
+  bdd_manager seq( n, 12u );
+  bdd_manager par( n, 6u ); /* small table, forces restarts after growing */
+  par.set_parallel_apply( true, 4u );
+
+  std::mt19937 gen_seq( 7u ), gen_par( 7u );
+  for ( auto k = 0u; k < 20u; ++k )
+  {
+    const auto f = random_function( seq, gen_seq, 6u );
+    const auto g = random_function( par, gen_par, 6u );
+    const auto ex = par.bdd_var( 1u ) && par.bdd_var( 4u );
+
+    for ( auto a = 0u; a < ( 1u << n ); ++a )
+    {
+      BOOST_CHECK_EQUAL( evaluate( f, a ), evaluate( g, a ) );
+
+      const auto e = evaluate( g, a & ~0x12u ) || evaluate( g, ( a & ~0x12u ) | 0x02u ) ||
+                     evaluate( g, ( a & ~0x12u ) | 0x10u ) || evaluate( g, a | 0x12u );
+      BOOST_CHECK_EQUAL( evaluate( g.exists( ex ), a ), e );
+    }
+  }
+
+  bdd_manager qpar( 25u, 8u );
+  qpar.set_parallel_apply( true, 3u, 6u );
+  BOOST_CHECK_EQUAL( count_solutions( queens( qpar, 5u ) ), 10u );
+}
+
+BOOST_AUTO_TEST_CASE( zdd_sifting )
+{
+  zdd_manager mgr( 8u, 6u );
+
+  auto family = mgr.zdd_bot();
+  for ( auto i = 0u; i < 4u; ++i )
+  {
+    family = family || ( mgr.zdd_var( i ) + mgr.zdd_var( i + 4u ) );
+  }
+  family = family + family;
+  auto sets = zdd_to_sets( family );
+  std::sort( sets.begin(), sets.end() );
+
+  mgr.reorder();
+  auto sets2 = zdd_to_sets( family );
+  std::sort( sets2.begin(), sets2.end() );
+  BOOST_CHECK( sets == sets2 );
+  BOOST_CHECK( ( family || mgr.zdd_bot() ).equals( family ) );
+}
+
+BOOST_AUTO_TEST_CASE( zdd_garbage_collection )
+{
+  zdd_manager mgr( 8u, 6u );
+
+  auto keep = mgr.zdd_bot();
+  for ( auto i = 0u; i < 200u; ++i )
+  {
+    auto s = mgr.zdd_top();
+    for ( auto v = 0u; v < 8u; ++v )
+    {
+      if ( ( i >> ( v % 4u ) ) & 1u )
+      {
+        s = s + mgr.zdd_var( v );
+      }
+    }
+    keep = keep || s;
+    keep = keep - mgr.zdd_var( i % 8u );
+  }
+
+  const auto before = mgr.size();
+  mgr.garbage_collect();
+  BOOST_CHECK( mgr.size() <= before );
+
+  /* structure is unchanged after collection */
+  const auto copy = keep || mgr.zdd_bot();
+  BOOST_CHECK( copy.equals( keep ) );
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
@@ -0,0 +1,148 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE exact_database
+
+#include <cstdio>
+#include <fstream>
+#include <random>
+
+#include <boost/test/unit_test.hpp>
+
+#include <classical/mig/mig_simulate.hpp>
+#include <classical/utils/exact_database.hpp>
+#include <classical/utils/truth_table_utils.hpp>
+#include <classical/xmg/xmg_simulate.hpp>
+
+using namespace cirkit;
+
+/* sum of minterms, not optimum but sufficient to test the transformations */
+mig_graph mig_from_minterms( const tt& spec )
+{
+  const auto n = tt_num_vars( spec );
+
+  mig_graph mig;
+  mig_initialize( mig );
+  std::vector<mig_function> pis;
+  for ( auto i = 0u; i < n; ++i )
+  {
+    pis.push_back( mig_create_pi( mig, "x" + std::to_string( i ) ) );
+  }
+
+  auto f = mig_get_constant( mig, false );
+  for ( auto m = 0u; m < spec.size(); ++m )
+  {
+    if ( !spec[m] ) { continue; }
+    auto cube = mig_get_constant( mig, true );
+    for ( auto i = 0u; i < n; ++i )
+    {
+      cube = mig_create_and( mig, cube, pis[i] ^ !( ( m >> i ) & 1u ) );
+    }
+    f = mig_create_or( mig, f, cube );
+  }
+  mig_create_po( mig, f, "f" );
+  return mig;
+}
+
+BOOST_AUTO_TEST_CASE(npn_lookup)
+{
+  const std::string filename = "exact_database_test.db";
+  std::remove( filename.c_str() );
+
+  std::mt19937 gen( 42u );
+  std::vector<tt> functions;
+  for ( auto i = 0u; i < 50u; ++i )
+  {
+    functions.push_back( tt( 16u, gen() & 0xffffu ) );
+  }
+
+  {
+    exact_database db( filename );
+    BOOST_CHECK( db.is_open() );
+
+    for ( const auto& f : functions )
+    {
+      db.insert_mig( f, 0u, mig_from_minterms( f ) );
+
+      /* complement and NPN equivalent functions are found as well */
+      const auto g = ~f;
+      const auto mig = db.find_mig( g, 0u );
+      BOOST_REQUIRE( (bool)mig );
+      BOOST_CHECK( mig_simulate_output( *mig, mig_info( *mig ).inputs.size() ) == g );
+
+      BOOST_CHECK( !db.find_mig( f, 1u ) );
+      BOOST_CHECK( !db.find_xmg( f, 0u ) );
+    }
+  }
+
+  /* persistent, and a torn record at the end is dropped on the next insert */
+  {
+    std::ofstream os( filename.c_str(), std::ofstream::out | std::ofstream::app | std::ofstream::binary );
+    os.write( "EXBRgarbage", 11u );
+  }
+
+  {
+    exact_database db( filename );
+    BOOST_CHECK( db.is_open() );
+    const auto before = db.size();
+    BOOST_CHECK( before > 0u );
+
+    for ( const auto& f : functions )
+    {
+      const auto mig = db.find_mig( f, 0u );
+      BOOST_REQUIRE( (bool)mig );
+      BOOST_CHECK( mig_simulate_output( *mig, mig_info( *mig ).inputs.size() ) == f );
+    }
+
+    tt f( 8u, 0xe8u );
+    xmg_graph xmg;
+    const auto a = xmg.create_pi( "a" ), b = xmg.create_pi( "b" ), c = xmg.create_pi( "c" );
+    xmg.create_po( xmg.create_maj( a, b, c ), "f" );
+    BOOST_CHECK( db.insert_xmg( f, 0u, xmg ) );
+    BOOST_CHECK( !db.insert_xmg( f, 0u, xmg ) );
+    BOOST_CHECK_EQUAL( db.size(), before + 1u );
+
+    const auto g = tt( 8u, 0xd4u ); /* maj( !a, b, c ) */
+    const auto xmg2 = db.find_xmg( g, 0u );
+    BOOST_REQUIRE( (bool)xmg2 );
+    BOOST_CHECK( xmg_simulate_output( *xmg2, xmg2->inputs().size() ) == g );
+    BOOST_CHECK_EQUAL( xmg2->num_gates(), 1u );
+  }
+
+  {
+    exact_database db( filename );
+    BOOST_CHECK( (bool)db.find_xmg( tt( 8u, 0xe8u ), 0u ) );
+  }
+
+  std::remove( filename.c_str() );
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
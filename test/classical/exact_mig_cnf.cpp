@@ -0,0 +1,112 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE exact_mig_cnf
+
+#include <boost/test/unit_test.hpp>
+
+#include <classical/functions/exact_mig_cnf.hpp>
+#include <classical/mig/mig_simulate.hpp>
+#include <classical/mig/mig_utils.hpp>
+#include <classical/utils/truth_table_utils.hpp>
+#include <classical/xmg/xmg_simulate.hpp>
+
+using namespace cirkit;
+
+BOOST_AUTO_TEST_CASE( all_three_input_functions )
+{
+  for ( auto v = 0u; v < 256u; ++v )
+  {
+    const tt spec( 8u, v );
+
+    const auto mig = exact_mig_with_cnf( spec );
+    BOOST_REQUIRE( (bool)mig );
+    BOOST_CHECK( mig_simulate_output( *mig, 3u ) == spec );
+
+    const auto xmg = exact_xmg_with_cnf( spec );
+    BOOST_REQUIRE( (bool)xmg );
+    BOOST_CHECK( xmg_simulate_output( *xmg, 3u ) == spec );
+  }
+}
+
+BOOST_AUTO_TEST_CASE( optimum_sizes )
+{
+  BOOST_CHECK_EQUAL( number_of_gates( *exact_mig_with_cnf( tt( 8u, 0xe8u ) ) ), 1u );
+  BOOST_CHECK_EQUAL( number_of_gates( *exact_mig_with_cnf( tt( 8u, 0x96u ) ) ), 3u );
+  BOOST_CHECK_EQUAL( number_of_gates( *exact_mig_with_cnf( tt( 16u, 0x7888u ) ) ), 5u );
+  BOOST_CHECK_EQUAL( exact_xmg_with_cnf( tt( 8u, 0x96u ) )->num_gates(), 2u );
+}
+
+BOOST_AUTO_TEST_CASE( depth_objective )
+{
+  const tt spec( 16u, 0x7888u );
+
+  auto settings = std::make_shared<properties>();
+  const auto by_size = exact_mig_with_cnf( spec, settings );
+
+  settings->set( "objective", 2u );
+  const auto by_depth = exact_mig_with_cnf( spec, settings );
+
+  const auto depth = []( const mig_graph& mig ) { return simulate_mig_function( mig, mig_info( mig ).outputs.front().first, mig_depth_simulator() ); };
+
+  BOOST_CHECK( mig_simulate_output( *by_depth, 4u ) == spec );
+  BOOST_CHECK( depth( *by_depth ) <= depth( *by_size ) );
+  BOOST_CHECK( number_of_gates( *by_depth ) >= number_of_gates( *by_size ) );
+}
+
+BOOST_AUTO_TEST_CASE( enumerate_solutions )
+{
+  auto settings = std::make_shared<properties>();
+  auto statistics = std::make_shared<properties>();
+  settings->set( "max_solutions", 3u );
+
+  const tt spec( 8u, 0x96u );
+  exact_mig_with_cnf( spec, settings, statistics );
+
+  const auto& solutions = statistics->get<std::vector<mig_graph>>( "all_solutions" );
+  BOOST_CHECK_EQUAL( solutions.size(), 3u );
+  for ( const auto& mig : solutions )
+  {
+    BOOST_CHECK( mig_simulate_output( mig, 3u ) == spec );
+    BOOST_CHECK_EQUAL( number_of_gates( mig ), 3u );
+  }
+}
+
+BOOST_AUTO_TEST_CASE( cancel )
+{
+  auto settings = std::make_shared<properties>();
+  settings->set( "cancel", std::function<bool()>( []() { return true; } ) );
+
+  BOOST_CHECK( !(bool)exact_mig_with_cnf( tt( 16u, 0x7888u ), settings ) );
+  BOOST_CHECK( (bool)exact_mig_with_cnf( tt( 16u, 0x7888u ) ) );
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
@@ -0,0 +1,251 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE netlist_readers
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <type_traits>
+
+#include <boost/dynamic_bitset.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <core/utils/tokenizer.hpp>
+#include <classical/aig.hpp>
+#include <classical/functions/simulate_aig.hpp>
+#include <classical/io/read_bench.hpp>
+#include <classical/io/read_blif.hpp>
+#include <classical/utils/aig_utils.hpp>
+#include <classical/utils/truth_table_utils.hpp>
+#include <classical/xmg/xmg_io.hpp>
+#include <classical/xmg/xmg_simulate.hpp>
+
+using namespace cirkit;
+
+std::string write_file( const std::string& extension, const std::string& content )
+{
+  const auto filename = "/tmp/test_netlist_readers." + extension;
+  std::ofstream os( filename.c_str(), std::ofstream::out );
+  os << content;
+  return filename;
+}
+
+template<typename Fn>
+std::string error_of( Fn&& fn )
+{
+  try
+  {
+    fn();
+  }
+  catch ( const std::string& e )
+  {
+    return e;
+  }
+  return std::string();
+}
+
+BOOST_AUTO_TEST_CASE(tokenizer_lines)
+{
+  BOOST_CHECK( !std::is_copy_constructible<tokenizer>::value );
+  BOOST_CHECK( !std::is_copy_assignable<tokenizer>::value );
+
+  tokenizer::options opts;
+  opts.newlines          = true;
+  opts.hash_comments     = true;
+  opts.line_continuation = true;
+
+  /* '\' inside a name does not split it, before the end of a line it joins lines */
+  std::stringstream s( ".names a\\b c \\\n d # comment\n\n11 1" );
+  tokenizer tok( s, opts );
+
+  std::vector<token_t> tokens;
+  BOOST_CHECK( tok.next_line( tokens ) );
+  BOOST_CHECK_EQUAL( tokens.size(), 4u );
+  BOOST_CHECK_EQUAL( tokens[1u], "a\\b" );
+  BOOST_CHECK_EQUAL( tokens[2u], "c" );
+  BOOST_CHECK_EQUAL( tokens[3u], "d" );
+  BOOST_CHECK_EQUAL( tok.token_line(), 2u );
+
+  /* last line has no newline */
+  BOOST_CHECK( tok.next_line( tokens ) );
+  BOOST_CHECK_EQUAL( tokens.size(), 2u );
+  BOOST_CHECK_EQUAL( tok.token_line(), 4u );
+  BOOST_CHECK( !tok.next_line( tokens ) );
+}
+
+BOOST_AUTO_TEST_CASE(bench)
+{
+  const auto filename = write_file( "bench", "# example\nINPUT(a)\nINPUT(b)\nINPUT(c)\nOUTPUT(f)\nOUTPUT(g)\nt = NAND(a, b)\nf = XOR(t, c)\ng = NOT(a)" );
+
+  aig_graph aig;
+  read_bench( aig, filename );
+
+  const auto& info = aig_info( aig );
+  BOOST_CHECK_EQUAL( info.inputs.size(), 3u );
+  BOOST_CHECK_EQUAL( info.outputs.size(), 2u );
+  BOOST_CHECK_EQUAL( info.outputs[0u].second, "f" );
+  BOOST_CHECK_EQUAL( info.outputs[1u].second, "g" );
+
+  for ( auto p = 0u; p < 8u; ++p )
+  {
+    const boost::dynamic_bitset<> pattern( 3u, p );
+    const auto result = simulate_aig( aig, pattern_simulator( pattern ) );
+    BOOST_CHECK_EQUAL( result.at( info.outputs[0u].first ), !( pattern[0u] && pattern[1u] ) != pattern[2u] );
+    BOOST_CHECK_EQUAL( result.at( info.outputs[1u].first ), !pattern[0u] );
+  }
+
+  /* b is never defined */
+  write_file( "bench", "INPUT(a)\nOUTPUT(f)\nf = AND(a, b)" );
+  aig_graph aig2;
+  BOOST_CHECK_EQUAL( error_of( [&]() { read_bench( aig2, filename ); } ), "undefined signal 'b' in line 3" );
+
+  write_file( "bench", "INPUT(a)\nOUTPUT(f)\ng = NOT(a)\n" );
+  aig_graph aig3;
+  BOOST_CHECK_EQUAL( error_of( [&]() { read_bench( aig3, filename ); } ), "undefined output 'f'" );
+
+  std::remove( filename.c_str() );
+}
+
+BOOST_AUTO_TEST_CASE(lut_bench)
+{
+  /* the last two lines cannot be matched and are skipped */
+  const auto filename = write_file( "bench", "INPUT(a)\nINPUT(b)\nOUTPUT(f)\nf = LUT 0x6 (t, b)\nt = LUT 0x1 (a)\nh = LUT (a)\nk = LUT 0x" );
+
+  lut_graph_t lut;
+  read_bench( lut, filename );
+  std::remove( filename.c_str() );
+
+  const auto types = boost::get( boost::vertex_lut_type, lut );
+  const auto luts  = boost::get( boost::vertex_lut, lut );
+  const auto names = boost::get( boost::vertex_name, lut );
+
+  /* gnd, vdd, a, b, t, f, and the output */
+  BOOST_CHECK_EQUAL( boost::num_vertices( lut ), 7u );
+
+  auto num_internal = 0u, num_outputs = 0u;
+  for ( const auto& v : boost::make_iterator_range( boost::vertices( lut ) ) )
+  {
+    if ( types[v] == lut_type_t::internal )
+    {
+      ++num_internal;
+      if ( boost::out_degree( v, lut ) == 2u )
+      {
+        BOOST_CHECK_EQUAL( luts[v], "6" );
+        const auto t = boost::target( *boost::out_edges( v, lut ).first, lut );
+        BOOST_CHECK( types[t] == lut_type_t::internal );
+        BOOST_CHECK_EQUAL( luts[t], "1" );
+      }
+      else
+      {
+        BOOST_CHECK_EQUAL( boost::out_degree( v, lut ), 1u );
+      }
+    }
+    else if ( types[v] == lut_type_t::po )
+    {
+      ++num_outputs;
+      BOOST_CHECK_EQUAL( names[v], "f" );
+    }
+  }
+  BOOST_CHECK_EQUAL( num_internal, 2u );
+  BOOST_CHECK_EQUAL( num_outputs, 1u );
+}
+
+BOOST_AUTO_TEST_CASE(blif)
+{
+  const auto filename = write_file( "blif", ".model test\n.inputs a\\x b\n.outputs f\n.names a\\x b \\\n f\n11 1\n.end\n" );
+
+  const auto lut = read_blif( filename );
+
+  const auto types = boost::get( boost::vertex_lut_type, lut );
+  const auto luts  = boost::get( boost::vertex_lut, lut );
+  const auto names = boost::get( boost::vertex_name, lut );
+
+  /* gnd, vdd, a\x, b, f, and the output */
+  BOOST_CHECK_EQUAL( boost::num_vertices( lut ), 6u );
+  BOOST_CHECK_EQUAL( names[2u], "a\\x" );
+  BOOST_CHECK( types[2u] == lut_type_t::pi );
+  BOOST_CHECK_EQUAL( names[3u], "b" );
+  BOOST_CHECK( types[3u] == lut_type_t::pi );
+  BOOST_CHECK_EQUAL( names[4u], "f" );
+  BOOST_CHECK( types[4u] == lut_type_t::internal );
+  BOOST_CHECK_EQUAL( luts[4u], "8" );
+  BOOST_CHECK_EQUAL( boost::out_degree( 4u, lut ), 2u );
+  BOOST_CHECK( types[5u] == lut_type_t::po );
+
+  /* g has no driver */
+  write_file( "blif", ".model test\n.inputs a b\n.outputs f g\n.names a b f\n11 1\n.end\n" );
+  BOOST_CHECK_THROW( read_blif( filename ), const char* );
+
+  std::remove( filename.c_str() );
+}
+
+BOOST_AUTO_TEST_CASE(verilog)
+{
+  /* assignments are not in topological order */
+  const auto filename = write_file( "v", "module top( a, b, c, f, g );\n"
+                                         "  input a, b, c;\n"
+                                         "  output f, g;\n"
+                                         "  wire t;\n"
+                                         "  assign f = ( t & c ) | ( t & a ) | ( c & a );\n"
+                                         "  assign t = a & ~b;\n"
+                                         "  assign g = t ^ c;\n"
+                                         "endmodule\n" );
+
+  const auto xmg = read_verilog( filename );
+
+  BOOST_CHECK_EQUAL( xmg.inputs().size(), 3u );
+  BOOST_CHECK_EQUAL( xmg.outputs().size(), 2u );
+  BOOST_CHECK_EQUAL( xmg.outputs()[0u].second, "f" );
+
+  const auto values = simulate_xmg( xmg, xmg_tt_simulator() );
+  auto f = values.at( xmg.outputs()[0u].first );
+  auto g = values.at( xmg.outputs()[1u].first );
+  tt_shrink( f, 3u );
+  tt_shrink( g, 3u );
+
+  /* t = a & ~b = 0x22 over a, b, c */
+  BOOST_CHECK_EQUAL( tt_to_hex( f ), "a2" );
+  BOOST_CHECK_EQUAL( tt_to_hex( g ), "d2" );
+
+  /* u is never defined */
+  write_file( "v", "module top( a, f );\n"
+                   "  input a;\n"
+                   "  output f;\n"
+                   "  assign f = a & u;\n"
+                   "endmodule\n" );
+  BOOST_CHECK_EQUAL( error_of( [&]() { read_verilog( filename ); } ), "undefined signal 'u' in line 4" );
+
+  write_file( "v", "module top( a, f );\n"
+                   "  input a;\n"
+                   "  output f;\n"
+                   "endmodule\n" );
+  BOOST_CHECK_EQUAL( error_of( [&]() { read_verilog( filename ); } ), "undefined output 'f'" );
+
+  std::remove( filename.c_str() );
+}
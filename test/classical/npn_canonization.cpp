@@ -0,0 +1,100 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE npn_canonization
+
+#include <boost/test/unit_test.hpp>
+
+#include <classical/functions/npn_canonization.hpp>
+#include <classical/utils/truth_table_utils.hpp>
+
+using namespace cirkit;
+
+template<int NumVars>
+void check_conversion( const std::string& hex, unsigned num_vars )
+{
+  const auto t = tt_from_hex( hex, num_vars );
+  const auto s = to_kitty_static<NumVars>( t );
+
+  BOOST_CHECK( from_kitty( s, num_vars ) == t );
+
+  /* variables that are not in t do not change the function */
+  for ( auto i = num_vars; i < static_cast<unsigned>( NumVars ); ++i )
+  {
+    BOOST_CHECK( kitty::flip( s, i ) == s );
+  }
+}
+
+BOOST_AUTO_TEST_CASE(conversion)
+{
+  check_conversion<3>( "e8", 3u );
+  check_conversion<4>( "e8", 3u );
+  check_conversion<4>( "e8a1", 4u );
+  check_conversion<6>( "8e3c1f7a02b4d659", 6u );
+  check_conversion<8>( "8e3c1f7a02b4d659", 6u );
+  check_conversion<8>( "0123456789abcdeffedcba9876543210", 7u );
+}
+
+BOOST_AUTO_TEST_CASE(npn)
+{
+  for ( const auto& hex : { "e8", "1e", "96", "80" } )
+  {
+    const auto t = tt_from_hex( hex, 3u );
+
+    unsigned                phase;
+    std::array<unsigned, 3> perm;
+    const auto npn = exact_npn_canonization<3>( to_kitty_static<3>( t ), phase, perm );
+
+    boost::dynamic_bitset<> dphase;
+    std::vector<unsigned>   dperm;
+    BOOST_CHECK( from_kitty( npn ) == exact_npn_canonization( t, dphase, dperm ) );
+    BOOST_CHECK_EQUAL( dphase.to_ulong(), phase );
+    BOOST_CHECK( std::equal( perm.begin(), perm.end(), dperm.begin() ) );
+  }
+}
+
+BOOST_AUTO_TEST_CASE(npn_8_inputs)
+{
+  const auto t = tt_from_hex( "8e3c1f7a02b4d6590123456789abcdeffedcba98765432108e3c1f7a02b4d659", 8u );
+
+  boost::dynamic_bitset<> phase;
+  std::vector<unsigned>   perm;
+  const auto npn = exact_npn_canonization( t, phase, perm );
+
+  auto perm_copy = perm;
+  BOOST_CHECK( tt_from_npn( npn, phase, perm_copy ) == t );
+
+  auto t2 = tt_flip( tt_permute( t, 1u, 7u ), 6u );
+  t2.flip();
+  BOOST_CHECK( exact_npn_canonization( t2, phase, perm ) == npn );
+}
+
+BOOST_AUTO_TEST_CASE(npn_classes)
+{
+  BOOST_CHECK_EQUAL( exact_npn_classes( 3u ).size(), 14u );
+  BOOST_CHECK_EQUAL( exact_npn_classes( 4u ).size(), 222u );
+}
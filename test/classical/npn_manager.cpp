@@ -0,0 +1,119 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE npn_manager
+
+#include <cstdio>
+#include <random>
+#include <thread>
+
+#include <boost/test/unit_test.hpp>
+
+#include <classical/functions/npn_canonization.hpp>
+#include <classical/utils/npn_manager.hpp>
+#include <classical/utils/truth_table_utils.hpp>
+
+using namespace cirkit;
+
+std::vector<tt> random_functions( unsigned count, unsigned num_vars )
+{
+  std::mt19937 gen( 42u );
+  std::vector<tt> functions;
+  for ( auto i = 0u; i < count; ++i )
+  {
+    functions.push_back( boost::dynamic_bitset<>( 1u << num_vars, gen() % 16u ) );
+  }
+  return functions;
+}
+
+void check_compute( npn_manager& mgr, const tt& t )
+{
+  boost::dynamic_bitset<> phase, phase2;
+  std::vector<unsigned> perm, perm2;
+
+  const auto npn = mgr.compute( t, phase, perm );
+  const auto npn2 = exact_npn_canonization( t, phase2, perm2 );
+
+  BOOST_CHECK( npn == npn2 );
+  BOOST_CHECK( phase == phase2 );
+  BOOST_CHECK( perm == perm2 );
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_compute)
+{
+  const auto functions = random_functions( 200u, 4u );
+  npn_manager mgr( 16u );
+
+  std::vector<std::thread> threads;
+  for ( auto i = 0u; i < 4u; ++i )
+  {
+    threads.emplace_back( [&]() {
+        for ( const auto& f : functions )
+        {
+          boost::dynamic_bitset<> phase;
+          std::vector<unsigned> perm;
+          mgr.compute( f, phase, perm );
+        }
+      } );
+  }
+  for ( auto& t : threads ) { t.join(); }
+
+  for ( const auto& f : functions )
+  {
+    check_compute( mgr, f );
+  }
+  BOOST_CHECK( mgr.size() <= 16u );
+}
+
+BOOST_AUTO_TEST_CASE(save_and_load)
+{
+  const auto filename = std::string( "/tmp/test_npn_manager.cache" );
+
+  {
+    npn_manager mgr;
+    for ( auto i = 0u; i < 256u; ++i )
+    {
+      boost::dynamic_bitset<> phase;
+      std::vector<unsigned> perm;
+      mgr.compute( boost::dynamic_bitset<>( 8u, i ), phase, perm );
+    }
+    BOOST_CHECK_EQUAL( mgr.size(), 256u );
+    BOOST_CHECK( mgr.save( filename ) );
+  }
+
+  npn_manager mgr;
+  BOOST_CHECK( mgr.load( filename ) );
+  BOOST_CHECK_EQUAL( mgr.size(), 256u );
+
+  for ( auto i = 0u; i < 256u; ++i )
+  {
+    check_compute( mgr, boost::dynamic_bitset<>( 8u, i ) );
+  }
+  BOOST_CHECK_EQUAL( mgr.size(), 256u );
+
+  std::remove( filename.c_str() );
+}
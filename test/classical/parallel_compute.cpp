@@ -0,0 +1,184 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE parallel_compute
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <boost/graph/topological_sort.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <classical/aig.hpp>
+#include <classical/functions/parallel_compute.hpp>
+#include <classical/utils/aig_utils.hpp>
+
+using namespace cirkit;
+
+/* random AIG with primary inputs, latches, and a free CI; gates only use
+ * earlier signals such that there are several levels of different width */
+aig_graph create_network( unsigned num_gates )
+{
+  aig_graph aig;
+  aig_initialize( aig );
+
+  std::mt19937 gen( 42u );
+  std::vector<aig_function> signals;
+
+  for ( auto i = 0u; i < 16u; ++i )
+  {
+    signals.push_back( aig_create_pi( aig, "x" + std::to_string( i ) ) );
+  }
+  signals.push_back( aig_create_ci( aig, "ci" ) );
+
+  for ( auto i = 0u; i < num_gates; ++i )
+  {
+    /* prefer recent signals to create deep paths */
+    const auto window = std::min<std::size_t>( signals.size(), 40u );
+    const auto& a = signals[signals.size() - 1u - gen() % window];
+    const auto& b = signals[gen() % signals.size()];
+    signals.push_back( aig_create_and( aig, a ^ ( gen() & 1u ), b ^ ( gen() & 1u ) ) );
+
+    if ( i % 100u == 50u )
+    {
+      signals.push_back( aig_create_lat( aig, signals.back(), "l" + std::to_string( i ) ) );
+    }
+  }
+
+  for ( auto i = 0u; i < 8u; ++i )
+  {
+    aig_create_po( aig, signals[signals.size() - 1u - i], "y" + std::to_string( i ) );
+  }
+
+  return aig;
+}
+
+std::uint64_t input_value( unsigned index )
+{
+  return ( index + 1u ) * 0x9e3779b97f4a7c15ull;
+}
+
+std::uint64_t and_value( const std::uint64_t& v1, bool c1, const std::uint64_t& v2, bool c2 )
+{
+  return ( c1 ? ~v1 : v1 ) & ( c2 ? ~v2 : v2 );
+}
+
+/* node by node in topological order */
+std::vector<std::uint64_t> sequential_compute( const aig_graph& aig )
+{
+  std::vector<aig_node> topsort( num_vertices( aig ) );
+  boost::topological_sort( aig, topsort.begin() );
+
+  std::vector<std::uint64_t> values( num_vertices( aig ) );
+  for ( auto n : topsort )
+  {
+    if ( n == 0u ) { continue; }
+
+    if ( out_degree( n, aig ) == 0u )
+    {
+      values[n] = input_value( aig_input_index( aig_info( aig ), n ) );
+    }
+    else
+    {
+      const auto children = get_children( aig, n );
+      values[n] = and_value( values[children[0u].node], children[0u].complemented, values[children[1u].node], children[1u].complemented );
+    }
+  }
+
+  return values;
+}
+
+BOOST_AUTO_TEST_CASE(values_match_sequential)
+{
+  const auto aig = create_network( 3000u );
+  BOOST_REQUIRE( !aig_info( aig ).cis.empty() );
+
+  const auto expected = sequential_compute( aig );
+  BOOST_CHECK_GT( aig_level_schedule( aig ).levels.size(), 10u );
+
+  for ( auto num_threads : {1u, 2u, 4u} )
+  {
+    for ( auto grain : {1u, 16u, 256u} )
+    {
+      std::vector<std::uint64_t> values;
+      parallel_compute<std::uint64_t>( aig, 0u, input_value, and_value, values, num_threads, grain );
+
+      BOOST_REQUIRE_EQUAL( values.size(), expected.size() );
+      for ( auto n = 1u; n < values.size(); ++n )
+      {
+        BOOST_REQUIRE_EQUAL( values[n], expected[n] );
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(each_node_once)
+{
+  const auto aig = create_network( 3000u );
+  const auto n = num_vertices( aig );
+
+  for ( auto num_threads : {1u, 4u} )
+  {
+    std::unique_ptr<std::atomic<unsigned>[]> visits( new std::atomic<unsigned>[n] );
+    for ( auto i = 0u; i < n; ++i ) { visits[i] = 0u; }
+
+    std::atomic<unsigned> early_children( 0u );
+    auto levels = 0u;
+    auto nodes_in_levels = 0u;
+
+    parallel_process( aig,
+                      [&]( aig_node node ) { ++visits[node]; },
+                      [&]( aig_node node, const aig_function& c1, const aig_function& c2 ) {
+                        /* children must be complete, the constant is never visited */
+                        if ( ( c1.node && visits[c1.node] != 1u ) || ( c2.node && visits[c2.node] != 1u ) ) { ++early_children; }
+                        ++visits[node];
+                      },
+                      [&]( const std::vector<aig_node>& level ) {
+                        ++levels;
+                        nodes_in_levels += level.size();
+                      },
+                      num_threads, 8u );
+
+    BOOST_CHECK_EQUAL( visits[0u].load(), 0u );
+    for ( auto i = 1u; i < n; ++i )
+    {
+      BOOST_REQUIRE_EQUAL( visits[i].load(), 1u );
+    }
+    BOOST_CHECK_EQUAL( early_children.load(), 0u );
+    BOOST_CHECK_EQUAL( levels, aig_level_schedule( aig ).levels.size() );
+    BOOST_CHECK_EQUAL( nodes_in_levels, n - 1u );
+  }
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
@@ -0,0 +1,295 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE priority_cuts
+
+#include <random>
+
+#include <boost/test/unit_test.hpp>
+
+#include <classical/aig.hpp>
+#include <classical/functions/cuts/priority.hpp>
+#include <classical/mig/mig.hpp>
+#include <classical/utils/aig_utils.hpp>
+#include <classical/utils/static_cut_simulation.hpp>
+#include <classical/xmg/xmg.hpp>
+#include <classical/xmg/xmg_utils.hpp>
+
+using namespace cirkit;
+
+template<unsigned K, typename Cuts, typename SimulateFn>
+void check_cuts( const Cuts& cuts, unsigned num_nodes, unsigned priority, SimulateFn&& simulate )
+{
+  for ( auto n = 0u; n < num_nodes; ++n )
+  {
+    BOOST_CHECK( cuts.count( n ) <= priority + 1u );
+
+    for ( const auto& c : cuts.cuts( n ) )
+    {
+      BOOST_CHECK( c.size <= K );
+      BOOST_CHECK( std::is_sorted( c.begin(), c.end() ) );
+      BOOST_CHECK( c.function == simulate( n, c ) );
+
+      for ( const auto& c2 : cuts.cuts( n ) )
+      {
+        BOOST_CHECK( &c == &c2 || !cut_dominates( c, c2 ) );
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(aig)
+{
+  aig_graph aig;
+  aig_initialize( aig );
+
+  std::mt19937 gen( 1u );
+  std::vector<aig_function> fs;
+  for ( auto i = 0u; i < 8u; ++i )
+  {
+    fs.push_back( aig_create_pi( aig, "x" + std::to_string( i ) ) );
+  }
+  for ( auto i = 0u; i < 200u; ++i )
+  {
+    const auto a = fs[gen() % fs.size()], b = fs[gen() % fs.size()];
+    fs.push_back( aig_create_and( aig, gen() % 2u ? !a : a, gen() % 2u ? !b : b ) );
+  }
+  for ( auto i = 8u; i < fs.size(); ++i )
+  {
+    aig_create_po( aig, fs[i], "y" + std::to_string( i ) );
+  }
+
+  auto settings = std::make_shared<properties>();
+  settings->set( "priority", 6u );
+  settings->set( "cost", cut_cost::depth );
+  const auto cuts = compute_priority_cuts<6u>( aig, settings );
+
+  BOOST_CHECK( cuts.total_cut_count() > 2u * boost::num_vertices( aig ) );
+
+  check_cuts<6u>( cuts, boost::num_vertices( aig ), 6u, [&aig]( unsigned n, const priority_cut<6u>& c ) {
+      return simulate_cut_static<6>( aig, n, c.begin(), c.end(), []( const kitty::static_truth_table<6>* v, unsigned ) { return v[0] & v[1]; } );
+    } );
+}
+
+BOOST_AUTO_TEST_CASE(mig)
+{
+  mig_graph mig;
+  mig_initialize( mig );
+
+  std::mt19937 gen( 3u );
+  std::vector<mig_function> fs;
+  for ( auto i = 0u; i < 8u; ++i )
+  {
+    fs.push_back( mig_create_pi( mig, "x" + std::to_string( i ) ) );
+  }
+  for ( auto i = 0u; i < 200u; ++i )
+  {
+    const auto a = fs[gen() % fs.size()], b = fs[gen() % fs.size()], c = fs[gen() % fs.size()];
+    fs.push_back( mig_create_maj( mig, a, gen() % 2u ? !b : b, c ) );
+  }
+  for ( auto i = 8u; i < fs.size(); ++i )
+  {
+    mig_create_po( mig, fs[i], "y" + std::to_string( i ) );
+  }
+
+  const auto simulate = [&mig]( unsigned n, const priority_cut<6u>& c ) {
+    return simulate_cut_static<6>( mig, n, c.begin(), c.end(), []( const kitty::static_truth_table<6>* v, unsigned ) { return kitty::ternary_majority( v[0], v[1], v[2] ); } );
+  };
+
+  const auto cuts = compute_priority_cuts<6u>( mig );
+
+  BOOST_CHECK( cuts.total_cut_count() > 2u * boost::num_vertices( mig ) );
+
+  check_cuts<6u>( cuts, boost::num_vertices( mig ), 8u, simulate );
+}
+
+BOOST_AUTO_TEST_CASE(large_priority)
+{
+  aig_graph aig;
+  aig_initialize( aig );
+
+  std::mt19937 gen( 4u );
+  std::vector<aig_function> fs;
+  for ( auto i = 0u; i < 16u; ++i )
+  {
+    fs.push_back( aig_create_pi( aig, "x" + std::to_string( i ) ) );
+  }
+  for ( auto i = 0u; i < 300u; ++i )
+  {
+    /* prefer recent nodes to obtain deep cones with many cuts */
+    const auto a = fs[fs.size() - 1u - gen() % std::min<unsigned>( fs.size(), 24u )];
+    const auto b = fs[fs.size() - 1u - gen() % std::min<unsigned>( fs.size(), 24u )];
+    fs.push_back( aig_create_and( aig, gen() % 2u ? !a : a, gen() % 2u ? !b : b ) );
+  }
+  aig_create_po( aig, fs.back(), "y" );
+
+  /* priorities beyond 255 must not overflow the per-node cut counter */
+  auto settings = std::make_shared<properties>();
+  settings->set( "priority", 300u );
+  const auto cuts = compute_priority_cuts<8u>( aig, settings );
+
+  auto max_count = 0u;
+  for ( auto n = 0u; n < boost::num_vertices( aig ); ++n )
+  {
+    max_count = std::max( max_count, cuts.count( n ) );
+  }
+  BOOST_CHECK( max_count > 255u );
+
+  /* with so many cuts per node, some leaves lie in the cone of other leaves,
+     so cut functions are checked against random simulation of the whole AIG */
+  const auto& complement = boost::get( boost::edge_complement, aig );
+  std::vector<std::array<uint64_t, 4u>> values( boost::num_vertices( aig ) );
+  for ( auto n = 0u; n < boost::num_vertices( aig ); ++n )
+  {
+    if ( n == aig_info( aig ).constant ) { values[n].fill( 0u ); continue; }
+    if ( boost::out_degree( n, aig ) == 0u )
+    {
+      for ( auto& w : values[n] ) { w = gen() ^ ( uint64_t( gen() ) << 32u ); }
+      continue;
+    }
+    values[n].fill( ~uint64_t( 0u ) );
+    for ( const auto& e : boost::make_iterator_range( boost::out_edges( n, aig ) ) )
+    {
+      for ( auto w = 0u; w < 4u; ++w )
+      {
+        values[n][w] &= complement[e] ? ~values[boost::target( e, aig )][w] : values[boost::target( e, aig )][w];
+      }
+    }
+  }
+
+  for ( auto n = 0u; n < boost::num_vertices( aig ); ++n )
+  {
+    BOOST_CHECK( cuts.count( n ) <= 301u );
+
+    for ( const auto& c : cuts.cuts( n ) )
+    {
+      BOOST_CHECK( c.size <= 8u );
+      BOOST_CHECK( std::is_sorted( c.begin(), c.end() ) );
+
+      auto mismatches = 0u;
+      for ( auto pattern = 0u; pattern < 256u; ++pattern )
+      {
+        auto index = 0u;
+        for ( auto i = 0u; i < c.size; ++i )
+        {
+          index |= ( ( values[c.leaves[i]][pattern >> 6u] >> ( pattern & 63u ) ) & 1u ) << i;
+        }
+        if ( kitty::get_bit( c.function, index ) != static_cast<bool>( ( values[n][pattern >> 6u] >> ( pattern & 63u ) ) & 1u ) )
+        {
+          ++mismatches;
+        }
+      }
+      BOOST_CHECK_EQUAL( mismatches, 0u );
+    }
+  }
+}
+
+/* whole-cone simulation on 16 inputs; alternates between graphs to check
+ * that the per-thread node table is not confused by earlier calls */
+BOOST_AUTO_TEST_CASE(static_simulation_large_cone)
+{
+  using tt16 = kitty::static_truth_table<16>;
+
+  const auto create = []( unsigned num_gates, unsigned seed ) {
+    aig_graph aig;
+    aig_initialize( aig );
+
+    std::mt19937 gen( seed );
+    std::vector<aig_function> fs;
+    for ( auto i = 0u; i < 16u; ++i )
+    {
+      fs.push_back( aig_create_pi( aig, "x" + std::to_string( i ) ) );
+    }
+    for ( auto i = 0u; i < num_gates; ++i )
+    {
+      const auto a = fs[fs.size() - 1u - gen() % std::min<std::size_t>( fs.size(), 20u )];
+      const auto b = fs[gen() % fs.size()];
+      fs.push_back( aig_create_and( aig, gen() % 2u ? !a : a, gen() % 2u ? !b : b ) );
+    }
+    aig_create_po( aig, fs.back(), "y" );
+    return aig;
+  };
+
+  const auto check = []( const aig_graph& aig ) {
+    /* nodes are created in topological order */
+    std::vector<tt16> expected( boost::num_vertices( aig ) );
+    for ( auto n = 1u; n < expected.size(); ++n )
+    {
+      if ( boost::out_degree( n, aig ) == 0u )
+      {
+        kitty::create_nth_var( expected[n], aig_input_index( aig_info( aig ), n ) );
+      }
+      else
+      {
+        const auto c = get_children( aig, n );
+        expected[n] = ( c[0u].complemented ? ~expected[c[0u].node] : expected[c[0u].node] ) &
+                      ( c[1u].complemented ? ~expected[c[1u].node] : expected[c[1u].node] );
+      }
+    }
+
+    const auto& inputs = aig_info( aig ).inputs;
+    const auto root = aig_info( aig ).outputs.front().first.node;
+    const auto f = simulate_cut_static<16>( aig, root, inputs.begin(), inputs.end(), []( const tt16* v, unsigned ) { return v[0] & v[1]; } );
+    BOOST_CHECK( f == expected[root] );
+  };
+
+  const auto large = create( 3000u, 5u );
+  const auto small = create( 40u, 6u );
+
+  check( large );
+  check( small );
+  check( large );
+}
+
+BOOST_AUTO_TEST_CASE(xmg)
+{
+  xmg_graph xmg;
+
+  std::mt19937 gen( 2u );
+  std::vector<xmg_function> fs;
+  for ( auto i = 0u; i < 8u; ++i )
+  {
+    fs.push_back( xmg.create_pi( "x" + std::to_string( i ) ) );
+  }
+  for ( auto i = 0u; i < 200u; ++i )
+  {
+    const auto a = fs[gen() % fs.size()], b = fs[gen() % fs.size()], c = fs[gen() % fs.size()];
+    fs.push_back( gen() % 3u ? xmg.create_maj( a, gen() % 2u ? !b : b, c ) : xmg.create_xor( a, b ) );
+  }
+  for ( auto i = 8u; i < fs.size(); ++i )
+  {
+    xmg.create_po( fs[i], "y" + std::to_string( i ) );
+  }
+
+  const auto cuts = compute_priority_cuts<4u>( xmg );
+
+  BOOST_CHECK( cuts.total_cut_count() > 2u * xmg.size() );
+
+  check_cuts<4u>( cuts, xmg.size(), 8u, [&xmg]( unsigned n, const priority_cut<4u>& c ) {
+      return xmg_simulate_cut_static<4>( xmg, n, c.begin(), c.end() );
+    } );
+}
@@ -0,0 +1,164 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE simulate_aig_bitparallel
+
+#include <random>
+
+#include <boost/dynamic_bitset.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <classical/aig.hpp>
+#include <classical/aig_compact.hpp>
+#include <classical/functions/simulate_aig.hpp>
+#include <classical/functions/simulate_aig_bitparallel.hpp>
+#include <classical/utils/aig_utils.hpp>
+
+using namespace cirkit;
+
+template<typename AIG>
+void create_network( AIG& aig )
+{
+  const auto a = aig_create_pi( aig, "a" );
+  const auto b = aig_create_pi( aig, "b" );
+  const auto c = aig_create_pi( aig, "c" );
+  const auto d = aig_create_pi( aig, "d" );
+
+  const auto m = aig_create_maj( aig, a, b, c );
+  const auto x = aig_create_xor( aig, m, d );
+
+  aig_create_po( aig, x, "x" );
+  aig_create_po( aig, !aig_create_or( aig, !a, aig_create_and( aig, c, !d ) ), "y" );
+  aig_create_po( aig, !b, "nb" );
+  aig_create_po( aig, aig_get_constant( aig, true ), "one" );
+}
+
+std::vector<boost::dynamic_bitset<>> random_patterns( unsigned num_inputs, unsigned num_patterns )
+{
+  std::mt19937 gen( 42u );
+  std::vector<boost::dynamic_bitset<>> patterns;
+
+  for ( auto p = 0u; p < num_patterns; ++p )
+  {
+    boost::dynamic_bitset<> pattern( num_inputs );
+    for ( auto i = 0u; i < num_inputs; ++i )
+    {
+      pattern[i] = gen() & 1u;
+    }
+    patterns.push_back( pattern );
+  }
+
+  return patterns;
+}
+
+template<typename AIG>
+void check_against_simulate_aig( const AIG& aig, const std::vector<aig_function>& outputs, unsigned num_patterns )
+{
+  const auto patterns = random_patterns( 4u, num_patterns );
+
+  aig_bitparallel_simulator sim( aig );
+  sim.simulate( patterns );
+
+  BOOST_CHECK_EQUAL( sim.num_patterns(), num_patterns );
+  const auto sigs = sim.output_signatures();
+  BOOST_REQUIRE_EQUAL( sigs.size(), outputs.size() );
+
+  for ( auto p = 0u; p < num_patterns; ++p )
+  {
+    const auto values = simulate_aig( aig, pattern_simulator( patterns[p] ) );
+    for ( auto o = 0u; o < outputs.size(); ++o )
+    {
+      BOOST_CHECK_EQUAL( sigs[o][p], values.at( outputs[o] ) );
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(aig_graph_patterns)
+{
+  aig_graph aig;
+  aig_initialize( aig );
+  create_network( aig );
+
+  std::vector<aig_function> outputs;
+  for ( const auto& o : aig_info( aig ).outputs )
+  {
+    outputs.push_back( o.first );
+  }
+
+  /* one partial block and several blocks with a partial last one */
+  check_against_simulate_aig( aig, outputs, 70u );
+  check_against_simulate_aig( aig, outputs, 2u * 64u * aig_bitparallel_simulator::block_words + 100u );
+}
+
+BOOST_AUTO_TEST_CASE(aig_compact_patterns)
+{
+  aig_compact aig;
+  create_network( aig );
+
+  std::vector<aig_function> outputs;
+  for ( auto i = 0u; i < aig.outputs().size(); ++i )
+  {
+    outputs.push_back( aig.output( i ) );
+  }
+
+  check_against_simulate_aig( aig, outputs, 70u );
+  check_against_simulate_aig( aig, outputs, 2u * 64u * aig_bitparallel_simulator::block_words + 100u );
+}
+
+BOOST_AUTO_TEST_CASE(input_words)
+{
+  aig_compact aig;
+  create_network( aig );
+
+  const auto num_patterns = 64u * aig_bitparallel_simulator::block_words + 65u;
+  const auto patterns = random_patterns( 4u, num_patterns );
+
+  std::vector<std::vector<std::uint64_t>> words( 4u, std::vector<std::uint64_t>( ( num_patterns + 63u ) >> 6u, 0u ) );
+  for ( auto p = 0u; p < num_patterns; ++p )
+  {
+    for ( auto i = 0u; i < 4u; ++i )
+    {
+      if ( patterns[p][i] )
+      {
+        words[i][p >> 6u] |= std::uint64_t( 1u ) << ( p & 63u );
+      }
+    }
+  }
+
+  aig_bitparallel_simulator sim1( aig ), sim2( aig );
+  sim1.simulate( patterns );
+  sim2.simulate_words( words, num_patterns );
+
+  BOOST_CHECK( sim1.output_signatures() == sim2.output_signatures() );
+  BOOST_CHECK( sim2.output_signature( 3u ).all() );
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
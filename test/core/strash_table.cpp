@@ -0,0 +1,113 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE strash_table
+
+#include <boost/test/unit_test.hpp>
+
+#include <core/utils/strash_table.hpp>
+
+using namespace cirkit;
+
+BOOST_AUTO_TEST_CASE(simple)
+{
+  strash_table<2u> table( 0.5, 16u );
+
+  for ( auto i = 0u; i < 1000u; ++i )
+  {
+    BOOST_CHECK( table.find( {{2u * i, 2u * i + 3u}} ) == nullptr );
+    BOOST_CHECK( table.insert( {{2u * i, 2u * i + 3u}}, i ).second );
+  }
+
+  BOOST_CHECK_EQUAL( table.size(), 1000u );
+  BOOST_CHECK( table.size() <= table.capacity() * table.max_load_factor() );
+
+  for ( auto i = 0u; i < 1000u; ++i )
+  {
+    const auto* value = table.find( {{2u * i, 2u * i + 3u}} );
+    BOOST_REQUIRE( value != nullptr );
+    BOOST_CHECK_EQUAL( *value, i );
+
+    /* keys are ordered */
+    BOOST_CHECK( table.find( {{2u * i + 3u, 2u * i}} ) == nullptr );
+  }
+
+  /* inserting an existing key returns the stored value */
+  const auto r = table.insert( {{0u, 3u}}, 42u );
+  BOOST_CHECK( !r.second );
+  BOOST_CHECK_EQUAL( r.first, 0u );
+
+  BOOST_CHECK_EQUAL( table.statistics().hits, 1000u );
+  BOOST_CHECK( table.statistics().rehashes > 0u );
+
+  table.clear();
+  BOOST_CHECK( table.empty() );
+  BOOST_CHECK( table.find( {{0u, 3u}} ) == nullptr );
+}
+
+BOOST_AUTO_TEST_CASE(load_factor)
+{
+  strash_table<3u> table;
+
+  table.reserve( 100u );
+  const auto capacity = table.capacity();
+  for ( auto i = 0u; i < 100u; ++i )
+  {
+    table.insert( {{i, i + 1u, i + 2u}}, i );
+  }
+  BOOST_CHECK_EQUAL( table.capacity(), capacity );
+
+  table.set_max_load_factor( 0.25 );
+  BOOST_CHECK( table.size() <= table.capacity() * 0.25 );
+  for ( auto i = 0u; i < 100u; ++i )
+  {
+    BOOST_CHECK_EQUAL( *table.find( {{i, i + 1u, i + 2u}} ), i );
+  }
+}
+
+BOOST_AUTO_TEST_CASE(const_lookup)
+{
+  struct function { unsigned node; bool complemented; };
+
+  strash_table<2u> table;
+  const auto key = strash_table<2u>::key_t{{strash_literal( function{3u, true} ), strash_literal( function{5u, false} )}};
+  BOOST_CHECK_EQUAL( key[0u], 7u );
+  BOOST_CHECK_EQUAL( key[1u], 10u );
+  table.insert( key, 6u );
+
+  /* lookups through a const reference still count */
+  const auto& ctable = table;
+  BOOST_CHECK_EQUAL( *ctable.find( key ), 6u );
+  BOOST_CHECK_EQUAL( ctable.statistics().lookups, 1u );
+  BOOST_CHECK_EQUAL( ctable.statistics().hits, 1u );
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
@@ -0,0 +1,79 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2017  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE thread_pool
+
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+#include <core/utils/thread_pool.hpp>
+
+using namespace cirkit;
+
+BOOST_AUTO_TEST_CASE(parallel_for)
+{
+  thread_pool pool( 4u );
+
+  std::vector<unsigned> values( 10000u, 0u );
+  pool.parallel_for( 0u, values.size(), 64u, [&values]( std::size_t i ) { values[i] = i * i; } );
+
+  for ( auto i = 0u; i < values.size(); ++i )
+  {
+    BOOST_CHECK_EQUAL( values[i], i * i );
+  }
+}
+
+BOOST_AUTO_TEST_CASE(nested_groups)
+{
+  thread_pool pool( 2u );
+
+  std::atomic<unsigned> count( 0u );
+  task_group outer( pool );
+  for ( auto i = 0u; i < 16u; ++i )
+  {
+    outer.run( [&pool, &count]() {
+        pool.parallel_for( 0u, 100u, 10u, [&count]( std::size_t ) { ++count; } );
+      } );
+  }
+  outer.wait();
+
+  BOOST_CHECK_EQUAL( count.load(), 1600u );
+}
+
+BOOST_AUTO_TEST_CASE(exceptions)
+{
+  task_group group( shared_thread_pool() );
+  group.run( []() { throw std::runtime_error( "task failed" ); } );
+  BOOST_CHECK_THROW( group.wait(), std::runtime_error );
+
+  /* enqueue still returns futures */
+  auto f = shared_thread_pool().enqueue( []( unsigned a, unsigned b ) { return a + b; }, 2u, 3u );
+  BOOST_CHECK_EQUAL( f.get(), 5u );
+}